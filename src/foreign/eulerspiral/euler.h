@@ -30,6 +30,7 @@
 
 // Rewritten by Amir: Feb 1, 2004
 
+#include <cmath>
 #include "angles.h"
 #include "BiArc.h"
 #include <vector>
@@ -108,19 +109,28 @@ public:
   }
 };
 
+//the values stored per pair of angles: k0, k1, gamma and L
+#define ES_LOOKUP_FIELDS 4
+
 class EulerSpiralLookupTable
 {
 private:
-  // following line commented out to make clang compiler happy, MB 14.06.2014 
-  //int NN; //size of the lookup tables (NNxNN) or number of data points between -pi and pi
-  double* _theta; //lookup the theta value corresponding to the index NN long
+  int _NN; //size of the lookup tables (NNxNN) or number of data points between -pi and pi
   double _dt; //delta theta 
 
-  //lookup tables read in from files
-  double** ES_k0;
-  double** ES_k1;
-  double** ES_gamma;
-  double** ES_L;
+  //lookup tables read in from files, stored as one contiguous block of NNxNN
+  //records {k0, k1, gamma, L} (row = start angle) so that all values for a
+  //pair of angles are read from the same cache line
+  std::vector<double> _table;
+
+  const double* record(double start_angle, double end_angle) const
+  {
+    int i = (int)floor(angle0To2Pi(start_angle + M_PI)/_dt);
+    int j = (int)floor(angle0To2Pi(end_angle + M_PI)/_dt);
+    if (i >= _NN) i = _NN-1;
+    if (j >= _NN) j = _NN-1;
+    return &_table[(i*_NN + j)*ES_LOOKUP_FIELDS];
+  }
   
 public:
   EulerSpiralLookupTable();
@@ -128,13 +138,36 @@ public:
 
   static EulerSpiralLookupTable* get_globalEulerSpiralLookupTable();
 
-  double k0(double start_angle, double end_angle);
-  double k1(double start_angle, double end_angle);
-  double gamma(double start_angle, double end_angle);
-  double L(double start_angle, double end_angle);
+  //fills the table from the four NNxNN row major tables
+  void init(int NN, const double* k0_table, const double* k1_table, const double* gamma_table, const double* L_table)
+  {
+    _NN = NN;
+    _dt = 2*M_PI/NN;
+    _table.resize(NN*NN*ES_LOOKUP_FIELDS);
+    for (int i=0; i<NN*NN; i++){
+      _table[i*ES_LOOKUP_FIELDS]   = k0_table[i];
+      _table[i*ES_LOOKUP_FIELDS+1] = k1_table[i];
+      _table[i*ES_LOOKUP_FIELDS+2] = gamma_table[i];
+      _table[i*ES_LOOKUP_FIELDS+3] = L_table[i];
+    }
+  }
+
+  double k0(double start_angle, double end_angle) const { return record(start_angle, end_angle)[0]; }
+  double k1(double start_angle, double end_angle) const { return record(start_angle, end_angle)[1]; }
+  double gamma(double start_angle, double end_angle) const { return record(start_angle, end_angle)[2]; }
+  double L(double start_angle, double end_angle) const { return record(start_angle, end_angle)[3]; }
+
+  //looks up the initial estimates of k0, gamma and L at once
+  void lookup(double start_angle, double end_angle, double &k0, double &gamma, double &L) const
+  {
+    const double* r = record(start_angle, end_angle);
+    k0 = r[0];
+    gamma = r[2];
+    L = r[3];
+  }
 
-  double dt(); //delta theta values for the table (tells you about the accuracy of the lookup)
-  double theta(int N); //lookup the theta value indexed by N
+  double dt() const { return _dt; } //delta theta values for the table (tells you about the accuracy of the lookup)
+  double theta(int N) const { return -M_PI + N*_dt; } //lookup the theta value indexed by N
 };
 
 class EulerSpiral
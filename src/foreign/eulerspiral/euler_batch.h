@@ -0,0 +1,219 @@
+/************************************************************************
+ *                                                                      *
+ *  Batched evaluation of many Euler spirals                            *
+ *                                                                      *
+ *  The points of an Euler spiral (clothoid) with the start point       *
+ *  (x0, y0), the start angle theta, the curvature k0 and the           *
+ *  curvature rate gamma at arclength s are given in closed form by     *
+ *  the Fresnel integrals:                                              *
+ *                                                                      *
+ *    x + iy = (x0 + iy0) + sqrt(pi/|gamma|) * exp(i*phi)               *
+ *             * (sign(gamma)*dC + i*dS)                                *
+ *                                                                      *
+ *  with phi = theta - k0^2/(2*gamma), v(s) = (k0 + gamma*s) /          *
+ *  sqrt(pi*|gamma|), dC = C(v(s)) - C(v(0)) and dS likewise.           *
+ *                                                                      *
+ *  For spirals close to circular arcs the phase k0^2/(2*gamma) gets    *
+ *  large and the formula loses precision; these are integrated by      *
+ *  Gauss-Legendre quadrature instead.                                  *
+ *                                                                      *
+ ************************************************************************/
+
+#ifndef EULER_BATCH_H
+#define EULER_BATCH_H
+
+#include <vector>
+#include "points.h"
+#include "fresnel.h"
+#include "euler.h"
+
+//spirals with |gamma|*L^3 below this are evaluated as circular arcs
+#define ES_BATCH_ARC_LIMIT 1e-9
+//spirals with a larger Fresnel phase are integrated numerically
+#define ES_BATCH_PHASE_LIMIT 1e3
+//the maximum change of angle within one quadrature interval
+#define ES_BATCH_QUADRATURE_ANGLE 0.1
+
+//Stores the parameters of many spirals in contiguous arrays (one per
+//parameter) and evaluates their points in one go. The points of all spirals
+//are written into common arrays, each spiral's points starting at its offset.
+//
+//evaluate() does not modify the batch, so disjoint ranges of spirals may be
+//evaluated by several threads at once (e.g. one range of lanes per thread).
+class EulerSpiralBatch
+{
+private:
+  std::vector<double> _x0;
+  std::vector<double> _y0;
+  std::vector<double> _theta;
+  std::vector<double> _k0;
+  std::vector<double> _gamma;
+  std::vector<double> _L;
+  //the index of each spiral's first point (one more than spirals)
+  std::vector<int> _offset;
+
+public:
+  EulerSpiralBatch()
+  {
+    _offset.push_back(0);
+  }
+
+  //adds a spiral to be sampled at NPts (at least 2) equidistant points
+  //including both ends, returns its index
+  int add(Point2D<double> start_pt, double start_angle, double k0, double gamma, double L, int NPts)
+  {
+    _x0.push_back(start_pt.getX());
+    _y0.push_back(start_pt.getY());
+    _theta.push_back(start_angle);
+    _k0.push_back(k0);
+    _gamma.push_back(gamma);
+    _L.push_back(L);
+    _offset.push_back(_offset.back() + (NPts < 2 ? 2 : NPts));
+    return (int)_x0.size() - 1;
+  }
+
+  //adds a spiral with computed parameters (see EulerSpiral::compute_es_params)
+  int add(const EulerSpiralParams& params, int NPts)
+  {
+    return add(params.start_pt, params.start_angle, params.K0, params.gamma, params.L, NPts);
+  }
+
+  void clear()
+  {
+    _x0.clear();
+    _y0.clear();
+    _theta.clear();
+    _k0.clear();
+    _gamma.clear();
+    _L.clear();
+    _offset.resize(1);
+  }
+
+  int size() const { return (int)_x0.size(); }
+
+  //the total number of points of all spirals
+  int num_points() const { return _offset.back(); }
+
+  //the index of the spiral's first point
+  int first_point(int spiral) const { return _offset[spiral]; }
+
+  //the number of the spiral's points
+  int num_points(int spiral) const { return _offset[spiral+1] - _offset[spiral]; }
+
+  //evaluates the spirals [first, last), writing the points into x and y
+  //(which must hold num_points() values) at the spirals' offsets
+  void evaluate(int first, int last, double* x, double* y) const
+  {
+    int maxPts = 0;
+    for (int i=first; i<last; i++)
+      if (num_points(i) > maxPts)
+        maxPts = num_points(i);
+    std::vector<double> scratch(3*maxPts);
+    double* v = maxPts > 0 ? &scratch[0] : 0;
+    double* C = v + maxPts;
+    double* S = C + maxPts;
+
+    for (int i=first; i<last; i++){
+      const int n = num_points(i);
+      double* const px = x + _offset[i];
+      double* const py = y + _offset[i];
+      const double ds = _L[i]/(n-1);
+      const double k0 = _k0[i];
+      const double gamma = _gamma[i];
+      const double theta = _theta[i];
+
+      if (fabs(gamma)*_L[i]*_L[i]*_L[i] < ES_BATCH_ARC_LIMIT){
+        //circular arc or straight line: the chord of length 2*sin(k0*s/2)/k0
+        //points in the direction of the mean angle
+        for (int j=0; j<n; j++){
+          const double s = j*ds;
+          const double h = 0.5*k0*s;
+          const double sinc = fabs(h) < 1e-4 ? 1.0 - h*h/6.0 : sin(h)/h;
+          const double chord = s*sinc;
+          px[j] = _x0[i] + chord*cos(theta + h);
+          py[j] = _y0[i] + chord*sin(theta + h);
+        }
+        continue;
+      }
+
+      const double k1 = k0 + gamma*_L[i];
+      if ((k0*k0 > k1*k1 ? k0*k0 : k1*k1)/(2*fabs(gamma)) > ES_BATCH_PHASE_LIMIT){
+        integrate(i, ds, n, px, py);
+        continue;
+      }
+
+      const double scale = 1.0/sqrt(M_PI*fabs(gamma));
+      for (int j=0; j<n; j++)
+        v[j] = (k0 + gamma*j*ds)*scale;
+      fresnel_batch(v, C, S, n);
+
+      const double factor = sqrt(M_PI/fabs(gamma));
+      const double phi = theta - 0.5*k0*k0/gamma;
+      const double cos_phi = factor*cos(phi);
+      const double sin_phi = factor*sin(phi);
+      const double sign = gamma < 0 ? -1.0 : 1.0;
+      const double C0 = C[0];
+      const double S0 = S[0];
+      for (int j=0; j<n; j++){
+        const double dC = sign*(C[j] - C0);
+        const double dS = S[j] - S0;
+        px[j] = _x0[i] + cos_phi*dC - sin_phi*dS;
+        py[j] = _y0[i] + sin_phi*dC + cos_phi*dS;
+      }
+    }
+  }
+
+private:
+  //integrates the spiral by four point Gauss-Legendre quadrature between the samples
+  void integrate(int i, double ds, int n, double* px, double* py) const
+  {
+    static const double nodes[4] = {-0.861136311594052575, -0.339981043584856265, 0.339981043584856265, 0.861136311594052575};
+    static const double weights[4] = {0.347854845137453857, 0.652145154862546143, 0.652145154862546143, 0.347854845137453857};
+    const double k0 = _k0[i];
+    const double gamma = _gamma[i];
+    const double theta = _theta[i];
+    const double k1 = k0 + gamma*_L[i];
+    const double max_k = fabs(k0) > fabs(k1) ? fabs(k0) : fabs(k1);
+    const int steps = 1 + (int)(max_k*ds/ES_BATCH_QUADRATURE_ANGLE);
+    const double h = ds/steps;
+    double x = _x0[i];
+    double y = _y0[i];
+    px[0] = x;
+    py[0] = y;
+    for (int j=1; j<n; j++){
+      for (int k=0; k<steps; k++){
+        const double a = (j-1)*ds + k*h;
+        for (int q=0; q<4; q++){
+          const double s = a + 0.5*h*(1.0 + nodes[q]);
+          const double angle = theta + s*(k0 + 0.5*gamma*s);
+          x += 0.5*h*weights[q]*cos(angle);
+          y += 0.5*h*weights[q]*sin(angle);
+        }
+      }
+      px[j] = x;
+      py[j] = y;
+    }
+  }
+
+public:
+  //evaluates all spirals
+  void evaluate(std::vector<double>& x, std::vector<double>& y) const
+  {
+    x.resize(num_points());
+    y.resize(num_points());
+    if (num_points() > 0)
+      evaluate(0, size(), &x[0], &y[0]);
+  }
+
+  //evaluates all spirals into points
+  void evaluate(std::vector<Point2D<double> >& pts) const
+  {
+    std::vector<double> x, y;
+    evaluate(x, y);
+    pts.resize(x.size());
+    for (unsigned int i=0; i<x.size(); i++)
+      pts[i].set(x[i], y[i]);
+  }
+};
+
+#endif
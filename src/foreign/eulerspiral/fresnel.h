@@ -0,0 +1,195 @@
+/************************************************************************
+ *                                                                      *
+ *  Fresnel integrals for the evaluation of Euler spirals               *
+ *                                                                      *
+ *  The rational approximations are the ones of the Cephes Math         *
+ *  Library (fresnl.c, Copyright 1984, 1987, 1989 by Stephen L.         *
+ *  Moshier), accurate to about 1e-15.                                  *
+ *                                                                      *
+ ************************************************************************/
+
+#ifndef FRESNEL_H
+#define FRESNEL_H
+
+#include <cmath>
+#include "angles.h"
+
+//the argument (x*x) up to which the power series approximation is used
+#define FRESNEL_SERIES_LIMIT 2.5625
+//the argument beyond which C(x) and S(x) are 0.5 in double precision
+#define FRESNEL_ASYMPTOTIC_LIMIT 36974.0
+
+namespace fresnel_detail
+{
+  //S(x) for small x
+  static const double sn[6] = {
+    -2.99181919401019853726E3,
+     7.08840045257738576863E5,
+    -6.29741486205862506537E7,
+     2.54890880573376359104E9,
+    -4.42979518059697779103E10,
+     3.18016297876567817986E11
+  };
+  static const double sd[6] = {
+     2.81376268889994315696E2,
+     4.55847810806532581675E4,
+     5.17343888770096400730E6,
+     4.19320245898111231129E8,
+     2.24411795645340920940E10,
+     6.07366389490084639049E11
+  };
+
+  //C(x) for small x
+  static const double cn[6] = {
+    -4.98843114573573548651E-8,
+     9.50428062829859605134E-6,
+    -6.45191435683965050962E-4,
+     1.88843319396703850064E-2,
+    -2.05525900955013891793E-1,
+     9.99999999999999998822E-1
+  };
+  static const double cd[7] = {
+     3.99982968972495980367E-12,
+     9.15439215774657478799E-10,
+     1.25001862479598821474E-7,
+     1.22262789024179030997E-5,
+     8.68029542941784300606E-4,
+     4.12142090722199792936E-2,
+     1.00000000000000000118E0
+  };
+
+  //auxiliary function f(x)
+  static const double fn[10] = {
+    4.21543555043677546506E-1,
+    1.43407919780758885261E-1,
+    1.15220955073585758835E-2,
+    3.45017939782574027900E-4,
+    4.63613749287867322088E-6,
+    3.05568983790257605827E-8,
+    1.02304514164907233465E-10,
+    1.72010743268161828879E-13,
+    1.34283276233062758925E-16,
+    3.76329711269987889006E-20
+  };
+  static const double fd[10] = {
+    7.51586398353378947175E-1,
+    1.16888925859191382142E-1,
+    6.44051526508858611005E-3,
+    1.55934409164153020873E-4,
+    1.84627567348930545870E-6,
+    1.12699224763999035261E-8,
+    3.60140029589371370404E-11,
+    5.88754533621578410010E-14,
+    4.52001434074129701496E-17,
+    1.25443237090011264384E-20
+  };
+
+  //auxiliary function g(x)
+  static const double gn[11] = {
+    5.04442073643383265887E-1,
+    1.97102833525523411709E-1,
+    1.87648584092575249293E-2,
+    6.84079380915393090172E-4,
+    1.15138826111884280931E-5,
+    9.82852443688422223854E-8,
+    4.45344415861750144738E-10,
+    1.08268041139020870318E-12,
+    1.37555460633261799868E-15,
+    8.36354435630677421531E-19,
+    1.86958710162783235106E-22
+  };
+  static const double gd[11] = {
+    1.47495759925128324529E0,
+    3.37748989120019970451E-1,
+    2.53603741420338795122E-2,
+    8.14679107184306179049E-4,
+    1.27545075667729118702E-5,
+    1.04314589657571990585E-7,
+    4.60680728146520428211E-10,
+    1.10273215066240270757E-12,
+    1.38796531259578871258E-15,
+    8.39158816283118707363E-19,
+    1.86958710162783236342E-22
+  };
+
+  //evaluates the polynomial with the given coefficients (highest degree first)
+  inline double polevl(double x, const double* coef, int degree)
+  {
+    double result = coef[0];
+    for (int i=1; i<=degree; i++)
+      result = result*x + coef[i];
+    return result;
+  }
+
+  //like polevl, with an implicit leading coefficient of 1
+  inline double p1evl(double x, const double* coef, int degree)
+  {
+    double result = x + coef[0];
+    for (int i=1; i<degree; i++)
+      result = result*x + coef[i];
+    return result;
+  }
+}
+
+//computes the Fresnel integrals C(x) = int_0^x cos(pi/2 t^2) dt and S(x) = int_0^x sin(pi/2 t^2) dt
+inline void fresnel(double x, double &C, double &S)
+{
+  using namespace fresnel_detail;
+  const double ax = fabs(x);
+  const double x2 = ax*ax;
+  if (x2 < FRESNEL_SERIES_LIMIT){
+    const double t = x2*x2;
+    S = ax*x2*polevl(t, sn, 5)/p1evl(t, sd, 6);
+    C = ax*polevl(t, cn, 5)/polevl(t, cd, 6);
+  }
+  else if (ax > FRESNEL_ASYMPTOTIC_LIMIT){
+    C = 0.5;
+    S = 0.5;
+  }
+  else {
+    double t = M_PI*x2;
+    const double u = 1.0/(t*t);
+    t = 1.0/t;
+    const double f = 1.0 - u*polevl(u, fn, 9)/p1evl(u, fd, 10);
+    const double g = t*polevl(u, gn, 10)/p1evl(u, gd, 11);
+    t = M_PI/2*x2;
+    const double c = cos(t);
+    const double s = sin(t);
+    t = M_PI*ax;
+    C = 0.5 + (f*s - g*c)/t;
+    S = 0.5 - (f*c + g*s)/t;
+  }
+  if (x < 0){
+    C = -C;
+    S = -S;
+  }
+}
+
+//computes the Fresnel integrals of n arguments
+//
+//The power series is evaluated for all arguments by a loop without branches
+//which the compiler may vectorize; the (usually few) arguments needing the
+//asymptotic approximation are recomputed afterwards.
+inline void fresnel_batch(const double* x, double* C, double* S, int n)
+{
+  using namespace fresnel_detail;
+  for (int i=0; i<n; i++){
+    //power series for all, the asymptotic arguments are fixed below
+    const double ax = fabs(x[i]);
+    const double x2 = ax*ax;
+    const double t = x2*x2;
+    S[i] = ax*x2*polevl(t, sn, 5)/p1evl(t, sd, 6);
+    C[i] = ax*polevl(t, cn, 5)/polevl(t, cd, 6);
+  }
+  for (int i=0; i<n; i++){
+    const double ax = fabs(x[i]);
+    if (ax*ax >= FRESNEL_SERIES_LIMIT)
+      fresnel(ax, C[i], S[i]);
+    if (x[i] < 0){
+      C[i] = -C[i];
+      S[i] = -S[i];
+    }
+  }
+}
+
+#endif
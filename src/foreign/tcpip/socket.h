@@ -91,8 +91,12 @@ namespace tcpip
 		/// Connects to host_:port_
 		void connect() throw( SocketException );
 
-		/// Wait for a incoming connection to port_
-		void accept() throw( SocketException );
+		/** Wait for a incoming connection to port_
+		 *  If create is set, the connection is handed over to a new Socket
+		 *  which is returned (0 if a non blocking accept found no pending
+		 *  connection) and further connections may be accepted.
+		 */
+		Socket* accept(const bool create = false) throw( SocketException );
 
 		void send( const std::vector<unsigned char> &buffer) throw( SocketException );
 		void sendExact( const Storage & ) throw( SocketException );
@@ -105,6 +109,8 @@ namespace tcpip
 		void set_blocking(bool) throw( SocketException );
 		bool is_blocking() throw();
 		bool has_client_connection() const;
+		/// The descriptor of the connection (-1 if not connected), e.g. for select()
+		int socket_descriptor() const { return socket_; }
 
 		// If verbose, each send and received data is written to stderr
 		bool verbose() { return verbose_; }
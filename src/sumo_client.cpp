@@ -63,6 +63,7 @@ SUMO_CLIENT::commandSimulationStep(SUMOTime time) {
     std::string acknowledgement;
     check_resultState(inMsg, CMD_SIMSTEP2, false, &acknowledgement);
     answerLog << acknowledgement << std::endl;
+    readStepSummary(inMsg);
     validateSimulationStep2(inMsg);
   } catch (tcpip::SocketException& e) {
     answerLog << e.what() << std::endl;
@@ -1,14 +1,24 @@
 #include <config.h>
 
 #include <iostream>
+#include <fstream>
 #include <string>
 #include <cstdlib>
+#include <traci-server/TraCIConstants.h>
+#include <utils/traci/ControllerRuntime.h>
+#include <utils/traci/StepSummary.h>
+#include <utils/traci/SubscriptionResults.h>
+#include <utils/traci/TLSCommandBuffer.h>
+#include <utils/traci/TripStatistics.h>
 #include "sumo_client.hpp"
 
 #include <unistd.h>
 
 SUMO_CLIENT client;
 
+// the actuation of all intersections is sent at once after each step
+TLSCommandBuffer tls_commands(client);
+
 const std::string NSGREEN = "Grr";
 const std::string NSYELLOW = "yrr";
 const std::string WEGREEN = "rGG";
@@ -19,226 +29,264 @@ const std::string NSYELLOW1 = "yyrr";
 const std::string WEGREEN1 = "rrGG";
 const std::string WEYELLOW1 = "rryy";
 
-const int Light_Min_IK=30; 
-const int Light_Max_IK=120; //the constrains of the length of traffic lights for intersection IK
-
-const int Light_Min_LJ=30;  
-const int Light_Max_LJ=120; //the constrains of the length of traffic lights for intersection LJ
+// The controller parameters; the defaults may be overridden using
+// "-P <name>=<value>", which allows sweeping them without recompiling
+int Light_Min_IK=30; 
+int Light_Max_IK=120; //the constrains of the length of traffic lights for intersection IK
 
-const int Light_Min_GD=30;  
-const int Light_Max_GD=120; //the constrains of the length of traffic lights for intersection GD
+int Light_Min_LJ=30;  
+int Light_Max_LJ=120; //the constrains of the length of traffic lights for intersection LJ
 
-const int Light_Min_FH=30;  
-const int Light_Max_FH=120; //the constrains of the length of traffic lights for intersection FH
+int Light_Min_GD=30;  
+int Light_Max_GD=120; //the constrains of the length of traffic lights for intersection GD
 
-const int Light_Min_AC=30;  
-const int Light_Max_AC=120; //the constrains of the length of traffic lights for intersection AC
+int Light_Min_FH=30;  
+int Light_Max_FH=120; //the constrains of the length of traffic lights for intersection FH
 
-const int s_NS_IK=4; 
-const int s_WE_IK=15; //the threshold of North-South and West-East direction for intersection IK
+int Light_Min_AC=30;  
+int Light_Max_AC=120; //the constrains of the length of traffic lights for intersection AC
 
-const int s_NS_LJ=4; 
-const int s_WE_LJ=15; //the threshold of North-South and West-East direction for intersection LJ
+int s_NS_IK=4; 
+int s_WE_IK=15; //the threshold of North-South and West-East direction for intersection IK
 
-const int s_NS_GD=4; 
-const int s_WE_GD=15; //the threshold of North-South and West-East direction for intersection GD
+int s_NS_LJ=4; 
+int s_WE_LJ=15; //the threshold of North-South and West-East direction for intersection LJ
 
-const int s_NS_FH=4; 
-const int s_WE_FH=15; //the threshold of North-South and West-East direction for intersection FH
+int s_NS_GD=4; 
+int s_WE_GD=15; //the threshold of North-South and West-East direction for intersection GD
 
-const int s_NS_AC=4; 
-const int s_WE_AC=15; //the threshold of North-South and West-East direction for intersection IK
+int s_NS_FH=4; 
+int s_WE_FH=15; //the threshold of North-South and West-East direction for intersection FH
 
+int s_NS_AC=4; 
+int s_WE_AC=15; //the threshold of North-South and West-East direction for intersection IK
 
-void vehicle_number(std::string sensor1,
-		    std::string sensor2,
-		    std::string& id_T1,
-		    std::string& id_S1,
-		    int& sum_sensor1,
-		    int& sum_sensor2,
-		    int& queue_length)
+struct Parameter
 {
-  int numVehicles = client.inductionloop.getLastStepVehicleNumber(sensor1);
-  if (numVehicles == 0)
-    id_T1="";
-  else
-    {
-      std::vector<std::string> list_T1 = client.inductionloop.getLastStepVehicleIDs(sensor1);
-      for ( std::vector<std::string>::iterator it = list_T1.begin(); it != list_T1.end(); ++it)
-	{
-	  if ( *it != id_T1 )
-	    {
-	      id_T1 = *it;
-	      sum_sensor1 += 1;
-	    }
-	}
-    }
-  numVehicles = client.inductionloop.getLastStepVehicleNumber(sensor2);
-  if (numVehicles == 0)
-    id_S1="";
-  else
+  const char* name;
+  int* value;
+};
+
+Parameter parameters[] =
+  {
+    { "Light_Min_IK", &Light_Min_IK }, { "Light_Max_IK", &Light_Max_IK },
+    { "Light_Min_LJ", &Light_Min_LJ }, { "Light_Max_LJ", &Light_Max_LJ },
+    { "Light_Min_GD", &Light_Min_GD }, { "Light_Max_GD", &Light_Max_GD },
+    { "Light_Min_FH", &Light_Min_FH }, { "Light_Max_FH", &Light_Max_FH },
+    { "Light_Min_AC", &Light_Min_AC }, { "Light_Max_AC", &Light_Max_AC },
+    { "s_NS_IK", &s_NS_IK }, { "s_WE_IK", &s_WE_IK },
+    { "s_NS_LJ", &s_NS_LJ }, { "s_WE_LJ", &s_WE_LJ },
+    { "s_NS_GD", &s_NS_GD }, { "s_WE_GD", &s_WE_GD },
+    { "s_NS_FH", &s_NS_FH }, { "s_WE_FH", &s_WE_FH },
+    { "s_NS_AC", &s_NS_AC }, { "s_WE_AC", &s_WE_AC },
+    { 0, 0 }
+  };
+
+// sets the parameter given as "<name>=<value>", returns false if there is none such
+bool set_parameter(const std::string& definition)
+{
+  std::string::size_type eq = definition.find('=');
+  if (eq == std::string::npos)
+    return false;
+  std::string name = definition.substr(0, eq);
+  for (Parameter* p = parameters; p->name != 0; ++p)
     {
-      std::vector<std::string> list_S1 = client.inductionloop.getLastStepVehicleIDs(sensor2);
-      for ( std::vector<std::string>::iterator it = list_S1.begin(); it != list_S1.end(); ++it)
+      if (!name.compare(p->name))
 	{
-	  if ( *it != id_S1 )
-	    {
-	      id_S1 = *it;
-	      sum_sensor2 += 1;
-	    }
+	  *p->value = atoi(definition.c_str() + eq + 1);
+	  return true;
 	}
     }
-  queue_length = sum_sensor1-sum_sensor2 + 1 ;
+  return false;
 }
 
-void clock_value(std::string intersection,
-		 int& clock_WE,
-		 int& clock_NS,
-		 std::string& tl_state)
-{
-  tl_state = client.trafficlights.getRedYellowGreenState(intersection);
-  if (!tl_state.compare(NSGREEN))
-    {
-      clock_NS = clock_NS + 1;
-      clock_WE = 0;
-    }
-  else
-    {
-      clock_WE = clock_WE + 1;
-      clock_NS = 0;
-    }
-}
 
-void clock_value1(std::string intersection,
-		  int& clock_WE,
-		  int& clock_NS,
-		  std::string& tl_state)
-{
-  tl_state = client.trafficlights.getRedYellowGreenState(intersection);
-  if (!tl_state.compare(NSGREEN1))
-    {
-      clock_NS = clock_NS + 1;
-      clock_WE = 0;
-    }
-  else
-    {
-      clock_WE = clock_WE + 1;
-      clock_NS = 0;
-    }
-}
+// the values subscribed for the sensors and traffic lights, as of the last step
+SubscriptionResults step_results;
 
-void controller(std::string intersection,
-		std::string& tl_state,
-		int queue_WE,
-		int queue_NS,
-		int& clock_WE,
-		int& clock_NS,
-		int Light_Min,
-		int Light_Max,
-		int s_WE,
-		int s_NS)
+// the vehicles which arrived and the number still expected, as of the last step
+StepSummary step_summary;
+
+// the latency of a vehicle is its arrival step: tlc_sweep relies on it never
+// decreasing, so only the arrivals are recorded (measured from step 0)
+TripStatistics trip_stats;
+
+// counts the vehicles passing the sensor since the start, skipping the
+// last one seen in the previous step
+void count_vehicles(const std::string& sensor,
+		    std::string& last_id,
+		    int& sum)
 {
-  if ((queue_WE < s_WE && queue_NS < s_NS) || (queue_WE >= s_WE && queue_NS >= s_NS))
-    {
-      if ( !tl_state.compare(WEGREEN) && clock_WE > Light_Max )
-	{
-	  client.trafficlights.setRedYellowGreenState(intersection, NSGREEN);
-	  clock_WE = 0;
-	}
-      if ( !tl_state.compare(NSGREEN) && clock_NS > Light_Max )
-	{
-	  client.trafficlights.setRedYellowGreenState(intersection, WEGREEN);
-	  clock_NS = 0;
-	}
-    }
-  else if (queue_WE >= s_WE && queue_NS <s_NS)
-    {
-      if ( !tl_state.compare(NSGREEN) && clock_NS > Light_Min )
-	{
-	  client.trafficlights.setRedYellowGreenState(intersection, WEGREEN);
-	  clock_NS = 0;
-	}
-      if ( !tl_state.compare(WEGREEN) && clock_WE > Light_Max )
-	{
-	  client.trafficlights.setRedYellowGreenState(intersection, NSGREEN);
-	  clock_WE = 0;
-	}
-    }
+  std::vector<std::string> ids;
+  unsigned int object = step_results.find(CMD_SUBSCRIBE_INDUCTIONLOOP_VARIABLE, sensor);
+  if (object != SubscriptionResults::NO_OBJECT && step_results.isOK(object, LAST_STEP_VEHICLE_ID_LIST))
+    ids = step_results.getStringList(object, LAST_STEP_VEHICLE_ID_LIST);
+  if (ids.empty())
+    last_id="";
   else
     {
-      if ( !tl_state.compare(WEGREEN) && clock_WE > Light_Min )
-	{
-	  client.trafficlights.setRedYellowGreenState(intersection, NSGREEN);
-	  clock_WE = 0;
-	}
-      if ( !tl_state.compare(NSGREEN) && clock_NS > Light_Max )
+      for ( std::vector<std::string>::iterator it = ids.begin(); it != ids.end(); ++it)
 	{
-	  client.trafficlights.setRedYellowGreenState(intersection, WEGREEN);
-	  clock_NS = 0;
+	  if ( *it != last_id )
+	    {
+	      last_id = *it;
+	      sum += 1;
+	    }
 	}
     }
 }
 
-void controller1(std::string intersection,
-		 std::string& tl_state,
-		 int queue_WE,
-		 int queue_NS,
-		 int& clock_WE,
-		 int& clock_NS,
-		 int Light_Min,
-		 int Light_Max,
-		 int s_WE,
-		 int s_NS)
+// returns the state of the traffic light as of the last step
+std::string tls_state(const std::string& intersection)
 {
-  if ((queue_WE < s_WE && queue_NS < s_NS) || (queue_WE >= s_WE && queue_NS >= s_NS))
-    {
-      if ( !tl_state.compare(WEGREEN1) && clock_WE > Light_Max )
-	{
-	  client.trafficlights.setRedYellowGreenState(intersection, NSGREEN1);
-	  clock_WE = 0;
-	}
-      if ( !tl_state.compare(NSGREEN1) && clock_NS > Light_Max )
-	{
-	  client.trafficlights.setRedYellowGreenState(intersection, WEGREEN1);
-	  clock_NS = 0;
-	}
-    }
-  else if (queue_WE >= s_WE && queue_NS <s_NS)
-    {
-      if ( !tl_state.compare(NSGREEN1) && clock_NS > Light_Min )
-	{
-	  client.trafficlights.setRedYellowGreenState(intersection, WEGREEN1);
-	  clock_NS = 0;
-	}
-      if ( !tl_state.compare(WEGREEN1) && clock_WE > Light_Max )
-	{
-	  client.trafficlights.setRedYellowGreenState(intersection, NSGREEN1);
-	  clock_WE = 0;
-	}
-    }
-  else
-    {
-      if ( !tl_state.compare(WEGREEN1) && clock_WE > Light_Min )
-	{
-	  client.trafficlights.setRedYellowGreenState(intersection, NSGREEN1);
-	  clock_WE = 0;
-	}
-      if ( !tl_state.compare(NSGREEN1) && clock_NS > Light_Max )
-	{
-	  client.trafficlights.setRedYellowGreenState(intersection, WEGREEN1);
-	  clock_NS = 0;
-	}
-    }
+  unsigned int object = step_results.find(CMD_SUBSCRIBE_TL_VARIABLE, intersection);
+  if (object == SubscriptionResults::NO_OBJECT || !step_results.isOK(object, TL_RED_YELLOW_GREEN_STATE))
+    return "";
+  return step_results.getString(object, TL_RED_YELLOW_GREEN_STATE);
 }
 
+// The logic of one intersection; the decisions of all intersections run in
+// parallel and only read the subscription results besides their own state
+class Intersection : public ControllerRuntime::Controller
+{
+public:
+  Intersection(const std::string& intersection,
+	       const std::string& ns_green,
+	       const std::string& we_green,
+	       int light_min,
+	       int light_max,
+	       int s_we,
+	       int s_ns,
+	       const std::string& decision_tls = "")
+    : ControllerRuntime::Controller(intersection),
+      NS_green(ns_green), WE_green(we_green), decision_TLS(decision_tls),
+      Light_Min(light_min), Light_Max(light_max), s_WE(s_we), s_NS(s_ns),
+      clock_WE(0), clock_NS(0), queue_WE(0), queue_NS(0) {}
+
+  // adds a pair of sensors at the entry and the exit of a lane
+  void add_WE(const std::string& sensor1, const std::string& sensor2)
+  {
+    WE.push_back(Lane(sensor1, sensor2));
+  }
+
+  void add_NS(const std::string& sensor1, const std::string& sensor2)
+  {
+    NS.push_back(Lane(sensor1, sensor2));
+  }
+
+  int get_queue_WE() const
+  {
+    return queue_WE;
+  }
+
+  void decide(SUMOTime, ControllerRuntime::Decision& decision)
+  {
+    //First we compute the queue length of West-East and North-South direction
+    queue_WE = queue_length(WE);
+    queue_NS = queue_length(NS);
+    //Now we compute the clock value of the traffic lights(value k in the paper)
+    std::string tl_state = tls_state(getTLSID());
+    if (!tl_state.compare(NS_green))
+      {
+	clock_NS = clock_NS + 1;
+	clock_WE = 0;
+      }
+    else
+      {
+	clock_WE = clock_WE + 1;
+	clock_NS = 0;
+      }
+    //The decisions may follow the state of another traffic light
+    if (!decision_TLS.empty())
+      tl_state = tls_state(decision_TLS);
+    //Now the traffic light control logic
+    if ((queue_WE < s_WE && queue_NS < s_NS) || (queue_WE >= s_WE && queue_NS >= s_NS))
+      {
+	if ( !tl_state.compare(WE_green) && clock_WE > Light_Max )
+	  {
+	    decision.setRedYellowGreenState(NS_green);
+	    clock_WE = 0;
+	  }
+	if ( !tl_state.compare(NS_green) && clock_NS > Light_Max )
+	  {
+	    decision.setRedYellowGreenState(WE_green);
+	    clock_NS = 0;
+	  }
+      }
+    else if (queue_WE >= s_WE && queue_NS <s_NS)
+      {
+	if ( !tl_state.compare(NS_green) && clock_NS > Light_Min )
+	  {
+	    decision.setRedYellowGreenState(WE_green);
+	    clock_NS = 0;
+	  }
+	if ( !tl_state.compare(WE_green) && clock_WE > Light_Max )
+	  {
+	    decision.setRedYellowGreenState(NS_green);
+	    clock_WE = 0;
+	  }
+      }
+    else
+      {
+	if ( !tl_state.compare(WE_green) && clock_WE > Light_Min )
+	  {
+	    decision.setRedYellowGreenState(NS_green);
+	    clock_WE = 0;
+	  }
+	if ( !tl_state.compare(NS_green) && clock_NS > Light_Max )
+	  {
+	    decision.setRedYellowGreenState(WE_green);
+	    clock_NS = 0;
+	  }
+      }
+  }
+
+private:
+  struct Lane
+  {
+    Lane(const std::string& s1, const std::string& s2)
+      : sensor1(s1), sensor2(s2), sum_sensor1(0), sum_sensor2(0) {}
+    std::string sensor1, sensor2;
+    std::string id_1, id_2;
+    int sum_sensor1, sum_sensor2;
+  };
+
+  static int queue_length(std::vector<Lane>& lanes)
+  {
+    int queue = 0;
+    for (std::vector<Lane>::iterator l = lanes.begin(); l != lanes.end(); ++l)
+      {
+	count_vehicles(l->sensor1, l->id_1, l->sum_sensor1);
+	count_vehicles(l->sensor2, l->id_2, l->sum_sensor2);
+	queue += l->sum_sensor1 - l->sum_sensor2 + 1;
+      }
+    return queue;
+  }
+
+  const std::string NS_green, WE_green;
+  const std::string decision_TLS;
+  const int Light_Min, Light_Max, s_WE, s_NS;
+  std::vector<Lane> WE, NS;
+  int clock_WE, clock_NS;
+  int queue_WE, queue_NS;
+};
+
 int main(int argc, char* argv[]) {
     int port = -1;
     std::string host = "localhost";
     int sleep_us = -1;
+    int report_steps = 0;
+    std::string statistics_file;
+    int connect_attempts = 1;
+    unsigned int decision_threads = ThreadPool::getHardwareConcurrency() - 1;
 
     if (argc < 5) {
         std::cout << "Usage: tlc -p <remote port> -s <sleep time in us>"
-                  << " [-h <remote host>]" << std::endl;
+                  << " [-h <remote host>] [-P <parameter>=<value>]..."
+                  << " [-i <interim report interval in steps>]"
+                  << " [-c <connection attempts>]"
+                  << " [-t <decision threads>]"
+                  << " [-e <latency statistics file>]" << std::endl;
         return 0;
     }
 
@@ -253,6 +301,24 @@ int main(int argc, char* argv[]) {
         } else if (arg.compare("-h") == 0) {
             host = argv[i + 1];
             i++;
+        } else if (arg.compare("-P") == 0) {
+            if (!set_parameter(argv[i + 1])) {
+                std::cout << "unknown controller parameter: " << argv[i + 1] << std::endl;
+                return 1;
+            }
+            i++;
+        } else if (arg.compare("-i") == 0) {
+            report_steps = atoi(argv[i + 1]);
+            i++;
+        } else if (arg.compare("-c") == 0) {
+            connect_attempts = atoi(argv[i + 1]);
+            i++;
+        } else if (arg.compare("-t") == 0) {
+            decision_threads = (unsigned int)atoi(argv[i + 1]);
+            i++;
+        } else if (arg.compare("-e") == 0) {
+            statistics_file = argv[i + 1];
+            i++;
         } else {
             std::cout << "unknown parameter: " << argv[i] << std::endl;
             return 1;
@@ -264,236 +330,142 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    client.create_connection(port,host);
+    // the simulation may still be starting up, so retry once per second
+    bool connected = client.create_connection(port,host);
+    for (int attempt = 1; !connected && attempt < connect_attempts; attempt++)
+      {
+	sleep(1);
+	connected = client.create_connection(port,host);
+      }
+    if (!connected)
+      return 1;
 
     // IMPLEMENT TRAFFIC LIGHT CONTROLLER HERE
-    
-    int clock_I_IK=0;
-    int clock_K_IK=0;
-    int clock_IK_LJ=0;
-    int clock_L_LJ=0;
-    int clock_G_GD=0;
-    int clock_IK_GD=0;
-    int clock_GD_FH=0;
-    int clock_LJ_FH=0;
-    int clock_A_AC=0;
-    int clock_E_AC=0;
-
-    int queue_I_IK=0;
-    int queue_K_IK=0;
-    int queue_IK_LJ=0;
-    int queue_LK_LJ=0;
-    int queue_L_LJ=0;
-    int queue_G_GD=0;
-    int queue_IK_GD=0;
-    int queue_GD_FH=0;
-    int queue_LJ_FH=0;
-    int queue_A_AC=0;
-    int queue_E_AC=0;
-
-    int sum1_I_IK_0 = 0;
-    int sum2_I_IK_0 = 0;
-    int sum1_I_IK_1 = 0;
-    int sum2_I_IK_1 = 0;
-    int sum1_K_IK=0;
-    int sum2_K_IK=0;
-    int sum1_IK_LJ_0 = 0;
-    int sum2_IK_LJ_0 = 0;
-    int sum1_IK_LJ_1 = 0;
-    int sum2_IK_LJ_1 = 0;
-    int sum1_L_LJ = 0;
-    int sum2_L_LJ = 0;
-    int sum1_G_GD_0 = 0;
-    int sum2_G_GD_0 = 0;
-    int sum1_G_GD_1 = 0;
-    int sum2_G_GD_1 = 0;
-    int sum1_IK_GD=0;
-    int sum2_IK_GD=0;
-    int sum1_GD_FH_0 = 0;
-    int sum2_GD_FH_0 = 0;
-    int sum1_GD_FH_1 = 0;
-    int sum2_GD_FH_1 = 0;
-    int sum1_LJ_FH = 0;
-    int sum2_LJ_FH = 0;
-    int sum1_A_AC_0 = 0;
-    int sum2_A_AC_0 = 0;
-    int sum1_A_AC_1 = 0;
-    int sum2_A_AC_1 = 0;
-    int sum1_E_AC_0 = 0;
-    int sum2_E_AC_0 = 0;
-    int sum1_E_AC_1 = 0;
-    int sum2_E_AC_1 = 0;
-
-    std::string id_V1="";
-    std::string id_V2="";
-    std::string id_V3="";
-    std::string id_V4="";
-    std::string id_V5="";
-    std::string id_V6="";
-    std::string id_V7="";
-    std::string id_V8="";
-    std::string id_V9="";
-    std::string id_V10="";
-    
-    std::string id_U1="";
-    std::string id_U2="";
-    std::string id_U3="";
-    std::string id_U4="";
-    std::string id_U5="";
-    std::string id_U6="";
-    std::string id_U7="";
-    std::string id_U8="";
-    std::string id_U9="";
-    std::string id_U10="";
-
-    std::string id_T1="";
-    std::string id_T2="";
-    std::string id_T3="";
-    std::string id_T4="";
-    std::string id_T5="";
-    std::string id_T6="";
-    std::string id_S1="";
-    std::string id_S2="";
-    std::string id_S3="";
-    std::string id_S4="";
-    std::string id_S5="";
-    std::string id_S6="";
-   
-    std::string state_IK = "";
-    std::string state_LJ = "";
-    std::string state_GD = "";
-    std::string state_FH = "";
-    std::string state_AC = "";
+    ControllerRuntime runtime(tls_commands, decision_threads);
+
+    Intersection* IK = new Intersection("IK", NSGREEN, WEGREEN, Light_Min_IK, Light_Max_IK, s_WE_IK, s_NS_IK);
+    IK->add_WE("V1", "U1");
+    IK->add_WE("V2", "U2");
+    IK->add_NS("T1", "S1");
+    runtime.add(IK);
+
+    Intersection* LJ = new Intersection("LJ", NSGREEN, WEGREEN, Light_Min_LJ, Light_Max_LJ, s_WE_LJ, s_NS_LJ);
+    LJ->add_WE("V3", "U3");
+    LJ->add_WE("V4", "U4");
+    LJ->add_NS("T3", "S3");
+    runtime.add(LJ);
+
+    Intersection* GD = new Intersection("GD", NSGREEN, WEGREEN, Light_Min_GD, Light_Max_GD, s_WE_GD, s_NS_GD);
+    GD->add_WE("V5", "U5");
+    GD->add_WE("V6", "U6");
+    GD->add_NS("T2", "S2");
+    runtime.add(GD);
+
+    Intersection* FH = new Intersection("FH", NSGREEN, WEGREEN, Light_Min_FH, Light_Max_FH, s_WE_FH, s_NS_FH);
+    FH->add_WE("V7", "U7");
+    FH->add_WE("V8", "U8");
+    FH->add_NS("T4", "S4");
+    runtime.add(FH);
+
+    // AC counts its clock by its own state but decides by the state of IK
+    Intersection* AC = new Intersection("AC", NSGREEN1, WEGREEN1, Light_Min_AC, Light_Max_AC, s_WE_AC, s_NS_AC, "IK");
+    AC->add_WE("V9", "U9");
+    AC->add_WE("V10", "U10");
+    AC->add_NS("T5", "S5");
+    AC->add_NS("T6", "S6");
+    runtime.add(AC);
+
+    // the sensors and traffic lights report with each step instead of being queried
+    const char* sensors[] = { "V1", "V2", "V3", "V4", "V5", "V6", "V7", "V8", "V9", "V10",
+			      "U1", "U2", "U3", "U4", "U5", "U6", "U7", "U8", "U9", "U10",
+			      "T1", "T2", "T3", "T4", "T5", "T6",
+			      "S1", "S2", "S3", "S4", "S5", "S6", 0 };
+    std::vector<int> sensor_vars(1, LAST_STEP_VEHICLE_ID_LIST);
+    for (const char** sensor = sensors; *sensor != 0; ++sensor)
+      client.subscribe(CMD_SUBSCRIBE_INDUCTIONLOOP_VARIABLE, *sensor, 0, SUMOTime_MAX, sensor_vars);
+    std::vector<int> tls_vars(1, TL_RED_YELLOW_GREEN_STATE);
+    for (unsigned int i = 0; i < runtime.size(); i++)
+      client.subscribe(CMD_SUBSCRIBE_TL_VARIABLE, runtime.get(i).getTLSID(), 0, SUMOTime_MAX, tls_vars);
+    StepSummary::subscribe(client);
+    client.setStepSummary(&step_summary);
+
+    const unsigned int CAR = trip_stats.addClass("car");
+    const unsigned int TRUCK = trip_stats.addClass("truck");
+    trip_stats.addPrefix("flowsI2J", CAR);
+    trip_stats.addPrefix("flowsG2H", CAR);
+    trip_stats.addPrefix("flowsA2B", CAR);
+    trip_stats.setDefaultClass(TRUCK);
+
+    // the statistics are exported with each interim report and at the end
+    std::ofstream statistics;
+    if (!statistics_file.empty())
+      {
+	statistics.open(statistics_file.c_str());
+	if (!statistics)
+	  {
+	    std::cout << "could not open " << statistics_file << std::endl;
+	    return 1;
+	  }
+	TripStatistics::writeHeader(statistics);
+      }
 
     int step = 0;
 
-    int total_latency=0;
-    int car_number=0;
-    int car_latency=0;
-    int truck_number=0;
-    int truck_latency=0;
-
     int minExpectedNumber = client.simulation.getMinExpectedNumber();
     std::cout << "Min expected number: " << minExpectedNumber << std::endl;
     while (minExpectedNumber > 0)
       {
-	client.commandSimulationStep(0);
-        //The first controller IK ~~~~~~~~~~~~~~~~~~~~~~~~
-        //First we compute the queue length of West-East direction
-	int queue_I_IK_0, queue_I_IK_1;
-        vehicle_number( "V1", "U1", id_V1, id_U1, sum1_I_IK_0, sum2_I_IK_0, queue_I_IK_0 );
-        vehicle_number( "V2", "U2", id_V2, id_U2, sum1_I_IK_1, sum2_I_IK_1, queue_I_IK_1 );
-        queue_I_IK = queue_I_IK_0 + queue_I_IK_1;
-	std::cout << "EW Q len: " << queue_I_IK << std::endl;
-        //Then we compute the length in North-South direction
-        vehicle_number( "T1", "S1", id_T1, id_S1, sum1_K_IK, sum2_K_IK, queue_K_IK );
-        //Now we compute the clock value of the traffic lights(value k in the paper)
-	std::string tl_state_IK;
-        clock_value ("IK", clock_I_IK, clock_K_IK, tl_state_IK);
-        //Now we need to design the traffic light control logic
-	controller( "IK", tl_state_IK, queue_I_IK, queue_K_IK, clock_I_IK, clock_K_IK,
-		    Light_Min_IK, Light_Max_IK, s_WE_IK, s_NS_IK );
-        
-
-        //The second controller LJ ~~~~~~~~~~~~~~~~~~~~~~~~~~
-        //First we compute the queue length of West-East direction
-	int queue_IK_LJ_0, queue_IK_LJ_1;
-        vehicle_number( "V3", "U3", id_V3, id_U3, sum1_IK_LJ_0, sum2_IK_LJ_0, queue_IK_LJ_0 );
-        vehicle_number("V4", "U4", id_V4, id_U4, sum1_IK_LJ_1, sum2_IK_LJ_1, queue_IK_LJ_1 );
-        queue_IK_LJ = queue_IK_LJ_0 + queue_IK_LJ_1;
-        //Then we compute the length in North-South direction
-        vehicle_number( "T3", "S3", id_T3, id_S3, sum1_L_LJ, sum2_L_LJ, queue_L_LJ );
-        //Now we compute the clock value of the traffic lights(value k in the paper)
-	std::string tl_state_LJ;
-        clock_value( "LJ", clock_IK_LJ, clock_L_LJ, tl_state_LJ );
-        //Now we need to design the traffic light control logic
-        controller( "LJ", tl_state_LJ, queue_IK_LJ, queue_L_LJ, clock_IK_LJ, clock_L_LJ,
-		    Light_Min_LJ, Light_Max_LJ, s_WE_LJ, s_NS_LJ );
-      
-
-        //The 3rd controller GD ~~~~~~~~~~~~~~~~~~~~~~~~
-        //First we compute the queue length of West-East direction
-	int queue_G_GD_0, queue_G_GD_1;
-        vehicle_number("V5", "U5", id_V5, id_U5, sum1_G_GD_0, sum2_G_GD_0, queue_G_GD_0 );
-        vehicle_number("V6", "U6", id_V6, id_U6, sum1_G_GD_1, sum2_G_GD_1, queue_G_GD_1 );
-	queue_G_GD = queue_G_GD_0 + queue_G_GD_1;
-        //Then we compute the length in North-South direction
-	vehicle_number("T2", "S2", id_T2, id_S2, sum1_IK_GD, sum2_IK_GD, queue_IK_GD );
-        //Now we compute the clock value of the traffic lights(value k in the paper)
-	std::string tl_state_GD;
-        clock_value ("GD", clock_G_GD, clock_IK_GD, tl_state_GD);
-        //Now we need to design the traffic light control logic
-        controller( "GD", tl_state_GD, queue_G_GD, queue_IK_GD, clock_G_GD, clock_IK_GD,
-		    Light_Min_GD, Light_Max_GD, s_WE_GD, s_NS_GD );
-
-
-        //The 4th controller FH ~~~~~~~~~~~~~~~~~~~~~~~~
-        //First we compute the queue length of West-East direction
-	int queue_GD_FH_0, queue_GD_FH_1;
-        vehicle_number("V7", "U7", id_V7, id_U7, sum1_GD_FH_0, sum2_GD_FH_0, queue_GD_FH_0 );
-	vehicle_number("V8", "U8", id_V8, id_U8, sum1_GD_FH_1, sum2_GD_FH_1, queue_GD_FH_1 );
-        queue_GD_FH = queue_GD_FH_0 + queue_GD_FH_1;
-        //Then we compute the length in North-South direction
-        vehicle_number("T4", "S4", id_T4, id_S4, sum1_LJ_FH, sum2_LJ_FH, queue_LJ_FH );
-        //Now we compute the clock value of the traffic lights(value k in the paper)
-	std::string tl_state_FH;
-        clock_value ("FH", clock_GD_FH, clock_LJ_FH, tl_state_FH);
-        //Now we need to design the traffic light control logic
-        controller ("FH", tl_state_FH, queue_GD_FH, queue_LJ_FH, clock_GD_FH, clock_LJ_FH,
-		    Light_Min_FH, Light_Max_FH, s_WE_FH, s_NS_FH );
-
-        //The 5th controller AC ~~~~~~~~~~~~~~~~~~~~~~~~~~~
-        //First we compute the queue length of West-East direction
-	int queue_A_AC_0, queue_A_AC_1;
-        vehicle_number("V9", "U9", id_V9, id_U9, sum1_A_AC_0, sum2_A_AC_0, queue_A_AC_0 );
-        vehicle_number("V10", "U10", id_V10, id_U10, sum1_A_AC_1, sum2_A_AC_1, queue_A_AC_1 );
-        queue_A_AC = queue_A_AC_0 + queue_A_AC_1;
-        //Then we compute the length in North-South direction
-	int queue_E_AC_0, queue_E_AC_1;
-        vehicle_number("T5", "S5", id_T5, id_S5, sum1_E_AC_0, sum2_E_AC_0, queue_E_AC_0 );
-        vehicle_number("T6", "S6", id_T6, id_S6, sum1_E_AC_1, sum2_E_AC_1, queue_E_AC_1 );
-        queue_E_AC = queue_E_AC_0 + queue_E_AC_1;
-        //Now we compute the clock value of the traffic lights(value k in the paper)
-	std::string tl_state_AC;
-        clock_value1 ("AC", clock_A_AC, clock_E_AC, tl_state_AC );
-        //Now we need to design the traffic light control logic
-        controller1 ("AC", tl_state_IK, queue_A_AC, queue_E_AC, clock_A_AC, clock_E_AC,
-		     Light_Min_AC, Light_Max_AC, s_WE_AC, s_NS_AC );
-
-	int total_number = client.simulation.getArrivedNumber();
-        if (total_number>=1)
+	client.simulationStep(0, step_results);
+	for (unsigned int i = 0; i < runtime.size(); i++)
 	  {
-	    std::vector<std::string> current_list = client.simulation.getArrivedIDList();
-	    for (std::vector<std::string>::iterator it = current_list.begin(); it != current_list.end(); ++it)
-	      {
-		std::string v_id = it->substr(0,8);
-		if (!v_id.compare("flowsI2J") || !v_id.compare("flowsG2H") || v_id.compare("flowsA2B"))
-		  {
-		    car_number++;
-		    car_latency += step;
-		  }
-		else
-		  {
-		    truck_number++;
-		    truck_latency += step;
-		  }
-	      }
+	    const std::string& intersection = runtime.get(i).getTLSID();
+	    tls_commands.setCurrentState(intersection, tls_state(intersection));
 	  }
+	runtime.step(step);
+	std::cout << "EW Q len: " << IK->get_queue_WE() << std::endl;
+	tls_commands.flush();
+
+	trip_stats.arrive(step_summary.getArrivedIDList(), step);
         step += 1;
-	minExpectedNumber = client.simulation.getMinExpectedNumber();
+	// the interim sums allow a caller to abandon a run early
+	if (report_steps > 0 && step % report_steps == 0)
+	  {
+	    std::cout << "Interim step, car number, car latency, truck number, truck latency: "
+		      << step << ", " << trip_stats.getArrivedNumber(CAR) << ", " << (int)trip_stats.getTravelTimeSum(CAR) << ", "
+		      << trip_stats.getArrivedNumber(TRUCK) << ", " << (int)trip_stats.getTravelTimeSum(TRUCK) << std::endl;
+	    if (statistics.is_open())
+	      trip_stats.write(statistics, step);
+	  }
+	minExpectedNumber = step_summary.getMinExpectedNumber();
 	usleep(sleep_us);
       }
+    if (statistics.is_open() && (report_steps <= 0 || step % report_steps != 0))
+      trip_stats.write(statistics, step);
+    const int car_number = trip_stats.getArrivedNumber(CAR);
+    const double car_latency = trip_stats.getTravelTimeSum(CAR);
+    const int truck_number = trip_stats.getArrivedNumber(TRUCK);
+    const double truck_latency = trip_stats.getTravelTimeSum(TRUCK);
     float average_car_latency = 1.0 * float(car_latency) / float(car_number);
     float average_truck_latency = 1.0 * float(truck_latency) / float(truck_number);
     std::cout << "Step: " << step << std::endl;
     std::cout << "Car number, Car latency: " << car_number << ", " << average_car_latency << std::endl;
     std::cout << "Truck number, Truck latency: " << truck_number << ", " << average_truck_latency << std::endl;
+    std::cout << "Car latency, median, 90%, 99%, max: " << trip_stats.getTravelTimeQuantile(CAR, .5) << ", "
+	      << trip_stats.getTravelTimeQuantile(CAR, .9) << ", " << trip_stats.getTravelTimeQuantile(CAR, .99) << ", "
+	      << trip_stats.getMaxTravelTime(CAR) << std::endl;
+    std::cout << "Truck latency, median, 90%, 99%, max: " << trip_stats.getTravelTimeQuantile(TRUCK, .5) << ", "
+	      << trip_stats.getTravelTimeQuantile(TRUCK, .9) << ", " << trip_stats.getTravelTimeQuantile(TRUCK, .99) << ", "
+	      << trip_stats.getMaxTravelTime(TRUCK) << std::endl;
     for (int i=1; i<11; i++)
       {
 	float average_latency = (float(car_latency) + float(i)*float(truck_latency)) /
 	  (float(car_number) + float(i)*float(truck_number));
 	std::cout << "Average Latency: " << average_latency << std::endl;
       }
+    std::cout << "Decision threads: " << runtime.getConcurrency() << std::endl;
+    std::cout << "Decision latency (us), mean, median, 99%, max: " << runtime.getMeanLatency() << ", "
+	      << runtime.getLatencyQuantile(.5) << ", " << runtime.getLatencyQuantile(.99) << ", "
+	      << runtime.getLatencyQuantile(1.) << std::endl;
     client.close_connection();
     return 0;
 }
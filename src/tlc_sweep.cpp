@@ -0,0 +1,469 @@
+#include <config.h>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <foreign/mersenne/MersenneTwister.h>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Runs the tlc controller for a grid or random sample of its parameters,
+// several runs in parallel, each against its own simulation instance.
+// One line per run is appended to a tab separated results file (one column
+// per parameter and metric). Runs whose interim latency already exceeds the
+// best final latency found so far are aborted: a vehicle arriving later never
+// has a smaller latency than the ones arrived so far, so the final average
+// can not drop below the interim one.
+
+struct SweepParameter
+{
+  std::string name;
+  std::vector<int> values;
+};
+
+struct Run
+{
+  int index;
+  std::vector<int> values;
+};
+
+enum SlotState { SLOT_FREE, SLOT_RUNNING, SLOT_DRAINING };
+
+struct Slot
+{
+  SlotState state;
+  int port;
+  pid_t simulation;
+  pid_t controller;
+  int output;
+  std::string line;
+  double draining_deadline;
+  Run run;
+  bool aborted;
+  bool have_result;
+  int steps;
+  int car_number;
+  double car_latency;
+  int truck_number;
+  double truck_latency;
+};
+
+double now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+// parses "<name>=<v1>,<v2>,..." or "<name>=<from>:<to>[:<step>]"
+bool parse_parameter(const std::string& definition, SweepParameter& into)
+{
+  std::string::size_type eq = definition.find('=');
+  if (eq == std::string::npos || eq == 0)
+    return false;
+  into.name = definition.substr(0, eq);
+  std::string values = definition.substr(eq + 1);
+  if (values.find(':') != std::string::npos)
+    {
+      int from = 0, to = 0, step = 1;
+      if (sscanf(values.c_str(), "%d:%d:%d", &from, &to, &step) < 2 || step <= 0 || to < from)
+	return false;
+      for (int v = from; v <= to; v += step)
+	into.values.push_back(v);
+    }
+  else
+    {
+      std::istringstream in(values);
+      std::string value;
+      while (std::getline(in, value, ','))
+	{
+	  char* end;
+	  long v = strtol(value.c_str(), &end, 10);
+	  if (value.empty() || *end != 0)
+	    return false;
+	  into.values.push_back((int)v);
+	}
+    }
+  return !into.values.empty();
+}
+
+// replaces every "%p" by the port
+std::string expand_command(const std::string& command, int port)
+{
+  std::ostringstream p;
+  p << port;
+  std::string result;
+  for (std::string::size_type i = 0; i < command.size(); i++)
+    {
+      if (command[i] == '%' && i + 1 < command.size() && command[i + 1] == 'p')
+	{
+	  result += p.str();
+	  i++;
+	}
+      else
+	result += command[i];
+    }
+  return result;
+}
+
+pid_t start_simulation(const std::string& command)
+{
+  pid_t pid = fork();
+  if (pid == 0)
+    {
+      // an own process group, so the shell and the simulation can be killed together
+      setpgid(0, 0);
+      int null = open("/dev/null", O_WRONLY);
+      if (null >= 0)
+	dup2(null, STDOUT_FILENO);
+      execl("/bin/sh", "sh", "-c", command.c_str(), (char*)0);
+      _exit(127);
+    }
+  if (pid > 0)
+    setpgid(pid, pid);
+  return pid;
+}
+
+pid_t start_controller(const std::vector<std::string>& args, int& output)
+{
+  int fds[2];
+  if (pipe(fds) != 0)
+    return -1;
+  pid_t pid = fork();
+  if (pid == 0)
+    {
+      close(fds[0]);
+      dup2(fds[1], STDOUT_FILENO);
+      close(fds[1]);
+      std::vector<char*> argv;
+      for (std::vector<std::string>::const_iterator i = args.begin(); i != args.end(); ++i)
+	argv.push_back(const_cast<char*>(i->c_str()));
+      argv.push_back(0);
+      execv(argv[0], &argv[0]);
+      _exit(127);
+    }
+  close(fds[1]);
+  if (pid < 0)
+    {
+      close(fds[0]);
+      return -1;
+    }
+  output = fds[0];
+  return pid;
+}
+
+double weighted_latency(int car_number, double car_latency,
+			int truck_number, double truck_latency, double truck_weight)
+{
+  double cars = car_number > 0 ? car_number * car_latency : 0.;
+  double trucks = truck_number > 0 ? truck_number * truck_latency : 0.;
+  double number = car_number + truck_weight * truck_number;
+  if (number <= 0.)
+    return 0.;
+  return (cars + truck_weight * trucks) / number;
+}
+
+int main(int argc, char* argv[]) {
+    std::string simulation_command;
+    std::string controller = "./tlc";
+    std::string results_file = "tlc_sweep.tsv";
+    std::vector<SweepParameter> sweep;
+    int workers = 1;
+    int base_port = 8813;
+    int samples = 0;
+    unsigned int seed = 42;
+    int sleep_us = 0;
+    int report_steps = 100;
+    double abort_factor = 1.;
+    double truck_weight = 1.;
+
+    if (argc < 5) {
+        std::cout << "Usage: tlc_sweep -c <simulation command, %p is replaced by the port>"
+                  << " -g <parameter>=<v1>,<v2>,...|<from>:<to>[:<step>] [-g ...]"
+                  << " [-t <tlc binary>] [-j <workers>] [-b <base port>]"
+                  << " [-n <random samples>] [-S <seed>] [-o <results file>]"
+                  << " [-s <sleep time in us>] [-i <interim report interval in steps>]"
+                  << " [-k <abort factor, 0 disables>] [-w <truck weight>]" << std::endl;
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cout << "missing value for parameter: " << arg << std::endl;
+            return 1;
+        }
+        if (arg.compare("-c") == 0) {
+            simulation_command = argv[i + 1];
+        } else if (arg.compare("-g") == 0) {
+            SweepParameter parameter;
+            if (!parse_parameter(argv[i + 1], parameter)) {
+                std::cout << "invalid parameter range: " << argv[i + 1] << std::endl;
+                return 1;
+            }
+            sweep.push_back(parameter);
+        } else if (arg.compare("-t") == 0) {
+            controller = argv[i + 1];
+        } else if (arg.compare("-j") == 0) {
+            workers = atoi(argv[i + 1]);
+        } else if (arg.compare("-b") == 0) {
+            base_port = atoi(argv[i + 1]);
+        } else if (arg.compare("-n") == 0) {
+            samples = atoi(argv[i + 1]);
+        } else if (arg.compare("-S") == 0) {
+            seed = (unsigned int)strtoul(argv[i + 1], 0, 10);
+        } else if (arg.compare("-o") == 0) {
+            results_file = argv[i + 1];
+        } else if (arg.compare("-s") == 0) {
+            sleep_us = atoi(argv[i + 1]);
+        } else if (arg.compare("-i") == 0) {
+            report_steps = atoi(argv[i + 1]);
+        } else if (arg.compare("-k") == 0) {
+            abort_factor = atof(argv[i + 1]);
+        } else if (arg.compare("-w") == 0) {
+            truck_weight = atof(argv[i + 1]);
+        } else {
+            std::cout << "unknown parameter: " << argv[i] << std::endl;
+            return 1;
+        }
+        i++;
+    }
+
+    if (simulation_command.empty() || sweep.empty()) {
+        std::cout << "Missing simulation command or parameters" << std::endl;
+        return 1;
+    }
+    if (workers < 1) {
+        workers = 1;
+    }
+
+    // the runs, either the full grid or random samples from it
+    std::vector<Run> runs;
+    if (samples > 0) {
+        MTRand random(seed);
+        for (int r = 0; r < samples; r++) {
+            Run run;
+            run.index = r;
+            for (std::vector<SweepParameter>::const_iterator p = sweep.begin(); p != sweep.end(); ++p) {
+                run.values.push_back(p->values[random.randInt((MTRand::uint32)p->values.size() - 1)]);
+            }
+            runs.push_back(run);
+        }
+    } else {
+        std::vector<unsigned int> position(sweep.size(), 0);
+        for (int r = 0; ; r++) {
+            Run run;
+            run.index = r;
+            for (unsigned int p = 0; p < sweep.size(); p++) {
+                run.values.push_back(sweep[p].values[position[p]]);
+            }
+            runs.push_back(run);
+            unsigned int p = 0;
+            while (p < sweep.size() && ++position[p] == sweep[p].values.size()) {
+                position[p] = 0;
+                p++;
+            }
+            if (p == sweep.size()) {
+                break;
+            }
+        }
+    }
+
+    std::ofstream results(results_file.c_str());
+    if (!results.good()) {
+        std::cout << "Could not open results file: " << results_file << std::endl;
+        return 1;
+    }
+    results << "run\tstatus";
+    for (std::vector<SweepParameter>::const_iterator p = sweep.begin(); p != sweep.end(); ++p) {
+        results << "\t" << p->name;
+    }
+    results << "\tsteps\tcar_number\tcar_latency\ttruck_number\ttruck_latency\tlatency" << std::endl;
+
+    signal(SIGPIPE, SIG_IGN);
+    std::vector<Slot> slots(workers);
+    for (int w = 0; w < workers; w++) {
+        slots[w].state = SLOT_FREE;
+        slots[w].port = base_port + w;
+    }
+
+    unsigned int next_run = 0;
+    unsigned int finished = 0;
+    double best_latency = -1.;
+    int best_run = -1;
+    while (finished < runs.size()) {
+        // start runs in the free slots
+        for (int w = 0; w < workers && next_run < runs.size(); w++) {
+            Slot& slot = slots[w];
+            if (slot.state != SLOT_FREE) {
+                continue;
+            }
+            slot.run = runs[next_run++];
+            slot.line.clear();
+            slot.aborted = false;
+            slot.have_result = false;
+            slot.steps = slot.car_number = slot.truck_number = 0;
+            slot.car_latency = slot.truck_latency = 0.;
+            std::vector<std::string> args;
+            std::ostringstream port, sleep, report;
+            port << slot.port;
+            sleep << sleep_us;
+            report << report_steps;
+            args.push_back(controller);
+            args.push_back("-p");
+            args.push_back(port.str());
+            args.push_back("-s");
+            args.push_back(sleep.str());
+            args.push_back("-c");
+            args.push_back("30");
+            if (abort_factor > 0. && report_steps > 0) {
+                args.push_back("-i");
+                args.push_back(report.str());
+            }
+            for (unsigned int p = 0; p < sweep.size(); p++) {
+                std::ostringstream definition;
+                definition << sweep[p].name << "=" << slot.run.values[p];
+                args.push_back("-P");
+                args.push_back(definition.str());
+            }
+            slot.simulation = start_simulation(expand_command(simulation_command, slot.port));
+            slot.controller = start_controller(args, slot.output);
+            if (slot.simulation < 0 || slot.controller < 0) {
+                std::cout << "Could not start run " << slot.run.index << ": " << strerror(errno) << std::endl;
+                return 1;
+            }
+            slot.state = SLOT_RUNNING;
+        }
+
+        // read the controllers' output
+        std::vector<pollfd> fds;
+        std::vector<int> fd_slots;
+        for (int w = 0; w < workers; w++) {
+            if (slots[w].state == SLOT_RUNNING) {
+                pollfd fd;
+                fd.fd = slots[w].output;
+                fd.events = POLLIN;
+                fd.revents = 0;
+                fds.push_back(fd);
+                fd_slots.push_back(w);
+            }
+        }
+        if (!fds.empty()) {
+            poll(&fds[0], (nfds_t)fds.size(), 200);
+        } else {
+            usleep(200000);
+        }
+        for (unsigned int f = 0; f < fds.size(); f++) {
+            if (fds[f].revents == 0) {
+                continue;
+            }
+            Slot& slot = slots[fd_slots[f]];
+            char buffer[4096];
+            ssize_t read_bytes = read(slot.output, buffer, sizeof(buffer));
+            if (read_bytes > 0) {
+                slot.line.append(buffer, read_bytes);
+                std::string::size_type end;
+                while (!slot.aborted && (end = slot.line.find('\n')) != std::string::npos) {
+                    const std::string line = slot.line.substr(0, end);
+                    slot.line.erase(0, end + 1);
+                    const std::string::size_type colon = line.find(": ");
+                    const char* value = colon == std::string::npos ? "" : line.c_str() + colon + 2;
+                    if (line.compare(0, 6, "Step: ") == 0) {
+                        slot.steps = atoi(value);
+                    } else if (line.compare(0, 10, "Car number") == 0) {
+                        slot.have_result = sscanf(value, "%d, %lf", &slot.car_number, &slot.car_latency) == 2;
+                    } else if (line.compare(0, 12, "Truck number") == 0) {
+                        slot.have_result &= sscanf(value, "%d, %lf", &slot.truck_number, &slot.truck_latency) == 2;
+                    } else if (line.compare(0, 12, "Interim step") == 0 && best_latency >= 0.) {
+                        int step, car_number, car_latency, truck_number, truck_latency;
+                        if (sscanf(value, "%d, %d, %d, %d, %d", &step, &car_number, &car_latency,
+                                   &truck_number, &truck_latency) == 5) {
+                            slot.steps = step;
+                            slot.car_number = car_number;
+                            slot.car_latency = car_number > 0 ? (double)car_latency / car_number : 0.;
+                            slot.truck_number = truck_number;
+                            slot.truck_latency = truck_number > 0 ? (double)truck_latency / truck_number : 0.;
+                            slot.aborted = weighted_latency(slot.car_number, slot.car_latency, slot.truck_number,
+                                                            slot.truck_latency, truck_weight) > abort_factor * best_latency;
+                        }
+                    }
+                }
+                if (!slot.aborted) {
+                    continue;
+                }
+                kill(slot.controller, SIGKILL);
+                kill(-slot.simulation, SIGKILL);
+            }
+
+            // the controller is done (or aborted)
+            close(slot.output);
+            int status = 0;
+            waitpid(slot.controller, &status, 0);
+            std::string state = "done";
+            // for aborted runs, this is the interim latency (a lower bound of the final one)
+            const double latency = weighted_latency(slot.car_number, slot.car_latency,
+                                                    slot.truck_number, slot.truck_latency, truck_weight);
+            if (slot.aborted) {
+                state = "aborted";
+            } else if (!slot.have_result || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                state = "failed";
+            } else {
+                if (best_latency < 0. || latency < best_latency) {
+                    best_latency = latency;
+                    best_run = slot.run.index;
+                }
+            }
+            results << slot.run.index << "\t" << state;
+            for (std::vector<int>::const_iterator v = slot.run.values.begin(); v != slot.run.values.end(); ++v) {
+                results << "\t" << *v;
+            }
+            results << "\t" << slot.steps << "\t" << slot.car_number << "\t" << slot.car_latency
+                    << "\t" << slot.truck_number << "\t" << slot.truck_latency << "\t" << latency << std::endl;
+            std::cout << "Run " << slot.run.index << " " << state;
+            if (state == "done") {
+                std::cout << ", latency: " << latency;
+            }
+            std::cout << " (" << ++finished << "/" << runs.size() << ")" << std::endl;
+            // the simulation usually ends by itself once the controller closed the connection
+            slot.state = SLOT_DRAINING;
+            slot.draining_deadline = now() + 5.;
+        }
+
+        // release the ports of finished simulations
+        for (int w = 0; w < workers; w++) {
+            Slot& slot = slots[w];
+            if (slot.state != SLOT_DRAINING) {
+                continue;
+            }
+            if (waitpid(slot.simulation, 0, WNOHANG) != 0) {
+                slot.state = SLOT_FREE;
+            } else if (now() > slot.draining_deadline) {
+                kill(-slot.simulation, SIGKILL);
+                waitpid(slot.simulation, 0, 0);
+                slot.state = SLOT_FREE;
+            }
+        }
+    }
+    for (int w = 0; w < workers; w++) {
+        if (slots[w].state == SLOT_DRAINING) {
+            kill(-slots[w].simulation, SIGKILL);
+            waitpid(slots[w].simulation, 0, 0);
+        }
+    }
+
+    if (best_run >= 0) {
+        std::cout << "Best run, latency: " << best_run << ", " << best_latency << std::endl;
+    }
+    return 0;
+}
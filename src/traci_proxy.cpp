@@ -0,0 +1,104 @@
+/****************************************************************************/
+/// @file    traci_proxy.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+/// Main method for the TraCI proxy
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2001-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <foreign/tcpip/socket.h>
+#include <utils/traci/TraCIProxy.h>
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+int main(int argc, char* argv[]) {
+    int port = -1;
+    std::string host = "localhost";
+    int listenPort = -1;
+    int leader = 1;
+    bool synchronous = false;
+
+    if (argc < 5) {
+        std::cout << "Usage: traci_proxy -p <remote port> -l <listen port>"
+                  << " [-h <remote host>] [-leader <client number>] [-sync]" << std::endl;
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare("-sync") == 0) {
+            synchronous = true;
+        } else if (i + 1 == argc) {
+            std::cout << "missing value for parameter: " << argv[i] << std::endl;
+            return 1;
+        } else if (arg.compare("-p") == 0) {
+            port = atoi(argv[i + 1]);
+            i++;
+        } else if (arg.compare("-l") == 0) {
+            listenPort = atoi(argv[i + 1]);
+            i++;
+        } else if (arg.compare("-h") == 0) {
+            host = argv[i + 1];
+            i++;
+        } else if (arg.compare("-leader") == 0) {
+            leader = atoi(argv[i + 1]);
+            i++;
+        } else {
+            std::cout << "unknown parameter: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    if (port == -1 || listenPort == -1) {
+        std::cout << "Missing port" << std::endl;
+        return 1;
+    }
+    if (leader < 1) {
+        std::cout << "The leader must be a positive client number" << std::endl;
+        return 1;
+    }
+
+    TraCIProxy proxy(listenPort, leader, synchronous);
+    try {
+        proxy.connect(host, port);
+        proxy.run();
+    } catch (tcpip::SocketException& e) {
+        std::cout << "#Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    const TraCIProxy::Statistics& stats = proxy.getStatistics();
+    std::cout << "clients: " << stats.clients << std::endl
+              << "steps: " << stats.steps << std::endl
+              << "subscriptions (clients/simulation): " << stats.subscriptions
+              << "/" << stats.upstreamSubscriptions << std::endl
+              << "step answer bytes (simulation/clients): " << stats.upstreamBytes
+              << "/" << stats.downstreamBytes << std::endl;
+    return 0;
+}
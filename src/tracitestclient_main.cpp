@@ -31,10 +31,14 @@
 #include <config.h>
 #endif
 
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <cstdlib>
-#include "sumo_client.hpp"
+#include <foreign/tcpip/socket.h>
+#include <utils/common/UtilExceptions.h>
+#include <utils/traci/TraCIProgram.h>
+#include <utils/traci/TraCIProgramExecutor.h>
 
 
 // ===========================================================================
@@ -42,13 +46,19 @@
 // ===========================================================================
 int main(int argc, char* argv[]) {
     std::string defFile = "";
+    std::string programFile = "";
+    std::string compileFile = "";
     std::string outFileName = "testclient_out.txt";
     int port = -1;
     std::string host = "localhost";
+    int batchSize = 1;
+    int inFlight = 1;
 
     if ((argc == 1) || (argc % 2 == 0)) {
         std::cout << "Usage: TraCITestClient -def <definition_file>  -p <remote port>"
-                  << "[-h <remote host>] [-o <outputfile name>]" << std::endl;
+                  << "[-h <remote host>] [-o <outputfile name>]" << std::endl
+                  << "       [-compile <program file>] [-program <program file>]"
+                  << " [-batch <commands per message>] [-inflight <messages>]" << std::endl;
         return 0;
     }
 
@@ -66,18 +76,84 @@ int main(int argc, char* argv[]) {
         } else if (arg.compare("-h") == 0) {
             host = argv[i + 1];
             i++;
+        } else if (arg.compare("-compile") == 0) {
+            compileFile = argv[i + 1];
+            i++;
+        } else if (arg.compare("-program") == 0) {
+            programFile = argv[i + 1];
+            i++;
+        } else if (arg.compare("-batch") == 0) {
+            batchSize = atoi(argv[i + 1]);
+            i++;
+        } else if (arg.compare("-inflight") == 0) {
+            inFlight = atoi(argv[i + 1]);
+            i++;
         } else {
             std::cout << "unknown parameter: " << argv[i] << std::endl;
             return 1;
         }
     }
 
+    if (defFile.compare("") == 0 && programFile.compare("") == 0) {
+        std::cout << "Missing definition file" << std::endl;
+        return 1;
+    }
+    if (batchSize < 1 || inFlight < 1) {
+        std::cout << "The batch size and the number of messages in flight must be positive" << std::endl;
+        return 1;
+    }
+
+    // compile the script once, the executor only sends the encoded commands
+    TraCIProgram program;
+    try {
+        if (programFile.compare("") != 0) {
+            if (!program.load(programFile)) {
+                std::cout << "Can not read program file " << programFile << std::endl;
+                return 1;
+            }
+        } else {
+            program.compile(defFile);
+        }
+        if (compileFile.compare("") != 0) {
+            program.save(compileFile);
+            if (port == -1) {
+                return 0;
+            }
+        }
+    } catch (ProcessError& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+
     if (port == -1) {
         std::cout << "Missing port" << std::endl;
         return 1;
     }
-    if (defFile.compare("") == 0) {
-        std::cout << "Missing definition file" << std::endl;
+
+    TraCIProgramExecutor executor;
+    executor.prepare(program, batchSize);
+    try {
+        executor.connect(host, port);
+        executor.run(inFlight);
+        executor.closeSimulation();
+    } catch (tcpip::SocketException& e) {
+        std::cout << "#Error: " << e.what() << std::endl;
         return 1;
     }
+
+    const TraCIProgramExecutor::Statistics& stats = executor.getStatistics();
+    const double seconds = (double)stats.duration / 1000000.;
+    std::ofstream out(outFileName.c_str());
+    out << "commands: " << stats.commands << std::endl
+        << "messages: " << stats.messages << std::endl
+        << "errors: " << stats.errors << std::endl
+        << "duration [s]: " << seconds << std::endl
+        << "commands per second: " << (seconds > 0 ? stats.commands / seconds : 0) << std::endl
+        << "message latency [us] min/median/p99/max: " << executor.getLatencyQuantile(0)
+        << "/" << executor.getLatencyQuantile(.5) << "/" << executor.getLatencyQuantile(.99)
+        << "/" << executor.getLatencyQuantile(1) << std::endl;
+    if (stats.errors > 0) {
+        out << "first error: " << stats.firstError << std::endl;
+    }
+    return stats.errors > 0 ? 1 : 0;
 }
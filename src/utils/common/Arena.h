@@ -0,0 +1,201 @@
+/****************************************************************************/
+/// @file    Arena.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// A region of memory handing out pieces which are released all at once
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2001-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef Arena_h
+#define Arena_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <vector>
+#include <cstring>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class Arena
+ * @brief A region of memory handing out pieces which are released all at once
+ *
+ * Memory is taken from large blocks by advancing a pointer; single pieces
+ *  can not be freed. reset() releases all pieces at once but keeps the
+ *  blocks, so an arena which is reset and refilled (e.g. once per parsed
+ *  chunk of a document) stops calling the allocator after warming up.
+ *
+ * Only memory is handed out, no destructors are called; the arena is meant
+ *  for character data and plain structures.
+ */
+class Arena {
+public:
+    /** @brief Constructor
+     * @param[in] blockSize The size of the blocks to allocate
+     */
+    explicit Arena(size_t blockSize = 65536)
+        : myBlockSize(blockSize), myCurrent(0), myPos(0), myEnd(0) {}
+
+
+    /// @brief Destructor, frees all blocks
+    ~Arena() {
+        for (std::vector<Block>::iterator i = myBlocks.begin(); i != myBlocks.end(); ++i) {
+            delete[] i->begin;
+        }
+    }
+
+
+    /** @brief Returns uninitialised memory of the given size, aligned for any basic type
+     * @param[in] size The number of bytes needed
+     * @return The memory, valid until the next reset or the destruction of the arena
+     */
+    void* allocate(size_t size) {
+        size = (size + ALIGNMENT - 1) & ~(size_t)(ALIGNMENT - 1);
+        if ((size_t)(myEnd - myPos) < size) {
+            nextBlock(size);
+        }
+        void* const result = myPos;
+        myPos += size;
+        return result;
+    }
+
+
+    /** @brief Stores a 0-terminated copy of the given characters
+     * @param[in] data The characters to copy
+     * @param[in] length The number of characters
+     * @return The copy
+     */
+    char* copy(const char* data, size_t length) {
+        char* const result = (char*)allocate(length + 1);
+        memcpy(result, data, length);
+        result[length] = 0;
+        return result;
+    }
+
+
+    /** @brief Stores a 0-terminated copy of the given wide characters, narrowed to chars
+     *
+     * Like TplConvert::_2str, characters beyond 255 are replaced by '?'.
+     *
+     * @param[in] data The characters to copy
+     * @param[in] length The number of characters
+     * @return The copy
+     */
+    template<class E>
+    char* copy(const E* data, size_t length) {
+        char* const result = (char*)allocate(length + 1);
+        for (size_t i = 0; i < length; ++i) {
+            result[i] = (int)data[i] > 255 ? '?' : (char)data[i];
+        }
+        result[length] = 0;
+        return result;
+    }
+
+
+    /// @brief Releases all pieces handed out, keeping the blocks for reuse
+    void reset() {
+        myCurrent = 0;
+        if (myBlocks.empty()) {
+            myPos = myEnd = 0;
+        } else {
+            myPos = myBlocks[0].begin;
+            myEnd = myBlocks[0].end;
+        }
+    }
+
+
+    /// @brief Returns the number of bytes held in blocks
+    size_t capacity() const {
+        size_t result = 0;
+        for (std::vector<Block>::const_iterator i = myBlocks.begin(); i != myBlocks.end(); ++i) {
+            result += i->end - i->begin;
+        }
+        return result;
+    }
+
+
+private:
+    /// @brief The alignment of all pieces
+    static const size_t ALIGNMENT = 8;
+
+    /// @brief A block of memory
+    struct Block {
+        char* begin;
+        char* end;
+    };
+
+
+    /// @brief Continues within the next block with at least the given size, allocating it if needed
+    void nextBlock(size_t size) {
+        if (!myBlocks.empty()) {
+            // the blocks following the current one are free after a reset
+            for (myCurrent++; myCurrent < myBlocks.size(); myCurrent++) {
+                if ((size_t)(myBlocks[myCurrent].end - myBlocks[myCurrent].begin) >= size) {
+                    myPos = myBlocks[myCurrent].begin;
+                    myEnd = myBlocks[myCurrent].end;
+                    return;
+                }
+            }
+        }
+        Block block;
+        const size_t blockSize = size > myBlockSize ? size : myBlockSize;
+        block.begin = new char[blockSize];
+        block.end = block.begin + blockSize;
+        myBlocks.push_back(block);
+        myCurrent = myBlocks.size() - 1;
+        myPos = block.begin;
+        myEnd = block.end;
+    }
+
+
+private:
+    /// @brief The size of newly allocated blocks
+    const size_t myBlockSize;
+
+    /// @brief All blocks in the order of their use
+    std::vector<Block> myBlocks;
+
+    /// @brief The index of the block in use
+    size_t myCurrent;
+
+    /// @brief The next free byte within the block in use
+    char* myPos;
+
+    /// @brief The end of the block in use
+    char* myEnd;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    Arena(const Arena&);
+
+    /// @brief Invalidated assignment operator.
+    Arena& operator=(const Arena&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
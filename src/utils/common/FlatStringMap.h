@@ -0,0 +1,218 @@
+/****************************************************************************/
+/// @file    FlatStringMap.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// An open addressing hash map from strings to values
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2002-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef FlatStringMap_h
+#define FlatStringMap_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "StringRef.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class FlatStringMap
+ * @brief An open addressing hash map from strings to values
+ *
+ * All entries are stored in a single array which is probed linearly, so a
+ *  lookup usually touches one or two neighbouring slots and compares the
+ *  stored hash before comparing characters. Lookups take a StringRef, so
+ *  keys held in parse buffers need not be copied into a std::string.
+ *  Erasing shifts the following entries back instead of leaving
+ *  tombstones. The iteration order is unspecified; use an ordered
+ *  container next to this one where the order matters.
+ *
+ * T must be default constructible and assignable.
+ */
+template<class T>
+class FlatStringMap {
+public:
+    /// @brief Constructor
+    FlatStringMap() : mySize(0) {}
+
+
+    /** @brief Adds an entry
+     * @param[in] key The key to add
+     * @param[in] value The value to store
+     * @return Whether the entry was added (false if the key was already stored)
+     */
+    bool insert(const std::string& key, const T& value) {
+        if ((mySize + 1) * 4 > mySlots.size() * 3) {
+            rehash(mySlots.empty() ? 16 : (unsigned int)mySlots.size() * 2);
+        }
+        const unsigned int hash = StringRef(key).hash();
+        unsigned int pos = findSlot(StringRef(key), hash);
+        if (mySlots[pos].used) {
+            return false;
+        }
+        Slot& slot = mySlots[pos];
+        slot.used = true;
+        slot.hash = hash;
+        slot.key = key;
+        slot.value = value;
+        mySize++;
+        return true;
+    }
+
+
+    /** @brief Returns the value stored for the key
+     * @param[in] key The key to look up
+     * @return The stored value or 0 if the key is not stored
+     */
+    const T* find(const StringRef& key) const {
+        if (mySize == 0) {
+            return 0;
+        }
+        const Slot& slot = mySlots[findSlot(key, key.hash())];
+        return slot.used ? &slot.value : 0;
+    }
+
+
+    /// @brief Returns the value stored for the key (0 if the key is not stored)
+    T* find(const StringRef& key) {
+        return const_cast<T*>(static_cast<const FlatStringMap*>(this)->find(key));
+    }
+
+
+    /** @brief Removes an entry
+     * @param[in] key The key to remove
+     * @return Whether the key was stored
+     */
+    bool erase(const StringRef& key) {
+        if (mySize == 0) {
+            return false;
+        }
+        const unsigned int mask = (unsigned int)mySlots.size() - 1;
+        unsigned int pos = findSlot(key, key.hash());
+        if (!mySlots[pos].used) {
+            return false;
+        }
+        // shift back the following entries which would not be found otherwise
+        unsigned int next = (pos + 1) & mask;
+        while (mySlots[next].used) {
+            const unsigned int home = mySlots[next].hash & mask;
+            if (((next - home) & mask) >= ((next - pos) & mask)) {
+                swapSlots(mySlots[pos], mySlots[next]);
+                pos = next;
+            }
+            next = (next + 1) & mask;
+        }
+        mySlots[pos].used = false;
+        mySlots[pos].key = std::string();
+        mySlots[pos].value = T();
+        mySize--;
+        return true;
+    }
+
+
+    /// @brief Removes all entries
+    void clear() {
+        mySlots.clear();
+        mySize = 0;
+    }
+
+
+    /// @brief Returns the number of entries
+    unsigned int size() const {
+        return mySize;
+    }
+
+
+private:
+    /// @brief A slot of the table
+    struct Slot {
+        Slot() : used(false), hash(0), value() {}
+        /// @brief Whether the slot holds an entry
+        bool used;
+        /// @brief The hash of the key
+        unsigned int hash;
+        /// @brief The key
+        std::string key;
+        /// @brief The value
+        T value;
+    };
+
+
+    /// @brief Returns the slot holding the key or the free slot where it would be inserted
+    unsigned int findSlot(const StringRef& key, unsigned int hash) const {
+        const unsigned int mask = (unsigned int)mySlots.size() - 1;
+        unsigned int pos = hash & mask;
+        while (mySlots[pos].used) {
+            const Slot& slot = mySlots[pos];
+            if (slot.hash == hash && key == StringRef(slot.key)) {
+                break;
+            }
+            pos = (pos + 1) & mask;
+        }
+        return pos;
+    }
+
+
+    /// @brief Exchanges the contents of two slots without copying the keys
+    static void swapSlots(Slot& a, Slot& b) {
+        std::swap(a.used, b.used);
+        std::swap(a.hash, b.hash);
+        a.key.swap(b.key);
+        std::swap(a.value, b.value);
+    }
+
+
+    /// @brief Moves all entries into a table of the given size (a power of two)
+    void rehash(unsigned int size) {
+        std::vector<Slot> old(size);
+        old.swap(mySlots);
+        const unsigned int mask = size - 1;
+        for (typename std::vector<Slot>::iterator i = old.begin(); i != old.end(); ++i) {
+            if (i->used) {
+                unsigned int pos = i->hash & mask;
+                while (mySlots[pos].used) {
+                    pos = (pos + 1) & mask;
+                }
+                swapSlots(mySlots[pos], *i);
+            }
+        }
+    }
+
+
+private:
+    /// @brief The slots, the size is a power of two
+    std::vector<Slot> mySlots;
+
+    /// @brief The number of entries
+    unsigned int mySize;
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -34,11 +34,15 @@
 #include <vector>
 #include <algorithm>
 #include <iostream>
+#include <map>
 #include "MsgHandler.h"
 #include <utils/options/OptionsCont.h>
 #include <utils/iodevices/OutputDevice.h>
 #include <utils/common/UtilExceptions.h>
 #include "AbstractMutex.h"
+#include "PosixThread.h"
+#include "SysUtils.h"
+#include "ToString.h"
 
 #ifdef CHECK_MEMORY_LEAKS
 #include <foreign/nvwa/debug_new.h>
@@ -53,6 +57,284 @@ MsgHandler* MsgHandler::myWarningInstance = 0;
 MsgHandler* MsgHandler::myMessageInstance = 0;
 bool MsgHandler::myAmProcessingProcess = false;
 AbstractMutex* MsgHandler::myLock = 0;
+MsgHandler::BufferedSink* MsgHandler::mySink = 0;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MsgHandler::BufferedSink
+ * @brief Collects the messages of all threads and delivers them in order
+ *
+ * Each thread appends to its own buffer, guarded by a lock of its own which
+ *  is only contended while the sink empties the buffer. Messages are
+ *  numbered on arrival; after emptying all buffers, the sink delivers all
+ *  messages numbered below the counter value read before it started, so
+ *  no message can overtake an earlier one which is still being appended.
+ */
+class MsgHandler::BufferedSink : public PosixThread {
+public:
+    /// @brief The kind of a buffered call
+    enum EntryKind {
+        ENTRY_INFORM,
+        ENTRY_BEGIN_PROCESS,
+        ENTRY_END_PROCESS
+    };
+
+    /// @brief Constructor, starts the thread
+    BufferedSink(unsigned int maxPerSecond, bool collapseRepeated, unsigned int interval)
+        : myMaxPerSecond(maxPerSecond), myCollapseRepeated(collapseRepeated), myInterval(interval),
+          mySequence(0), myDelivered(0), myQuit(false), myWindowStart(SysUtils::getCurrentMillis()) {
+        pthread_key_create(&myBufferKey, &BufferedSink::releaseBuffer);
+        start();
+    }
+
+    /// @brief Destructor, delivers everything and stops the thread
+    ~BufferedSink() {
+        myLock.lock();
+        myQuit = true;
+        myWakeup.signal();
+        myLock.unlock();
+        join();
+        pthread_key_delete(myBufferKey);
+        for (std::vector<ThreadBuffer*>::iterator i = myBuffers.begin(); i != myBuffers.end(); ++i) {
+            delete *i;
+        }
+    }
+
+    /// @brief Appends a call to the calling thread's buffer
+    void add(MsgHandler* handler, EntryKind kind, const std::string& msg, bool addType) {
+        ThreadBuffer& buffer = getBuffer();
+        buffer.lock.lock();
+        buffer.entries.push_back(Entry());
+        Entry& entry = buffer.entries.back();
+        entry.sequence = __sync_fetch_and_add(&mySequence, 1);
+        entry.handler = handler;
+        entry.kind = kind;
+        entry.msg = msg;
+        entry.addType = addType;
+        buffer.lock.unlock();
+    }
+
+    /// @brief Waits until everything added so far is delivered
+    void flush() {
+        const unsigned long target = __sync_fetch_and_add(&mySequence, 0);
+        myLock.lock();
+        myWakeup.signal();
+        while (myDelivered < target) {
+            myDeliveredCondition.wait(myLock);
+        }
+        myLock.unlock();
+    }
+
+protected:
+    /// @brief Delivers the buffered messages every interval
+    void run() {
+        myLock.lock();
+        while (!myQuit) {
+            myWakeup.wait(myLock, myInterval);
+            myLock.unlock();
+            deliverBuffered(false);
+            myLock.lock();
+        }
+        myLock.unlock();
+        deliverBuffered(true);
+        closeWindow(true);
+    }
+
+private:
+    /// @brief A buffered call
+    struct Entry {
+        unsigned long sequence;
+        MsgHandler* handler;
+        EntryKind kind;
+        std::string msg;
+        bool addType;
+
+        bool operator<(const Entry& other) const {
+            return sequence < other.sequence;
+        }
+    };
+
+    /// @brief The buffer of one thread
+    struct ThreadBuffer {
+        PosixMutex lock;
+        std::vector<Entry> entries;
+        /// @brief Whether the thread has ended
+        bool orphaned;
+    };
+
+    /// @brief Returns the calling thread's buffer, registering it if needed
+    ThreadBuffer& getBuffer() {
+        ThreadBuffer* buffer = static_cast<ThreadBuffer*>(pthread_getspecific(myBufferKey));
+        if (buffer == 0) {
+            buffer = new ThreadBuffer();
+            buffer->orphaned = false;
+            myLock.lock();
+            myBuffers.push_back(buffer);
+            myLock.unlock();
+            pthread_setspecific(myBufferKey, buffer);
+        }
+        return *buffer;
+    }
+
+    /// @brief Marks the buffer of an ending thread for removal
+    static void releaseBuffer(void* buffer) {
+        ThreadBuffer* const threadBuffer = static_cast<ThreadBuffer*>(buffer);
+        threadBuffer->lock.lock();
+        threadBuffer->orphaned = true;
+        threadBuffer->lock.unlock();
+    }
+
+    /// @brief Empties all thread buffers and delivers the messages in order
+    void deliverBuffered(bool all) {
+        const unsigned long watermark = __sync_fetch_and_add(&mySequence, 0);
+        std::vector<Entry> collected;
+        collected.swap(myHeldBack);
+        myLock.lock();
+        for (std::vector<ThreadBuffer*>::iterator i = myBuffers.begin(); i != myBuffers.end();) {
+            ThreadBuffer* const buffer = *i;
+            buffer->lock.lock();
+            collected.insert(collected.end(), buffer->entries.begin(), buffer->entries.end());
+            buffer->entries.clear();
+            const bool orphaned = buffer->orphaned;
+            buffer->lock.unlock();
+            if (orphaned) {
+                delete buffer;
+                i = myBuffers.erase(i);
+            } else {
+                ++i;
+            }
+        }
+        myLock.unlock();
+        std::sort(collected.begin(), collected.end());
+        const std::vector<Entry>::const_iterator end = collected.end();
+        for (std::vector<Entry>::const_iterator i = collected.begin(); i != end; ++i) {
+            if (!all && i->sequence >= watermark) {
+                myHeldBack.assign(i, end);
+                break;
+            }
+            deliver(*i);
+        }
+        closeWindow(false);
+        myLock.lock();
+        myDelivered = watermark;
+        myDeliveredCondition.broadcast();
+        myLock.unlock();
+    }
+
+    /// @brief Delivers a single call, applying the repetition and rate limits
+    void deliver(const Entry& entry) {
+        MsgHandler* const handler = entry.handler;
+        if (entry.kind == ENTRY_BEGIN_PROCESS) {
+            handler->beginProcessMsgNow(entry.msg, entry.addType);
+            return;
+        }
+        if (entry.kind == ENTRY_END_PROCESS) {
+            handler->endProcessMsgNow(entry.msg);
+            return;
+        }
+        handler->myNumInformed++;
+        if (myCollapseRepeated) {
+            const std::pair<MsgHandler*, std::string> key(handler, entry.msg);
+            std::map<std::pair<MsgHandler*, std::string>, Repetition>::iterator i = myRepetitions.find(key);
+            if (i != myRepetitions.end()) {
+                i->second.count++;
+                handler->myNumSuppressed++;
+                return;
+            }
+            myRepetitions[key].addType = entry.addType;
+        }
+        if (myMaxPerSecond > 0 && handler->myType != MT_ERROR) {
+            unsigned int& num = myWindowCounts[handler];
+            if (num >= myMaxPerSecond) {
+                myDropped[handler]++;
+                handler->myNumSuppressed++;
+                return;
+            }
+            num++;
+        }
+        handler->informNow(entry.msg, entry.addType);
+    }
+
+    /// @brief Reports repetitions and dropped messages once a second has passed (or if forced)
+    void closeWindow(bool force) {
+        const long now = SysUtils::getCurrentMillis();
+        if (!force && now - myWindowStart < 1000) {
+            return;
+        }
+        myWindowStart = now;
+        for (std::map<std::pair<MsgHandler*, std::string>, Repetition>::const_iterator i = myRepetitions.begin(); i != myRepetitions.end(); ++i) {
+            if (i->second.count > 0) {
+                i->first.first->informNow(i->first.second + " (repeated " + toString(i->second.count) + " times)", i->second.addType);
+            }
+        }
+        myRepetitions.clear();
+        for (std::map<MsgHandler*, unsigned int>::const_iterator i = myDropped.begin(); i != myDropped.end(); ++i) {
+            i->first->informNow(toString(i->second) + " further messages suppressed.", true);
+        }
+        myDropped.clear();
+        myWindowCounts.clear();
+    }
+
+private:
+    /// @brief The repetitions of a message within the current window
+    struct Repetition {
+        Repetition() : count(0), addType(true) {}
+        unsigned int count;
+        bool addType;
+    };
+
+    /// @brief The maximum number of messages per type and second
+    const unsigned int myMaxPerSecond;
+
+    /// @brief Whether identical messages shall be collapsed
+    const bool myCollapseRepeated;
+
+    /// @brief The delivery interval in milliseconds
+    const unsigned int myInterval;
+
+    /// @brief The number of calls added so far (the next sequence number)
+    unsigned long mySequence;
+
+    /// @brief All calls numbered below this are delivered
+    unsigned long myDelivered;
+
+    /// @brief Whether the thread shall stop
+    bool myQuit;
+
+    /// @brief The key to the buffer of the current thread
+    pthread_key_t myBufferKey;
+
+    /// @brief The registered thread buffers
+    std::vector<ThreadBuffer*> myBuffers;
+
+    /// @brief Calls collected but numbered after the watermark of their round
+    std::vector<Entry> myHeldBack;
+
+    /// @brief The begin of the current rate/repetition window
+    long myWindowStart;
+
+    /// @brief The messages delivered within the current window
+    std::map<std::pair<MsgHandler*, std::string>, Repetition> myRepetitions;
+
+    /// @brief The number of messages delivered per type within the current window
+    std::map<MsgHandler*, unsigned int> myWindowCounts;
+
+    /// @brief The number of messages dropped per type within the current window
+    std::map<MsgHandler*, unsigned int> myDropped;
+
+    /// @brief The lock guarding the buffer registry and the delivery state
+    PosixMutex myLock;
+
+    /// @brief Wakes up the thread early (on flush or stop)
+    PosixCondition myWakeup;
+
+    /// @brief Signals finished deliveries
+    PosixCondition myDeliveredCondition;
+
+};
 
 
 // ===========================================================================
@@ -87,13 +369,25 @@ MsgHandler::getErrorInstance() {
 
 void
 MsgHandler::inform(std::string msg, bool addType) {
+    if (mySink != 0) {
+        myWasInformed = true;
+        mySink->add(this, BufferedSink::ENTRY_INFORM, msg, addType);
+        return;
+    }
+    myNumInformed++;
+    informNow(msg, addType);
+}
+
+
+void
+MsgHandler::informNow(std::string msg, bool addType) {
     if (myLock != 0) {
         myLock->lock();
     }
     // beautify progress output
     if (myAmProcessingProcess) {
         myAmProcessingProcess = false;
-        MsgHandler::getMessageInstance()->inform("");
+        MsgHandler::getMessageInstance()->informNow("", true);
     }
     msg = build(msg, addType);
     // inform all receivers
@@ -110,6 +404,17 @@ MsgHandler::inform(std::string msg, bool addType) {
 
 void
 MsgHandler::beginProcessMsg(std::string msg, bool addType) {
+    if (mySink != 0) {
+        myWasInformed = true;
+        mySink->add(this, BufferedSink::ENTRY_BEGIN_PROCESS, msg, addType);
+        return;
+    }
+    beginProcessMsgNow(msg, addType);
+}
+
+
+void
+MsgHandler::beginProcessMsgNow(std::string msg, bool addType) {
     if (myLock != 0) {
         myLock->lock();
     }
@@ -129,6 +434,17 @@ MsgHandler::beginProcessMsg(std::string msg, bool addType) {
 
 void
 MsgHandler::endProcessMsg(std::string msg) {
+    if (mySink != 0) {
+        myWasInformed = true;
+        mySink->add(this, BufferedSink::ENTRY_END_PROCESS, msg, false);
+        return;
+    }
+    endProcessMsgNow(msg);
+}
+
+
+void
+MsgHandler::endProcessMsgNow(std::string msg) {
     if (myLock != 0) {
         myLock->lock();
     }
@@ -240,6 +556,7 @@ MsgHandler::initOutputOptions() {
 
 void
 MsgHandler::cleanupOnEnd() {
+    disableBuffering();
     if (myLock != 0) {
         myLock->lock();
     }
@@ -256,7 +573,7 @@ MsgHandler::cleanupOnEnd() {
 
 
 MsgHandler::MsgHandler(MsgType type)
-    : myType(type), myWasInformed(false) {
+    : myType(type), myWasInformed(false), myNumInformed(0), myNumSuppressed(0) {
     if (type == MT_MESSAGE) {
         addRetriever(&OutputDevice::getDevice("stdout"));
     } else {
@@ -282,6 +599,46 @@ MsgHandler::assignLock(AbstractMutex* lock) {
 }
 
 
+void
+MsgHandler::enableBuffering(unsigned int maxPerSecond, bool collapseRepeated, unsigned int interval) {
+    if (mySink == 0) {
+        // create the instances now, the sink thread must not do it concurrently
+        getMessageInstance();
+        getWarningInstance();
+        getErrorInstance();
+        mySink = new BufferedSink(maxPerSecond, collapseRepeated, interval);
+    }
+}
+
+
+void
+MsgHandler::flushBuffers() {
+    if (mySink != 0) {
+        mySink->flush();
+    }
+}
+
+
+void
+MsgHandler::disableBuffering() {
+    BufferedSink* const sink = mySink;
+    mySink = 0;
+    delete sink;
+}
+
+
+unsigned long
+MsgHandler::getNumInformed() const {
+    return myNumInformed;
+}
+
+
+unsigned long
+MsgHandler::getNumSuppressed() const {
+    return myNumSuppressed;
+}
+
+
 
 /****************************************************************************/
 
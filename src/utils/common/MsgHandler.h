@@ -114,6 +114,42 @@ public:
         The lock will not be deleted */
     static void assignLock(AbstractMutex* lock);
 
+    /** @brief Switches all instances to buffered delivery
+     *
+     * Messages are then appended to a buffer of the calling thread and
+     *  delivered to the retrievers by a background thread, in the order
+     *  they were informed. Identical messages of one type are delivered
+     *  once per second, followed by a note how often they were repeated.
+     *  Messages and warnings exceeding the given rate are dropped, a note
+     *  tells how many. Errors are never dropped.
+     *
+     * Must be called before further threads inform messages.
+     *
+     * @param[in] maxPerSecond The maximum number of messages per type and second (0 for no limit)
+     * @param[in] collapseRepeated Whether identical messages shall be collapsed
+     * @param[in] interval The delivery interval in milliseconds
+     */
+    static void enableBuffering(unsigned int maxPerSecond = 0, bool collapseRepeated = true,
+                                unsigned int interval = 100);
+
+    /** @brief Waits until all messages informed so far (by any thread) are delivered
+     *
+     * Does nothing if buffering is not enabled.
+     */
+    static void flushBuffers();
+
+    /** @brief Delivers all pending messages and switches back to direct delivery
+     *
+     * Must be called after the other threads stopped informing messages.
+     */
+    static void disableBuffering();
+
+    /// Returns the number of messages informed to this instance
+    unsigned long getNumInformed() const;
+
+    /// Returns the number of messages which were collapsed or dropped (buffered mode only)
+    unsigned long getNumSuppressed() const;
+
     /** @brief Generic output operator
      * @return The MsgHandler for further processing
      */
@@ -151,6 +187,15 @@ private:
     /// standard constructor
     MsgHandler(MsgType type);
 
+    /// delivers a message to the retrievers
+    void informNow(std::string msg, bool addType);
+
+    /// delivers the begin of a process information to the retrievers
+    void beginProcessMsgNow(std::string msg, bool addType);
+
+    /// delivers the end of a process information to the retrievers
+    void endProcessMsgNow(std::string msg);
+
     /// destructor
     ~MsgHandler();
 
@@ -171,6 +216,13 @@ private:
         The lock will not be deleted */
     static AbstractMutex* myLock;
 
+    /// The background thread delivering buffered messages
+    class BufferedSink;
+    friend class BufferedSink;
+
+    /// The sink if buffering is enabled, 0 otherwise
+    static BufferedSink* mySink;
+
 private:
     /// The type of the instance
     MsgType myType;
@@ -178,6 +230,12 @@ private:
     /// information wehther an error occured at all
     bool myWasInformed;
 
+    /// The number of messages informed
+    unsigned long myNumInformed;
+
+    /// The number of messages collapsed or dropped
+    unsigned long myNumSuppressed;
+
     /// Definition of the list of retrievers to inform
     typedef std::vector<OutputDevice*> RetrieverVector;
 
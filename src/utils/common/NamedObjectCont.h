@@ -36,6 +36,7 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include "FlatStringMap.h"
 
 
 // ===========================================================================
@@ -49,6 +50,10 @@
  *  which do have a name. In order to get the stored objects as a list,
  *  each insertion/deletion sets the internal state value "myHaveChanged"
  *  to true, indicating the list must be rebuild.
+ *
+ * Besides the map, which keeps the objects ordered by their ids for
+ *  iteration, an open addressing hash index is maintained which serves
+ *  the lookups by id.
  */
 template<class T>
 class NamedObjectCont {
@@ -56,6 +61,9 @@ public:
     /// @brief Definition of the key to pointer map type
     typedef std::map< std::string, T > IDMap;
 
+    /// @brief Definition of the hashed id index
+    typedef FlatStringMap<T> IDIndex;
+
     /// @brief Constructor
     NamedObjectCont() : myHaveChanged(false) { }
 
@@ -78,7 +86,7 @@ public:
      * @return If the item could been added (no item with the same id was within the container before)
      */
     virtual bool add(const std::string& id, T item) {
-        if (myMap.find(id) != myMap.end()) {
+        if (!myIndex.insert(id, item)) {
             return false;
         }
         myMap.insert(std::make_pair(id, item));
@@ -92,7 +100,7 @@ public:
      * @return If the item could been removed (an item with the id was within the container before)
      */
     virtual bool remove(const std::string& id) {
-        if (myMap.find(id) == myMap.end()) {
+        if (!myIndex.erase(id)) {
             return false;
         }
         typename std::map<std::string, T>::iterator i = myMap.find(id);
@@ -110,12 +118,12 @@ public:
      * @param[in] id The id of the item to retrieve
      * @return The item stored under the given id, or 0 if no such item exists
      */
-    T get(const std::string& id) const {
-        typename std::map<std::string, T>::const_iterator i = myMap.find(id);
-        if (i == myMap.end()) {
+    T get(const StringRef& id) const {
+        const T* const item = myIndex.find(id);
+        if (item == 0) {
             return 0;
         }
-        return (*i).second;
+        return *item;
     }
 
 
@@ -125,6 +133,7 @@ public:
             delete(*i).second;
         }
         myMap.clear();
+        myIndex.clear();
         myVector.clear();
         myHaveChanged = true;
     }
@@ -154,6 +163,7 @@ public:
             return false;
         }
         T o = (*i).second;
+        myIndex.erase(id);
         myMap.erase(i);
         // and from the vector
         typename ObjectVector::iterator i2 =
@@ -233,6 +243,9 @@ private:
     /// @brief The map from key to object
     IDMap myMap;
 
+    /// @brief The hashed index from key to object
+    IDIndex myIndex;
+
     /// @brief Definition objects vector
     typedef std::vector<T> ObjectVector;
 
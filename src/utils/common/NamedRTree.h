@@ -33,46 +33,27 @@
 #endif
 
 #include <set>
-#include <foreign/rtree/RTree.h>
 #include <utils/common/Named.h>
+#include <utils/common/PackedRTree.h>
 
 
-// specialized implementation for speedup and avoiding warnings
-#define NAMED_RTREE_QUAL RTree<Named*, Named, float, 2, Named::StoringVisitor>
-
-template<>
-inline float NAMED_RTREE_QUAL::RectSphericalVolume(Rect* a_rect) {
-    ASSERT(a_rect);
-    const float extent0 = a_rect->m_max[0] - a_rect->m_min[0];
-    const float extent1 = a_rect->m_max[1] - a_rect->m_min[1];
-    return .78539816f * (extent0 * extent0 + extent1 * extent1);
-}
-
-template<>
-inline NAMED_RTREE_QUAL::Rect NAMED_RTREE_QUAL::CombineRect(Rect* a_rectA, Rect* a_rectB) {
-    ASSERT(a_rectA && a_rectB);
-    Rect newRect;
-    newRect.m_min[0] = rtree_min(a_rectA->m_min[0], a_rectB->m_min[0]);
-    newRect.m_max[0] = rtree_max(a_rectA->m_max[0], a_rectB->m_max[0]);
-    newRect.m_min[1] = rtree_min(a_rectA->m_min[1], a_rectB->m_min[1]);
-    newRect.m_max[1] = rtree_max(a_rectA->m_max[1], a_rectB->m_max[1]);
-    return newRect;
-}
-
 // ===========================================================================
 // class definitions
 // ===========================================================================
 /** @class NamedRTree
  * @brief A RT-tree for efficient storing of SUMO's Named objects
  *
- * This class specialises the used RT-tree implementation from "rttree.h".
- * It stores names of "Named"-objects.
+ * This class wraps a PackedRTree, keeping the interface of the former
+ *  "rttree.h" based implementation. It stores names of "Named"-objects.
+ *  Objects inserted after the last packing are found by a linear scan
+ *  until the tree is packed again; call Pack once all objects are loaded.
  * @see Named
+ * @see PackedRTree
  */
-class NamedRTree : private NAMED_RTREE_QUAL {
+class NamedRTree {
 public:
     /// @brief Constructor
-    NamedRTree() : NAMED_RTREE_QUAL(&Named::addTo) {
+    NamedRTree() {
     }
 
 
@@ -85,10 +66,10 @@ public:
      * @param a_min Min of bounding rect
      * @param a_max Max of bounding rect
      * @param a_data The instance of a Named-object to add (the ID is added)
-     * @see RTree::Insert
+     * @see PackedRTree::insert
      */
     void Insert(const float a_min[2], const float a_max[2], Named* const& a_data) {
-        NAMED_RTREE_QUAL::Insert(a_min, a_max, a_data);
+        myTree.insert(a_min, a_max, a_data);
     }
 
 
@@ -96,35 +77,57 @@ public:
      * @param a_min Min of bounding rect
      * @param a_max Max of bounding rect
      * @param a_data The instance of a Named-object to remove
-     * @see RTree::Remove
+     * @see PackedRTree::remove
      */
     void Remove(const float a_min[2], const float a_max[2], Named* const& a_data) {
-        NAMED_RTREE_QUAL::Remove(a_min, a_max, a_data);
+        myTree.remove(a_min, a_max, a_data);
     }
 
 
     /** @brief Remove all enrties
-     * @see RTree::RemoveAll
+     * @see PackedRTree::clear
      */
     void RemoveAll() {
-        NAMED_RTREE_QUAL::RemoveAll();
+        myTree.clear();
+    }
+
+
+    /** @brief Packs all entries into the tree
+     * @see PackedRTree::pack
+     */
+    void Pack() {
+        myTree.pack();
     }
 
 
     /** @brief Find all within search rectangle
      * @param a_min Min of search bounding rect
      * @param a_max Max of search bounding rect
-     * @param a_searchResult Search result array.  Caller should set grow size. Function will reset, not append to array.
-     * @param a_resultCallback Callback function to return result.  Callback should return 'true' to continue searching
-     * @param a_context User context to pass as parameter to a_resultCallback
+     * @param c The visitor the ids of the found objects are added to
      * @return Returns the number of entries found
-     * @see RTree::Search
+     * @see PackedRTree::search
      */
     int Search(const float a_min[2], const float a_max[2], const Named::StoringVisitor& c) const {
-        return NAMED_RTREE_QUAL::Search(a_min, a_max, c);
+        AddingVisitor visitor(c);
+        return (int)myTree.search(a_min, a_max, visitor);
     }
 
 
+private:
+    /// @brief Adds the found objects to a StoringVisitor
+    struct AddingVisitor {
+        AddingVisitor(const Named::StoringVisitor& c) : myVisitor(c) {}
+        void operator()(const Named* const o) {
+            o->addTo(myVisitor);
+        }
+        const Named::StoringVisitor& myVisitor;
+    };
+
+
+private:
+    /// @brief The tree
+    PackedRTree<Named*> myTree;
+
 };
 
 
@@ -0,0 +1,199 @@
+/****************************************************************************/
+/// @file    NumberFormat.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Allocation free formatting of numbers into caller supplied buffers
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2001-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef NumberFormat_h
+#define NumberFormat_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <cstdio>
+#include <cstring>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class NumberFormat
+ * @brief Allocation free formatting of numbers into caller supplied buffers
+ *
+ * formatFixed yields the same characters as a stream set to std::ios::fixed
+ *  with the given precision (i.e. printf's "%.*f"), which is what toString
+ *  and the output devices write. The value is split into its binary mantissa
+ *  and exponent and scaled by 10^precision in integer arithmetic, rounding
+ *  ties to even like the C library does; values for which this does not fit
+ *  into 64 bits are handed to snprintf.
+ *
+ * The buffers must hold at least BUFFER_SIZE characters; the results are
+ *  not 0-terminated, the length is returned.
+ */
+class NumberFormat {
+public:
+    /// @brief The size of the buffers handed to the format methods
+    static const int BUFFER_SIZE = 400;
+
+    /// @brief The largest precision supported by formatFixed
+    static const int MAX_PRECISION = 64;
+
+
+    /** @brief Writes the value with the given number of digits behind the decimal point
+     * @param[in] v The value to format
+     * @param[in] precision The number of decimals (0 to MAX_PRECISION)
+     * @param[out] buf The buffer to write into
+     * @return The number of characters written
+     */
+    static unsigned int formatFixed(double v, int precision, char* buf) {
+        if (precision < 0 || precision > MAX_PRECISION || !(v - v == 0)) {
+            // nan, inf and unsupported precisions
+            return slowFormat(v, precision, buf);
+        }
+        unsigned long long bits;
+        memcpy(&bits, &v, sizeof(bits));
+        const bool negative = (bits >> 63) != 0;
+        const int biased = (int)((bits >> 52) & 0x7ff);
+        unsigned long long mantissa = bits & ((1ULL << 52) - 1);
+        int exponent = -1074;
+        if (biased != 0) {
+            mantissa |= 1ULL << 52;
+            exponent = biased - 1075;
+        }
+        // v * 10^precision = mantissa * 5^precision * 2^(exponent + precision)
+        unsigned long long scaled = 0;
+        if (mantissa != 0) {
+            while ((mantissa & 1) == 0) {
+                mantissa >>= 1;
+                exponent++;
+            }
+            if (precision > 27) {
+                return slowFormat(v, precision, buf);
+            }
+            const unsigned long long power = powerOf5(precision);
+            if (mantissa > ~0ULL / power) {
+                return slowFormat(v, precision, buf);
+            }
+            scaled = mantissa * power;
+            const int shift = exponent + precision;
+            if (shift >= 0) {
+                if (shift >= 64 || scaled > (~0ULL >> shift)) {
+                    return slowFormat(v, precision, buf);
+                }
+                scaled <<= shift;
+            } else if (shift < -64) {
+                // less than a quarter of the last digit
+                scaled = 0;
+            } else if (shift == -64) {
+                return slowFormat(v, precision, buf);
+            } else {
+                const unsigned long long rest = scaled & ((1ULL << -shift) - 1);
+                const unsigned long long half = 1ULL << (-shift - 1);
+                scaled >>= -shift;
+                if (rest > half || (rest == half && (scaled & 1) != 0)) {
+                    scaled++;
+                }
+            }
+        }
+        // the digits in reverse order, at least one before the decimal point
+        char digits[24];
+        int numDigits = 0;
+        do {
+            digits[numDigits++] = (char)('0' + scaled % 10);
+            scaled /= 10;
+        } while (scaled != 0);
+        unsigned int pos = 0;
+        if (negative) {
+            buf[pos++] = '-';
+        }
+        for (int i = (precision + 1 > numDigits ? precision + 1 : numDigits) - 1; i >= 0; --i) {
+            buf[pos++] = i < numDigits ? digits[i] : '0';
+            if (i == precision && precision > 0) {
+                buf[pos++] = '.';
+            }
+        }
+        return pos;
+    }
+
+
+    /** @brief Writes the integer
+     * @param[in] v The value to format
+     * @param[out] buf The buffer to write into
+     * @return The number of characters written
+     */
+    static unsigned int formatInt(long long v, char* buf) {
+        if (v < 0) {
+            buf[0] = '-';
+            // negate in unsigned arithmetic to support the smallest value
+            return 1 + formatUnsigned(0ULL - (unsigned long long)v, buf + 1);
+        }
+        return formatUnsigned((unsigned long long)v, buf);
+    }
+
+
+    /** @brief Writes the unsigned integer
+     * @param[in] v The value to format
+     * @param[out] buf The buffer to write into
+     * @return The number of characters written
+     */
+    static unsigned int formatUnsigned(unsigned long long v, char* buf) {
+        char digits[20];
+        unsigned int numDigits = 0;
+        do {
+            digits[numDigits++] = (char)('0' + v % 10);
+            v /= 10;
+        } while (v != 0);
+        for (unsigned int i = 0; i < numDigits; ++i) {
+            buf[i] = digits[numDigits - 1 - i];
+        }
+        return numDigits;
+    }
+
+
+private:
+    /// @brief Returns 5^exponent for 0 <= exponent <= 27
+    static unsigned long long powerOf5(int exponent) {
+        unsigned long long result = 1;
+        for (int i = 0; i < exponent; ++i) {
+            result *= 5;
+        }
+        return result;
+    }
+
+
+    /// @brief Formats using the C library
+    static unsigned int slowFormat(double v, int precision, char* buf) {
+        if (precision > MAX_PRECISION) {
+            precision = MAX_PRECISION;
+        }
+        const int length = precision < 0 ? snprintf(buf, BUFFER_SIZE, "%f", v) : snprintf(buf, BUFFER_SIZE, "%.*f", precision, v);
+        return length < BUFFER_SIZE ? (unsigned int)length : BUFFER_SIZE - 1;
+    }
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -0,0 +1,438 @@
+/****************************************************************************/
+/// @file    PackedRTree.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// A bulk loaded R-tree stored in contiguous arrays
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2008-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef PackedRTree_h
+#define PackedRTree_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class PackedRTree
+ * @brief A bulk loaded R-tree stored in contiguous arrays
+ *
+ * The tree is packed using Sort-Tile-Recursive: the entries are sorted by
+ *  the x-coordinate of their centers, cut into vertical slices, sorted by
+ *  the y-coordinate within each slice and grouped into leaves of
+ *  nodeCapacity entries; the upper levels are built the same way from
+ *  the nodes below. All entries and all nodes are kept in one array each
+ *  (leaves first, the root last), so a search walks contiguous memory.
+ *
+ * For moving objects, the tree may be used incrementally: inserted
+ *  entries are collected in an unpacked buffer which is scanned linearly,
+ *  removed entries are only marked. Once the buffer or the number of
+ *  removed entries grows too large compared to the packed entries, the
+ *  whole tree is packed again. pack() may also be called explicitly after
+ *  loading, so that all entries are found using the tree.
+ *
+ * T is the stored data (usually a pointer or an index); it must be
+ *  comparable using == for removal.
+ */
+template<class T>
+class PackedRTree {
+public:
+    /// @brief An axis aligned rectangle
+    struct Box {
+        float min[2];
+        float max[2];
+
+        /// @brief Returns whether the rectangles overlap (touching counts)
+        bool overlaps(const Box& other) const {
+            return min[0] <= other.max[0] && other.min[0] <= max[0]
+                   && min[1] <= other.max[1] && other.min[1] <= max[1];
+        }
+
+        /// @brief Extends the rectangle to include the other one
+        void add(const Box& other) {
+            min[0] = std::min(min[0], other.min[0]);
+            min[1] = std::min(min[1], other.min[1]);
+            max[0] = std::max(max[0], other.max[0]);
+            max[1] = std::max(max[1], other.max[1]);
+        }
+
+        /// @brief Returns the squared distance between the point and the rectangle (0 if inside)
+        float distance2(float x, float y) const {
+            const float dx = x < min[0] ? min[0] - x : (x > max[0] ? x - max[0] : 0.f);
+            const float dy = y < min[1] ? min[1] - y : (y > max[1] ? y - max[1] : 0.f);
+            return dx * dx + dy * dy;
+        }
+
+        /// @brief Returns the center in the given dimension
+        float center(int dim) const {
+            return (min[dim] + max[dim]) * .5f;
+        }
+    };
+
+
+public:
+    /** @brief Constructor
+     * @param[in] nodeCapacity The number of entries per node (clipped to [2, 32])
+     */
+    PackedRTree(unsigned int nodeCapacity = 16)
+        : myNodeCapacity(std::max(2u, std::min(32u, nodeCapacity))),
+          myPackedSize(0), myLeafNodes(0), myRemoved(0) {}
+
+
+    /// @brief Destructor
+    ~PackedRTree() {}
+
+
+    /** @brief Adds an entry
+     *
+     * The entry is kept in the unpacked buffer until the next packing.
+     *
+     * @param[in] min The minimum corner of the entry's bounding box
+     * @param[in] max The maximum corner of the entry's bounding box
+     * @param[in] data The data to store
+     */
+    void insert(const float min[2], const float max[2], const T& data) {
+        Entry e;
+        e.box.min[0] = min[0];
+        e.box.min[1] = min[1];
+        e.box.max[0] = max[0];
+        e.box.max[1] = max[1];
+        e.data = data;
+        e.removed = false;
+        myEntries.push_back(e);
+        if (myEntries.size() - myPackedSize > std::max((size_t)MIN_BUFFER, (size_t)myPackedSize / 8)) {
+            pack();
+        }
+    }
+
+
+    /** @brief Removes an entry
+     * @param[in] min The minimum corner of the bounding box the entry was inserted with
+     * @param[in] max The maximum corner of the bounding box the entry was inserted with
+     * @param[in] data The stored data
+     * @return Whether the entry was found
+     */
+    bool remove(const float min[2], const float max[2], const T& data) {
+        Box box;
+        box.min[0] = min[0];
+        box.min[1] = min[1];
+        box.max[0] = max[0];
+        box.max[1] = max[1];
+        RemovingVisitor visitor(data);
+        searchPacked(box, visitor);
+        if (visitor.entry == 0) {
+            for (size_t i = myPackedSize; i < myEntries.size(); ++i) {
+                if (myEntries[i].data == data && myEntries[i].box.overlaps(box)) {
+                    myEntries[i] = myEntries.back();
+                    myEntries.pop_back();
+                    return true;
+                }
+            }
+            return false;
+        }
+        visitor.entry->removed = true;
+        myRemoved++;
+        if (myRemoved > std::max((size_t)MIN_BUFFER, (size_t)myPackedSize / 4)) {
+            pack();
+        }
+        return true;
+    }
+
+
+    /// @brief Removes all entries
+    void clear() {
+        myEntries.clear();
+        myNodes.clear();
+        myPackedSize = 0;
+        myLeafNodes = 0;
+        myRemoved = 0;
+    }
+
+
+    /// @brief Returns the number of stored entries
+    size_t size() const {
+        return myEntries.size() - myRemoved;
+    }
+
+
+    /** @brief Calls the visitor for all entries overlapping the rectangle
+     * @param[in] min The minimum corner of the search rectangle
+     * @param[in] max The maximum corner of the search rectangle
+     * @param[in] visitor A function object called with the data of each entry found
+     * @return The number of entries found
+     */
+    template<class Visitor>
+    unsigned int search(const float min[2], const float max[2], Visitor& visitor) const {
+        Box box;
+        box.min[0] = min[0];
+        box.min[1] = min[1];
+        box.max[0] = max[0];
+        box.max[1] = max[1];
+        DataVisitor<Visitor> dataVisitor(visitor);
+        searchAll(box, dataVisitor);
+        return dataVisitor.found;
+    }
+
+
+    /** @brief Calls the visitor for all entries whose bounding box is within the distance of the point
+     * @param[in] x The x-coordinate of the point
+     * @param[in] y The y-coordinate of the point
+     * @param[in] radius The maximum distance between the point and an entry's bounding box
+     * @param[in] visitor A function object called with the data of each entry found
+     * @return The number of entries found
+     */
+    template<class Visitor>
+    unsigned int searchWithin(float x, float y, float radius, Visitor& visitor) const {
+        Box box;
+        box.min[0] = x - radius;
+        box.min[1] = y - radius;
+        box.max[0] = x + radius;
+        box.max[1] = y + radius;
+        DistanceVisitor<Visitor> distanceVisitor(x, y, radius * radius, visitor);
+        searchAll(box, distanceVisitor);
+        return distanceVisitor.found;
+    }
+
+
+    /// @brief Packs all entries into the tree, dropping removed ones
+    void pack() {
+        size_t kept = 0;
+        for (size_t i = 0; i < myEntries.size(); ++i) {
+            if (!myEntries[i].removed) {
+                myEntries[kept++] = myEntries[i];
+            }
+        }
+        myEntries.resize(kept);
+        myRemoved = 0;
+        myNodes.clear();
+        myPackedSize = myEntries.size();
+        myLeafNodes = 0;
+        if (myEntries.empty()) {
+            return;
+        }
+        sortTiles(myEntries, 0, myEntries.size());
+        for (size_t i = 0; i < myEntries.size(); i += myNodeCapacity) {
+            addNode(myEntries, i, std::min(myEntries.size(), i + myNodeCapacity));
+        }
+        myLeafNodes = myNodes.size();
+        size_t levelBegin = 0;
+        while (myNodes.size() - levelBegin > 1) {
+            const size_t levelEnd = myNodes.size();
+            sortTiles(myNodes, levelBegin, levelEnd);
+            for (size_t i = levelBegin; i < levelEnd; i += myNodeCapacity) {
+                addNode(myNodes, i, std::min(levelEnd, i + myNodeCapacity));
+            }
+            levelBegin = levelEnd;
+        }
+    }
+
+
+private:
+    /// @brief A stored entry
+    struct Entry {
+        /// @brief The bounding box
+        Box box;
+        /// @brief The stored data
+        T data;
+        /// @brief Whether the entry was removed after packing
+        bool removed;
+    };
+
+    /// @brief A node of the tree
+    struct Node {
+        /// @brief The bounding box of the children
+        Box box;
+        /// @brief The index of the first child (an entry for leaves, a node otherwise)
+        unsigned int first;
+        /// @brief The number of children
+        unsigned int count;
+    };
+
+    /// @brief Compares items by the center of their bounding boxes in one dimension
+    template<class Item>
+    struct CenterLess {
+        CenterLess(int dim) : myDim(dim) {}
+        bool operator()(const Item& a, const Item& b) const {
+            return a.box.center(myDim) < b.box.center(myDim);
+        }
+        int myDim;
+    };
+
+    /// @brief Counts the entries found and hands their data to the visitor
+    template<class Visitor>
+    struct DataVisitor {
+        DataVisitor(Visitor& visitor) : myVisitor(visitor), found(0) {}
+        void operator()(const Entry& e) {
+            myVisitor(e.data);
+            found++;
+        }
+        Visitor& myVisitor;
+        unsigned int found;
+    };
+
+    /// @brief Filters the found data by the distance of their bounding box
+    template<class Visitor>
+    struct DistanceVisitor {
+        DistanceVisitor(float x, float y, float radius2, Visitor& visitor)
+            : myX(x), myY(y), myRadius2(radius2), myVisitor(visitor), found(0) {}
+        void operator()(const Entry& e) {
+            if (e.box.distance2(myX, myY) <= myRadius2) {
+                myVisitor(e.data);
+                found++;
+            }
+        }
+        float myX, myY, myRadius2;
+        Visitor& myVisitor;
+        unsigned int found;
+    };
+
+    /// @brief Remembers the first packed entry holding the data
+    struct RemovingVisitor {
+        RemovingVisitor(const T& data) : myData(data), entry(0) {}
+        void operator()(const Entry& e) {
+            if (entry == 0 && e.data == myData) {
+                entry = const_cast<Entry*>(&e);
+            }
+        }
+        const T& myData;
+        Entry* entry;
+    };
+
+
+    /// @brief Calls the visitor for all entries overlapping the box
+    template<class Visitor>
+    void searchAll(const Box& box, Visitor& visitor) const {
+        searchPacked(box, visitor);
+        for (size_t i = myPackedSize; i < myEntries.size(); ++i) {
+            if (myEntries[i].box.overlaps(box)) {
+                visitor(myEntries[i]);
+            }
+        }
+    }
+
+
+    /// @brief Calls the visitor for all packed, not removed entries overlapping the box
+    template<class Visitor>
+    void searchPacked(const Box& box, Visitor& visitor) const {
+        if (myNodes.empty() || !myNodes.back().box.overlaps(box)) {
+            return;
+        }
+        // the pending nodes; at most (capacity - 1) per level plus one
+        unsigned int stack[MAX_STACK];
+        unsigned int top = 0;
+        stack[top++] = (unsigned int)myNodes.size() - 1;
+        while (top > 0) {
+            const unsigned int index = stack[--top];
+            const Node& node = myNodes[index];
+            const unsigned int end = node.first + node.count;
+            if (index < myLeafNodes) {
+                for (unsigned int i = node.first; i < end; ++i) {
+                    const Entry& e = myEntries[i];
+                    if (!e.removed && e.box.overlaps(box)) {
+                        visitor(e);
+                    }
+                }
+            } else {
+                for (unsigned int i = node.first; i < end; ++i) {
+                    if (myNodes[i].box.overlaps(box)) {
+                        stack[top++] = i;
+                    }
+                }
+            }
+        }
+    }
+
+
+    /// @brief Sorts the items in [begin, end) into tiles of nodeCapacity items
+    template<class Item>
+    void sortTiles(std::vector<Item>& items, size_t begin, size_t end) const {
+        const size_t n = end - begin;
+        const size_t leaves = (n + myNodeCapacity - 1) / myNodeCapacity;
+        const size_t slices = (size_t)std::ceil(std::sqrt((double)leaves));
+        const size_t sliceSize = slices * myNodeCapacity;
+        typename std::vector<Item>::iterator first = items.begin() + begin;
+        std::sort(first, first + n, CenterLess<Item>(0));
+        for (size_t i = 0; i < n; i += sliceSize) {
+            std::sort(first + i, first + std::min(n, i + sliceSize), CenterLess<Item>(1));
+        }
+    }
+
+
+    /// @brief Adds a node spanning the items in [begin, end)
+    template<class Item>
+    void addNode(const std::vector<Item>& items, size_t begin, size_t end) {
+        Node node;
+        node.box = items[begin].box;
+        for (size_t i = begin + 1; i < end; ++i) {
+            node.box.add(items[i].box);
+        }
+        node.first = (unsigned int)begin;
+        node.count = (unsigned int)(end - begin);
+        myNodes.push_back(node);
+    }
+
+
+private:
+    /// @brief The minimum number of buffered or removed entries before packing again
+    static const unsigned int MIN_BUFFER = 64;
+
+    /// @brief The size of the search stack (sufficient for 32 entries per node and 2^32 entries)
+    static const unsigned int MAX_STACK = 256;
+
+    /// @brief The number of entries per node
+    const unsigned int myNodeCapacity;
+
+    /// @brief The entries, the packed ones (in leaf order) first, the unpacked buffer behind
+    std::vector<Entry> myEntries;
+
+    /// @brief The nodes, leaves first, the root last
+    std::vector<Node> myNodes;
+
+    /// @brief The number of packed entries
+    size_t myPackedSize;
+
+    /// @brief The number of leaf nodes
+    size_t myLeafNodes;
+
+    /// @brief The number of packed entries marked as removed
+    size_t myRemoved;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    PackedRTree(const PackedRTree&);
+
+    /// @brief Invalidated assignment operator.
+    PackedRTree& operator=(const PackedRTree&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
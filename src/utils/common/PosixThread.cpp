@@ -0,0 +1,149 @@
+/****************************************************************************/
+/// @file    PosixThread.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Thin wrappers around POSIX threads, mutexes and condition variables
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2001-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <cerrno>
+#include <sys/time.h>
+#include "UtilExceptions.h"
+#include "PosixThread.h"
+
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif // CHECK_MEMORY_LEAKS
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+// ---------------------------------------------------------------------------
+// PosixMutex - methods
+// ---------------------------------------------------------------------------
+PosixMutex::PosixMutex() {
+    pthread_mutex_init(&myMutex, 0);
+}
+
+
+PosixMutex::~PosixMutex() {
+    pthread_mutex_destroy(&myMutex);
+}
+
+
+void
+PosixMutex::lock() {
+    pthread_mutex_lock(&myMutex);
+}
+
+
+void
+PosixMutex::unlock() {
+    pthread_mutex_unlock(&myMutex);
+}
+
+
+// ---------------------------------------------------------------------------
+// PosixCondition - methods
+// ---------------------------------------------------------------------------
+PosixCondition::PosixCondition() {
+    pthread_cond_init(&myCondition, 0);
+}
+
+
+PosixCondition::~PosixCondition() {
+    pthread_cond_destroy(&myCondition);
+}
+
+
+void
+PosixCondition::wait(PosixMutex& mutex) {
+    pthread_cond_wait(&myCondition, &mutex.myMutex);
+}
+
+
+bool
+PosixCondition::wait(PosixMutex& mutex, unsigned int milliseconds) {
+    struct timeval now;
+    gettimeofday(&now, 0);
+    struct timespec until;
+    const long nanos = (now.tv_usec + (long)(milliseconds % 1000) * 1000) * 1000;
+    until.tv_sec = now.tv_sec + (time_t)(milliseconds / 1000) + nanos / 1000000000;
+    until.tv_nsec = nanos % 1000000000;
+    return pthread_cond_timedwait(&myCondition, &mutex.myMutex, &until) != ETIMEDOUT;
+}
+
+
+void
+PosixCondition::signal() {
+    pthread_cond_signal(&myCondition);
+}
+
+
+void
+PosixCondition::broadcast() {
+    pthread_cond_broadcast(&myCondition);
+}
+
+
+// ---------------------------------------------------------------------------
+// PosixThread - methods
+// ---------------------------------------------------------------------------
+PosixThread::PosixThread() : myAmRunning(false) {}
+
+
+PosixThread::~PosixThread() {}
+
+
+void
+PosixThread::start() {
+    if (myAmRunning) {
+        return;
+    }
+    if (pthread_create(&myThread, 0, &PosixThread::threadMain, this) != 0) {
+        throw ProcessError("Could not create thread.");
+    }
+    myAmRunning = true;
+}
+
+
+void
+PosixThread::join() {
+    if (myAmRunning) {
+        pthread_join(myThread, 0);
+        myAmRunning = false;
+    }
+}
+
+
+void*
+PosixThread::threadMain(void* thread) {
+    static_cast<PosixThread*>(thread)->run();
+    return 0;
+}
+
+
+/****************************************************************************/
+
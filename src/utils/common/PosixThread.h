@@ -0,0 +1,198 @@
+/****************************************************************************/
+/// @file    PosixThread.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Thin wrappers around POSIX threads, mutexes and condition variables
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2001-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef PosixThread_h
+#define PosixThread_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <pthread.h>
+#include "AbstractMutex.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class PosixMutex
+ * @brief An AbstractMutex backed by a pthread mutex
+ *
+ * This is the mutex to use within the command line clients when a
+ *  synchronized access from several threads is needed (e.g. for
+ *  MsgHandler::assignLock).
+ */
+class PosixMutex : public AbstractMutex {
+public:
+    /// @brief Constructor
+    PosixMutex();
+
+
+    /// @brief Destructor
+    ~PosixMutex();
+
+
+    /// @brief Locks the mutex
+    void lock();
+
+
+    /// @brief Unlocks the mutex
+    void unlock();
+
+
+private:
+    /// @brief The wrapped mutex
+    pthread_mutex_t myMutex;
+
+    /// @brief PosixCondition waits on the raw mutex
+    friend class PosixCondition;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    PosixMutex(const PosixMutex&);
+
+    /// @brief Invalidated assignment operator.
+    PosixMutex& operator=(const PosixMutex&);
+
+};
+
+
+/**
+ * @class PosixCondition
+ * @brief A condition variable to be used together with a PosixMutex
+ */
+class PosixCondition {
+public:
+    /// @brief Constructor
+    PosixCondition();
+
+
+    /// @brief Destructor
+    ~PosixCondition();
+
+
+    /** @brief Waits for a signal
+     * @param[in] mutex The mutex which is locked by the caller; it is released while waiting
+     */
+    void wait(PosixMutex& mutex);
+
+
+    /** @brief Waits for a signal or until the given time has elapsed
+     * @param[in] mutex The mutex which is locked by the caller; it is released while waiting
+     * @param[in] milliseconds The maximum time to wait
+     * @return Whether a signal was received (false on timeout)
+     */
+    bool wait(PosixMutex& mutex, unsigned int milliseconds);
+
+
+    /// @brief Wakes up one waiting thread
+    void signal();
+
+
+    /// @brief Wakes up all waiting threads
+    void broadcast();
+
+
+private:
+    /// @brief The wrapped condition variable
+    pthread_cond_t myCondition;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    PosixCondition(const PosixCondition&);
+
+    /// @brief Invalidated assignment operator.
+    PosixCondition& operator=(const PosixCondition&);
+
+};
+
+
+/**
+ * @class PosixThread
+ * @brief Base class for objects running their own thread
+ *
+ * Subclasses implement run(); the thread is started explicitly using
+ *  start() and must be joined before the object is destroyed.
+ */
+class PosixThread {
+public:
+    /// @brief Constructor
+    PosixThread();
+
+
+    /// @brief Destructor
+    virtual ~PosixThread();
+
+
+    /** @brief Starts the thread which executes run()
+     * @exception ProcessError If the thread could not be created
+     */
+    void start();
+
+
+    /// @brief Waits until run() has returned
+    void join();
+
+
+    /// @brief Returns whether the thread was started and not yet joined
+    bool isRunning() const {
+        return myAmRunning;
+    }
+
+
+protected:
+    /// @brief The method executed within the thread
+    virtual void run() = 0;
+
+
+private:
+    /// @brief The entry point handed to pthread_create
+    static void* threadMain(void* thread);
+
+
+private:
+    /// @brief The thread handle
+    pthread_t myThread;
+
+    /// @brief Whether the thread is running
+    bool myAmRunning;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    PosixThread(const PosixThread&);
+
+    /// @brief Invalidated assignment operator.
+    PosixThread& operator=(const PosixThread&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -0,0 +1,245 @@
+/****************************************************************************/
+/// @file    SPSCQueue.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// A bounded lock-free queue for exactly one producer and one consumer thread
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2001-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef SPSCQueue_h
+#define SPSCQueue_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#include <intrin.h>
+#else
+#include <config.h>
+#endif
+
+#include <vector>
+#include "PosixThread.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class SPSCQueue
+ * @brief A bounded lock-free queue for exactly one producer and one consumer thread
+ *
+ * The entries are stored in a ring buffer; the producer only writes the tail
+ *  index and the consumer only writes the head index, so neither push nor pop
+ *  take a lock as long as the queue is neither full nor empty. Only then
+ *  the waiting thread sleeps on a condition; the flags telling the other side
+ *  to signal it are checked after each successful operation, so an idle
+ *  consumer does not cost the producer a lock per entry. Waits are bounded
+ *  to survive a missed signal.
+ *
+ * T must be cheap to copy (usually a pointer).
+ */
+template<class T>
+class SPSCQueue {
+public:
+    /** @brief Constructor
+     * @param[in] capacity The maximum number of entries held
+     */
+    explicit SPSCQueue(unsigned int capacity)
+        : myEntries(capacity + 1), myHead(0), myTail(0),
+          myConsumerWaiting(false), myProducerWaiting(false), myAmClosed(false) {}
+
+
+    /// @brief Destructor
+    ~SPSCQueue() {}
+
+
+    /** @brief Appends the value if the queue is not full (producer only)
+     * @return Whether the value was appended
+     */
+    bool tryPush(const T& value) {
+        const unsigned int tail = myTail;
+        const unsigned int next = advance(tail);
+        if (next == myHead) {
+            return false;
+        }
+        myEntries[tail] = value;
+        // the entry must be visible before the new tail
+        barrier();
+        myTail = next;
+        barrier();
+        if (myConsumerWaiting) {
+            wake();
+        }
+        return true;
+    }
+
+
+    /** @brief Removes the first value if the queue is not empty (consumer only)
+     * @return Whether a value was removed
+     */
+    bool tryPop(T& value) {
+        const unsigned int head = myHead;
+        if (head == myTail) {
+            return false;
+        }
+        barrier();
+        value = myEntries[head];
+        barrier();
+        myHead = advance(head);
+        barrier();
+        if (myProducerWaiting) {
+            wake();
+        }
+        return true;
+    }
+
+
+    /** @brief Appends the value, waiting while the queue is full (producer only)
+     * @return Whether the value was appended (false if the queue was closed)
+     */
+    bool push(const T& value) {
+        while (!tryPush(value)) {
+            myMutex.lock();
+            myProducerWaiting = true;
+            barrier();
+            if (!myAmClosed && advance(myTail) == myHead) {
+                myCondition.wait(myMutex, 10);
+            }
+            myProducerWaiting = false;
+            const bool closed = myAmClosed;
+            myMutex.unlock();
+            if (closed) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+
+    /** @brief Removes the first value, waiting while the queue is empty (consumer only)
+     * @return Whether a value was removed (false if the queue is closed and empty)
+     */
+    bool pop(T& value) {
+        while (!tryPop(value)) {
+            myMutex.lock();
+            myConsumerWaiting = true;
+            barrier();
+            const bool closed = myAmClosed;
+            if (!closed && myHead == myTail) {
+                myCondition.wait(myMutex, 10);
+            }
+            myConsumerWaiting = false;
+            myMutex.unlock();
+            if (closed) {
+                // entries pushed before closing are still delivered
+                return tryPop(value);
+            }
+        }
+        return true;
+    }
+
+
+    /** @brief Marks the queue as closed and wakes all waiting threads
+     *
+     * A closed queue accepts no further blocking pushes; pop returns the
+     *  remaining entries and fails afterwards.
+     */
+    void close() {
+        myMutex.lock();
+        myAmClosed = true;
+        myCondition.broadcast();
+        myMutex.unlock();
+    }
+
+
+    /// @brief Returns whether the queue was closed
+    bool isClosed() const {
+        return myAmClosed;
+    }
+
+
+    /// @brief Returns whether the queue holds no entries (exact only for the consumer)
+    bool empty() const {
+        return myHead == myTail;
+    }
+
+
+private:
+    /// @brief Returns the ring position following the given one
+    unsigned int advance(unsigned int pos) const {
+        return pos + 1 == (unsigned int)myEntries.size() ? 0 : pos + 1;
+    }
+
+
+    /// @brief Wakes the thread waiting on the other side
+    void wake() {
+        myMutex.lock();
+        myCondition.broadcast();
+        myMutex.unlock();
+    }
+
+
+    /// @brief A full memory barrier for the compiler and the processor
+    static void barrier() {
+#ifdef _MSC_VER
+        _ReadWriteBarrier();
+        _mm_mfence();
+#else
+        __sync_synchronize();
+#endif
+    }
+
+
+private:
+    /// @brief The ring buffer (one slot stays empty to tell full from empty)
+    std::vector<T> myEntries;
+
+    /// @brief The position of the first entry, written by the consumer only
+    volatile unsigned int myHead;
+
+    /// @brief The position behind the last entry, written by the producer only
+    volatile unsigned int myTail;
+
+    /// @brief Whether the consumer sleeps on the condition
+    volatile bool myConsumerWaiting;
+
+    /// @brief Whether the producer sleeps on the condition
+    volatile bool myProducerWaiting;
+
+    /// @brief Whether the queue was closed
+    volatile bool myAmClosed;
+
+    /// @brief The lock guarding the condition
+    PosixMutex myMutex;
+
+    /// @brief The condition sleeping threads wait on
+    PosixCondition myCondition;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    SPSCQueue(const SPSCQueue&);
+
+    /// @brief Invalidated assignment operator.
+    SPSCQueue& operator=(const SPSCQueue&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
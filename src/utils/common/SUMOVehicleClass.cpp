@@ -37,7 +37,7 @@
 #include <utils/common/TplConvert.h>
 #include <utils/common/ToString.h>
 #include <utils/common/MsgHandler.h>
-#include <utils/common/StringTokenizer.h>
+#include <utils/common/StringRefTokenizer.h>
 
 
 #ifdef CHECK_MEMORY_LEAKS
@@ -216,13 +216,15 @@ parseVehicleClasses(const std::string& allowedS) {
         return SVCAll;
     }
     SVCPermissions result = 0;
-    StringTokenizer sta(allowedS, " ");
-    while (sta.hasNext()) {
-        const std::string s = sta.next();
-        const SUMOVehicleClass vc = getVehicleClassID(s);
-        const std::string& realName = SumoVehicleClassStrings.getString(vc);
-        if (realName != s) {
-            deprecatedVehicleClassesSeen.insert(s);
+    StringRefTokenizer sta(allowedS, ' ');
+    StringRef s;
+    while (sta.next(s)) {
+        SUMOVehicleClass vc;
+        if (!SumoVehicleClassStrings.get(s, vc)) {
+            throw InvalidArgument("Unknown vehicle class '" + s.str() + "'.");
+        }
+        if (StringRef(SumoVehicleClassStrings.getString(vc)) != s) {
+            deprecatedVehicleClassesSeen.insert(s.str());
         }
         result |= vc;
     }
@@ -235,9 +237,10 @@ canParseVehicleClasses(const std::string& classes) {
     if (classes == "all") {
         return true;
     }
-    StringTokenizer sta(classes, " ");
-    while (sta.hasNext()) {
-        if (!SumoVehicleClassStrings.hasString(sta.next())) {
+    StringRefTokenizer sta(classes, ' ');
+    StringRef s;
+    while (sta.next(s)) {
+        if (!SumoVehicleClassStrings.hasString(s)) {
             return false;
         }
     }
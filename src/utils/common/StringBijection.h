@@ -36,6 +36,9 @@
 #include <map>
 #include <vector>
 #include <string>
+#include <algorithm>
+#include <functional>
+#include <utils/common/StringRef.h>
 #include <utils/common/UtilExceptions.h>
 
 // ===========================================================================
@@ -46,6 +49,13 @@
  * It is not always a bijection since it allows for duplicate entries on both sides if either
  * checkDuplicates is set to false in the constructor or the insert function or if
  * the addAlias function is used.
+ *
+ * A bijection may be frozen once it is complete (the constructor taking an
+ * entry table does this). Frozen lookups use a minimal perfect hash
+ * (hash and displace) over all strings and a dense array from key to string,
+ * so they neither compare strings along a tree path nor allocate. Any
+ * modification thaws the bijection, it falls back to the maps until frozen
+ * again. T has to be an integral or enumeration type.
  */
 
 template< class T  >
@@ -66,14 +76,37 @@ public:
 #endif
 
 
-    StringBijection() {}
+    StringBijection() : myMinKey(0) {}
 
 
-    StringBijection(Entry entries[], T terminatorKey, bool checkDuplicates = true) {
+    StringBijection(Entry entries[], T terminatorKey, bool checkDuplicates = true) : myMinKey(0) {
         int i = 0;
         do {
             insert(entries[i].str, entries[i].key, checkDuplicates);
         } while (entries[i++].key != terminatorKey);
+        freeze();
+    }
+
+
+    StringBijection(const StringBijection& other)
+        : myString2T(other.myString2T), myT2String(other.myT2String), myMinKey(0) {
+        // the frozen tables point into the maps
+        if (other.isFrozen()) {
+            freeze();
+        }
+    }
+
+
+    StringBijection& operator=(const StringBijection& other) {
+        if (this != &other) {
+            myString2T = other.myString2T;
+            myT2String = other.myT2String;
+            thaw();
+            if (other.isFrozen()) {
+                freeze();
+            }
+        }
+        return *this;
     }
 
 
@@ -87,34 +120,45 @@ public:
                 throw InvalidArgument("Duplicate string '" + str + "'.");
             }
         }
+        thaw();
         myString2T[str] = key;
         myT2String[key] = str;
     }
 
 
     void addAlias(const std::string str, const T key) {
+        thaw();
         myString2T[str] = key;
     }
 
 
     void remove(const std::string str, const T key) {
+        thaw();
         myString2T.erase(str);
         myT2String.erase(key);
     }
 
 
-    T get(const std::string& str) const {
-        if (hasString(str)) {
-            return myString2T.find(str)->second;
+    T get(const StringRef& str) const {
+        T key = T();
+        if (lookup(str, key)) {
+            return key;
         } else {
-            throw InvalidArgument("String '" + str + "' not found.");
+            throw InvalidArgument("String '" + str.str() + "' not found.");
         }
     }
 
 
+    /// @brief Stores the key of the string in the given variable if known, returns whether it was
+    bool get(const StringRef& str, T& key) const {
+        return lookup(str, key);
+    }
+
+
     const std::string& getString(const T key) const {
-        if (has(key)) {
-            return myT2String.find(key)->second;
+        const std::string* const str = lookupString(key);
+        if (str != 0) {
+            return *str;
         } else {
             // cannot use toString(key) because that might create an infinite loop
             throw InvalidArgument("Key not found.");
@@ -122,13 +166,14 @@ public:
     }
 
 
-    bool hasString(const std::string& str) const {
-        return myString2T.count(str) != 0;
+    bool hasString(const StringRef& str) const {
+        T key = T();
+        return lookup(str, key);
     }
 
 
     bool has(const T key) const {
-        return myT2String.count(key) != 0;
+        return lookupString(key) != 0;
     }
 
 
@@ -155,9 +200,170 @@ public:
     }
 
 
+    /** @brief Builds the perfect hash and the dense key array
+     *
+     * If no perfect hash is found (colliding hashes), the bijection stays
+     *  unfrozen and keeps using the maps.
+     */
+    void freeze() {
+        thaw();
+        const unsigned int n = (unsigned int)myString2T.size();
+        if (n == 0) {
+            return;
+        }
+        // distribute the strings into buckets, place the largest buckets first
+        const unsigned int numBuckets = n / 2 + 1;
+        std::vector<std::vector<std::pair<unsigned int, const StringEntry*> > > buckets(numBuckets);
+        for (typename String2T::const_iterator i = myString2T.begin(); i != myString2T.end(); ++i) {
+            const unsigned long long h = hash(StringRef(i->first));
+            buckets[(unsigned int)(h >> 32) % numBuckets].push_back(std::make_pair((unsigned int)h, &*i));
+        }
+        std::vector<std::pair<size_t, unsigned int> > order;
+        for (unsigned int b = 0; b < numBuckets; ++b) {
+            order.push_back(std::make_pair(buckets[b].size(), b));
+        }
+        std::sort(order.begin(), order.end(), std::greater<std::pair<size_t, unsigned int> >());
+        // find a displacement per bucket which maps its strings to free slots
+        std::vector<const StringEntry*> slots(n, (const StringEntry*)0);
+        std::vector<unsigned int> displacements(numBuckets, 0);
+        std::vector<unsigned int> placed;
+        for (unsigned int o = 0; o < numBuckets && order[o].first > 0; ++o) {
+            const std::vector<std::pair<unsigned int, const StringEntry*> >& bucket = buckets[order[o].second];
+            unsigned int d = 0;
+            for (; d < MAX_DISPLACEMENT; ++d) {
+                placed.clear();
+                for (unsigned int j = 0; j < bucket.size(); ++j) {
+                    const unsigned int slot = mix(bucket[j].first ^ d) % n;
+                    if (slots[slot] != 0) {
+                        break;
+                    }
+                    slots[slot] = bucket[j].second;
+                    placed.push_back(slot);
+                }
+                if (placed.size() == bucket.size()) {
+                    break;
+                }
+                for (unsigned int j = 0; j < placed.size(); ++j) {
+                    slots[placed[j]] = 0;
+                }
+            }
+            if (d == MAX_DISPLACEMENT) {
+                return;
+            }
+            displacements[order[o].second] = d;
+        }
+        // the dense array if the keys are not too sparse
+        if (!myT2String.empty()) {
+            const long long minKey = static_cast<int>(myT2String.begin()->first);
+            const long long maxKey = static_cast<int>(myT2String.rbegin()->first);
+            if (maxKey - minKey < 4 * (long long)myT2String.size() + 64) {
+                myMinKey = (int)minKey;
+                myKeyStrings.resize((size_t)(maxKey - minKey + 1), (const std::string*)0);
+                for (typename T2String::const_iterator i = myT2String.begin(); i != myT2String.end(); ++i) {
+                    myKeyStrings[(size_t)(static_cast<int>(i->first) - minKey)] = &i->second;
+                }
+            }
+        }
+        mySlots.swap(slots);
+        myDisplacements.swap(displacements);
+    }
+
+
+    /// @brief Returns whether the bijection is frozen
+    bool isFrozen() const {
+        return !mySlots.empty();
+    }
+
+
 private:
-    std::map<std::string, T> myString2T;
-    std::map<T, std::string> myT2String;
+    typedef std::map<std::string, T> String2T;
+    typedef std::map<T, std::string> T2String;
+    typedef typename String2T::value_type StringEntry;
+
+    /// @brief The number of displacements to try per bucket before giving up
+    static const unsigned int MAX_DISPLACEMENT = 1 << 20;
+
+
+    /// @brief Drops the frozen tables
+    void thaw() {
+        mySlots.clear();
+        myDisplacements.clear();
+        myKeyStrings.clear();
+    }
+
+
+    /// @brief Looks up the key of the string
+    bool lookup(const StringRef& str, T& key) const {
+        if (!mySlots.empty()) {
+            const unsigned long long h = hash(str);
+            const unsigned int d = myDisplacements[(unsigned int)(h >> 32) % myDisplacements.size()];
+            const StringEntry* const entry = mySlots[mix((unsigned int)h ^ d) % mySlots.size()];
+            if (StringRef(entry->first) != str) {
+                return false;
+            }
+            key = entry->second;
+            return true;
+        }
+        typename String2T::const_iterator i = myString2T.find(str.str());
+        if (i == myString2T.end()) {
+            return false;
+        }
+        key = i->second;
+        return true;
+    }
+
+
+    /// @brief Returns the string of the key or 0 if the key is not known
+    const std::string* lookupString(const T key) const {
+        if (!myKeyStrings.empty()) {
+            const long long index = (long long)static_cast<int>(key) - myMinKey;
+            if (index < 0 || index >= (long long)myKeyStrings.size()) {
+                return 0;
+            }
+            return myKeyStrings[(size_t)index];
+        }
+        typename T2String::const_iterator i = myT2String.find(key);
+        return i == myT2String.end() ? 0 : &i->second;
+    }
+
+
+    /// @brief The 64bit FNV-1a hash, the upper half selects the bucket
+    static unsigned long long hash(const StringRef& str) {
+        unsigned long long h = 14695981039346656037ULL;
+        for (unsigned int i = 0; i < str.size(); ++i) {
+            h ^= (unsigned char)str[i];
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+
+    /// @brief Mixes the displaced lower hash half (murmur3 finalizer)
+    static unsigned int mix(unsigned int h) {
+        h ^= h >> 16;
+        h *= 0x85ebca6bu;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35u;
+        h ^= h >> 16;
+        return h;
+    }
+
+
+private:
+    String2T myString2T;
+    T2String myT2String;
+
+    /// @brief The strings by perfect hash slot (empty if not frozen)
+    std::vector<const StringEntry*> mySlots;
+
+    /// @brief The displacement per bucket
+    std::vector<unsigned int> myDisplacements;
+
+    /// @brief The strings by key minus myMinKey (empty if not frozen or the keys are too sparse)
+    std::vector<const std::string*> myKeyStrings;
+
+    /// @brief The smallest key
+    int myMinKey;
 
 };
 
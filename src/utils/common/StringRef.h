@@ -0,0 +1,175 @@
+/****************************************************************************/
+/// @file    StringRef.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// A non-owning reference to a sequence of characters
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2001-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef StringRef_h
+#define StringRef_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <string>
+#include <cstring>
+#include <ostream>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class StringRef
+ * @brief A non-owning reference to a sequence of characters
+ *
+ * A StringRef is a (pointer, length) pair pointing into memory owned by
+ *  somebody else (a mapped file, a std::string, a parse buffer). It is
+ *  meant for hot paths where copying into a std::string for every lookup
+ *  or token would dominate. The referenced memory must outlive the
+ *  StringRef; the sequence is not necessarily 0-terminated.
+ */
+class StringRef {
+public:
+    /// @brief Constructor for an empty reference
+    StringRef() : myData(""), mySize(0) {}
+
+
+    /// @brief Constructor referencing a 0-terminated character array
+    StringRef(const char* data) : myData(data), mySize(data == 0 ? 0 : (unsigned int)strlen(data)) {
+        if (myData == 0) {
+            myData = "";
+        }
+    }
+
+
+    /// @brief Constructor referencing the given number of characters
+    StringRef(const char* data, unsigned int size) : myData(data), mySize(size) {}
+
+
+    /// @brief Constructor referencing the content of a string (which must outlive this reference)
+    StringRef(const std::string& s) : myData(s.data()), mySize((unsigned int)s.size()) {}
+
+
+    /// @brief Returns the pointer to the first character
+    const char* data() const {
+        return myData;
+    }
+
+
+    /// @brief Returns the number of referenced characters
+    unsigned int size() const {
+        return mySize;
+    }
+
+
+    /// @brief Returns whether no characters are referenced
+    bool empty() const {
+        return mySize == 0;
+    }
+
+
+    /// @brief Returns the character at the given position (unchecked)
+    char operator[](unsigned int pos) const {
+        return myData[pos];
+    }
+
+
+    /// @brief Returns a copy of the referenced characters
+    std::string str() const {
+        return std::string(myData, mySize);
+    }
+
+
+    /// @brief Returns a reference to the given part of the sequence (clipped to the available characters)
+    StringRef substr(unsigned int pos, unsigned int len) const {
+        if (pos > mySize) {
+            pos = mySize;
+        }
+        if (len > mySize - pos) {
+            len = mySize - pos;
+        }
+        return StringRef(myData + pos, len);
+    }
+
+
+    /// @brief Lexicographical comparison, returns <0, 0 or >0 like strcmp
+    int compare(const StringRef& other) const {
+        const unsigned int n = mySize < other.mySize ? mySize : other.mySize;
+        const int c = n == 0 ? 0 : memcmp(myData, other.myData, n);
+        if (c != 0) {
+            return c;
+        }
+        return mySize < other.mySize ? -1 : (mySize > other.mySize ? 1 : 0);
+    }
+
+
+    bool operator==(const StringRef& other) const {
+        return mySize == other.mySize && (mySize == 0 || memcmp(myData, other.myData, mySize) == 0);
+    }
+
+
+    bool operator!=(const StringRef& other) const {
+        return !(*this == other);
+    }
+
+
+    bool operator<(const StringRef& other) const {
+        return compare(other) < 0;
+    }
+
+
+    /** @brief Returns the 32bit FNV-1a hash of the referenced characters
+     *
+     * The hash depends on the characters only, so a std::string and a
+     *  StringRef to the same characters hash identically.
+     */
+    unsigned int hash() const {
+        unsigned int h = 2166136261u;
+        for (unsigned int i = 0; i < mySize; ++i) {
+            h ^= (unsigned char)myData[i];
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+
+private:
+    /// @brief The first referenced character
+    const char* myData;
+
+    /// @brief The number of referenced characters
+    unsigned int mySize;
+
+};
+
+
+inline std::ostream&
+operator<<(std::ostream& os, const StringRef& s) {
+    os.write(s.data(), s.size());
+    return os;
+}
+
+
+#endif
+
+/****************************************************************************/
+
@@ -0,0 +1,379 @@
+/****************************************************************************/
+/// @file    StringRefTokenizer.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// A non-owning tokenizer yielding references into the split string
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2001-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef StringRefTokenizer_h
+#define StringRefTokenizer_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <cstring>
+#include "StringRef.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class StringRefTokenizer
+ * @brief A non-owning tokenizer yielding references into the split string
+ *
+ * Splits like StringTokenizer and yields the same tokens, but neither copies
+ *  the string nor stores the token positions: each call of next() scans for
+ *  the next delimiter and returns a StringRef into the split string, which
+ *  must outlive the tokenizer and the tokens.
+ *
+ * The delimiters are searched eight bytes at a time using word-wide bit
+ *  operations; only the word containing a candidate is inspected bytewise.
+ *
+ * The normal usage is like this:
+ * <pre>
+ * StringRefTokenizer st(line, ' ');
+ * StringRef token;
+ * while (st.next(token)) {
+ *     ...
+ * }
+ * </pre>
+ */
+class StringRefTokenizer {
+public:
+    /// @brief identifier for splitting at all newline characters (same as StringTokenizer::NEWLINE)
+    static const int NEWLINE = -256;
+
+    /// @brief identifier for splitting at all whitespace characters (same as StringTokenizer::WHITECHARS)
+    static const int WHITECHARS = -257;
+
+    /// @brief the ascii index of the highest whitespace character
+    static const int SPACE = 32;
+
+
+public:
+    /** @brief Constructor splitting at whitespace
+     *
+     * A run of whitespace is regarded as a single divider, empty tokens are not returned.
+     */
+    explicit StringRefTokenizer(const StringRef& tosplit) {
+        init(tosplit);
+        myMode = MODE_WHITECHARS;
+    }
+
+
+    /** @brief Constructor splitting at NEWLINE, WHITECHARS or the given character
+     *
+     * With NEWLINE, the string is split at each 0x0d and 0x0a, with any other
+     *  character at each occurence of it; empty tokens are returned.
+     */
+    StringRefTokenizer(const StringRef& tosplit, int special) {
+        init(tosplit);
+        switch (special) {
+            case NEWLINE:
+                initChars(StringRef("\r\n"));
+                break;
+            case WHITECHARS:
+                myMode = MODE_WHITECHARS;
+                break;
+            default:
+                myMode = MODE_CHAR;
+                myChars[0] = (char)special;
+                break;
+        }
+    }
+
+
+    /** @brief Constructor splitting at the given string
+     *
+     * If splitAtAllChars is true, the string is split at each character of
+     *  the token instead. Empty tokens are returned.
+     */
+    StringRefTokenizer(const StringRef& tosplit, const StringRef& token, bool splitAtAllChars = false) {
+        init(tosplit);
+        if (splitAtAllChars || token.size() <= 1) {
+            initChars(token);
+        } else {
+            myMode = MODE_STRING;
+            myToken = token;
+        }
+    }
+
+
+    /** @brief Retrieves the next token
+     * @param[out] token The token found
+     * @return Whether a further token existed
+     */
+    bool next(StringRef& token) {
+        if (myPendingEmpty) {
+            // the string ended with a divider
+            myPendingEmpty = false;
+            token = StringRef(myEnd, 0);
+            return true;
+        }
+        if (myMode == MODE_WHITECHARS) {
+            while (myPos < myEnd && *myPos <= SPACE) {
+                ++myPos;
+            }
+            if (myPos >= myEnd) {
+                return false;
+            }
+            const char* const end = findWhite(myPos + 1);
+            token = StringRef(myPos, (unsigned int)(end - myPos));
+            myPos = end;
+            return true;
+        }
+        if (myPos >= myEnd) {
+            return false;
+        }
+        unsigned int dividerLength = 1;
+        const char* end;
+        switch (myMode) {
+            case MODE_CHAR:
+                end = findChar(myPos);
+                break;
+            case MODE_CHAR_PAIR:
+                end = findCharPair(myPos);
+                break;
+            case MODE_CHAR_SET:
+                end = findCharSet(myPos);
+                break;
+            case MODE_STRING:
+            default:
+                end = findString(myPos);
+                dividerLength = myToken.size();
+                break;
+        }
+        token = StringRef(myPos, (unsigned int)(end - myPos));
+        if (end == myEnd) {
+            myPos = myEnd;
+        } else {
+            myPos = end + dividerLength;
+            myPendingEmpty = myPos == myEnd;
+        }
+        return true;
+    }
+
+
+    /// @brief Restarts at the first token
+    void reinit() {
+        myPos = myBegin;
+        myPendingEmpty = false;
+    }
+
+
+    /// @brief Returns the number of tokens (scans the whole string)
+    unsigned int size() const {
+        StringRefTokenizer copy(*this);
+        copy.reinit();
+        StringRef token;
+        unsigned int result = 0;
+        while (copy.next(token)) {
+            result++;
+        }
+        return result;
+    }
+
+
+private:
+    /// @brief The kinds of dividers
+    enum Mode {
+        MODE_WHITECHARS,
+        MODE_CHAR,
+        MODE_CHAR_PAIR,
+        MODE_CHAR_SET,
+        MODE_STRING
+    };
+
+    /// @brief A machine word holding eight characters
+    typedef unsigned long long Word;
+
+    /// @brief The word with all bytes set to 1
+    static Word ones() {
+        return 0x0101010101010101ULL;
+    }
+
+    /// @brief The word with the highest bit of all bytes set
+    static Word highs() {
+        return 0x8080808080808080ULL;
+    }
+
+    /// @brief Loads eight (unaligned) characters
+    static Word load(const char* p) {
+        Word w;
+        memcpy(&w, p, sizeof(Word));
+        return w;
+    }
+
+    /// @brief Returns whether one of the bytes of the word is 0
+    static bool hasZero(Word w) {
+        return ((w - ones()) & ~w & highs()) != 0;
+    }
+
+
+    /// @brief Sets the string to split
+    void init(const StringRef& tosplit) {
+        myBegin = myPos = tosplit.data();
+        myEnd = myBegin + tosplit.size();
+        myPendingEmpty = false;
+        myChars[0] = myChars[1] = 0;
+        memset(myCharSet, 0, sizeof(myCharSet));
+    }
+
+
+    /// @brief Chooses the mode for splitting at each of the given characters
+    void initChars(const StringRef& chars) {
+        if (chars.size() == 1) {
+            myMode = MODE_CHAR;
+            myChars[0] = chars[0];
+        } else if (chars.size() == 2) {
+            myMode = MODE_CHAR_PAIR;
+            myChars[0] = chars[0];
+            myChars[1] = chars[1];
+        } else {
+            // also for no characters at all, which never split
+            myMode = MODE_CHAR_SET;
+            for (unsigned int i = 0; i < chars.size(); ++i) {
+                const unsigned char c = (unsigned char)chars[i];
+                myCharSet[c / 64] |= (Word)1 << (c % 64);
+            }
+        }
+    }
+
+
+    /// @brief Returns the first whitespace character at or after p (or the end)
+    const char* findWhite(const char* p) const {
+        const Word limit = ones() * (SPACE + 1);
+        while (myEnd - p >= 8) {
+            const Word w = load(p);
+            // flags all bytes below limit and all bytes with the high bit set (negative chars)
+            if ((((w - limit) | w) & highs()) != 0) {
+                break;
+            }
+            p += 8;
+        }
+        while (p < myEnd && *p > SPACE) {
+            ++p;
+        }
+        return p;
+    }
+
+
+    /// @brief Returns the first occurence of the character at or after p (or the end)
+    const char* findChar(const char* p) const {
+        const Word pattern = ones() * (unsigned char)myChars[0];
+        while (myEnd - p >= 8 && !hasZero(load(p) ^ pattern)) {
+            p += 8;
+        }
+        while (p < myEnd && *p != myChars[0]) {
+            ++p;
+        }
+        return p;
+    }
+
+
+    /// @brief Returns the first occurence of one of the two characters at or after p (or the end)
+    const char* findCharPair(const char* p) const {
+        const Word pattern0 = ones() * (unsigned char)myChars[0];
+        const Word pattern1 = ones() * (unsigned char)myChars[1];
+        while (myEnd - p >= 8) {
+            const Word w = load(p);
+            if (hasZero(w ^ pattern0) || hasZero(w ^ pattern1)) {
+                break;
+            }
+            p += 8;
+        }
+        while (p < myEnd && *p != myChars[0] && *p != myChars[1]) {
+            ++p;
+        }
+        return p;
+    }
+
+
+    /// @brief Returns the first occurence of one of the characters of the set at or after p (or the end)
+    const char* findCharSet(const char* p) const {
+        while (p < myEnd) {
+            const unsigned char c = (unsigned char)*p;
+            if ((myCharSet[c / 64] & ((Word)1 << (c % 64))) != 0) {
+                break;
+            }
+            ++p;
+        }
+        return p;
+    }
+
+
+    /// @brief Returns the first occurence of the token at or after p (or the end)
+    const char* findString(const char* p) const {
+        const unsigned int n = myToken.size();
+        const Word pattern = ones() * (unsigned char)myToken[0];
+        while (myEnd - p >= (long)n) {
+            // skip to the next occurence of the first character
+            while (myEnd - p >= 8 && !hasZero(load(p) ^ pattern)) {
+                p += 8;
+            }
+            while (p < myEnd && *p != myToken[0]) {
+                ++p;
+            }
+            if (myEnd - p < (long)n) {
+                break;
+            }
+            if (memcmp(p, myToken.data(), n) == 0) {
+                return p;
+            }
+            ++p;
+        }
+        return myEnd;
+    }
+
+
+private:
+    /// @brief The string to split
+    const char* myBegin;
+
+    /// @brief The end of the string to split
+    const char* myEnd;
+
+    /// @brief The begin of the next token
+    const char* myPos;
+
+    /// @brief Whether an empty token after a final divider is still to be returned
+    bool myPendingEmpty;
+
+    /// @brief The kind of dividers
+    Mode myMode;
+
+    /// @brief The divider characters (MODE_CHAR, MODE_CHAR_PAIR)
+    char myChars[2];
+
+    /// @brief The divider characters as a bitset (MODE_CHAR_SET)
+    Word myCharSet[4];
+
+    /// @brief The divider string (MODE_STRING)
+    StringRef myToken;
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
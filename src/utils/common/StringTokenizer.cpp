@@ -34,6 +34,7 @@
 #include <vector>
 #include <iostream> // !!! debug only
 #include "UtilExceptions.h"
+#include "StringRefTokenizer.h"
 #include "StringTokenizer.h"
 
 #ifdef CHECK_MEMORY_LEAKS
@@ -44,43 +45,29 @@
 // ===========================================================================
 // variable definitions
 // ===========================================================================
-const int StringTokenizer::NEWLINE = -256;
-const int StringTokenizer::WHITECHARS = -257;
-const int StringTokenizer::SPACE = 32;
+const int StringTokenizer::NEWLINE = StringRefTokenizer::NEWLINE;
+const int StringTokenizer::WHITECHARS = StringRefTokenizer::WHITECHARS;
+const int StringTokenizer::SPACE = StringRefTokenizer::SPACE;
 
 
 // ===========================================================================
 // method definitions
 // ===========================================================================
-StringTokenizer::StringTokenizer(std::string tosplit)
+StringTokenizer::StringTokenizer(const std::string& tosplit)
     : myTosplit(tosplit), myPos(0) {
-    prepareWhitechar(tosplit);
+    prepare(StringRefTokenizer(myTosplit));
 }
 
 
-StringTokenizer::StringTokenizer(std::string tosplit, std::string token, bool splitAtAllChars)
+StringTokenizer::StringTokenizer(const std::string& tosplit, const std::string& token, bool splitAtAllChars)
     : myTosplit(tosplit), myPos(0) {
-    prepare(tosplit, token, splitAtAllChars);
+    prepare(StringRefTokenizer(myTosplit, token, splitAtAllChars));
 }
 
 
-StringTokenizer::StringTokenizer(std::string tosplit, int special)
+StringTokenizer::StringTokenizer(const std::string& tosplit, int special)
     : myTosplit(tosplit), myPos(0) {
-    switch (special) {
-        case NEWLINE:
-            prepare(tosplit, "\r\n", true);
-            break;
-        case WHITECHARS:
-            prepareWhitechar(tosplit);
-            break;
-        default:
-            char* buf = new char[2];
-            buf[0] = (char) special;
-            buf[1] = 0;
-            prepare(tosplit, buf, false);
-            delete[] buf;
-            break;
-    }
+    prepare(StringRefTokenizer(myTosplit, special));
 }
 
 
@@ -134,49 +121,11 @@ size_t StringTokenizer::size() const {
     return myStarts.size();
 }
 
-void StringTokenizer::prepare(const std::string& tosplit, const std::string& token, bool splitAtAllChars) {
-    size_t beg = 0;
-    size_t len = token.length();
-    if (splitAtAllChars) {
-        len = 1;
-    }
-    while (beg < tosplit.length()) {
-        size_t end;
-        if (splitAtAllChars) {
-            end = tosplit.find_first_of(token, beg);
-        } else {
-            end = tosplit.find(token, beg);
-        }
-        if (end == std::string::npos) {
-            end = tosplit.length();
-        }
-        myStarts.push_back(beg);
-        myLengths.push_back(end - beg);
-        beg = end + len;
-        if (beg == tosplit.length()) {
-            myStarts.push_back(beg - 1);
-            myLengths.push_back(0);
-        }
-    }
-}
-
-void StringTokenizer::prepareWhitechar(const std::string& tosplit) {
-    size_t len = tosplit.length();
-    size_t beg = 0;
-    while (beg < len && tosplit[beg] <= SPACE) {
-        beg++;
-    }
-    while (beg != std::string::npos && beg < len) {
-        size_t end = beg;
-        while (end < len && tosplit[end] > SPACE) {
-            end++;
-        }
-        myStarts.push_back(beg);
-        myLengths.push_back(end - beg);
-        beg = end;
-        while (beg < len && tosplit[beg] <= SPACE) {
-            beg++;
-        }
+void StringTokenizer::prepare(StringRefTokenizer tokenizer) {
+    StringRef token;
+    while (tokenizer.next(token)) {
+        myStarts.push_back(token.data() - myTosplit.data());
+        myLengths.push_back(token.size());
     }
 }
 
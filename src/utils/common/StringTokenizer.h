@@ -35,6 +35,13 @@
 #include <string>
 #include <vector>
 
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class StringRefTokenizer;
+
+
 /**
  * StringTokenizer
  * A class similar to the StringTokenizer from Java. It splits a string at
@@ -60,6 +67,9 @@
  * split is regarded as a single divider. All other parameter will use
  * multiple occurences of operators as a list of single divider and the
  * string between them will have a length of zero.
+ *
+ * The splitting is done by a StringRefTokenizer; use that one directly
+ * where the tokens need not be copied.
  */
 // ===========================================================================
 // class definitions
@@ -87,14 +97,14 @@ public:
         same as StringTokenizer(tosplit, StringTokenizer.WHITECHARS)
         tosplit is the string to split into substrings. If the string between two split
         positions is empty, it will not be returned.  */
-    StringTokenizer(std::string tosplit);
+    StringTokenizer(const std::string& tosplit);
 
     /** @brief constructor
         the first string will be split at the second string's occurences.
         If the optional third parameter is true, the string will be split whenever
         a char from the second string occurs. If the string between two split
         positions is empty, it will nevertheless be returned. */
-    StringTokenizer(std::string tosplit, std::string token, bool splitAtAllChars = false);
+    StringTokenizer(const std::string& tosplit, const std::string& token, bool splitAtAllChars = false);
 
     /** @brief constructor
         When StringTokenizer.NEWLINE is used as second parameter, the string
@@ -103,7 +113,7 @@ public:
         string will be split at all characters below 0x20 (SPACE)
         All other ints specified as second parameter are casted int o a char
         at which the string will be splitted. */
-    StringTokenizer(std::string tosplit, int special);
+    StringTokenizer(const std::string& tosplit, int special);
 
     /** destructor */
     ~StringTokenizer();
@@ -130,13 +140,8 @@ public:
     std::vector<std::string> getVector();
 
 private:
-    /** splits the first string at all occurences of the second. If the third parameter is true
-        split at all chars given in the second */
-    void prepare(const std::string& tosplit, const std::string& token,
-                 bool splitAtAllChars);
-
-    /** splits the first string at all occurences of whitechars */
-    void prepareWhitechar(const std::string& tosplit);
+    /** records the positions of all tokens of the given tokenizer working on myTosplit */
+    void prepare(StringRefTokenizer tokenizer);
 
 private:
     /** a list of positions/lengths */
@@ -63,6 +63,21 @@ SysUtils::getCurrentMillis() {
 }
 
 
+SUMOLong
+SysUtils::getCurrentMicros() {
+#ifndef WIN32
+    timeval current;
+    gettimeofday(&current, 0);
+    return (SUMOLong) current.tv_sec * 1000000 + (SUMOLong) current.tv_usec;
+#else
+    LARGE_INTEGER val, val2;
+    QueryPerformanceCounter(&val);
+    QueryPerformanceFrequency(&val2);
+    return (SUMOLong)(val.QuadPart / val2.QuadPart * 1000000 + val.QuadPart % val2.QuadPart * 1000000 / val2.QuadPart);
+#endif
+}
+
+
 #ifdef _MSC_VER
 long
 SysUtils::getWindowsTicks() {
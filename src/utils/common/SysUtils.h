@@ -46,6 +46,12 @@ public:
     static long getCurrentMillis();
 
 
+    /** @brief Returns the current time in microseconds
+     * @return Current time
+     */
+    static SUMOLong getCurrentMicros();
+
+
 #ifdef _MSC_VER
     /** @brief Returns the CPU ticks (windows only)
      *
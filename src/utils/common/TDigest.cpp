@@ -0,0 +1,164 @@
+/****************************************************************************/
+/// @file    TDigest.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// A compact summary of a stream of values answering quantile queries
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2001-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <cmath>
+#include <algorithm>
+#include <iterator>
+#include "StdDefs.h"
+#include "TDigest.h"
+
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif // CHECK_MEMORY_LEAKS
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+TDigest::TDigest(double compression)
+    : myCompression(compression < 10 ? 10 : compression),
+      myBufferSize((unsigned int)(5 * myCompression)),
+      myCount(0), myBufferWeight(0), myMin(0), myMax(0) {
+    myBuffer.reserve(myBufferSize);
+}
+
+
+TDigest::~TDigest() {}
+
+
+void
+TDigest::add(double value, double weight) {
+    if (weight <= 0) {
+        return;
+    }
+    if (getCount() == 0) {
+        myMin = myMax = value;
+    } else {
+        myMin = MIN2(myMin, value);
+        myMax = MAX2(myMax, value);
+    }
+    myBuffer.push_back(Centroid(value, weight));
+    myBufferWeight += weight;
+    if (myBuffer.size() >= myBufferSize) {
+        compress();
+    }
+}
+
+
+void
+TDigest::compress() const {
+    if (myBuffer.empty()) {
+        return;
+    }
+    std::sort(myBuffer.begin(), myBuffer.end());
+    myMerged.clear();
+    std::merge(myCentroids.begin(), myCentroids.end(), myBuffer.begin(), myBuffer.end(), std::back_inserter(myMerged));
+    const double total = myCount + myBufferWeight;
+    myCentroids.clear();
+    // join neighbours while the joined centroid stays within the limit of its quantile
+    Centroid current = myMerged.front();
+    double before = 0;
+    double limit = total * getQuantileLimit(0);
+    for (std::vector<Centroid>::const_iterator i = myMerged.begin() + 1; i != myMerged.end(); ++i) {
+        if (before + current.weight + i->weight <= limit) {
+            current.weight += i->weight;
+            current.mean += (i->mean - current.mean) * i->weight / current.weight;
+        } else {
+            myCentroids.push_back(current);
+            before += current.weight;
+            limit = total * getQuantileLimit(before / total);
+            current = *i;
+        }
+    }
+    myCentroids.push_back(current);
+    myCount = total;
+    myBuffer.clear();
+    myBufferWeight = 0;
+}
+
+
+void
+TDigest::clear() {
+    myCentroids.clear();
+    myBuffer.clear();
+    myCount = 0;
+    myBufferWeight = 0;
+    myMin = myMax = 0;
+}
+
+
+double
+TDigest::getQuantile(double q) const {
+    compress();
+    if (myCentroids.empty()) {
+        return 0;
+    }
+    if (q <= 0) {
+        return myMin;
+    }
+    if (q >= 1) {
+        return myMax;
+    }
+    // each centroid's mean is taken to lie at the middle of its weight,
+    //  the values in between (and towards the extremes) are interpolated
+    const double t = q * myCount;
+    const Centroid& first = myCentroids.front();
+    if (t < first.weight / 2) {
+        return myMin + (first.mean - myMin) * t / (first.weight / 2);
+    }
+    double before = 0;
+    for (unsigned int i = 0; i + 1 < (unsigned int)myCentroids.size(); ++i) {
+        const Centroid& left = myCentroids[i];
+        const Centroid& right = myCentroids[i + 1];
+        const double leftMiddle = before + left.weight / 2;
+        const double rightMiddle = before + left.weight + right.weight / 2;
+        if (t < rightMiddle) {
+            return left.mean + (right.mean - left.mean) * (t - leftMiddle) / (rightMiddle - leftMiddle);
+        }
+        before += left.weight;
+    }
+    const Centroid& last = myCentroids.back();
+    const double lastMiddle = myCount - last.weight / 2;
+    return MIN2(myMax, last.mean + (myMax - last.mean) * (t - lastMiddle) / (last.weight / 2));
+}
+
+
+double
+TDigest::getQuantileLimit(double q) const {
+    // the scale function k(q) = compression / (2 pi) * asin(2q - 1) grows by at most one per centroid
+    const double k = myCompression / (2 * M_PI) * asin(MAX2(-1., MIN2(1., 2 * q - 1))) + 1;
+    if (k >= myCompression / 4) {
+        return 1;
+    }
+    return (sin(k * 2 * M_PI / myCompression) + 1) / 2;
+}
+
+
+/****************************************************************************/
+
@@ -0,0 +1,165 @@
+/****************************************************************************/
+/// @file    TDigest.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// A compact summary of a stream of values answering quantile queries
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2001-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef TDigest_h
+#define TDigest_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <vector>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class TDigest
+ * @brief A compact summary of a stream of values answering quantile queries
+ *
+ * A merging t-digest (Dunning): the values are summarised by centroids
+ *  (a mean and a weight) sorted by their mean. Added values are buffered
+ *  and merged into the centroids once the buffer is full; the merge bounds
+ *  the weight of each centroid by its quantile, so the centroids near the
+ *  tails stay small and the extreme quantiles are estimated accurately.
+ *
+ * The number of centroids stays below the compression (about twice that
+ *  while the buffer is not merged), so the memory and the cost of a query
+ *  do not grow with the number of values. The minimum and the maximum are
+ *  kept exactly.
+ *
+ * Queries merge the pending values first; they are const but must not run
+ *  concurrently with other queries or additions.
+ */
+class TDigest {
+public:
+    /** @brief Constructor
+     * @param[in] compression The accuracy (the bound on the number of centroids)
+     */
+    explicit TDigest(double compression = 100);
+
+
+    /// @brief Destructor
+    ~TDigest();
+
+
+    /** @brief Adds a value
+     * @param[in] value The value to add
+     * @param[in] weight The weight of the value
+     */
+    void add(double value, double weight = 1);
+
+
+    /// @brief Merges the pending values into the centroids
+    void compress() const;
+
+
+    /// @brief Forgets all values
+    void clear();
+
+
+    /** @brief Returns the estimated value at the given quantile
+     * @param[in] q The quantile within [0, 1]
+     * @return The estimated value (0 if no value was added)
+     */
+    double getQuantile(double q) const;
+
+
+    /// @brief Returns the total weight of the added values
+    double getCount() const {
+        return myCount + myBufferWeight;
+    }
+
+
+    /// @brief Returns the smallest value added (0 if none)
+    double getMin() const {
+        return getCount() > 0 ? myMin : 0;
+    }
+
+
+    /// @brief Returns the largest value added (0 if none)
+    double getMax() const {
+        return getCount() > 0 ? myMax : 0;
+    }
+
+
+    /// @brief Returns the number of centroids after merging the pending values
+    unsigned int getNumCentroids() const {
+        compress();
+        return (unsigned int)myCentroids.size();
+    }
+
+
+private:
+    /// @brief A group of neighbouring values
+    struct Centroid {
+        Centroid(double m, double w) : mean(m), weight(w) {}
+        /// @brief The mean of the values
+        double mean;
+        /// @brief The weight of the values
+        double weight;
+        /// @brief Orders by mean
+        bool operator<(const Centroid& other) const {
+            return mean < other.mean;
+        }
+    };
+
+
+    /// @brief Returns the largest quantile a centroid starting at q may reach
+    double getQuantileLimit(double q) const;
+
+
+private:
+    /// @brief The accuracy
+    const double myCompression;
+
+    /// @brief The centroids, sorted by mean
+    mutable std::vector<Centroid> myCentroids;
+
+    /// @brief The values not merged yet
+    mutable std::vector<Centroid> myBuffer;
+
+    /// @brief The merged centroids (kept to avoid allocations)
+    mutable std::vector<Centroid> myMerged;
+
+    /// @brief The number of values buffered before merging
+    const unsigned int myBufferSize;
+
+    /// @brief The total weight of the centroids
+    mutable double myCount;
+
+    /// @brief The total weight of the buffered values
+    mutable double myBufferWeight;
+
+    /// @brief The extreme values
+    double myMin, myMax;
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -0,0 +1,267 @@
+/****************************************************************************/
+/// @file    ThreadPool.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// A fixed set of threads executing index ranges of a task in parallel
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2001-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <exception>
+#include "UtilExceptions.h"
+#include "ThreadPool.h"
+
+#ifndef WIN32
+#include <unistd.h>
+#else
+#define NOMINMAX
+#include <windows.h>
+#undef NOMINMAX
+#endif
+
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif // CHECK_MEMORY_LEAKS
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+// ---------------------------------------------------------------------------
+// ThreadPool::Worker - methods
+// ---------------------------------------------------------------------------
+void
+ThreadPool::Worker::run() {
+    myPool.workerLoop(myShare);
+}
+
+
+// ---------------------------------------------------------------------------
+// ThreadPool - methods
+// ---------------------------------------------------------------------------
+ThreadPool::ThreadPool(unsigned int numThreads)
+    : myTask(0), myGeneration(0), myGrain(1), myActive(0), myAmStopping(false) {
+    myShares.push_back(new Share());
+    try {
+        for (unsigned int i = 0; i < numThreads; ++i) {
+            myShares.push_back(new Share());
+            myWorkers.push_back(new Worker(*this, i + 1));
+            myWorkers.back()->start();
+        }
+    } catch (ProcessError&) {
+        // continue with the threads created so far
+        delete myWorkers.back();
+        myWorkers.pop_back();
+        delete myShares.back();
+        myShares.pop_back();
+    }
+}
+
+
+ThreadPool::~ThreadPool() {
+    myMutex.lock();
+    myAmStopping = true;
+    myTaskAvailable.broadcast();
+    myMutex.unlock();
+    for (std::vector<Worker*>::iterator i = myWorkers.begin(); i != myWorkers.end(); ++i) {
+        (*i)->join();
+        delete *i;
+    }
+    for (std::vector<Share*>::iterator i = myShares.begin(); i != myShares.end(); ++i) {
+        delete *i;
+    }
+}
+
+
+void
+ThreadPool::parallelFor(unsigned int size, unsigned int grain, Task& task) {
+    if (size == 0) {
+        return;
+    }
+    myMutex.lock();
+    myTask = &task;
+    myGrain = grain == 0 ? 1 : grain;
+    myActive = 1;
+    myError = "";
+    // no thread works on the shares before the generation changes
+    const unsigned int numShares = size > myGrain ? (unsigned int)myShares.size() : 1;
+    const unsigned int quotient = size / numShares;
+    const unsigned int remainder = size % numShares;
+    for (unsigned int i = 0; i < (unsigned int)myShares.size(); ++i) {
+        Share& share = *myShares[i];
+        if (i < numShares) {
+            share.begin = i * quotient + (i < remainder ? i : remainder);
+            share.end = share.begin + quotient + (i < remainder ? 1 : 0);
+        } else {
+            share.begin = share.end = size;
+        }
+    }
+    myGeneration++;
+    if (numShares > 1) {
+        myTaskAvailable.broadcast();
+    }
+    myMutex.unlock();
+    work(0);
+    myMutex.lock();
+    myActive--;
+    while (myActive > 0) {
+        myTaskDone.wait(myMutex);
+    }
+    myTask = 0;
+    const std::string error = myError;
+    myMutex.unlock();
+    if (error != "") {
+        throw ProcessError(error);
+    }
+}
+
+
+unsigned int
+ThreadPool::getNumSteals() const {
+    unsigned int result = 0;
+    for (std::vector<Share*>::const_iterator i = myShares.begin(); i != myShares.end(); ++i) {
+        result += (*i)->numSteals;
+    }
+    return result;
+}
+
+
+void
+ThreadPool::work(unsigned int share) {
+    Share& own = *myShares[share];
+    while (true) {
+        own.mutex.lock();
+        if (own.begin == own.end) {
+            own.mutex.unlock();
+            if (!steal(share)) {
+                return;
+            }
+            continue;
+        }
+        const unsigned int begin = own.begin;
+        const unsigned int end = own.end - begin > myGrain ? begin + myGrain : own.end;
+        own.begin = end;
+        own.mutex.unlock();
+        std::string error;
+        try {
+            myTask->run(begin, end);
+        } catch (std::exception& e) {
+            error = e.what();
+            if (error == "") {
+                error = "Task failed.";
+            }
+        } catch (...) {
+            error = "Task failed.";
+        }
+        if (error != "") {
+            myMutex.lock();
+            if (myError == "") {
+                myError = error;
+            }
+            myMutex.unlock();
+            cancel();
+            return;
+        }
+    }
+}
+
+
+bool
+ThreadPool::steal(unsigned int share) {
+    // only one lock is held at a time, so thieves cannot deadlock each other
+    const unsigned int numShares = (unsigned int)myShares.size();
+    for (unsigned int i = 1; i < numShares; ++i) {
+        Share& victim = *myShares[(share + i) % numShares];
+        victim.mutex.lock();
+        const unsigned int remaining = victim.end - victim.begin;
+        if (remaining == 0) {
+            victim.mutex.unlock();
+            continue;
+        }
+        // the victim keeps the lower half it is working towards; small remainders are taken whole
+        const unsigned int stolen = remaining > myGrain ? remaining / 2 : remaining;
+        const unsigned int end = victim.end;
+        victim.end -= stolen;
+        victim.mutex.unlock();
+        Share& own = *myShares[share];
+        own.mutex.lock();
+        own.begin = end - stolen;
+        own.end = end;
+        own.numSteals++;
+        own.mutex.unlock();
+        return true;
+    }
+    return false;
+}
+
+
+void
+ThreadPool::cancel() {
+    for (std::vector<Share*>::iterator i = myShares.begin(); i != myShares.end(); ++i) {
+        (*i)->mutex.lock();
+        (*i)->end = (*i)->begin;
+        (*i)->mutex.unlock();
+    }
+}
+
+
+void
+ThreadPool::workerLoop(unsigned int share) {
+    myMutex.lock();
+    unsigned int generation = myGeneration;
+    while (true) {
+        while (!myAmStopping && (myTask == 0 || generation == myGeneration)) {
+            myTaskAvailable.wait(myMutex);
+        }
+        if (myAmStopping) {
+            break;
+        }
+        generation = myGeneration;
+        myActive++;
+        myMutex.unlock();
+        work(share);
+        myMutex.lock();
+        myActive--;
+        if (myActive == 0) {
+            myTaskDone.signal();
+        }
+    }
+    myMutex.unlock();
+}
+
+
+unsigned int
+ThreadPool::getHardwareConcurrency() {
+#ifndef WIN32
+    const long result = sysconf(_SC_NPROCESSORS_ONLN);
+    return result > 0 ? (unsigned int)result : 1;
+#else
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (unsigned int)info.dwNumberOfProcessors : 1;
+#endif
+}
+
+
+/****************************************************************************/
+
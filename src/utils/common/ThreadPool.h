@@ -0,0 +1,222 @@
+/****************************************************************************/
+/// @file    ThreadPool.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// A fixed set of threads executing index ranges of a task in parallel
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2001-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef ThreadPool_h
+#define ThreadPool_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include "PosixThread.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class ThreadPool
+ * @brief A fixed set of threads executing index ranges of a task in parallel
+ *
+ * parallelFor deals the indices [0, size) out to the pool's threads and
+ *  the calling thread in contiguous shares. Each thread processes its
+ *  share grain indices at a time; a thread which runs out of work steals
+ *  the upper half of another thread's remaining share, so threads which
+ *  finish early (or tasks whose indices differ in cost) keep all threads
+ *  busy without a shared counter all threads contend for. Each share has
+ *  its own lock which is only contended by a thief. The call returns when
+ *  all indices are done. The threads are started once and wait for the
+ *  next call in between.
+ *
+ * Only one parallelFor may run at a time.
+ */
+class ThreadPool {
+public:
+    /**
+     * @class Task
+     * @brief The work to be done for a range of indices
+     */
+    class Task {
+    public:
+        /// @brief Destructor
+        virtual ~Task() {}
+
+        /** @brief Processes the given range of indices
+         *
+         * Is called by several threads at once for disjoint ranges.
+         *
+         * @param[in] begin The first index
+         * @param[in] end The index after the last one
+         */
+        virtual void run(unsigned int begin, unsigned int end) = 0;
+    };
+
+
+    /** @brief Constructor; starts the threads
+     * @param[in] numThreads The number of threads besides the calling one (0 runs everything within the caller)
+     * @exception ProcessError If a thread could not be created
+     */
+    explicit ThreadPool(unsigned int numThreads);
+
+
+    /// @brief Destructor; stops the threads
+    ~ThreadPool();
+
+
+    /** @brief Runs the task for all indices in [0, size) and waits for it to finish
+     * @param[in] size The number of indices
+     * @param[in] grain The number of indices to claim at once
+     * @param[in] task The task to run
+     * @exception ProcessError If the task threw an exception (within any thread)
+     */
+    void parallelFor(unsigned int size, unsigned int grain, Task& task);
+
+
+    /// @brief Returns the number of threads working on a task, including the calling one
+    unsigned int getConcurrency() const {
+        return (unsigned int)myWorkers.size() + 1;
+    }
+
+
+    /// @brief Returns the number of ranges stolen from other threads so far
+    unsigned int getNumSteals() const;
+
+
+    /// @brief Returns the number of hardware threads (at least 1)
+    static unsigned int getHardwareConcurrency();
+
+
+private:
+    /**
+     * @class Worker
+     * @brief A thread of the pool
+     */
+    class Worker : public PosixThread {
+    public:
+        /// @brief Constructor
+        Worker(ThreadPool& pool, unsigned int share) : myPool(pool), myShare(share) {}
+
+    protected:
+        /// @brief Works on the pool's tasks until the pool is destroyed
+        void run();
+
+    private:
+        /// @brief The pool this thread belongs to
+        ThreadPool& myPool;
+
+        /// @brief The index of the thread's share
+        const unsigned int myShare;
+
+    private:
+        /// @brief Invalidated copy constructor.
+        Worker(const Worker&);
+
+        /// @brief Invalidated assignment operator.
+        Worker& operator=(const Worker&);
+
+    };
+
+
+    /**
+     * @struct Share
+     * @brief The indices not yet claimed by a thread
+     */
+    struct Share {
+        /// @brief Constructor
+        Share() : begin(0), end(0), numSteals(0) {}
+        /// @brief The lock guarding the range
+        PosixMutex mutex;
+        /// @brief The remaining range
+        unsigned int begin, end;
+        /// @brief The number of ranges the owner stole
+        unsigned int numSteals;
+    };
+
+
+    /// @brief Runs the task for the thread's share and the ranges it steals until no indices remain
+    void work(unsigned int share);
+
+    /** @brief Moves the upper half of another share's range into the given (empty) share
+     * @return Whether anything was left to steal
+     */
+    bool steal(unsigned int share);
+
+    /// @brief Drops the remaining ranges of all shares
+    void cancel();
+
+    /// @brief The loop of the pool's threads
+    void workerLoop(unsigned int share);
+
+
+private:
+    /// @brief The pool's threads
+    std::vector<Worker*> myWorkers;
+
+    /// @brief The shares of the calling thread (first) and the pool's threads
+    std::vector<Share*> myShares;
+
+    /// @brief The lock guarding all of the following members
+    PosixMutex myMutex;
+
+    /// @brief Signalled when a new task is available or the pool stops
+    PosixCondition myTaskAvailable;
+
+    /// @brief Signalled when the last thread left the current task
+    PosixCondition myTaskDone;
+
+    /// @brief The current task
+    Task* myTask;
+
+    /// @brief The number of the current task, telling the threads apart whether they already joined it
+    unsigned int myGeneration;
+
+    /// @brief The number of indices to claim at once
+    unsigned int myGrain;
+
+    /// @brief The number of threads working on the current task
+    unsigned int myActive;
+
+    /// @brief The message of the first exception thrown by the current task
+    std::string myError;
+
+    /// @brief Whether the pool is being destroyed
+    bool myAmStopping;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    ThreadPool(const ThreadPool&);
+
+    /// @brief Invalidated assignment operator.
+    ThreadPool& operator=(const ThreadPool&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -39,6 +39,7 @@
 #include <algorithm>
 #include <utils/xml/SUMOXMLDefinitions.h>
 #include <utils/common/SUMOVehicleClass.h>
+#include "NumberFormat.h"
 #include "StdDefs.h"
 
 
@@ -59,6 +60,69 @@ inline std::string toString(const T& t, std::streamsize accuracy = OUTPUT_ACCURA
 }
 
 
+/* numbers are formatted without a stream, yielding the same characters */
+template <>
+inline std::string toString<double>(const double& t, std::streamsize accuracy) {
+    char buf[NumberFormat::BUFFER_SIZE];
+    return std::string(buf, NumberFormat::formatFixed(t, (int)accuracy, buf));
+}
+
+
+template <>
+inline std::string toString<float>(const float& t, std::streamsize accuracy) {
+    char buf[NumberFormat::BUFFER_SIZE];
+    return std::string(buf, NumberFormat::formatFixed(t, (int)accuracy, buf));
+}
+
+
+template <>
+inline std::string toString<int>(const int& t, std::streamsize accuracy) {
+    UNUSED_PARAMETER(accuracy);
+    char buf[NumberFormat::BUFFER_SIZE];
+    return std::string(buf, NumberFormat::formatInt(t, buf));
+}
+
+
+template <>
+inline std::string toString<unsigned int>(const unsigned int& t, std::streamsize accuracy) {
+    UNUSED_PARAMETER(accuracy);
+    char buf[NumberFormat::BUFFER_SIZE];
+    return std::string(buf, NumberFormat::formatUnsigned(t, buf));
+}
+
+
+template <>
+inline std::string toString<long>(const long& t, std::streamsize accuracy) {
+    UNUSED_PARAMETER(accuracy);
+    char buf[NumberFormat::BUFFER_SIZE];
+    return std::string(buf, NumberFormat::formatInt(t, buf));
+}
+
+
+template <>
+inline std::string toString<unsigned long>(const unsigned long& t, std::streamsize accuracy) {
+    UNUSED_PARAMETER(accuracy);
+    char buf[NumberFormat::BUFFER_SIZE];
+    return std::string(buf, NumberFormat::formatUnsigned(t, buf));
+}
+
+
+template <>
+inline std::string toString<long long>(const long long& t, std::streamsize accuracy) {
+    UNUSED_PARAMETER(accuracy);
+    char buf[NumberFormat::BUFFER_SIZE];
+    return std::string(buf, NumberFormat::formatInt(t, buf));
+}
+
+
+template <>
+inline std::string toString<unsigned long long>(const unsigned long long& t, std::streamsize accuracy) {
+    UNUSED_PARAMETER(accuracy);
+    char buf[NumberFormat::BUFFER_SIZE];
+    return std::string(buf, NumberFormat::formatUnsigned(t, buf));
+}
+
+
 template<typename T>
 inline std::string toHex(const T i, std::streamsize numDigits = 0) {
     // taken from http://stackoverflow.com/questions/5100718/int-to-hex-string-in-c
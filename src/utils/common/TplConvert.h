@@ -33,6 +33,9 @@
 #endif
 
 #include <string>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
 #include <cmath>
 #include <limits>
 #include <algorithm>
@@ -47,6 +50,10 @@
  * TplConvert
  * Some methods that convert 0-terminated char-arrays of any type into
  * other values (numerical/boolean) or into std::strings
+ *
+ * Plain char arrays are parsed by parseLong / parseDouble which do not
+ * need the 0-termination, check eight digits at once and round doubles
+ * correctly; other character types use the generic loops.
  */
 class TplConvert {
 public:
@@ -134,6 +141,47 @@ public:
     }
 
 
+    /** converts a char array of the given length into the integer value described by it
+        throws an EmptyData - exception if the given string is empty
+        throws a NumberFormatException - exception when the string does
+            not contain an integer */
+    static int _2int(const char* const data, unsigned length) {
+        SUMOLong result = _2long(data, length);
+        if (result > std::numeric_limits<int>::max() || result < std::numeric_limits<int>::min()) {
+            throw NumberFormatException();
+        }
+        return (int)result;
+    }
+
+
+    /** converts a 0-terminated char array into the long value described by it
+        throws an EmptyData - exception if the given string is empty
+        throws a NumberFormatException - exception when the string does
+            not contain a long or the value does not fit */
+    static SUMOLong _2long(const char* const data) {
+        if (data == 0 || data[0] == 0) {
+            throw EmptyData();
+        }
+        return _2long(data, (unsigned)strlen(data));
+    }
+
+
+    /** converts a char array of the given length into the long value described by it
+        throws an EmptyData - exception if the given string is empty
+        throws a NumberFormatException - exception when the string does
+            not contain a long or the value does not fit */
+    static SUMOLong _2long(const char* const data, unsigned length) {
+        if (data == 0 || length == 0) {
+            throw EmptyData();
+        }
+        SUMOLong result;
+        if (parseLong(data, data + length, result) != data + length) {
+            throw NumberFormatException();
+        }
+        return result;
+    }
+
+
     /** converts a char-type array into the long value described by it
         throws an EmptyData - exception if the given string is empty
         throws a NumberFormatException - exception when the string does
@@ -215,6 +263,36 @@ public:
     }
 
 
+    /** converts a 0-terminated char array into the SUMOReal value described by it
+        "," is accepted as decimal point, too
+        throws an EmptyData - exception if the given string is empty
+        throws a NumberFormatException - exception when the string does
+            not contain a SUMOReal */
+    static SUMOReal _2SUMOReal(const char* const data) {
+        if (data == 0 || data[0] == 0) {
+            throw EmptyData();
+        }
+        return _2SUMOReal(data, (unsigned)strlen(data));
+    }
+
+
+    /** converts a char array of the given length into the SUMOReal value described by it
+        "," is accepted as decimal point, too
+        throws an EmptyData - exception if the given string is empty
+        throws a NumberFormatException - exception when the string does
+            not contain a SUMOReal */
+    static SUMOReal _2SUMOReal(const char* const data, unsigned length) {
+        if (data == 0 || length == 0) {
+            throw EmptyData();
+        }
+        double result;
+        if (parseDouble(data, data + length, result, true) != data + length) {
+            throw NumberFormatException();
+        }
+        return (SUMOReal)result;
+    }
+
+
     /** converts a char-type array into the SUMOReal value described by it
         throws an EmptyData - exception if the given string is empty
         throws a NumberFormatException - exception when the string does
@@ -269,6 +347,187 @@ public:
     }
 
 
+    /** converts a list of positions ("x,y x,y,z ...") into the given vector
+        POSITION has to provide the members x, y and z (z is 0 if not given)
+        throws a NumberFormatException - exception when the string does
+            not contain a list of positions */
+    template<class POSITION>
+    static void _2positions(const char* const data, unsigned length, std::vector<POSITION>& into) {
+        const char* p = data;
+        const char* const end = data + length;
+        double coords[3];
+        while (true) {
+            while (p < end && (unsigned char)*p <= ' ') {
+                ++p;
+            }
+            if (p == end) {
+                return;
+            }
+            unsigned int dim = 0;
+            while (true) {
+                p = parseDouble(p, end, coords[dim], false);
+                if (p == 0) {
+                    throw NumberFormatException();
+                }
+                dim++;
+                if (p == end || *p != ',') {
+                    break;
+                }
+                if (dim == 3) {
+                    throw NumberFormatException();
+                }
+                ++p;
+            }
+            if (dim < 2 || (p != end && (unsigned char)*p > ' ')) {
+                throw NumberFormatException();
+            }
+            POSITION pos;
+            pos.x = coords[0];
+            pos.y = coords[1];
+            pos.z = dim == 3 ? coords[2] : 0;
+            into.push_back(pos);
+        }
+    }
+
+
+    /** @brief parses the integer at the begin of the given range
+     * @param[in] data The begin of the range
+     * @param[in] end The end of the range
+     * @param[out] result The value parsed
+     * @return The position behind the number, 0 if there was no number or it did not fit
+     */
+    static const char* parseLong(const char* data, const char* end, SUMOLong& result) {
+        const char* p = data;
+        const bool negative = p < end && *p == '-';
+        if (p < end && (*p == '+' || *p == '-')) {
+            ++p;
+        }
+        const char* const digits = p;
+        while (p < end && *p == '0') {
+            ++p;
+        }
+        const char* const significant = p;
+        unsigned long long value = 0;
+        while (end - p >= 8 && isEightDigits(p) && p - significant < 16) {
+            value = value * 100000000 + parseEightDigits(p);
+            p += 8;
+        }
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (p - significant == 19) {
+                return 0;
+            }
+            value = value * 10 + (*p - '0');
+            ++p;
+        }
+        if (p == digits) {
+            return 0;
+        }
+        const unsigned long long limit = (unsigned long long)std::numeric_limits<SUMOLong>::max();
+        if (value > limit + (negative ? 1 : 0)) {
+            return 0;
+        }
+        if (negative) {
+            result = value == 0 ? 0 : -(SUMOLong)(value - 1) - 1;
+        } else {
+            result = (SUMOLong)value;
+        }
+        return p;
+    }
+
+
+    /** @brief parses the floating point number at the begin of the given range
+     *
+     * The result is the correctly rounded double: numbers with up to 15 significant
+     *  digits and small exponents are computed exactly, all others by strtod.
+     *
+     * @param[in] data The begin of the range
+     * @param[in] end The end of the range
+     * @param[out] result The value parsed
+     * @param[in] decimalComma Whether "," is accepted as decimal point
+     * @return The position behind the number, 0 if there was no number
+     */
+    static const char* parseDouble(const char* data, const char* end, double& result, bool decimalComma) {
+        const char* p = data;
+        const bool negative = p < end && *p == '-';
+        if (p < end && (*p == '+' || *p == '-')) {
+            ++p;
+        }
+        // collect up to 19 significant digits, the exponent compensates the remaining ones
+        const unsigned long long maxMantissa = 1000000000000000000ULL;
+        unsigned long long mantissa = 0;
+        int exponent = 0;
+        bool truncated = false;
+        bool anyDigit = false;
+        while (end - p >= 8 && mantissa < 100000000000ULL && isEightDigits(p)) {
+            mantissa = mantissa * 100000000 + parseEightDigits(p);
+            p += 8;
+            anyDigit = true;
+        }
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (mantissa < maxMantissa) {
+                mantissa = mantissa * 10 + (*p - '0');
+            } else {
+                exponent++;
+                truncated |= *p != '0';
+            }
+            ++p;
+            anyDigit = true;
+        }
+        if (p < end && (*p == '.' || (decimalComma && *p == ','))) {
+            ++p;
+            while (end - p >= 8 && mantissa < 100000000000ULL && isEightDigits(p)) {
+                mantissa = mantissa * 100000000 + parseEightDigits(p);
+                exponent -= 8;
+                p += 8;
+                anyDigit = true;
+            }
+            while (p < end && *p >= '0' && *p <= '9') {
+                if (mantissa < maxMantissa) {
+                    mantissa = mantissa * 10 + (*p - '0');
+                    exponent--;
+                } else {
+                    truncated |= *p != '0';
+                }
+                ++p;
+                anyDigit = true;
+            }
+        }
+        if (!anyDigit) {
+            return 0;
+        }
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            ++p;
+            const bool negativeExponent = p < end && *p == '-';
+            if (p < end && (*p == '+' || *p == '-')) {
+                ++p;
+            }
+            if (p == end || *p < '0' || *p > '9') {
+                return 0;
+            }
+            int explicitExponent = 0;
+            while (p < end && *p >= '0' && *p <= '9') {
+                if (explicitExponent < 100000) {
+                    explicitExponent = explicitExponent * 10 + (*p - '0');
+                }
+                ++p;
+            }
+            exponent += negativeExponent ? -explicitExponent : explicitExponent;
+        }
+        if (mantissa == 0) {
+            result = negative ? -0. : 0.;
+        } else if (!truncated && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+            // both operands are exact, so the single operation rounds correctly
+            result = exponent < 0 ? (double)mantissa / exactPowerOf10(-exponent) : (double)mantissa * exactPowerOf10(exponent);
+            if (negative) {
+                result = -result;
+            }
+        } else {
+            result = slowParseDouble(data, p);
+        }
+        return p;
+    }
+
+
     /** converts a 0-terminated char-type array into the boolean value
             described by it
         returns true if the data* is one of the following (case insensitive):
@@ -383,6 +642,52 @@ public:
         return i;
     }
 
+
+private:
+    /// @brief Loads eight characters into a word, the first one in the lowest byte
+    static unsigned long long loadEight(const char* p) {
+        unsigned long long w = 0;
+        for (int i = 7; i >= 0; --i) {
+            w = (w << 8) | (unsigned char)p[i];
+        }
+        return w;
+    }
+
+
+    /// @brief Returns whether the eight characters are all digits
+    static bool isEightDigits(const char* p) {
+        const unsigned long long w = loadEight(p);
+        return (((w + 0x4646464646464646ULL) | (w - 0x3030303030303030ULL)) & 0x8080808080808080ULL) == 0;
+    }
+
+
+    /// @brief Returns the value of eight digits, combining pairs, quadruples and octets by multiplication
+    static unsigned int parseEightDigits(const char* p) {
+        unsigned long long w = loadEight(p) - 0x3030303030303030ULL;
+        w = (w * 10) + (w >> 8);
+        w = (((w & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)))
+             + (((w >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+        return (unsigned int)w;
+    }
+
+
+    /// @brief Returns 10^exponent for 0 <= exponent <= 22 (all exactly representable)
+    static double exactPowerOf10(int exponent) {
+        static const double powers[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        return powers[exponent];
+    }
+
+
+    /// @brief Parses the already validated number using strtod (with "." as decimal point)
+    static double slowParseDouble(const char* data, const char* end) {
+        std::string buf(data, end);
+        std::replace(buf.begin(), buf.end(), ',', '.');
+        return strtod(buf.c_str(), 0);
+    }
+
 };
 
 
@@ -0,0 +1,412 @@
+/****************************************************************************/
+/// @file    ColumnarFormatter.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Output formatter writing element attributes as column-chunked tables
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <cstring>
+#include <ostream>
+#include <utils/common/UtilExceptions.h>
+#include "ColumnarFormatter.h"
+
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif // CHECK_MEMORY_LEAKS
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+const unsigned char ColumnarFormatter::FORMAT_VERSION = 2;
+
+
+// ===========================================================================
+// static helpers
+// ===========================================================================
+namespace {
+/// @brief Appends an unsigned LEB128 varint
+inline void
+appendVarint(std::string& into, unsigned SUMOLong val) {
+    while (val >= 0x80) {
+        into += (char)((val & 0x7f) | 0x80);
+        val >>= 7;
+    }
+    into += (char)val;
+}
+
+/// @brief Appends a signed value as zigzag varint
+inline void
+appendZigzag(std::string& into, SUMOLong val) {
+    appendVarint(into, ((unsigned SUMOLong)val << 1) ^ (unsigned SUMOLong)(val >> 63));
+}
+
+/// @brief Appends the raw bytes of a value
+template <typename T>
+inline void
+appendRaw(std::string& into, const T& val) {
+    into.append((const char*)&val, sizeof(T));
+}
+
+/// @brief Appends a varint length prefixed string
+inline void
+appendString(std::string& into, const std::string& val) {
+    appendVarint(into, val.size());
+    into += val;
+}
+}
+
+
+// ===========================================================================
+// member method definitions
+// ===========================================================================
+ColumnarFormatter::ColumnarFormatter(unsigned int blockRows, bool encode)
+    : myBlockRows(blockRows == 0 ? 1 : blockRows), myEncode(encode),
+      myHaveHeader(false), myPosition(0) {
+}
+
+
+ColumnarFormatter::~ColumnarFormatter() {
+    for (std::vector<Table*>::iterator i = myTableList.begin(); i != myTableList.end(); ++i) {
+        delete *i;
+    }
+}
+
+
+bool
+ColumnarFormatter::writeXMLHeader(std::ostream& into, const std::string& rootElement,
+                                  const std::string& /* attrs */, const std::string& /* comment */) {
+    if (myHaveHeader) {
+        return false;
+    }
+    write(into, "SCOL", 4);
+    write(into, &FORMAT_VERSION, 1);
+    myHaveHeader = true;
+    myRoot = rootElement;
+    myStack.push_back(0);
+    return true;
+}
+
+
+bool
+ColumnarFormatter::writeHeader(std::ostream& into, const SumoXMLTag& rootElement) {
+    return writeXMLHeader(into, toString(rootElement));
+}
+
+
+void
+ColumnarFormatter::openTag(std::ostream& into, const std::string& xmlElement) {
+    if (!myHaveHeader) {
+        writeXMLHeader(into, xmlElement);
+        return;
+    }
+    Table* table = 0;
+    std::map<std::string, Table*>::const_iterator i = myTables.find(xmlElement);
+    if (i == myTables.end()) {
+        table = new Table();
+        table->id = (unsigned int)myTableList.size();
+        table->name = xmlElement;
+        table->rows = 0;
+        myTables[xmlElement] = table;
+        myTableList.push_back(table);
+    } else {
+        table = i->second;
+    }
+    table->rows++;
+    myStack.push_back(table);
+}
+
+
+void
+ColumnarFormatter::openTag(std::ostream& into, const SumoXMLTag& xmlElement) {
+    openTag(into, toString(xmlElement));
+}
+
+
+bool
+ColumnarFormatter::closeTag(std::ostream& into) {
+    if (myStack.empty()) {
+        return false;
+    }
+    Table* const table = myStack.back();
+    myStack.pop_back();
+    if (table == 0) {
+        // the root element
+        for (std::vector<Table*>::iterator i = myTableList.begin(); i != myTableList.end(); ++i) {
+            if ((*i)->rows > 0) {
+                writeBlock(into, **i);
+            }
+        }
+        writeFooter(into);
+        into.flush();
+        return true;
+    }
+    completeRows(*table);
+    if (table->rows >= myBlockRows) {
+        writeBlock(into, *table);
+    }
+    return true;
+}
+
+
+void
+ColumnarFormatter::writePreformattedTag(std::ostream& /* into */, const std::string& /* val */) {
+    throw ProcessError("Preformatted output is not supported by the columnar format.");
+}
+
+
+ColumnarFormatter::Column&
+ColumnarFormatter::getColumn(const std::string& name, ColumnType type) {
+    if (myStack.empty() || myStack.back() == 0) {
+        throw ProcessError("Attribute '" + name + "' written outside of a row.");
+    }
+    Table& table = *myStack.back();
+    for (std::vector<Column>::iterator i = table.columns.begin(); i != table.columns.end(); ++i) {
+        if (i->name == name) {
+            return *i;
+        }
+    }
+    table.columns.push_back(Column());
+    Column& column = table.columns.back();
+    column.name = name;
+    column.type = type;
+    return column;
+}
+
+
+void
+ColumnarFormatter::writeInt(const std::string& attr, SUMOLong val) {
+    Column& column = getColumn(attr, COLUMN_INT);
+    const unsigned int row = myStack.back()->rows - 1;
+    switch (column.type) {
+        case COLUMN_INT:
+            column.ints.resize(row, 0);
+            column.ints.push_back(val);
+            break;
+        case COLUMN_FLOAT:
+            writeFloat(attr, (SUMOReal)val);
+            break;
+        default:
+            writeString(attr, toString(val));
+            break;
+    }
+}
+
+
+void
+ColumnarFormatter::writeFloat(const std::string& attr, SUMOReal val) {
+    Column& column = getColumn(attr, COLUMN_FLOAT);
+    const unsigned int row = myStack.back()->rows - 1;
+    switch (column.type) {
+        case COLUMN_FLOAT:
+            column.floats.resize(row, 0);
+            column.floats.push_back(val);
+            break;
+        case COLUMN_STRING:
+            column.strings.resize(row);
+            column.strings.push_back(toString(val));
+            break;
+        default:
+            throw ProcessError("Column '" + attr + "' of table '" + myStack.back()->name + "' holds integers.");
+    }
+}
+
+
+void
+ColumnarFormatter::writeString(const std::string& attr, const std::string& val) {
+    Column& column = getColumn(attr, COLUMN_STRING);
+    if (column.type != COLUMN_STRING) {
+        throw ProcessError("Column '" + attr + "' of table '" + myStack.back()->name + "' holds numbers.");
+    }
+    const unsigned int row = myStack.back()->rows - 1;
+    column.strings.resize(row);
+    column.strings.push_back(val);
+}
+
+
+void
+ColumnarFormatter::completeRows(Table& table) {
+    for (std::vector<Column>::iterator i = table.columns.begin(); i != table.columns.end(); ++i) {
+        switch (i->type) {
+            case COLUMN_INT:
+                i->ints.resize(table.rows, 0);
+                break;
+            case COLUMN_FLOAT:
+                i->floats.resize(table.rows, 0);
+                break;
+            default:
+                i->strings.resize(table.rows);
+                break;
+        }
+    }
+}
+
+
+void
+ColumnarFormatter::writeBlock(std::ostream& into, Table& table) {
+    completeRows(table);
+    const unsigned int numColumns = (unsigned int)table.columns.size();
+    std::vector<unsigned char> encodings(numColumns);
+    std::vector<unsigned int> sizes(numColumns);
+    std::string chunk;
+    for (unsigned int i = 0; i < numColumns; ++i) {
+        chunk.clear();
+        encodings[i] = (unsigned char)encodeColumn(table.columns[i], chunk);
+        sizes[i] = (unsigned int)chunk.size();
+        write(into, chunk.data(), sizes[i]);
+        table.columns[i].ints.clear();
+        table.columns[i].floats.clear();
+        table.columns[i].strings.clear();
+    }
+    myBlockOffsets.push_back(myPosition);
+    write(into, &table.id, sizeof(unsigned int));
+    write(into, &table.rows, sizeof(unsigned int));
+    write(into, &numColumns, sizeof(unsigned int));
+    for (unsigned int i = 0; i < numColumns; ++i) {
+        write(into, &encodings[i], 1);
+        write(into, &sizes[i], sizeof(unsigned int));
+    }
+    table.rows = 0;
+}
+
+
+ColumnarFormatter::Encoding
+ColumnarFormatter::encodeColumn(const Column& column, std::string& into) const {
+    std::string plain;
+    std::string rle;
+    std::string delta;
+    switch (column.type) {
+        case COLUMN_INT: {
+            SUMOLong prev = 0;
+            for (std::vector<SUMOLong>::const_iterator i = column.ints.begin(); i != column.ints.end(); ++i) {
+                appendRaw(plain, *i);
+                if (myEncode) {
+                    appendZigzag(delta, *i - prev);
+                    prev = *i;
+                    std::vector<SUMOLong>::const_iterator j = i;
+                    while (j + 1 != column.ints.end() && *(j + 1) == *i) {
+                        ++j;
+                    }
+                    appendVarint(rle, (unsigned SUMOLong)(j - i + 1));
+                    appendZigzag(rle, *i);
+                    for (; i != j; ++i) {
+                        appendRaw(plain, *i);
+                        appendZigzag(delta, 0);
+                    }
+                }
+            }
+            break;
+        }
+        case COLUMN_FLOAT:
+            for (std::vector<SUMOReal>::const_iterator i = column.floats.begin(); i != column.floats.end(); ++i) {
+                appendRaw(plain, *i);
+                if (myEncode) {
+                    std::vector<SUMOReal>::const_iterator j = i;
+                    while (j + 1 != column.floats.end() && memcmp(&*(j + 1), &*i, sizeof(SUMOReal)) == 0) {
+                        ++j;
+                    }
+                    appendVarint(rle, (unsigned SUMOLong)(j - i + 1));
+                    appendRaw(rle, *i);
+                    for (; i != j; ++i) {
+                        appendRaw(plain, *i);
+                    }
+                }
+            }
+            break;
+        default:
+            for (std::vector<std::string>::const_iterator i = column.strings.begin(); i != column.strings.end(); ++i) {
+                appendString(plain, *i);
+                if (myEncode) {
+                    std::vector<std::string>::const_iterator j = i;
+                    while (j + 1 != column.strings.end() && *(j + 1) == *i) {
+                        ++j;
+                    }
+                    appendVarint(rle, (unsigned SUMOLong)(j - i + 1));
+                    appendString(rle, *i);
+                    for (; i != j; ++i) {
+                        appendString(plain, *i);
+                    }
+                }
+            }
+            break;
+    }
+    Encoding result = ENCODING_PLAIN;
+    std::string* best = &plain;
+    if (myEncode && !rle.empty() && rle.size() < best->size()) {
+        result = ENCODING_RLE;
+        best = &rle;
+    }
+    if (myEncode && column.type == COLUMN_INT && !delta.empty() && delta.size() < best->size()) {
+        result = ENCODING_DELTA;
+        best = &delta;
+    }
+    into.swap(*best);
+    return result;
+}
+
+
+void
+ColumnarFormatter::writeFooter(std::ostream& into) {
+    const SUMOLong footerOffset = myPosition;
+    write(into, myRoot);
+    const unsigned int numTables = (unsigned int)myTableList.size();
+    write(into, &numTables, sizeof(unsigned int));
+    for (std::vector<Table*>::const_iterator i = myTableList.begin(); i != myTableList.end(); ++i) {
+        write(into, (*i)->name);
+        const unsigned int numColumns = (unsigned int)(*i)->columns.size();
+        write(into, &numColumns, sizeof(unsigned int));
+        for (std::vector<Column>::const_iterator j = (*i)->columns.begin(); j != (*i)->columns.end(); ++j) {
+            write(into, j->name);
+            const unsigned char type = (unsigned char)j->type;
+            write(into, &type, 1);
+        }
+    }
+    const unsigned int numBlocks = (unsigned int)myBlockOffsets.size();
+    write(into, &numBlocks, sizeof(unsigned int));
+    for (std::vector<SUMOLong>::const_iterator i = myBlockOffsets.begin(); i != myBlockOffsets.end(); ++i) {
+        write(into, &*i, sizeof(SUMOLong));
+    }
+    write(into, &footerOffset, sizeof(SUMOLong));
+    write(into, "SCOL", 4);
+}
+
+
+void
+ColumnarFormatter::write(std::ostream& into, const void* data, unsigned int size) {
+    into.write((const char*)data, (std::streamsize)size);
+    myPosition += size;
+}
+
+
+void
+ColumnarFormatter::write(std::ostream& into, const std::string& val) {
+    const unsigned int size = (unsigned int)val.size();
+    write(into, &size, sizeof(unsigned int));
+    write(into, val.data(), size);
+}
+
+
+/****************************************************************************/
+
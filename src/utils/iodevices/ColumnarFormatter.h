@@ -0,0 +1,327 @@
+/****************************************************************************/
+/// @file    ColumnarFormatter.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Output formatter writing element attributes as column-chunked tables
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef ColumnarFormatter_h
+#define ColumnarFormatter_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <map>
+#include <string>
+#include <vector>
+#include <utils/common/ToString.h>
+#include "OutputFormatter.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class ColumnarFormatter
+ * @brief Output formatter writing element attributes as column-chunked tables
+ *
+ * Every element below the root element becomes a row of the table named
+ *  like the element; its attributes are the columns. Each block stores
+ *  all columns known when it is written, so the schema is fixed per
+ *  block; a column first seen in a later block reads as 0 or the empty
+ *  string for the earlier rows. Rows are collected in memory and
+ *  written in blocks of a fixed number of rows; within a block, each
+ *  column is stored as one contiguous chunk, so a reader may fetch single
+ *  columns without touching the others (see ColumnarReader).
+ *
+ * Layout (all numbers in the byte order of the writing machine):
+ * <pre>
+ * file    := "SCOL" version:u8 block* footer trailer
+ * block   := chunk* blockFooter
+ * chunk   := encoded values of one column
+ * blockFooter := table:u32 rows:u32 columns:u32 (encoding:u8 size:u32)*
+ * footer  := root:str tables:u32 (name:str columns:u32 (name:str type:u8)*)*
+ *            blocks:u32 (blockFooterOffset:u64)*
+ * trailer := footerOffset:u64 "SCOL"
+ * </pre>
+ *
+ * Integer columns may be delta or run length encoded, floating point and
+ *  string columns run length encoded. If encoding is enabled, each chunk
+ *  uses the smallest of the applicable encodings.
+ *
+ * Values are typed by the C++ type handed to writeAttr: integral values
+ *  (and bools) form integer columns, SUMOReal values floating point
+ *  columns and everything else string columns using toString. Attributes
+ *  missing in a row are filled with 0 or the empty string.
+ */
+class ColumnarFormatter : public OutputFormatter {
+public:
+    /// @brief The type of a column
+    enum ColumnType {
+        /// @brief 64 bit integers
+        COLUMN_INT = 0,
+        /// @brief Floating point numbers (SUMOReal)
+        COLUMN_FLOAT = 1,
+        /// @brief Strings
+        COLUMN_STRING = 2
+    };
+
+    /// @brief The encoding of a column chunk
+    enum Encoding {
+        /// @brief Values one after the other (varint length prefix for strings)
+        ENCODING_PLAIN = 0,
+        /// @brief Zigzag varint of the difference to the previous value (integers only)
+        ENCODING_DELTA = 1,
+        /// @brief Pairs of varint run length and value
+        ENCODING_RLE = 2
+    };
+
+    /// @brief The format version
+    static const unsigned char FORMAT_VERSION;
+
+
+public:
+    /** @brief Constructor
+     * @param[in] blockRows The number of rows per block
+     * @param[in] encode Whether chunks may be delta/run length encoded
+     */
+    ColumnarFormatter(unsigned int blockRows = 4096, bool encode = true);
+
+
+    /// @brief Destructor
+    virtual ~ColumnarFormatter();
+
+
+    /** @brief Writes the file header and opens the root element
+     *
+     * Additional attributes and the comment are not stored.
+     *
+     * @param[in] into The output stream to use
+     * @param[in] rootElement The root element to use
+     * @param[in] attrs Ignored
+     * @param[in] comment Ignored
+     * @return Whether the header could be written (nothing was written before)
+     */
+    bool writeXMLHeader(std::ostream& into, const std::string& rootElement,
+                        const std::string& attrs = "",
+                        const std::string& comment = "");
+
+
+    /** @brief Writes the file header and opens the root element
+     *
+     * @param[in] into The output stream to use
+     * @param[in] rootElement The root element to use
+     * @return Whether the header could be written (nothing was written before)
+     */
+    bool writeHeader(std::ostream& into, const SumoXMLTag& rootElement);
+
+
+    /** @brief Begins a new row of the table named like the element
+     *
+     * Opening the first element writes the header if this was not done before.
+     *
+     * @param[in] into The output stream to use
+     * @param[in] xmlElement Name of element to open
+     */
+    void openTag(std::ostream& into, const std::string& xmlElement);
+
+
+    /** @brief Begins a new row of the table named like the element
+     *
+     * @param[in] into The output stream to use
+     * @param[in] xmlElement Id of the element to open
+     */
+    void openTag(std::ostream& into, const SumoXMLTag& xmlElement);
+
+
+    /** @brief Completes the current row (or the file if the root is closed)
+     *
+     * Writes a block if the table has collected enough rows. Closing the
+     *  root element writes all remaining rows, the footer and the trailer.
+     *
+     * @param[in] into The output stream to use
+     * @return Whether a further element existed in the stack and could be closed
+     */
+    bool closeTag(std::ostream& into);
+
+
+    /** @brief Not supported by this format
+     * @exception ProcessError always
+     */
+    void writePreformattedTag(std::ostream& into, const std::string& val);
+
+
+    /// @brief Returns true
+    bool isColumnar() const {
+        return true;
+    }
+
+
+    /** @brief writes an attribute value into the current row
+     *
+     * @param[in] into The output stream to use
+     * @param[in] attr The attribute (name)
+     * @param[in] val The attribute value
+     * @exception ProcessError If no row is open or the value does not fit the column's type
+     */
+    template <class T>
+    void writeAttr(std::ostream& into, const std::string& attr, const T& val) {
+        writeString(attr, toString(val, into.precision()));
+    }
+
+
+    /// @brief writes an attribute value into the current row
+    template <class T>
+    void writeAttr(std::ostream& into, const SumoXMLAttr attr, const T& val) {
+        writeAttr(into, toString(attr), val);
+    }
+
+
+    /// @name typed attribute values
+    /// @{
+    void writeAttr(std::ostream&, const std::string& attr, const int& val) {
+        writeInt(attr, val);
+    }
+
+    void writeAttr(std::ostream&, const std::string& attr, const unsigned int& val) {
+        writeInt(attr, val);
+    }
+
+    void writeAttr(std::ostream&, const std::string& attr, const SUMOLong& val) {
+        writeInt(attr, val);
+    }
+
+    void writeAttr(std::ostream&, const std::string& attr, const bool& val) {
+        writeInt(attr, val ? 1 : 0);
+    }
+
+    void writeAttr(std::ostream&, const std::string& attr, const SUMOReal& val) {
+        writeFloat(attr, val);
+    }
+
+    void writeAttr(std::ostream&, const std::string& attr, const std::string& val) {
+        writeString(attr, val);
+    }
+    /// @}
+
+
+private:
+    /// @brief A column of a table with the values of the rows not written yet
+    struct Column {
+        /// @brief The column name
+        std::string name;
+        /// @brief The value type
+        ColumnType type;
+        /// @brief The values of an integer column
+        std::vector<SUMOLong> ints;
+        /// @brief The values of a floating point column
+        std::vector<SUMOReal> floats;
+        /// @brief The values of a string column
+        std::vector<std::string> strings;
+    };
+
+    /// @brief A table (all elements with the same name)
+    struct Table {
+        /// @brief The table id (order of appearance)
+        unsigned int id;
+        /// @brief The table (element) name
+        std::string name;
+        /// @brief The columns
+        std::vector<Column> columns;
+        /// @brief The number of rows begun within the current block
+        unsigned int rows;
+    };
+
+
+    /// @brief Returns the column with the given name within the currently open row, creating it if needed
+    Column& getColumn(const std::string& name, ColumnType type);
+
+    /// @brief Appends an integer to the current row
+    void writeInt(const std::string& attr, SUMOLong val);
+
+    /// @brief Appends a floating point value to the current row
+    void writeFloat(const std::string& attr, SUMOReal val);
+
+    /// @brief Appends a string to the current row
+    void writeString(const std::string& attr, const std::string& val);
+
+    /// @brief Fills the columns of the table to the number of rows
+    void completeRows(Table& table);
+
+    /// @brief Writes the collected rows of the table as a block
+    void writeBlock(std::ostream& into, Table& table);
+
+    /// @brief Encodes a chunk, choosing the encoding; returns the encoding used
+    Encoding encodeColumn(const Column& column, std::string& into) const;
+
+    /// @brief Writes the footer and the trailer
+    void writeFooter(std::ostream& into);
+
+    /// @brief Writes raw bytes, keeping track of the position
+    void write(std::ostream& into, const void* data, unsigned int size);
+
+    /// @brief Writes a length prefixed string, keeping track of the position
+    void write(std::ostream& into, const std::string& val);
+
+
+private:
+    /// @brief The number of rows per block
+    const unsigned int myBlockRows;
+
+    /// @brief Whether encodings other than plain may be used
+    const bool myEncode;
+
+    /// @brief The name of the root element
+    std::string myRoot;
+
+    /// @brief Whether the header has been written
+    bool myHaveHeader;
+
+    /// @brief The tables by name
+    std::map<std::string, Table*> myTables;
+
+    /// @brief The tables in order of appearance
+    std::vector<Table*> myTableList;
+
+    /// @brief The tables of the open elements (0 for the root)
+    std::vector<Table*> myStack;
+
+    /// @brief The offsets of the written block footers
+    std::vector<SUMOLong> myBlockOffsets;
+
+    /// @brief The number of bytes written
+    SUMOLong myPosition;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    ColumnarFormatter(const ColumnarFormatter&);
+
+    /// @brief Invalidated assignment operator.
+    ColumnarFormatter& operator=(const ColumnarFormatter&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -0,0 +1,378 @@
+/****************************************************************************/
+/// @file    ColumnarReader.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Reads single columns of files written by the ColumnarFormatter
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <cstring>
+#include <utils/common/UtilExceptions.h>
+#include <utils/common/ToString.h>
+#include "ColumnarReader.h"
+
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif // CHECK_MEMORY_LEAKS
+
+
+// ===========================================================================
+// static helpers
+// ===========================================================================
+namespace {
+/**
+ * @class ChunkDecoder
+ * @brief Sequential access to the bytes of a chunk
+ */
+class ChunkDecoder {
+public:
+    ChunkDecoder(const std::vector<char>& buffer)
+        : myPos(buffer.empty() ? 0 : &buffer[0]), myEnd(myPos + buffer.size()) {}
+
+    bool atEnd() const {
+        return myPos >= myEnd;
+    }
+
+    unsigned SUMOLong varint() {
+        unsigned SUMOLong result = 0;
+        for (unsigned int shift = 0; shift < 64; shift += 7) {
+            check(1);
+            const unsigned char byte = (unsigned char) * myPos++;
+            result |= (unsigned SUMOLong)(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return result;
+            }
+        }
+        throw ProcessError("Invalid varint in columnar chunk.");
+    }
+
+    SUMOLong zigzag() {
+        const unsigned SUMOLong val = varint();
+        return (SUMOLong)(val >> 1) ^ -(SUMOLong)(val & 1);
+    }
+
+    template <typename T>
+    T raw() {
+        T result;
+        check(sizeof(T));
+        memcpy(&result, myPos, sizeof(T));
+        myPos += sizeof(T);
+        return result;
+    }
+
+    std::string string() {
+        const unsigned int size = (unsigned int)varint();
+        check(size);
+        const std::string result(myPos, size);
+        myPos += size;
+        return result;
+    }
+
+private:
+    void check(unsigned int num) const {
+        if ((unsigned int)(myEnd - myPos) < num) {
+            throw ProcessError("Unexpected end of columnar chunk.");
+        }
+    }
+
+    const char* myPos;
+    const char* const myEnd;
+};
+}
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+ColumnarReader::ColumnarReader(const std::string& file)
+    : myFileName(file), myStream(file.c_str(), std::ios::binary) {
+    if (!myStream.good()) {
+        throw IOError("Could not open '" + file + "'.");
+    }
+    char magic[5];
+    read(magic, 5);
+    if (memcmp(magic, "SCOL", 4) != 0 || (unsigned char)magic[4] != ColumnarFormatter::FORMAT_VERSION) {
+        throw ProcessError("'" + file + "' is no columnar file of version " + toString((int)ColumnarFormatter::FORMAT_VERSION) + ".");
+    }
+    myStream.seekg(-(std::streamoff)(sizeof(SUMOLong) + 4), std::ios::end);
+    SUMOLong footerOffset;
+    read(&footerOffset, sizeof(SUMOLong));
+    read(magic, 4);
+    if (memcmp(magic, "SCOL", 4) != 0) {
+        throw ProcessError("'" + file + "' is incomplete (missing trailer).");
+    }
+    myStream.seekg((std::streamoff)footerOffset);
+    myRoot = readString();
+    unsigned int numTables;
+    read(&numTables, sizeof(unsigned int));
+    myTables.resize(numTables);
+    for (std::vector<TableInfo>::iterator i = myTables.begin(); i != myTables.end(); ++i) {
+        i->name = readString();
+        unsigned int numColumns;
+        read(&numColumns, sizeof(unsigned int));
+        i->columns.resize(numColumns);
+        for (std::vector<ColumnInfo>::iterator j = i->columns.begin(); j != i->columns.end(); ++j) {
+            j->name = readString();
+            unsigned char type;
+            read(&type, 1);
+            j->type = (ColumnarFormatter::ColumnType)type;
+        }
+    }
+    unsigned int numBlocks;
+    read(&numBlocks, sizeof(unsigned int));
+    std::vector<SUMOLong> blockOffsets(numBlocks);
+    for (std::vector<SUMOLong>::iterator i = blockOffsets.begin(); i != blockOffsets.end(); ++i) {
+        read(&*i, sizeof(SUMOLong));
+    }
+    for (std::vector<SUMOLong>::const_iterator i = blockOffsets.begin(); i != blockOffsets.end(); ++i) {
+        myStream.seekg((std::streamoff)*i);
+        unsigned int tableID, rows, numColumns;
+        read(&tableID, sizeof(unsigned int));
+        read(&rows, sizeof(unsigned int));
+        read(&numColumns, sizeof(unsigned int));
+        if (tableID >= myTables.size() || numColumns > myTables[tableID].columns.size()) {
+            throw ProcessError("Invalid block index in '" + file + "'.");
+        }
+        TableInfo& table = myTables[tableID];
+        table.blockRows.push_back(rows);
+        // the chunks precede the block footer
+        std::vector<Chunk> chunks(numColumns);
+        SUMOLong size = 0;
+        for (std::vector<Chunk>::iterator j = chunks.begin(); j != chunks.end(); ++j) {
+            unsigned char encoding;
+            read(&encoding, 1);
+            read(&j->size, sizeof(unsigned int));
+            j->encoding = (ColumnarFormatter::Encoding)encoding;
+            size += j->size;
+        }
+        SUMOLong offset = *i - size;
+        for (std::vector<Chunk>::iterator j = chunks.begin(); j != chunks.end(); ++j) {
+            j->offset = offset;
+            offset += j->size;
+        }
+        // columns added after this block was written have no chunk
+        Chunk missing;
+        missing.offset = 0;
+        missing.size = 0;
+        missing.encoding = ColumnarFormatter::ENCODING_PLAIN;
+        chunks.resize(table.columns.size(), missing);
+        table.chunks.insert(table.chunks.end(), chunks.begin(), chunks.end());
+    }
+}
+
+
+ColumnarReader::~ColumnarReader() {}
+
+
+std::vector<std::string>
+ColumnarReader::getTables() const {
+    std::vector<std::string> result;
+    for (std::vector<TableInfo>::const_iterator i = myTables.begin(); i != myTables.end(); ++i) {
+        result.push_back(i->name);
+    }
+    return result;
+}
+
+
+const std::vector<ColumnarReader::ColumnInfo>&
+ColumnarReader::getColumns(const std::string& table) const {
+    return getTable(table).columns;
+}
+
+
+unsigned int
+ColumnarReader::getNumRows(const std::string& table) const {
+    const TableInfo& info = getTable(table);
+    unsigned int result = 0;
+    for (std::vector<unsigned int>::const_iterator i = info.blockRows.begin(); i != info.blockRows.end(); ++i) {
+        result += *i;
+    }
+    return result;
+}
+
+
+void
+ColumnarReader::readColumn(const std::string& table, const std::string& column, std::vector<SUMOLong>& into) {
+    const TableInfo& info = getTable(table);
+    const unsigned int index = getColumnIndex(info, column);
+    if (info.columns[index].type != ColumnarFormatter::COLUMN_INT) {
+        throw ProcessError("Column '" + column + "' of table '" + table + "' holds no integers.");
+    }
+    into.clear();
+    const unsigned int numColumns = (unsigned int)info.columns.size();
+    for (unsigned int block = 0; block < info.blockRows.size(); ++block) {
+        const Chunk& chunk = info.chunks[block * numColumns + index];
+        const size_t end = into.size() + info.blockRows[block];
+        readChunk(chunk);
+        ChunkDecoder decoder(myBuffer);
+        SUMOLong prev = 0;
+        while (!decoder.atEnd() && into.size() < end) {
+            switch (chunk.encoding) {
+                case ColumnarFormatter::ENCODING_DELTA:
+                    prev += decoder.zigzag();
+                    into.push_back(prev);
+                    break;
+                case ColumnarFormatter::ENCODING_RLE: {
+                    const size_t run = (size_t)decoder.varint();
+                    into.resize(into.size() + run, decoder.zigzag());
+                    break;
+                }
+                default:
+                    into.push_back(decoder.raw<SUMOLong>());
+                    break;
+            }
+        }
+        into.resize(end, 0);
+    }
+}
+
+
+void
+ColumnarReader::readColumn(const std::string& table, const std::string& column, std::vector<SUMOReal>& into) {
+    const TableInfo& info = getTable(table);
+    const unsigned int index = getColumnIndex(info, column);
+    if (info.columns[index].type == ColumnarFormatter::COLUMN_INT) {
+        std::vector<SUMOLong> ints;
+        readColumn(table, column, ints);
+        into.assign(ints.begin(), ints.end());
+        return;
+    }
+    if (info.columns[index].type != ColumnarFormatter::COLUMN_FLOAT) {
+        throw ProcessError("Column '" + column + "' of table '" + table + "' is not numerical.");
+    }
+    into.clear();
+    const unsigned int numColumns = (unsigned int)info.columns.size();
+    for (unsigned int block = 0; block < info.blockRows.size(); ++block) {
+        const Chunk& chunk = info.chunks[block * numColumns + index];
+        const size_t end = into.size() + info.blockRows[block];
+        readChunk(chunk);
+        ChunkDecoder decoder(myBuffer);
+        while (!decoder.atEnd() && into.size() < end) {
+            if (chunk.encoding == ColumnarFormatter::ENCODING_RLE) {
+                const size_t run = (size_t)decoder.varint();
+                into.resize(into.size() + run, decoder.raw<SUMOReal>());
+            } else {
+                into.push_back(decoder.raw<SUMOReal>());
+            }
+        }
+        into.resize(end, 0);
+    }
+}
+
+
+void
+ColumnarReader::readColumn(const std::string& table, const std::string& column, std::vector<std::string>& into) {
+    const TableInfo& info = getTable(table);
+    const unsigned int index = getColumnIndex(info, column);
+    into.clear();
+    if (info.columns[index].type == ColumnarFormatter::COLUMN_INT) {
+        std::vector<SUMOLong> ints;
+        readColumn(table, column, ints);
+        for (std::vector<SUMOLong>::const_iterator i = ints.begin(); i != ints.end(); ++i) {
+            into.push_back(toString(*i));
+        }
+        return;
+    }
+    if (info.columns[index].type == ColumnarFormatter::COLUMN_FLOAT) {
+        std::vector<SUMOReal> floats;
+        readColumn(table, column, floats);
+        for (std::vector<SUMOReal>::const_iterator i = floats.begin(); i != floats.end(); ++i) {
+            into.push_back(toString(*i));
+        }
+        return;
+    }
+    const unsigned int numColumns = (unsigned int)info.columns.size();
+    for (unsigned int block = 0; block < info.blockRows.size(); ++block) {
+        const Chunk& chunk = info.chunks[block * numColumns + index];
+        const size_t end = into.size() + info.blockRows[block];
+        readChunk(chunk);
+        ChunkDecoder decoder(myBuffer);
+        while (!decoder.atEnd() && into.size() < end) {
+            if (chunk.encoding == ColumnarFormatter::ENCODING_RLE) {
+                const size_t run = (size_t)decoder.varint();
+                into.resize(into.size() + run, decoder.string());
+            } else {
+                into.push_back(decoder.string());
+            }
+        }
+        into.resize(end);
+    }
+}
+
+
+const ColumnarReader::TableInfo&
+ColumnarReader::getTable(const std::string& table) const {
+    for (std::vector<TableInfo>::const_iterator i = myTables.begin(); i != myTables.end(); ++i) {
+        if (i->name == table) {
+            return *i;
+        }
+    }
+    throw ProcessError("Unknown table '" + table + "' in '" + myFileName + "'.");
+}
+
+
+unsigned int
+ColumnarReader::getColumnIndex(const TableInfo& table, const std::string& column) const {
+    for (unsigned int i = 0; i < table.columns.size(); ++i) {
+        if (table.columns[i].name == column) {
+            return i;
+        }
+    }
+    throw ProcessError("Unknown column '" + column + "' in table '" + table.name + "'.");
+}
+
+
+void
+ColumnarReader::readChunk(const Chunk& chunk) {
+    myBuffer.resize(chunk.size);
+    if (chunk.size > 0) {
+        myStream.seekg((std::streamoff)chunk.offset);
+        read(&myBuffer[0], chunk.size);
+    }
+}
+
+
+void
+ColumnarReader::read(void* into, unsigned int size) {
+    myStream.read((char*)into, (std::streamsize)size);
+    if (!myStream.good()) {
+        throw ProcessError("Unexpected end of '" + myFileName + "'.");
+    }
+}
+
+
+std::string
+ColumnarReader::readString() {
+    unsigned int size;
+    read(&size, sizeof(unsigned int));
+    std::string result(size, ' ');
+    if (size > 0) {
+        read(&result[0], size);
+    }
+    return result;
+}
+
+
+/****************************************************************************/
+
@@ -0,0 +1,194 @@
+/****************************************************************************/
+/// @file    ColumnarReader.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Reads single columns of files written by the ColumnarFormatter
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef ColumnarReader_h
+#define ColumnarReader_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include "ColumnarFormatter.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class ColumnarReader
+ * @brief Reads single columns of files written by the ColumnarFormatter
+ *
+ * On construction only the footer and the block footers are read. A column
+ *  is read by seeking to its chunk within each block of the table, so
+ *  reading one column touches only the bytes of this column.
+ *
+ * @see ColumnarFormatter
+ */
+class ColumnarReader {
+public:
+    /// @brief The description of a column
+    struct ColumnInfo {
+        /// @brief The column name
+        std::string name;
+        /// @brief The value type
+        ColumnarFormatter::ColumnType type;
+    };
+
+
+public:
+    /** @brief Constructor, reads the index
+     * @param[in] file The file to read
+     * @exception IOError If the file can not be opened
+     * @exception ProcessError If the file is no (complete) columnar file
+     */
+    ColumnarReader(const std::string& file);
+
+
+    /// @brief Destructor
+    ~ColumnarReader();
+
+
+    /// @brief Returns the name of the root element
+    const std::string& getRoot() const {
+        return myRoot;
+    }
+
+
+    /// @brief Returns the names of all tables
+    std::vector<std::string> getTables() const;
+
+
+    /** @brief Returns the columns of the named table
+     * @exception ProcessError If the table does not exist
+     */
+    const std::vector<ColumnInfo>& getColumns(const std::string& table) const;
+
+
+    /** @brief Returns the number of rows of the named table
+     * @exception ProcessError If the table does not exist
+     */
+    unsigned int getNumRows(const std::string& table) const;
+
+
+    /** @brief Reads an integer column
+     * @param[in] table The table name
+     * @param[in] column The column name
+     * @param[out] into The vector to fill (cleared first)
+     * @exception ProcessError If the column does not exist or does not hold integers
+     */
+    void readColumn(const std::string& table, const std::string& column, std::vector<SUMOLong>& into);
+
+
+    /** @brief Reads a numerical column (integer columns are converted)
+     * @param[in] table The table name
+     * @param[in] column The column name
+     * @param[out] into The vector to fill (cleared first)
+     * @exception ProcessError If the column does not exist or is a string column
+     */
+    void readColumn(const std::string& table, const std::string& column, std::vector<SUMOReal>& into);
+
+
+    /** @brief Reads a column as strings (numbers are converted using toString)
+     * @param[in] table The table name
+     * @param[in] column The column name
+     * @param[out] into The vector to fill (cleared first)
+     * @exception ProcessError If the column does not exist
+     */
+    void readColumn(const std::string& table, const std::string& column, std::vector<std::string>& into);
+
+
+private:
+    /// @brief A chunk of a column
+    struct Chunk {
+        /// @brief The chunk's file offset
+        SUMOLong offset;
+        /// @brief The chunk's size in bytes
+        unsigned int size;
+        /// @brief The encoding
+        ColumnarFormatter::Encoding encoding;
+    };
+
+    /// @brief The description and index of a table
+    struct TableInfo {
+        /// @brief The table name
+        std::string name;
+        /// @brief The columns
+        std::vector<ColumnInfo> columns;
+        /// @brief The number of rows per block
+        std::vector<unsigned int> blockRows;
+        /// @brief The chunks per block (columns consecutive)
+        std::vector<Chunk> chunks;
+    };
+
+
+    /// @brief Returns the named table
+    const TableInfo& getTable(const std::string& table) const;
+
+    /// @brief Returns the index of the named column within the table
+    unsigned int getColumnIndex(const TableInfo& table, const std::string& column) const;
+
+    /// @brief Reads the given chunk into the buffer
+    void readChunk(const Chunk& chunk);
+
+    /// @brief Reads raw bytes at the current position
+    void read(void* into, unsigned int size);
+
+    /// @brief Reads a length prefixed string at the current position
+    std::string readString();
+
+
+private:
+    /// @brief The file name
+    const std::string myFileName;
+
+    /// @brief The read stream
+    std::ifstream myStream;
+
+    /// @brief The root element name
+    std::string myRoot;
+
+    /// @brief The tables in order of appearance
+    std::vector<TableInfo> myTables;
+
+    /// @brief The buffer holding the chunk being decoded
+    std::vector<char> myBuffer;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    ColumnarReader(const ColumnarReader&);
+
+    /// @brief Invalidated assignment operator.
+    ColumnarReader& operator=(const ColumnarReader&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -0,0 +1,422 @@
+/****************************************************************************/
+/// @file    MappedBinaryInputDevice.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Zero-copy reader for binary SUMO files using a memory mapping
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2005-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <cstring>
+#include <fstream>
+#include <utils/common/UtilExceptions.h>
+#include <utils/common/ToString.h>
+#include "MappedBinaryInputDevice.h"
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif // CHECK_MEMORY_LEAKS
+
+
+// ===========================================================================
+// static helpers
+// ===========================================================================
+namespace {
+/// @brief Reads an unaligned int from the mapping
+inline int
+readIntAt(const char* at) {
+    int result;
+    memcpy(&result, at, sizeof(int));
+    return result;
+}
+
+/// @brief Reads an unaligned floating point number from the mapping
+inline SUMOReal
+readFloatAt(const char* at) {
+    SUMOReal result;
+    memcpy(&result, at, sizeof(SUMOReal));
+    return result;
+}
+}
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+// ---------------------------------------------------------------------------
+// MappedBinaryInputDevice::Value - methods
+// ---------------------------------------------------------------------------
+int
+MappedBinaryInputDevice::Value::getInt() const {
+    switch (myType) {
+        case BinaryFormatter::BF_BYTE:
+        case BinaryFormatter::BF_NODE_TYPE:
+        case BinaryFormatter::BF_EDGE_FUNCTION:
+            return (unsigned char)myData[0];
+        case BinaryFormatter::BF_INTEGER:
+        case BinaryFormatter::BF_EDGE:
+        case BinaryFormatter::BF_LANE:
+            return readIntAt(myData);
+        default:
+            throw ProcessError("Binary value of type " + toString((int)myType) + " is no integer.");
+    }
+}
+
+
+SUMOReal
+MappedBinaryInputDevice::Value::getFloat() const {
+    switch (myType) {
+        case BinaryFormatter::BF_FLOAT:
+            return readFloatAt(myData);
+        case BinaryFormatter::BF_SCALED2INT:
+            return (SUMOReal) readIntAt(myData) / (SUMOReal) 100.;
+        default:
+            return (SUMOReal) getInt();
+    }
+}
+
+
+StringRef
+MappedBinaryInputDevice::Value::getString() const {
+    if (myType != BinaryFormatter::BF_STRING) {
+        throw ProcessError("Binary value of type " + toString((int)myType) + " is no string.");
+    }
+    return StringRef(myData + sizeof(int), mySize - (unsigned int)sizeof(int));
+}
+
+
+unsigned int
+MappedBinaryInputDevice::Value::getCoordinates(SUMOReal into[4]) const {
+    switch (myType) {
+        case BinaryFormatter::BF_POSITION_2D:
+        case BinaryFormatter::BF_POSITION_3D:
+        case BinaryFormatter::BF_BOUNDARY: {
+            const unsigned int num = mySize / (unsigned int)sizeof(SUMOReal);
+            for (unsigned int i = 0; i < num; ++i) {
+                into[i] = readFloatAt(myData + i * sizeof(SUMOReal));
+            }
+            return num;
+        }
+        case BinaryFormatter::BF_SCALED2INT_POSITION_2D:
+        case BinaryFormatter::BF_SCALED2INT_POSITION_3D: {
+            const unsigned int num = mySize / (unsigned int)sizeof(int);
+            for (unsigned int i = 0; i < num; ++i) {
+                into[i] = (SUMOReal) readIntAt(myData + i * sizeof(int)) / (SUMOReal) 100.;
+            }
+            return num;
+        }
+        default:
+            throw ProcessError("Binary value of type " + toString((int)myType) + " is no position.");
+    }
+}
+
+
+unsigned int
+MappedBinaryInputDevice::Value::getListSize() const {
+    if (myType != BinaryFormatter::BF_LIST) {
+        throw ProcessError("Binary value of type " + toString((int)myType) + " is no list.");
+    }
+    return (unsigned int)readIntAt(myData);
+}
+
+
+void
+MappedBinaryInputDevice::Value::getListEntries(std::vector<Value>& into) const {
+    const unsigned int num = getListSize();
+    into.clear();
+    into.reserve(num);
+    const char* const end = myData + mySize;
+    const char* pos = myData + sizeof(int);
+    for (unsigned int i = 0; i < num; ++i) {
+        const BinaryFormatter::DataType type = (BinaryFormatter::DataType)(unsigned char) * pos;
+        const unsigned int size = payloadSize(type, pos + 1, end);
+        into.push_back(Value(type, pos + 1, size));
+        pos += 1 + size;
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// MappedBinaryInputDevice - methods
+// ---------------------------------------------------------------------------
+MappedBinaryInputDevice::MappedBinaryInputDevice(const std::string& name)
+    : myFileName(name), myBegin(0), myEnd(0), myPos(0), myAmMapped(false),
+      myTokenType(TOKEN_EOF), myTag(-1), myAttribute(-1) {
+#ifndef WIN32
+    const int fd = open(name.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw IOError("Could not open '" + name + "'.");
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw IOError("Could not determine the size of '" + name + "'.");
+    }
+    if (info.st_size > 0) {
+        void* const data = mmap(0, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) {
+            throw IOError("Could not map '" + name + "'.");
+        }
+#ifdef MADV_SEQUENTIAL
+        madvise(data, (size_t)info.st_size, MADV_SEQUENTIAL);
+#endif
+        myBegin = (const char*)data;
+        myEnd = myBegin + info.st_size;
+        myAmMapped = true;
+    } else {
+        close(fd);
+    }
+#else
+    std::ifstream strm(name.c_str(), std::ios::binary);
+    if (!strm.good()) {
+        throw IOError("Could not open '" + name + "'.");
+    }
+    strm.seekg(0, std::ios::end);
+    const std::streamoff size = strm.tellg();
+    strm.seekg(0, std::ios::beg);
+    if (size > 0) {
+        char* const data = new char[(size_t)size];
+        strm.read(data, size);
+        myBegin = data;
+        myEnd = myBegin + size;
+    }
+#endif
+    myPos = myBegin;
+}
+
+
+MappedBinaryInputDevice::~MappedBinaryInputDevice() {
+    if (myBegin == 0) {
+        return;
+    }
+#ifndef WIN32
+    if (myAmMapped) {
+        munmap((void*)myBegin, (size_t)(myEnd - myBegin));
+        return;
+    }
+#endif
+    delete[] myBegin;
+}
+
+
+void
+MappedBinaryInputDevice::readHeader() {
+    myPos = myBegin;
+    checkAvailable(myPos, myEnd, 2);
+    if (myPos[0] != BinaryFormatter::BF_BYTE || myPos[1] != 1) {
+        throw ProcessError("Unknown binary format version in '" + myFileName + "'.");
+    }
+    myPos += 2;
+    const Value version = readValue();
+    version.getString();
+    readStringList(myTagNames);
+    readStringList(myAttributeNames);
+    std::vector<StringRef> ignored;
+    readStringList(ignored); // node types
+    readStringList(ignored); // edge functions
+    myEdgeNames.clear();
+    if (myPos < myEnd && *myPos == BinaryFormatter::BF_LIST) {
+        readStringList(myEdgeNames);
+    }
+    // skip any further header lists (e.g. the edge successors)
+    while (myPos < myEnd && *myPos == BinaryFormatter::BF_LIST) {
+        readValue();
+    }
+    myTokenType = TOKEN_VALUE;
+}
+
+
+MappedBinaryInputDevice::TokenType
+MappedBinaryInputDevice::next() {
+    if (myPos >= myEnd) {
+        myTokenType = TOKEN_EOF;
+        return myTokenType;
+    }
+    const BinaryFormatter::DataType type = (BinaryFormatter::DataType)(unsigned char) * myPos;
+    switch (type) {
+        case BinaryFormatter::BF_XML_TAG_START:
+            checkAvailable(myPos, myEnd, 2);
+            myTag = (unsigned char)myPos[1];
+            myPos += 2;
+            myTokenType = TOKEN_TAG_START;
+            break;
+        case BinaryFormatter::BF_XML_TAG_END:
+            myPos += 1;
+            myTokenType = TOKEN_TAG_END;
+            break;
+        case BinaryFormatter::BF_XML_ATTRIBUTE:
+            checkAvailable(myPos, myEnd, 2);
+            myAttribute = (unsigned char)myPos[1];
+            myPos += 2;
+            myValue = readValue();
+            myTokenType = TOKEN_ATTRIBUTE;
+            break;
+        default:
+            myValue = readValue();
+            myTokenType = TOKEN_VALUE;
+            break;
+    }
+    return myTokenType;
+}
+
+
+unsigned int
+MappedBinaryInputDevice::readAttributes(std::vector<Attribute>& into) {
+    into.clear();
+    while (myPos < myEnd && *myPos == BinaryFormatter::BF_XML_ATTRIBUTE) {
+        next();
+        into.push_back(Attribute());
+        into.back().id = myAttribute;
+        into.back().value = myValue;
+    }
+    return (unsigned int)into.size();
+}
+
+
+MappedBinaryInputDevice::Value
+MappedBinaryInputDevice::readValue() {
+    checkAvailable(myPos, myEnd, 1);
+    const BinaryFormatter::DataType type = (BinaryFormatter::DataType)(unsigned char) * myPos;
+    const char* const data = myPos + 1;
+    const unsigned int size = payloadSize(type, data, myEnd);
+    myPos = data + size;
+    return Value(type, data, size);
+}
+
+
+unsigned int
+MappedBinaryInputDevice::payloadSize(BinaryFormatter::DataType type, const char* at, const char* end) {
+    unsigned int size = 0;
+    switch (type) {
+        case BinaryFormatter::BF_BYTE:
+        case BinaryFormatter::BF_NODE_TYPE:
+        case BinaryFormatter::BF_EDGE_FUNCTION:
+            size = 1;
+            break;
+        case BinaryFormatter::BF_INTEGER:
+        case BinaryFormatter::BF_EDGE:
+        case BinaryFormatter::BF_LANE:
+        case BinaryFormatter::BF_SCALED2INT:
+            size = (unsigned int)sizeof(int);
+            break;
+        case BinaryFormatter::BF_FLOAT:
+            size = (unsigned int)sizeof(SUMOReal);
+            break;
+        case BinaryFormatter::BF_STRING:
+            checkAvailable(at, end, sizeof(int));
+            if (readIntAt(at) < 0) {
+                throw ProcessError("Negative binary string length.");
+            }
+            size = (unsigned int)sizeof(int) + (unsigned int)readIntAt(at);
+            break;
+        case BinaryFormatter::BF_POSITION_2D:
+            size = 2 * (unsigned int)sizeof(SUMOReal);
+            break;
+        case BinaryFormatter::BF_POSITION_3D:
+            size = 3 * (unsigned int)sizeof(SUMOReal);
+            break;
+        case BinaryFormatter::BF_BOUNDARY:
+            size = 4 * (unsigned int)sizeof(SUMOReal);
+            break;
+        case BinaryFormatter::BF_COLOR:
+            size = 4;
+            break;
+        case BinaryFormatter::BF_SCALED2INT_POSITION_2D:
+            size = 2 * (unsigned int)sizeof(int);
+            break;
+        case BinaryFormatter::BF_SCALED2INT_POSITION_3D:
+            size = 3 * (unsigned int)sizeof(int);
+            break;
+        case BinaryFormatter::BF_LIST: {
+            checkAvailable(at, end, sizeof(int));
+            const int num = readIntAt(at);
+            const char* pos = at + sizeof(int);
+            for (int i = 0; i < num; ++i) {
+                checkAvailable(pos, end, 1);
+                const BinaryFormatter::DataType entryType = (BinaryFormatter::DataType)(unsigned char) * pos;
+                pos += 1 + payloadSize(entryType, pos + 1, end);
+            }
+            size = (unsigned int)(pos - at);
+            break;
+        }
+        case BinaryFormatter::BF_ROUTE: {
+            // see FileHelpers::writeEdgeVector
+            checkAvailable(at, end, 2 * sizeof(int));
+            const int num = readIntAt(at);
+            const int bits = readIntAt(at + sizeof(int));
+            if (num < 0 || bits < -8 * (int)sizeof(unsigned int)) {
+                throw ProcessError("Invalid binary route of " + toString(num) + " edges.");
+            }
+            unsigned long words;
+            if (bits < 0) {
+                const unsigned long numFields = 8 * sizeof(unsigned int) / (unsigned long)(-bits);
+                words = 3 + (num > 1 ? ((unsigned long)num - 1 + numFields - 1) / numFields : 0);
+            } else {
+                words = 1 + (unsigned long)num;
+            }
+            // checked in words so a damaged count cannot wrap the size
+            if (words > (unsigned long)(end - at) / sizeof(int)) {
+                throw ProcessError("Unexpected end of binary data.");
+            }
+            size = (unsigned int)(words * sizeof(int));
+            break;
+        }
+        default:
+            throw ProcessError("Unknown binary type " + toString((int)type) + ".");
+    }
+    checkAvailable(at, end, size);
+    return size;
+}
+
+
+void
+MappedBinaryInputDevice::readStringList(std::vector<StringRef>& into) {
+    const Value list = readValue();
+    std::vector<Value> entries;
+    list.getListEntries(entries);
+    into.clear();
+    into.reserve(entries.size());
+    for (std::vector<Value>::const_iterator i = entries.begin(); i != entries.end(); ++i) {
+        into.push_back(i->getString());
+    }
+}
+
+
+void
+MappedBinaryInputDevice::checkAvailable(const char* at, const char* end, unsigned long num) {
+    if (at > end || (unsigned long)(end - at) < num) {
+        throw ProcessError("Unexpected end of binary data.");
+    }
+}
+
+
+/****************************************************************************/
+
@@ -0,0 +1,347 @@
+/****************************************************************************/
+/// @file    MappedBinaryInputDevice.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Zero-copy reader for binary SUMO files using a memory mapping
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2005-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef MappedBinaryInputDevice_h
+#define MappedBinaryInputDevice_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <utils/common/StringRef.h>
+#include "BinaryFormatter.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MappedBinaryInputDevice
+ * @brief Zero-copy reader for binary SUMO files using a memory mapping
+ *
+ * In contrast to BinaryInputDevice, which extracts one value at a time from
+ *  an ifstream, this device maps the complete file into memory and walks the
+ *  token stream written by BinaryFormatter in place. Values are returned as
+ *  views (Value) pointing into the mapping; nothing is copied until a value
+ *  is actually decoded, and strings can be used as StringRef without any
+ *  allocation at all.
+ *
+ * The usual loop looks like this:
+ * <pre>
+ * MappedBinaryInputDevice in(file);
+ * in.readHeader();
+ * std::vector<MappedBinaryInputDevice::Attribute> attrs;
+ * while (in.next() != MappedBinaryInputDevice::TOKEN_EOF) {
+ *     if (in.getTokenType() == MappedBinaryInputDevice::TOKEN_TAG_START) {
+ *         in.readAttributes(attrs);
+ *         ...
+ *     }
+ * }
+ * </pre>
+ *
+ * The attribute vector keeps its capacity, so after the first few elements
+ *  parsing does not allocate anymore. All views stay valid as long as the
+ *  device exists.
+ *
+ * As with BinaryInputDevice, the byte order is the one of the writing
+ *  machine.
+ */
+class MappedBinaryInputDevice {
+public:
+    /// @brief The kind of token the device is positioned on
+    enum TokenType {
+        /// @brief An opening element (BF_XML_TAG_START)
+        TOKEN_TAG_START,
+        /// @brief A closing element (BF_XML_TAG_END)
+        TOKEN_TAG_END,
+        /// @brief An attribute of the last opened element (BF_XML_ATTRIBUTE)
+        TOKEN_ATTRIBUTE,
+        /// @brief A typed value outside of an attribute (e.g. header lists)
+        TOKEN_VALUE,
+        /// @brief The end of the file was reached
+        TOKEN_EOF
+    };
+
+
+    /**
+     * @class Value
+     * @brief A view onto a typed value within the mapping
+     */
+    class Value {
+    public:
+        /// @brief Constructor
+        Value() : myType(BinaryFormatter::BF_BYTE), myData(0), mySize(0) {}
+
+        /// @brief Constructor
+        Value(BinaryFormatter::DataType type, const char* data, unsigned int size)
+            : myType(type), myData(data), mySize(size) {}
+
+        /// @brief Returns the type of the value
+        BinaryFormatter::DataType getType() const {
+            return myType;
+        }
+
+        /// @brief Returns the raw payload (without the type byte)
+        const char* getData() const {
+            return myData;
+        }
+
+        /// @brief Returns the size of the raw payload in bytes
+        unsigned int getSize() const {
+            return mySize;
+        }
+
+        /** @brief Returns the value as integer
+         * @exception ProcessError If the value is not of an integral type
+         */
+        int getInt() const;
+
+        /** @brief Returns the value as a floating point number (unscaling BF_SCALED2INT)
+         * @exception ProcessError If the value is not numerical
+         */
+        SUMOReal getFloat() const;
+
+        /** @brief Returns a reference to the string within the mapping
+         * @exception ProcessError If the value is not a string
+         */
+        StringRef getString() const;
+
+        /** @brief Returns the coordinates of a (possibly scaled) position or of a boundary
+         *
+         * @param[out] into The array to fill; positions fill 2 or 3 entries, boundaries 4
+         * @return The number of coordinates written
+         * @exception ProcessError If the value is no position or boundary
+         */
+        unsigned int getCoordinates(SUMOReal into[4]) const;
+
+        /** @brief Returns the number of entries if the value is a list
+         * @exception ProcessError If the value is not a list
+         */
+        unsigned int getListSize() const;
+
+        /** @brief Returns the list entries as views
+         * @param[out] into The vector to fill (cleared first)
+         * @exception ProcessError If the value is not a list
+         */
+        void getListEntries(std::vector<Value>& into) const;
+
+    private:
+        /// @brief The type of the value
+        BinaryFormatter::DataType myType;
+
+        /// @brief The payload within the mapping
+        const char* myData;
+
+        /// @brief The payload length
+        unsigned int mySize;
+
+    };
+
+
+    /// @brief An attribute of an element, given as a view
+    struct Attribute {
+        /// @brief The attribute id (index into the attribute name list)
+        int id;
+        /// @brief The attribute value
+        Value value;
+    };
+
+
+public:
+    /** @brief Constructor
+     *
+     * Maps the complete file into memory.
+     *
+     * @param[in] name The name of the file to open for reading
+     * @exception IOError If the file can not be opened or mapped
+     */
+    MappedBinaryInputDevice(const std::string& name);
+
+
+    /// @brief Destructor, releases the mapping
+    ~MappedBinaryInputDevice();
+
+
+    /** @brief Reads the static header written by BinaryFormatter
+     *
+     * Checks the version and stores views onto the tag, attribute and (if
+     *  present) edge names contained within the header. Further header lists
+     *  (e.g. edge successors) are skipped.
+     *
+     * @exception ProcessError If the header is malformed
+     */
+    void readHeader();
+
+
+    /** @brief Advances to the next token
+     *
+     * Values of attributes and of unnamed values are skipped automatically
+     *  if they have not been read.
+     *
+     * @return The type of the token now current
+     * @exception ProcessError If the stream is malformed
+     */
+    TokenType next();
+
+
+    /// @brief Returns the type of the current token
+    TokenType getTokenType() const {
+        return myTokenType;
+    }
+
+
+    /// @brief Returns the tag id of the current TOKEN_TAG_START
+    int getTag() const {
+        return myTag;
+    }
+
+
+    /// @brief Returns the attribute id of the current TOKEN_ATTRIBUTE
+    int getAttributeID() const {
+        return myAttribute;
+    }
+
+
+    /// @brief Returns the value of the current TOKEN_ATTRIBUTE or TOKEN_VALUE
+    const Value& getValue() const {
+        return myValue;
+    }
+
+
+    /** @brief Collects all attributes following the current position
+     *
+     * Should be called directly after next() returned TOKEN_TAG_START. The
+     *  device is positioned on the last attribute afterwards.
+     *
+     * @param[out] into The vector to fill (cleared first, capacity is kept)
+     * @return The number of attributes read
+     */
+    unsigned int readAttributes(std::vector<Attribute>& into);
+
+
+    /// @brief Returns the tag names read from the header
+    const std::vector<StringRef>& getTagNames() const {
+        return myTagNames;
+    }
+
+
+    /// @brief Returns the attribute names read from the header
+    const std::vector<StringRef>& getAttributeNames() const {
+        return myAttributeNames;
+    }
+
+
+    /// @brief Returns the edge names read from the header (empty if the file contains none)
+    const std::vector<StringRef>& getEdgeNames() const {
+        return myEdgeNames;
+    }
+
+
+    /// @brief Returns the current read position
+    unsigned long getPosition() const {
+        return (unsigned long)(myPos - myBegin);
+    }
+
+
+    /// @brief Returns the file size
+    unsigned long getSize() const {
+        return (unsigned long)(myEnd - myBegin);
+    }
+
+
+private:
+    /** @brief Reads the typed value starting at the current position
+     * @exception ProcessError If the type is unknown or the value exceeds the file
+     */
+    Value readValue();
+
+
+    /** @brief Determines the payload length of a value of the given type at the given position
+     * @exception ProcessError If the type is unknown or the value exceeds the given end
+     */
+    static unsigned int payloadSize(BinaryFormatter::DataType type, const char* at, const char* end);
+
+
+    /// @brief Reads a list of strings (as written by BinaryFormatter::writeStringList)
+    void readStringList(std::vector<StringRef>& into);
+
+
+    /// @brief Throws a ProcessError if less than the given number of bytes remain between the position and the end
+    static void checkAvailable(const char* at, const char* end, unsigned long num);
+
+
+private:
+    /// @brief The name of the mapped file
+    const std::string myFileName;
+
+    /// @brief Begin of the mapped (or read) data
+    const char* myBegin;
+
+    /// @brief End of the mapped (or read) data
+    const char* myEnd;
+
+    /// @brief The current read position
+    const char* myPos;
+
+    /// @brief Whether the data is a mapping (or a heap buffer on platforms without mmap)
+    bool myAmMapped;
+
+    /// @brief The type of the current token
+    TokenType myTokenType;
+
+    /// @brief The current tag
+    int myTag;
+
+    /// @brief The current attribute
+    int myAttribute;
+
+    /// @brief The current value
+    Value myValue;
+
+    /// @brief Tag names from the header
+    std::vector<StringRef> myTagNames;
+
+    /// @brief Attribute names from the header
+    std::vector<StringRef> myAttributeNames;
+
+    /// @brief Edge names from the header
+    std::vector<StringRef> myEdgeNames;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    MappedBinaryInputDevice(const MappedBinaryInputDevice&);
+
+    /// @brief Invalidated assignment operator.
+    MappedBinaryInputDevice& operator=(const MappedBinaryInputDevice&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
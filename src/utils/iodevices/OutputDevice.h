@@ -39,6 +39,7 @@
 #include <utils/xml/SUMOXMLDefinitions.h>
 #include "PlainXMLFormatter.h"
 #include "BinaryFormatter.h"
+#include "ColumnarFormatter.h"
 
 
 // ===========================================================================
@@ -162,6 +163,12 @@ public:
     void close();
 
 
+    /// @brief Flushes the written data to the underlying stream
+    void flush() {
+        getOStream().flush();
+    }
+
+
     /** @brief Sets the precison or resets it to default
      * @param[in] precision The accuracy (number of digits behind '.') to set
      */
@@ -190,6 +197,9 @@ public:
         if (myAmBinary) {
             return static_cast<BinaryFormatter*>(myFormatter)->writeHeader<E>(getOStream(), rootElement);
         }
+        if (myFormatter->isColumnar()) {
+            return static_cast<ColumnarFormatter*>(myFormatter)->writeHeader(getOStream(), rootElement);
+        }
         return static_cast<PlainXMLFormatter*>(myFormatter)->writeHeader(getOStream(), rootElement);
     }
 
@@ -233,7 +243,7 @@ public:
     /** @brief writes a line feed if applicable
      */
     void lf() {
-        if (!myAmBinary) {
+        if (!myAmBinary && !myFormatter->isColumnar()) {
             getOStream() << "\n";
         }
     }
@@ -257,6 +267,8 @@ public:
     OutputDevice& writeAttr(const SumoXMLAttr attr, const T& val) {
         if (myAmBinary) {
             BinaryFormatter::writeAttr(getOStream(), attr, val);
+        } else if (myFormatter->isColumnar()) {
+            static_cast<ColumnarFormatter*>(myFormatter)->writeAttr(getOStream(), attr, val);
         } else {
             PlainXMLFormatter::writeAttr(getOStream(), attr, val);
         }
@@ -274,6 +286,8 @@ public:
     OutputDevice& writeAttr(const std::string& attr, const T& val) {
         if (myAmBinary) {
             BinaryFormatter::writeAttr(getOStream(), attr, val);
+        } else if (myFormatter->isColumnar()) {
+            static_cast<ColumnarFormatter*>(myFormatter)->writeAttr(getOStream(), attr, val);
         } else {
             PlainXMLFormatter::writeAttr(getOStream(), attr, val);
         }
@@ -326,6 +340,13 @@ public:
     }
 
 protected:
+    /** @brief Constructor for devices using a formatter other than the XML ones
+     * @param[in] formatter The formatter to use (the device gets responsible for it)
+     */
+    OutputDevice(OutputFormatter* formatter)
+        : myFormatter(formatter), myAmBinary(false) {}
+
+
     /// @brief Returns the associated ostream
     virtual std::ostream& getOStream() = 0;
 
@@ -0,0 +1,225 @@
+/****************************************************************************/
+/// @file    OutputDevice_Async.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// An output device buffering per thread and writing in the background
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2004-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <exception>
+#include <utils/common/UtilExceptions.h>
+#include "OutputDevice_Async.h"
+
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif // CHECK_MEMORY_LEAKS
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+OutputDevice_Async::OutputDevice_Async(OutputDevice* target, unsigned int blockSize,
+                                       const bool binary)
+    : OutputDevice(binary), myTarget(target), myBlockSize(blockSize),
+      myHandedOver(0), myWritten(0), myQuit(false) {
+    pthread_key_create(&myBufferKey, &OutputDevice_Async::releaseBuffer);
+    start();
+}
+
+
+OutputDevice_Async::~OutputDevice_Async() {
+    // the writing threads are expected to be done, so their buffers may be accessed
+    for (std::vector<ThreadBuffer*>::iterator i = myBuffers.begin(); i != myBuffers.end(); ++i) {
+        handOver(**i);
+    }
+    myLock.lock();
+    myQuit = true;
+    myQueued.signal();
+    myLock.unlock();
+    join();
+    pthread_key_delete(myBufferKey);
+    for (std::vector<ThreadBuffer*>::iterator i = myBuffers.begin(); i != myBuffers.end(); ++i) {
+        delete *i;
+    }
+    delete myTarget;
+}
+
+
+bool
+OutputDevice_Async::ok() {
+    AbstractMutex::ScopedLocker locker(myLock);
+    return myError.empty() && myTarget->ok();
+}
+
+
+unsigned long
+OutputDevice_Async::handOver() {
+    checkError();
+    return handOver(getBuffer());
+}
+
+
+void
+OutputDevice_Async::fence() {
+    const unsigned long sequence = handOver(getBuffer());
+    myLock.lock();
+    while (myWritten < sequence) {
+        myWrittenCondition.wait(myLock);
+    }
+    myLock.unlock();
+    checkError();
+}
+
+
+unsigned long
+OutputDevice_Async::getWrittenBlocks() {
+    AbstractMutex::ScopedLocker locker(myLock);
+    return myWritten;
+}
+
+
+std::ostream&
+OutputDevice_Async::getOStream() {
+    return getBuffer().stream;
+}
+
+
+void
+OutputDevice_Async::postWriteHook() {
+    ThreadBuffer& buffer = getBuffer();
+    if (buffer.stream.tellp() < (std::streampos)myBlockSize) {
+        return;
+    }
+    if (isBinary()) {
+        handOver(buffer);
+        return;
+    }
+    // a line may be assembled from several writes; hand over complete lines only
+    std::string block = buffer.stream.str();
+    const std::string::size_type lineEnd = block.rfind('\n');
+    if (lineEnd == std::string::npos) {
+        return;
+    }
+    buffer.stream.str("");
+    buffer.stream.write(block.data() + lineEnd + 1, (std::streamsize)(block.size() - lineEnd - 1));
+    block.resize(lineEnd + 1);
+    queue(block);
+}
+
+
+OutputDevice_Async::ThreadBuffer&
+OutputDevice_Async::getBuffer() {
+    ThreadBuffer* buffer = static_cast<ThreadBuffer*>(pthread_getspecific(myBufferKey));
+    if (buffer == 0) {
+        buffer = new ThreadBuffer();
+        buffer->owner = this;
+        myLock.lock();
+        if (!myBuffers.empty()) {
+            // inherit the precision set via setPrecision by the first writer
+            buffer->stream.copyfmt(myBuffers.front()->stream);
+        }
+        myBuffers.push_back(buffer);
+        myLock.unlock();
+        pthread_setspecific(myBufferKey, buffer);
+    }
+    return *buffer;
+}
+
+
+unsigned long
+OutputDevice_Async::handOver(ThreadBuffer& buffer) {
+    std::string block = buffer.stream.str();
+    buffer.stream.str("");
+    return queue(block);
+}
+
+
+unsigned long
+OutputDevice_Async::queue(std::string& block) {
+    AbstractMutex::ScopedLocker locker(myLock);
+    if (!block.empty()) {
+        myQueue.push_back(std::string());
+        myQueue.back().swap(block);
+        myHandedOver++;
+        myQueued.signal();
+    }
+    return myHandedOver;
+}
+
+
+void
+OutputDevice_Async::checkError() {
+    myLock.lock();
+    const std::string error = myError;
+    myLock.unlock();
+    if (!error.empty()) {
+        throw IOError(error);
+    }
+}
+
+
+void
+OutputDevice_Async::releaseBuffer(void* buffer) {
+    ThreadBuffer* const threadBuffer = static_cast<ThreadBuffer*>(buffer);
+    threadBuffer->owner->handOver(*threadBuffer);
+}
+
+
+void
+OutputDevice_Async::run() {
+    std::deque<std::string> blocks;
+    myLock.lock();
+    while (true) {
+        while (myQueue.empty() && !myQuit) {
+            myQueued.wait(myLock);
+        }
+        if (myQueue.empty()) {
+            break;
+        }
+        blocks.swap(myQueue);
+        myLock.unlock();
+        std::string error;
+        for (std::deque<std::string>::const_iterator i = blocks.begin(); i != blocks.end(); ++i) {
+            try {
+                (*myTarget) << *i;
+            } catch (std::exception& e) {
+                error = e.what();
+            }
+        }
+        // a fence guarantees the data reached the file, not only the target's buffer
+        myTarget->flush();
+        myLock.lock();
+        if (!error.empty()) {
+            myError = error;
+        }
+        myWritten += (unsigned long)blocks.size();
+        blocks.clear();
+        myWrittenCondition.broadcast();
+    }
+    myLock.unlock();
+}
+
+
+/****************************************************************************/
+
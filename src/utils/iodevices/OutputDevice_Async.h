@@ -0,0 +1,224 @@
+/****************************************************************************/
+/// @file    OutputDevice_Async.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// An output device buffering per thread and writing in the background
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2004-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef OutputDevice_Async_h
+#define OutputDevice_Async_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <deque>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <pthread.h>
+#include <utils/common/PosixThread.h>
+#include "OutputDevice.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class OutputDevice_Async
+ * @brief An output device buffering per thread and writing in the background
+ *
+ * The device wraps another device (a file or a network connection) which
+ *  it owns. Everything written to this device goes into a buffer private
+ *  to the writing thread, so no lock is taken on the hot path. Once a
+ *  buffer exceeds the block size, it is handed over to a background
+ *  thread which writes it to the wrapped device as one large block. For
+ *  OutputDevice_Network this means one socket write per block instead of
+ *  one per operator<<.
+ *
+ * Blocks are handed over within postWriteHook and end at the last line
+ *  break of the buffer, so a line assembled from several writes is never
+ *  split (binary devices hand over the complete buffer). The writes of one
+ *  thread reach the wrapped device in order; writes of different threads
+ *  are interleaved at line granularity. Note that the formatter (and thus
+ *  openTag/closeTag) is shared; only preformatted writes may come from
+ *  several threads at once.
+ *
+ * Use fence() when the data must have reached the wrapped device (e.g.
+ *  before another process reads the file) and handOver() to merely push
+ *  the calling thread's buffer without waiting. Errors of the wrapped
+ *  device are reported at the next handOver() or fence() of any thread.
+ */
+class OutputDevice_Async : public OutputDevice, private PosixThread {
+public:
+    /** @brief Constructor
+     *
+     * Starts the background thread.
+     *
+     * @param[in] target The device to write to (the device gets responsible for it)
+     * @param[in] blockSize The buffer size at which a thread's buffer is handed over
+     * @param[in] binary Whether the formatter shall write binary data
+     * @exception ProcessError If the background thread could not be started
+     */
+    OutputDevice_Async(OutputDevice* target, unsigned int blockSize = 65536,
+                       const bool binary = false);
+
+
+    /// @brief Destructor, writes all remaining data and deletes the wrapped device
+    ~OutputDevice_Async();
+
+
+    /** @brief Returns whether the wrapped device is usable and no write failed
+     * @return Whether the device can be used
+     */
+    bool ok();
+
+
+    /** @brief Hands the calling thread's buffer over to the background thread
+     *
+     * Other than postWriteHook, this hands over the complete buffer, also
+     *  an incomplete last line.
+     *
+     * @return The sequence number of the last block handed over so far
+     * @exception IOError If a previous write to the wrapped device failed
+     */
+    unsigned long handOver();
+
+
+    /** @brief Waits until everything handed over so far has been written and flushed
+     *
+     * Hands over the calling thread's buffer first. Buffers of other
+     *  threads are not touched; each thread fences its own writes.
+     *
+     * @exception IOError If a write to the wrapped device failed
+     */
+    void fence();
+
+
+    /// @brief Returns the number of blocks written to the wrapped device so far
+    unsigned long getWrittenBlocks();
+
+
+protected:
+    /// @name Methods that override/implement OutputDevice-methods
+    /// @{
+
+    /** @brief Returns the calling thread's buffer
+     * @return The used stream
+     */
+    std::ostream& getOStream();
+
+
+    /** @brief Hands over the complete lines of the calling thread's buffer if it exceeds the block size
+     */
+    void postWriteHook();
+    /// @}
+
+
+private:
+    /// @brief A buffer owned by a single writing thread
+    struct ThreadBuffer {
+        /// @brief The device the buffer belongs to
+        OutputDevice_Async* owner;
+        /// @brief The buffered output
+        std::ostringstream stream;
+    };
+
+
+    /// @brief Returns (and creates, if needed) the calling thread's buffer
+    ThreadBuffer& getBuffer();
+
+
+    /** @brief Moves the content of the given buffer into the queue
+     * @return The sequence number of the last block in the queue
+     */
+    unsigned long handOver(ThreadBuffer& buffer);
+
+
+    /** @brief Appends the given block to the queue (leaving the given string empty)
+     * @return The sequence number of the last block in the queue
+     */
+    unsigned long queue(std::string& block);
+
+
+    /// @brief Throws an IOError if the background thread stored an error
+    void checkError();
+
+
+    /// @brief Called on exit of a writing thread, hands over its remaining data
+    static void releaseBuffer(void* buffer);
+
+
+    /// @brief The background thread: writes queued blocks to the wrapped device
+    void run();
+
+
+private:
+    /// @brief The wrapped device
+    OutputDevice* myTarget;
+
+    /// @brief The size at which buffers are handed over
+    const unsigned int myBlockSize;
+
+    /// @brief The key to the buffer of the current thread
+    pthread_key_t myBufferKey;
+
+    /// @brief All buffers created so far (for the final hand over)
+    std::vector<ThreadBuffer*> myBuffers;
+
+    /// @brief Blocks waiting to be written
+    std::deque<std::string> myQueue;
+
+    /// @brief The number of blocks handed over
+    unsigned long myHandedOver;
+
+    /// @brief The number of blocks written
+    unsigned long myWritten;
+
+    /// @brief Whether the background thread shall stop
+    bool myQuit;
+
+    /// @brief The last error of the wrapped device
+    std::string myError;
+
+    /// @brief The lock guarding the queue, the buffer list and the counters
+    PosixMutex myLock;
+
+    /// @brief Signals new blocks to the background thread
+    PosixCondition myQueued;
+
+    /// @brief Signals written blocks to fencing threads
+    PosixCondition myWrittenCondition;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    OutputDevice_Async(const OutputDevice_Async&);
+
+    /// @brief Invalidated assignment operator.
+    OutputDevice_Async& operator=(const OutputDevice_Async&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -0,0 +1,70 @@
+/****************************************************************************/
+/// @file    OutputDevice_ColumnarFile.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// An output device writing a columnar file
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2004-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <utils/common/UtilExceptions.h>
+#include "ColumnarFormatter.h"
+#include "OutputDevice_ColumnarFile.h"
+
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif // CHECK_MEMORY_LEAKS
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+OutputDevice_ColumnarFile::OutputDevice_ColumnarFile(const std::string& fullName,
+        unsigned int blockRows, bool encode)
+    : OutputDevice(new ColumnarFormatter(blockRows, encode)),
+      myFileStream(fullName.c_str(), std::ios::binary) {
+    if (!myFileStream.good()) {
+        throw IOError("Could not build output file '" + fullName + "'.");
+    }
+}
+
+
+OutputDevice_ColumnarFile::~OutputDevice_ColumnarFile() {
+    myFileStream.close();
+}
+
+
+bool
+OutputDevice_ColumnarFile::isColumnarName(const std::string& name) {
+    return name.length() > 5 && name.substr(name.length() - 5) == ".scol";
+}
+
+
+std::ostream&
+OutputDevice_ColumnarFile::getOStream() {
+    return myFileStream;
+}
+
+
+/****************************************************************************/
+
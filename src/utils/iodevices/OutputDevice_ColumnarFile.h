@@ -0,0 +1,91 @@
+/****************************************************************************/
+/// @file    OutputDevice_ColumnarFile.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// An output device writing a columnar file
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2004-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef OutputDevice_ColumnarFile_h
+#define OutputDevice_ColumnarFile_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <fstream>
+#include "OutputDevice.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class OutputDevice_ColumnarFile
+ * @brief An output device writing a columnar file
+ *
+ * The device uses a ColumnarFormatter; elements written to it become rows
+ *  of per-element tables which can be read column by column using the
+ *  ColumnarReader.
+ */
+class OutputDevice_ColumnarFile : public OutputDevice {
+public:
+    /** @brief Constructor
+     * @param[in] fullName The name of the file to write
+     * @param[in] blockRows The number of rows per block
+     * @param[in] encode Whether chunks may be delta/run length encoded
+     * @exception IOError If the file could not be opened
+     */
+    OutputDevice_ColumnarFile(const std::string& fullName, unsigned int blockRows = 4096,
+                              bool encode = true);
+
+
+    /// @brief Destructor
+    ~OutputDevice_ColumnarFile();
+
+
+    /** @brief Returns whether the given file name denotes a columnar file (ends with ".scol")
+     * @param[in] name The file name to check
+     * @return Whether a columnar device should be used
+     */
+    static bool isColumnarName(const std::string& name);
+
+
+protected:
+    /// @name Methods that override/implement OutputDevice-methods
+    /// @{
+
+    /** @brief Returns the associated ostream
+     * @return The used stream
+     */
+    std::ostream& getOStream();
+    /// @}
+
+
+private:
+    /// The wrapped ofstream
+    std::ofstream myFileStream;
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -53,8 +53,8 @@ class RGBColor;
  * @brief Abstract base class for output formatters
  *
  * OutputFormatter format XML like output into the output stream.
- *  There are only two implementation at the moment, "normal" XML
- *  and binary XML.
+ *  There are three implementations at the moment, "normal" XML,
+ *  binary XML and the column-chunked ColumnarFormatter.
  */
 class OutputFormatter {
 public:
@@ -112,6 +112,17 @@ public:
 
     virtual void writePreformattedTag(std::ostream& into, const std::string& val) = 0;
 
+
+    /** @brief Returns whether this formatter collects attributes into columns
+     *
+     * Columnar formatters receive attributes through their own writeAttr
+     *  methods instead of the static ones of the XML formatters.
+     * @see ColumnarFormatter
+     */
+    virtual bool isColumnar() const {
+        return false;
+    }
+
 };
 
 
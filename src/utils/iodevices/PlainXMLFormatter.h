@@ -31,6 +31,7 @@
 #include <config.h>
 #endif
 
+#include <utils/common/NumberFormat.h>
 #include "OutputFormatter.h"
 
 
@@ -129,7 +130,9 @@ public:
      */
     template <class T>
     static void writeAttr(std::ostream& into, const std::string& attr, const T& val) {
-        into << " " << attr << "=\"" << toString(val, into.precision()) << "\"";
+        into << " " << attr << "=\"";
+        writeValue(into, val);
+        into << "\"";
     }
 
 
@@ -141,11 +144,47 @@ public:
      */
     template <class T>
     static void writeAttr(std::ostream& into, const SumoXMLAttr attr, const T& val) {
-        into << " " << toString(attr) << "=\"" << toString(val, into.precision()) << "\"";
+        into << " " << toString(attr) << "=\"";
+        writeValue(into, val);
+        into << "\"";
     }
 
 
 private:
+    /// @brief writes an attribute value
+    template <class T>
+    static void writeValue(std::ostream& into, const T& val) {
+        into << toString(val, into.precision());
+    }
+
+
+    /// @brief writes a real attribute value without creating a string
+    static void writeValue(std::ostream& into, const double val) {
+        char buf[NumberFormat::BUFFER_SIZE];
+        into.write(buf, NumberFormat::formatFixed(val, (int)into.precision(), buf));
+    }
+
+
+    /// @brief writes a real attribute value without creating a string
+    static void writeValue(std::ostream& into, const float val) {
+        writeValue(into, (double)val);
+    }
+
+
+    /// @brief writes an integer attribute value without creating a string
+    static void writeValue(std::ostream& into, const int val) {
+        char buf[NumberFormat::BUFFER_SIZE];
+        into.write(buf, NumberFormat::formatInt(val, buf));
+    }
+
+
+    /// @brief writes an unsigned attribute value without creating a string
+    static void writeValue(std::ostream& into, const unsigned int val) {
+        char buf[NumberFormat::BUFFER_SIZE];
+        into.write(buf, NumberFormat::formatUnsigned(val, buf));
+    }
+
+
     /// @brief The stack of begun xml elements
     std::vector<std::string> myXMLStack;
 
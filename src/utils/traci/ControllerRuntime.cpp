@@ -0,0 +1,185 @@
+/****************************************************************************/
+/// @file    ControllerRuntime.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Runs the decisions of many traffic light controllers in parallel
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <algorithm>
+#include <utils/common/StdDefs.h>
+#include <utils/common/SysUtils.h>
+#include "ControllerRuntime.h"
+
+
+// ===========================================================================
+// task definitions
+// ===========================================================================
+class ControllerRuntime::DecideTask : public ThreadPool::Task {
+public:
+    DecideTask(const std::vector<Controller*>& controllers, std::vector<Decision>& decisions, SUMOTime time)
+        : myControllers(controllers), myDecisions(decisions), myTime(time) {}
+
+    void run(unsigned int begin, unsigned int end) {
+        for (unsigned int i = begin; i < end; ++i) {
+            myControllers[i]->decide(myTime, myDecisions[i]);
+        }
+    }
+
+private:
+    const std::vector<Controller*>& myControllers;
+    std::vector<Decision>& myDecisions;
+    const SUMOTime myTime;
+
+private:
+    DecideTask& operator=(const DecideTask&);
+};
+
+
+// ===========================================================================
+// member definitions
+// ===========================================================================
+// ---------------------------------------------------------------------------
+// ControllerRuntime::Decision - methods
+// ---------------------------------------------------------------------------
+ControllerRuntime::Decision::Decision()
+    : myHaveState(false), myHaveProgram(false), myPhase(-1), myPhaseDuration(-1) {}
+
+
+void
+ControllerRuntime::Decision::setRedYellowGreenState(const std::string& state) {
+    myState = state;
+    myHaveState = true;
+}
+
+
+void
+ControllerRuntime::Decision::setPhase(unsigned int index) {
+    myPhase = (int)index;
+}
+
+
+void
+ControllerRuntime::Decision::setProgram(const std::string& programID) {
+    myProgram = programID;
+    myHaveProgram = true;
+}
+
+
+void
+ControllerRuntime::Decision::setPhaseDuration(unsigned int phaseDuration) {
+    myPhaseDuration = (int)phaseDuration;
+}
+
+
+void
+ControllerRuntime::Decision::clear() {
+    myHaveState = false;
+    myHaveProgram = false;
+    myPhase = -1;
+    myPhaseDuration = -1;
+}
+
+
+// ---------------------------------------------------------------------------
+// ControllerRuntime - methods
+// ---------------------------------------------------------------------------
+ControllerRuntime::ControllerRuntime(TLSCommandBuffer& commands, unsigned int numThreads, unsigned int grain)
+    : myCommands(commands), myPool(numThreads), myGrain(grain) {}
+
+
+ControllerRuntime::~ControllerRuntime() {
+    for (std::vector<Controller*>::iterator i = myControllers.begin(); i != myControllers.end(); ++i) {
+        delete *i;
+    }
+}
+
+
+void
+ControllerRuntime::add(Controller* controller) {
+    myControllers.push_back(controller);
+    myDecisions.push_back(Decision());
+}
+
+
+unsigned int
+ControllerRuntime::step(SUMOTime time) {
+    const SUMOLong begin = SysUtils::getCurrentMicros();
+    for (std::vector<Decision>::iterator i = myDecisions.begin(); i != myDecisions.end(); ++i) {
+        i->clear();
+    }
+    // several ranges per thread leave something to steal when controllers differ in cost
+    const unsigned int grain = myGrain != 0 ? myGrain : MAX2(1u, size() / (8 * myPool.getConcurrency()));
+    DecideTask task(myControllers, myDecisions, time);
+    myPool.parallelFor(size(), grain, task);
+    // the buffer is not thread safe, so the decisions are gathered afterwards
+    unsigned int numDecided = 0;
+    for (unsigned int i = 0; i < size(); ++i) {
+        const Decision& d = myDecisions[i];
+        if (d.empty()) {
+            continue;
+        }
+        const std::string& tlsID = myControllers[i]->getTLSID();
+        if (d.myHaveProgram) {
+            myCommands.setProgram(tlsID, d.myProgram);
+        }
+        if (d.myPhase >= 0) {
+            myCommands.setPhase(tlsID, (unsigned int)d.myPhase);
+        }
+        if (d.myPhaseDuration >= 0) {
+            myCommands.setPhaseDuration(tlsID, (unsigned int)d.myPhaseDuration);
+        }
+        if (d.myHaveState) {
+            myCommands.setRedYellowGreenState(tlsID, d.myState);
+        }
+        numDecided++;
+    }
+    myLatencies.push_back(SysUtils::getCurrentMicros() - begin);
+    return numDecided;
+}
+
+
+SUMOLong
+ControllerRuntime::getLatencyQuantile(double q) const {
+    if (myLatencies.empty()) {
+        return 0;
+    }
+    std::vector<SUMOLong> latencies = myLatencies;
+    const size_t index = MIN2(latencies.size() - 1, (size_t)(MAX2(q, 0.) * (double)(latencies.size() - 1) + .5));
+    std::nth_element(latencies.begin(), latencies.begin() + index, latencies.end());
+    return latencies[index];
+}
+
+
+double
+ControllerRuntime::getMeanLatency() const {
+    if (myLatencies.empty()) {
+        return 0;
+    }
+    double sum = 0;
+    for (std::vector<SUMOLong>::const_iterator i = myLatencies.begin(); i != myLatencies.end(); ++i) {
+        sum += (double)*i;
+    }
+    return sum / (double)myLatencies.size();
+}
+
+
+/****************************************************************************/
+
@@ -0,0 +1,250 @@
+/****************************************************************************/
+/// @file    ControllerRuntime.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Runs the decisions of many traffic light controllers in parallel
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef ControllerRuntime_h
+#define ControllerRuntime_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <string>
+#include <vector>
+#include <utils/common/SUMOTime.h>
+#include <utils/common/ThreadPool.h>
+#include "TLSCommandBuffer.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class ControllerRuntime
+ * @brief Runs the decisions of many traffic light controllers in parallel
+ *
+ * Each controller decides upon the actuation of one intersection from
+ *  inputs retrieved before (e.g. SubscriptionResults or a NetworkCache),
+ *  so the decisions of a step are independent of each other. step() runs
+ *  them as tasks on a work stealing thread pool, each controller writing
+ *  into a Decision of its own, and gathers the decisions into a
+ *  TLSCommandBuffer afterwards, in the order the controllers were added.
+ *  Sending the buffer is left to the caller, so the decisions of a step
+ *  may be sent together with further commands.
+ *
+ * The wall clock time of each step's decisions (deciding and gathering,
+ *  without sending) is recorded, so the per step decision latency of
+ *  controllers with thousands of signals or expensive logic can be
+ *  reported.
+ */
+class ControllerRuntime {
+public:
+    /**
+     * @class Decision
+     * @brief The actuation one controller decided upon in a step
+     *
+     * Is gathered as program, phase, phase duration and state, in this order.
+     */
+    class Decision {
+    public:
+        /// @brief Constructor
+        Decision();
+
+        /// @name deciding
+        /// @{
+
+        void setRedYellowGreenState(const std::string& state);
+        void setPhase(unsigned int index);
+        void setProgram(const std::string& programID);
+        void setPhaseDuration(unsigned int phaseDuration);
+        /// @}
+
+        /// @brief Returns whether nothing was decided
+        bool empty() const {
+            return !myHaveState && !myHaveProgram && myPhase < 0 && myPhaseDuration < 0;
+        }
+
+        /// @brief Forgets the decision
+        void clear();
+
+    private:
+        /// @brief The state to set
+        std::string myState;
+
+        /// @brief The program to set
+        std::string myProgram;
+
+        /// @brief Whether a state / program was decided
+        bool myHaveState, myHaveProgram;
+
+        /// @brief The phase and phase duration to set (-1 if none)
+        int myPhase, myPhaseDuration;
+
+        friend class ControllerRuntime;
+    };
+
+
+    /**
+     * @class Controller
+     * @brief The logic of one intersection
+     */
+    class Controller {
+    public:
+        /** @brief Constructor
+         * @param[in] tlsID The traffic light to actuate
+         */
+        Controller(const std::string& tlsID) : myTLSID(tlsID) {}
+
+        /// @brief Destructor
+        virtual ~Controller() {}
+
+        /// @brief Returns the traffic light to actuate
+        const std::string& getTLSID() const {
+            return myTLSID;
+        }
+
+        /** @brief Decides upon the actuation of the intersection
+         *
+         * Is called by several threads at once for different controllers;
+         *  a controller may change its own state but only read shared data.
+         *
+         * @param[in] time The current simulation time
+         * @param[out] decision The actuation to send (empty on call)
+         */
+        virtual void decide(SUMOTime time, Decision& decision) = 0;
+
+    private:
+        /// @brief The traffic light to actuate
+        const std::string myTLSID;
+
+    private:
+        /// @brief Invalidated copy constructor.
+        Controller(const Controller&);
+
+        /// @brief Invalidated assignment operator.
+        Controller& operator=(const Controller&);
+
+    };
+
+
+    /** @brief Constructor
+     * @param[in] commands The buffer to gather the decisions in
+     * @param[in] numThreads The number of threads besides the calling one
+     * @param[in] grain The number of controllers to claim at once (0 chooses by the number of controllers)
+     */
+    ControllerRuntime(TLSCommandBuffer& commands, unsigned int numThreads = ThreadPool::getHardwareConcurrency() - 1,
+                      unsigned int grain = 0);
+
+
+    /// @brief Destructor; deletes the controllers
+    ~ControllerRuntime();
+
+
+    /// @brief Adds a controller, taking ownership
+    void add(Controller* controller);
+
+
+    /// @brief Returns the number of controllers
+    unsigned int size() const {
+        return (unsigned int)myControllers.size();
+    }
+
+
+    /// @brief Returns the controller at the given index
+    Controller& get(unsigned int index) const {
+        return *myControllers[index];
+    }
+
+
+    /** @brief Runs the decisions of all controllers and gathers them into the command buffer
+     * @param[in] time The current simulation time
+     * @return The number of controllers which decided upon an actuation
+     * @exception ProcessError If a controller threw an exception; nothing is gathered then
+     */
+    unsigned int step(SUMOTime time);
+
+
+    /// @name statistics
+    /// @{
+
+    /// @brief Returns the decision latency of each step so far (in microseconds)
+    const std::vector<SUMOLong>& getLatencies() const {
+        return myLatencies;
+    }
+
+    /** @brief Returns a decision latency quantile
+     * @param[in] q The quantile in [0, 1]
+     * @return The latency in microseconds, 0 if no step was made
+     */
+    SUMOLong getLatencyQuantile(double q) const;
+
+    /// @brief Returns the mean decision latency in microseconds (0 if no step was made)
+    double getMeanLatency() const;
+
+    /// @brief Returns the number of threads deciding, including the calling one
+    unsigned int getConcurrency() const {
+        return myPool.getConcurrency();
+    }
+
+    /// @brief Returns the number of controller ranges stolen between threads so far
+    unsigned int getNumSteals() const {
+        return myPool.getNumSteals();
+    }
+    /// @}
+
+
+private:
+    /// @brief Runs the decisions of a range of controllers
+    class DecideTask;
+
+
+private:
+    /// @brief The buffer to gather the decisions in
+    TLSCommandBuffer& myCommands;
+
+    /// @brief The threads
+    ThreadPool myPool;
+
+    /// @brief The number of controllers to claim at once (0 if chosen by the number of controllers)
+    const unsigned int myGrain;
+
+    /// @brief The controllers
+    std::vector<Controller*> myControllers;
+
+    /// @brief The decision of each controller in the current step
+    std::vector<Decision> myDecisions;
+
+    /// @brief The decision latency of each step
+    std::vector<SUMOLong> myLatencies;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    ControllerRuntime(const ControllerRuntime&);
+
+    /// @brief Invalidated assignment operator.
+    ControllerRuntime& operator=(const ControllerRuntime&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
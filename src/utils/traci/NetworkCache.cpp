@@ -0,0 +1,551 @@
+/****************************************************************************/
+/// @file    NetworkCache.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// A client side cache of the static network data retrieved via TraCI
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <foreign/tcpip/storage.h>
+#include <foreign/tcpip/socket.h>
+#include <traci-server/TraCIConstants.h>
+#include <utils/common/ToString.h>
+#include <utils/common/UtilExceptions.h>
+#include "ShapeSmoother.h"
+#include "NetworkCache.h"
+
+
+// ===========================================================================
+// static members
+// ===========================================================================
+/// @brief The first string of a cache file
+static const std::string CACHE_MAGIC = "SUMO network cache";
+
+/// @brief The format version, to be increased whenever the layout changes
+static const int CACHE_FORMAT = 1;
+
+
+// ===========================================================================
+// helper definitions
+// ===========================================================================
+namespace {
+
+/// @brief Throws if the value has not the expected type
+void
+checkType(int var, int valueType, int expected) {
+    if (valueType != expected) {
+        throw tcpip::SocketException("Unexpected type " + toString(valueType) + " for variable " + toString(var) + ".");
+    }
+}
+
+
+/// @brief Collects the lane data
+class LaneReader : public TraCIAPI::BatchReader {
+public:
+    LaneReader(unsigned int n) : lengths(n), maxSpeeds(n), shapes(n), edges(n) {}
+
+    void read(unsigned int object, int var, int valueType, tcpip::Storage& inMsg) {
+        switch (var) {
+            case VAR_LENGTH:
+                checkType(var, valueType, TYPE_DOUBLE);
+                lengths[object] = (SUMOReal)inMsg.readDouble();
+                break;
+            case VAR_MAXSPEED:
+                checkType(var, valueType, TYPE_DOUBLE);
+                maxSpeeds[object] = (SUMOReal)inMsg.readDouble();
+                break;
+            case VAR_SHAPE:
+                checkType(var, valueType, TYPE_POLYGON);
+                shapes[object] = TraCIAPI::readPolygon(inMsg);
+                break;
+            case LANE_EDGE_ID:
+                checkType(var, valueType, TYPE_STRING);
+                edges[object] = inMsg.readString();
+                break;
+            default:
+                break;
+        }
+    }
+
+    std::vector<SUMOReal> lengths;
+    std::vector<SUMOReal> maxSpeeds;
+    std::vector<TraCIAPI::TraCIPositionVector> shapes;
+    std::vector<std::string> edges;
+};
+
+
+/// @brief Collects the junction positions
+class JunctionReader : public TraCIAPI::BatchReader {
+public:
+    JunctionReader(TraCIAPI::TraCIPositionVector& into) : positions(into) {}
+
+    void read(unsigned int object, int var, int valueType, tcpip::Storage& inMsg) {
+        checkType(var, valueType, POSITION_2D);
+        positions[object].x = inMsg.readDouble();
+        positions[object].y = inMsg.readDouble();
+        positions[object].z = 0;
+    }
+
+    TraCIAPI::TraCIPositionVector& positions;
+};
+
+
+/// @brief Collects the lanes and links controlled by traffic lights
+class TLSReader : public TraCIAPI::BatchReader {
+public:
+    TLSReader(unsigned int n) : lanes(n), links(n) {}
+
+    void read(unsigned int object, int var, int valueType, tcpip::Storage& inMsg) {
+        if (var == TL_CONTROLLED_LANES) {
+            checkType(var, valueType, TYPE_STRINGLIST);
+            lanes[object] = inMsg.readStringList();
+        } else {
+            checkType(var, valueType, TYPE_COMPOUND);
+            links[object] = TraCIAPI::readLinks(inMsg);
+        }
+    }
+
+    std::vector<std::vector<std::string> > lanes;
+    std::vector<std::vector<TraCIAPI::TraCILink> > links;
+};
+
+
+/// @brief Reads a number of elements, rejecting numbers a damaged file could not hold
+unsigned int
+readCount(tcpip::Storage& in) {
+    const int count = in.readInt();
+    if (count < 0 || (size_t)count > in.size() - in.position()) {
+        throw std::invalid_argument("invalid element number");
+    }
+    return (unsigned int)count;
+}
+
+
+void
+writeReals(tcpip::Storage& out, const std::vector<SUMOReal>& values) {
+    out.writeInt((int)values.size());
+    for (std::vector<SUMOReal>::const_iterator i = values.begin(); i != values.end(); ++i) {
+        out.writeDouble(*i);
+    }
+}
+
+
+void
+readReals(tcpip::Storage& in, std::vector<SUMOReal>& values) {
+    values.resize(readCount(in));
+    for (std::vector<SUMOReal>::iterator i = values.begin(); i != values.end(); ++i) {
+        *i = (SUMOReal)in.readDouble();
+    }
+}
+
+
+void
+writeIndices(tcpip::Storage& out, const std::vector<unsigned int>& values) {
+    out.writeInt((int)values.size());
+    for (std::vector<unsigned int>::const_iterator i = values.begin(); i != values.end(); ++i) {
+        out.writeInt((int)*i);
+    }
+}
+
+
+void
+readIndices(tcpip::Storage& in, std::vector<unsigned int>& values) {
+    values.resize(readCount(in));
+    for (std::vector<unsigned int>::iterator i = values.begin(); i != values.end(); ++i) {
+        *i = (unsigned int)in.readInt();
+    }
+}
+
+
+void
+writePositions(tcpip::Storage& out, const TraCIAPI::TraCIPositionVector& values) {
+    out.writeInt((int)values.size());
+    for (TraCIAPI::TraCIPositionVector::const_iterator i = values.begin(); i != values.end(); ++i) {
+        out.writeDouble(i->x);
+        out.writeDouble(i->y);
+    }
+}
+
+
+void
+readPositions(tcpip::Storage& in, TraCIAPI::TraCIPositionVector& values) {
+    values.resize(readCount(in));
+    for (TraCIAPI::TraCIPositionVector::iterator i = values.begin(); i != values.end(); ++i) {
+        i->x = in.readDouble();
+        i->y = in.readDouble();
+        i->z = 0;
+    }
+}
+
+
+/// @brief Checks that the offsets address the given number of values
+void
+checkOffsets(const std::vector<unsigned int>& begin, size_t objects, size_t values) {
+    if (begin.size() != objects + 1 || begin.front() != 0 || begin.back() != values) {
+        throw std::invalid_argument("inconsistent offsets");
+    }
+    for (size_t i = 1; i < begin.size(); ++i) {
+        if (begin[i] < begin[i - 1]) {
+            throw std::invalid_argument("inconsistent offsets");
+        }
+    }
+}
+
+}
+
+
+// ===========================================================================
+// member definitions
+// ===========================================================================
+NetworkCache::NetworkCache() {
+    clear();
+}
+
+
+NetworkCache::~NetworkCache() {}
+
+
+void
+NetworkCache::download(TraCIAPI& api, unsigned int batchSize) {
+    clear();
+    // lanes
+    myLaneIDs = api.lane.getIDList();
+    LaneReader lanes((unsigned int)myLaneIDs.size());
+    std::vector<int> vars;
+    vars.push_back(VAR_LENGTH);
+    vars.push_back(VAR_MAXSPEED);
+    vars.push_back(VAR_SHAPE);
+    vars.push_back(LANE_EDGE_ID);
+    api.getVariables(CMD_GET_LANE_VARIABLE, vars, myLaneIDs, lanes, batchSize);
+    myLaneLengths.swap(lanes.lengths);
+    myLaneMaxSpeeds.swap(lanes.maxSpeeds);
+    myLaneShapeBegin.clear();
+    for (unsigned int i = 0; i < (unsigned int)myLaneIDs.size(); ++i) {
+        myLaneShapeBegin.push_back((unsigned int)myShapePoints.size());
+        myShapePoints.insert(myShapePoints.end(), lanes.shapes[i].begin(), lanes.shapes[i].end());
+        // edges are numbered in the order of their first lane
+        const unsigned int* const edge = myEdgeIndex.find(lanes.edges[i]);
+        if (edge == 0) {
+            myEdgeIndex.insert(lanes.edges[i], (unsigned int)myEdgeIDs.size());
+            myLaneEdges.push_back((unsigned int)myEdgeIDs.size());
+            myEdgeIDs.push_back(lanes.edges[i]);
+        } else {
+            myLaneEdges.push_back(*edge);
+        }
+    }
+    myLaneShapeBegin.push_back((unsigned int)myShapePoints.size());
+    // junctions
+    myJunctionIDs = api.junction.getIDList();
+    myJunctionPositions.resize(myJunctionIDs.size());
+    JunctionReader junctions(myJunctionPositions);
+    api.getVariables(CMD_GET_JUNCTION_VARIABLE, std::vector<int>(1, VAR_POSITION), myJunctionIDs, junctions, batchSize);
+    // traffic lights
+    myTLSIDs = api.trafficlights.getIDList();
+    TLSReader tls((unsigned int)myTLSIDs.size());
+    vars.clear();
+    vars.push_back(TL_CONTROLLED_LANES);
+    vars.push_back(TL_CONTROLLED_LINKS);
+    api.getVariables(CMD_GET_TL_VARIABLE, vars, myTLSIDs, tls, batchSize);
+    myControlledLaneBegin.clear();
+    myControlledLinkBegin.clear();
+    for (unsigned int i = 0; i < (unsigned int)myTLSIDs.size(); ++i) {
+        myControlledLaneBegin.push_back((unsigned int)myControlledLanes.size());
+        myControlledLanes.insert(myControlledLanes.end(), tls.lanes[i].begin(), tls.lanes[i].end());
+        myControlledLinkBegin.push_back((unsigned int)myControlledLinks.size());
+        myControlledLinks.insert(myControlledLinks.end(), tls.links[i].begin(), tls.links[i].end());
+    }
+    myControlledLaneBegin.push_back((unsigned int)myControlledLanes.size());
+    myControlledLinkBegin.push_back((unsigned int)myControlledLinks.size());
+    rebuild();
+}
+
+
+bool
+NetworkCache::load(const std::string& file, const std::string& key) {
+    std::ifstream strm(file.c_str(), std::ios::in | std::ios::binary);
+    if (!strm.good()) {
+        return false;
+    }
+    const std::vector<unsigned char> data((std::istreambuf_iterator<char>(strm)), std::istreambuf_iterator<char>());
+    if (data.empty()) {
+        return false;
+    }
+    tcpip::Storage in(&data[0], (int)data.size());
+    clear();
+    try {
+        if (in.readString() != CACHE_MAGIC || in.readInt() != CACHE_FORMAT || in.readString() != key) {
+            return false;
+        }
+        myLaneIDs = in.readStringList();
+        readIndices(in, myLaneEdges);
+        readReals(in, myLaneLengths);
+        readReals(in, myLaneMaxSpeeds);
+        readIndices(in, myLaneShapeBegin);
+        readPositions(in, myShapePoints);
+        myEdgeIDs = in.readStringList();
+        myJunctionIDs = in.readStringList();
+        readPositions(in, myJunctionPositions);
+        myTLSIDs = in.readStringList();
+        readIndices(in, myControlledLaneBegin);
+        myControlledLanes = in.readStringList();
+        readIndices(in, myControlledLinkBegin);
+        const unsigned int linkNo = readCount(in);
+        for (unsigned int i = 0; i < linkNo; ++i) {
+            const std::string from = in.readString();
+            const std::string via = in.readString();
+            const std::string to = in.readString();
+            myControlledLinks.push_back(TraCIAPI::TraCILink(from, via, to));
+        }
+        // do not trust a truncated or otherwise damaged file
+        const size_t lanes = myLaneIDs.size();
+        if (myLaneEdges.size() != lanes || myLaneLengths.size() != lanes || myLaneMaxSpeeds.size() != lanes
+                || myJunctionPositions.size() != myJunctionIDs.size()) {
+            throw std::invalid_argument("inconsistent table sizes");
+        }
+        for (std::vector<unsigned int>::const_iterator i = myLaneEdges.begin(); i != myLaneEdges.end(); ++i) {
+            if (*i >= myEdgeIDs.size()) {
+                throw std::invalid_argument("unknown edge");
+            }
+        }
+        checkOffsets(myLaneShapeBegin, lanes, myShapePoints.size());
+        checkOffsets(myControlledLaneBegin, myTLSIDs.size(), myControlledLanes.size());
+        checkOffsets(myControlledLinkBegin, myTLSIDs.size(), myControlledLinks.size());
+    } catch (std::invalid_argument&) {
+        clear();
+        return false;
+    }
+    rebuild();
+    return true;
+}
+
+
+void
+NetworkCache::save(const std::string& file, const std::string& key) const {
+    tcpip::Storage out;
+    out.writeString(CACHE_MAGIC);
+    out.writeInt(CACHE_FORMAT);
+    out.writeString(key);
+    out.writeStringList(myLaneIDs);
+    writeIndices(out, myLaneEdges);
+    writeReals(out, myLaneLengths);
+    writeReals(out, myLaneMaxSpeeds);
+    writeIndices(out, myLaneShapeBegin);
+    writePositions(out, myShapePoints);
+    out.writeStringList(myEdgeIDs);
+    out.writeStringList(myJunctionIDs);
+    writePositions(out, myJunctionPositions);
+    out.writeStringList(myTLSIDs);
+    writeIndices(out, myControlledLaneBegin);
+    out.writeStringList(myControlledLanes);
+    writeIndices(out, myControlledLinkBegin);
+    out.writeInt((int)myControlledLinks.size());
+    for (std::vector<TraCIAPI::TraCILink>::const_iterator i = myControlledLinks.begin(); i != myControlledLinks.end(); ++i) {
+        out.writeString(i->from);
+        out.writeString(i->via);
+        out.writeString(i->to);
+    }
+    // write to a temporary file first so that concurrent runs never read a partial cache
+    const std::string tmp = file + ".tmp";
+    std::ofstream strm(tmp.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    const std::vector<unsigned char> data(out.begin(), out.end());
+    if (!data.empty()) {
+        strm.write((const char*)&data[0], data.size());
+    }
+    strm.close();
+    if (strm.fail() || rename(tmp.c_str(), file.c_str()) != 0) {
+        remove(tmp.c_str());
+        throw IOError("Could not write the network cache '" + file + "'.");
+    }
+}
+
+
+bool
+NetworkCache::init(TraCIAPI& api, const std::string& file, const std::string& key) {
+    if (load(file, key)) {
+        return true;
+    }
+    download(api);
+    save(file, key);
+    return false;
+}
+
+
+std::string
+NetworkCache::hashFile(const std::string& file) {
+    std::ifstream strm(file.c_str(), std::ios::in | std::ios::binary);
+    if (!strm.good()) {
+        throw IOError("Could not open '" + file + "'.");
+    }
+    unsigned long long hash = 14695981039346656037ULL;
+    char buffer[65536];
+    while (strm.good()) {
+        strm.read(buffer, sizeof(buffer));
+        const std::streamsize read = strm.gcount();
+        for (std::streamsize i = 0; i < read; ++i) {
+            hash ^= (unsigned char)buffer[i];
+            hash *= 1099511628211ULL;
+        }
+    }
+    char result[17];
+    snprintf(result, sizeof(result), "%08x%08x", (unsigned int)(hash >> 32), (unsigned int)hash);
+    return result;
+}
+
+
+void
+NetworkCache::clear() {
+    myLaneIDs.clear();
+    myLaneIndex.clear();
+    myLaneEdges.clear();
+    myLaneLengths.clear();
+    myLaneMaxSpeeds.clear();
+    myLaneShapeBegin.assign(1, 0);
+    myShapePoints.clear();
+    myEdgeIDs.clear();
+    myEdgeIndex.clear();
+    myEdgeLaneBegin.assign(1, 0);
+    myEdgeLanes.clear();
+    myJunctionIDs.clear();
+    myJunctionIndex.clear();
+    myJunctionPositions.clear();
+    myTLSIDs.clear();
+    myTLSIndex.clear();
+    myControlledLaneBegin.assign(1, 0);
+    myControlledLanes.clear();
+    myControlledLinkBegin.assign(1, 0);
+    myControlledLinks.clear();
+}
+
+
+void
+NetworkCache::smoothLaneShapes(ShapeSmoother& smoother) {
+    TraCIAPI::TraCIPositionVector smoothed;
+    std::vector<unsigned int> smoothedBegins;
+    smoother.smooth(myShapePoints, myLaneShapeBegin, smoothed, smoothedBegins);
+    myShapePoints.swap(smoothed);
+    myLaneShapeBegin.swap(smoothedBegins);
+}
+
+
+SUMOReal
+NetworkCache::getLaneLength(const std::string& laneID) const {
+    return myLaneLengths[lookup(myLaneIndex, laneID, "lane")];
+}
+
+
+SUMOReal
+NetworkCache::getLaneMaxSpeed(const std::string& laneID) const {
+    return myLaneMaxSpeeds[lookup(myLaneIndex, laneID, "lane")];
+}
+
+
+TraCIAPI::TraCIPositionVector
+NetworkCache::getLaneShape(const std::string& laneID) const {
+    const unsigned int i = lookup(myLaneIndex, laneID, "lane");
+    return TraCIAPI::TraCIPositionVector(myShapePoints.begin() + myLaneShapeBegin[i],
+                                         myShapePoints.begin() + myLaneShapeBegin[i + 1]);
+}
+
+
+const std::string&
+NetworkCache::getLaneEdgeID(const std::string& laneID) const {
+    return myEdgeIDs[myLaneEdges[lookup(myLaneIndex, laneID, "lane")]];
+}
+
+
+std::vector<std::string>
+NetworkCache::getEdgeLanes(const std::string& edgeID) const {
+    const unsigned int i = lookup(myEdgeIndex, edgeID, "edge");
+    std::vector<std::string> result;
+    for (unsigned int j = myEdgeLaneBegin[i]; j < myEdgeLaneBegin[i + 1]; ++j) {
+        result.push_back(myLaneIDs[myEdgeLanes[j]]);
+    }
+    return result;
+}
+
+
+const TraCIAPI::TraCIPosition&
+NetworkCache::getJunctionPosition(const std::string& junctionID) const {
+    return myJunctionPositions[lookup(myJunctionIndex, junctionID, "junction")];
+}
+
+
+std::vector<std::string>
+NetworkCache::getControlledLanes(const std::string& tlsID) const {
+    const unsigned int i = lookup(myTLSIndex, tlsID, "traffic light");
+    return std::vector<std::string>(myControlledLanes.begin() + myControlledLaneBegin[i],
+                                    myControlledLanes.begin() + myControlledLaneBegin[i + 1]);
+}
+
+
+std::vector<TraCIAPI::TraCILink>
+NetworkCache::getControlledLinks(const std::string& tlsID) const {
+    const unsigned int i = lookup(myTLSIndex, tlsID, "traffic light");
+    return std::vector<TraCIAPI::TraCILink>(myControlledLinks.begin() + myControlledLinkBegin[i],
+                                            myControlledLinks.begin() + myControlledLinkBegin[i + 1]);
+}
+
+
+unsigned int
+NetworkCache::lookup(const FlatStringMap<unsigned int>& index, const std::string& id, const std::string& type) {
+    const unsigned int* const i = index.find(id);
+    if (i == 0) {
+        throw InvalidArgument("The " + type + " '" + id + "' is not known.");
+    }
+    return *i;
+}
+
+
+void
+NetworkCache::buildIndex(const std::vector<std::string>& ids, FlatStringMap<unsigned int>& index) {
+    index.clear();
+    for (unsigned int i = 0; i < (unsigned int)ids.size(); ++i) {
+        index.insert(ids[i], i);
+    }
+}
+
+
+void
+NetworkCache::rebuild() {
+    buildIndex(myLaneIDs, myLaneIndex);
+    buildIndex(myEdgeIDs, myEdgeIndex);
+    buildIndex(myJunctionIDs, myJunctionIndex);
+    buildIndex(myTLSIDs, myTLSIndex);
+    // group the lanes by edge, keeping their order
+    myEdgeLaneBegin.assign(myEdgeIDs.size() + 1, 0);
+    for (std::vector<unsigned int>::const_iterator i = myLaneEdges.begin(); i != myLaneEdges.end(); ++i) {
+        myEdgeLaneBegin[*i + 1]++;
+    }
+    for (size_t i = 1; i < myEdgeLaneBegin.size(); ++i) {
+        myEdgeLaneBegin[i] += myEdgeLaneBegin[i - 1];
+    }
+    std::vector<unsigned int> next(myEdgeLaneBegin.begin(), myEdgeLaneBegin.end() - 1);
+    myEdgeLanes.resize(myLaneEdges.size());
+    for (unsigned int i = 0; i < (unsigned int)myLaneEdges.size(); ++i) {
+        myEdgeLanes[next[myLaneEdges[i]]++] = i;
+    }
+}
+
+
+/****************************************************************************/
+
@@ -0,0 +1,280 @@
+/****************************************************************************/
+/// @file    NetworkCache.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// A client side cache of the static network data retrieved via TraCI
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef NetworkCache_h
+#define NetworkCache_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <vector>
+#include <string>
+#include <utils/common/FlatStringMap.h>
+#include "TraCIAPI.h"
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class ShapeSmoother;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class NetworkCache
+ * @brief A client side cache of the static network data retrieved via TraCI
+ *
+ * Lane lengths, speed limits, shapes and edges, junction positions and the
+ *  lanes and links controlled by traffic lights do not change during a
+ *  simulation. They are retrieved once using TraCIAPI::getVariables, which
+ *  sends many requests per message, and stored in contiguous tables: one
+ *  vector per attribute, indexed by the position of the object's id, with
+ *  the shapes, controlled lanes and links flattened into single vectors
+ *  addressed by begin offsets.
+ *
+ * The tables may be saved to a binary file and loaded in later runs without
+ *  any round trip. The file stores a format version and a key identifying
+ *  the network (usually hashFile of the network file); loading fails if
+ *  either does not match.
+ */
+class NetworkCache {
+public:
+    /// @brief Constructor
+    NetworkCache();
+
+
+    /// @brief Destructor
+    ~NetworkCache();
+
+
+    /// @name filling the cache
+    /// @{
+
+    /** @brief Retrieves all static data from the simulation
+     * @param[in] api The connection to use
+     * @param[in] batchSize The number of requests to send per message
+     * @exception tcpip::SocketException if the retrieval fails
+     */
+    void download(TraCIAPI& api, unsigned int batchSize = 1024);
+
+
+    /** @brief Loads the data from the given file
+     * @param[in] file The file to read
+     * @param[in] key The key of the network the data must belong to
+     * @return Whether the file existed and was written for this key by this format version
+     */
+    bool load(const std::string& file, const std::string& key);
+
+
+    /** @brief Saves the data to the given file
+     * @param[in] file The file to write
+     * @param[in] key The key of the network the data belongs to
+     * @exception IOError if the file could not be written
+     */
+    void save(const std::string& file, const std::string& key) const;
+
+
+    /** @brief Loads the data from the file or retrieves and saves it if this fails
+     * @param[in] api The connection to use
+     * @param[in] file The cache file
+     * @param[in] key The key of the network
+     * @return Whether the data was loaded from the file
+     */
+    bool init(TraCIAPI& api, const std::string& file, const std::string& key);
+
+
+    /** @brief Returns a key for the network stored in the given file
+     *
+     * The key is the hex-encoded 64 bit FNV-1a hash of the file's contents.
+     *
+     * @param[in] file The network file
+     * @return The key
+     * @exception IOError if the file could not be read
+     */
+    static std::string hashFile(const std::string& file);
+
+
+    /// @brief Removes all data
+    void clear();
+
+
+    /** @brief Replaces the lane shapes by smoothed ones
+     *
+     * All lane shapes are smoothed in one batch. Saving afterwards stores the
+     *  smoothed shapes, so this is usually called after init().
+     *
+     * @param[in] smoother The smoother to use
+     */
+    void smoothLaneShapes(ShapeSmoother& smoother);
+    /// @}
+
+
+    /// @name lane data
+    /// @{
+
+    /// @brief Returns the ids of all lanes
+    const std::vector<std::string>& getLaneIDs() const {
+        return myLaneIDs;
+    }
+
+    /// @brief Returns the length of the lane
+    SUMOReal getLaneLength(const std::string& laneID) const;
+
+    /// @brief Returns the maximum allowed speed on the lane
+    SUMOReal getLaneMaxSpeed(const std::string& laneID) const;
+
+    /// @brief Returns the shape of the lane
+    TraCIAPI::TraCIPositionVector getLaneShape(const std::string& laneID) const;
+
+    /// @brief Returns the id of the edge the lane belongs to
+    const std::string& getLaneEdgeID(const std::string& laneID) const;
+
+    /// @brief Returns the points of all lane shapes (in the order of getLaneIDs)
+    const TraCIAPI::TraCIPositionVector& getLaneShapePoints() const {
+        return myShapePoints;
+    }
+
+    /// @brief Returns the begin of each lane's shape within getLaneShapePoints (one more than lanes)
+    const std::vector<unsigned int>& getLaneShapeBegins() const {
+        return myLaneShapeBegin;
+    }
+    /// @}
+
+
+    /// @name edge data
+    /// @{
+
+    /// @brief Returns the ids of all edges (including internal ones)
+    const std::vector<std::string>& getEdgeIDs() const {
+        return myEdgeIDs;
+    }
+
+    /// @brief Returns the ids of the edge's lanes
+    std::vector<std::string> getEdgeLanes(const std::string& edgeID) const;
+    /// @}
+
+
+    /// @name junction data
+    /// @{
+
+    /// @brief Returns the ids of all junctions
+    const std::vector<std::string>& getJunctionIDs() const {
+        return myJunctionIDs;
+    }
+
+    /// @brief Returns the position of the junction
+    const TraCIAPI::TraCIPosition& getJunctionPosition(const std::string& junctionID) const;
+    /// @}
+
+
+    /// @name traffic light data
+    /// @{
+
+    /// @brief Returns the ids of all traffic lights
+    const std::vector<std::string>& getTrafficLightIDs() const {
+        return myTLSIDs;
+    }
+
+    /// @brief Returns the lanes controlled by the traffic light
+    std::vector<std::string> getControlledLanes(const std::string& tlsID) const;
+
+    /// @brief Returns the links controlled by the traffic light
+    std::vector<TraCIAPI::TraCILink> getControlledLinks(const std::string& tlsID) const;
+    /// @}
+
+
+private:
+    /// @brief Returns the index of the object, throws an InvalidArgument if it is not known
+    static unsigned int lookup(const FlatStringMap<unsigned int>& index, const std::string& id, const std::string& type);
+
+    /// @brief Rebuilds the index of the given ids
+    static void buildIndex(const std::vector<std::string>& ids, FlatStringMap<unsigned int>& index);
+
+    /// @brief Builds the edge table and all indices from the other tables
+    void rebuild();
+
+
+private:
+    /// @name lanes
+    /// @{
+
+    std::vector<std::string> myLaneIDs;
+    FlatStringMap<unsigned int> myLaneIndex;
+    std::vector<unsigned int> myLaneEdges;
+    std::vector<SUMOReal> myLaneLengths;
+    std::vector<SUMOReal> myLaneMaxSpeeds;
+    /// @brief The begin of each lane's shape within myShapePoints (one more than lanes)
+    std::vector<unsigned int> myLaneShapeBegin;
+    TraCIAPI::TraCIPositionVector myShapePoints;
+    /// @}
+
+    /// @name edges (derived from the lanes)
+    /// @{
+
+    std::vector<std::string> myEdgeIDs;
+    FlatStringMap<unsigned int> myEdgeIndex;
+    /// @brief The begin of each edge's lanes within myEdgeLanes (one more than edges)
+    std::vector<unsigned int> myEdgeLaneBegin;
+    std::vector<unsigned int> myEdgeLanes;
+    /// @}
+
+    /// @name junctions
+    /// @{
+
+    std::vector<std::string> myJunctionIDs;
+    FlatStringMap<unsigned int> myJunctionIndex;
+    TraCIAPI::TraCIPositionVector myJunctionPositions;
+    /// @}
+
+    /// @name traffic lights
+    /// @{
+
+    std::vector<std::string> myTLSIDs;
+    FlatStringMap<unsigned int> myTLSIndex;
+    /// @brief The begin of each traffic light's lanes within myControlledLanes (one more than traffic lights)
+    std::vector<unsigned int> myControlledLaneBegin;
+    std::vector<std::string> myControlledLanes;
+    /// @brief The begin of each traffic light's links within myControlledLinks (one more than traffic lights)
+    std::vector<unsigned int> myControlledLinkBegin;
+    std::vector<TraCIAPI::TraCILink> myControlledLinks;
+    /// @}
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    NetworkCache(const NetworkCache&);
+
+    /// @brief Invalidated assignment operator.
+    NetworkCache& operator=(const NetworkCache&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -0,0 +1,272 @@
+/****************************************************************************/
+/// @file    RoutingCommandBuffer.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Collects route definitions and edge weight updates and sends them at once
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <foreign/tcpip/storage.h>
+#include <traci-server/TraCIConstants.h>
+#include <utils/common/SysUtils.h>
+#include "RoutingCommandBuffer.h"
+
+
+// ===========================================================================
+// static members
+// ===========================================================================
+const unsigned int RoutingCommandBuffer::NO_COMMAND = (unsigned int) - 1;
+
+
+// ===========================================================================
+// member definitions
+// ===========================================================================
+RoutingCommandBuffer::RoutingCommandBuffer(TraCIAPI& api, SUMOReal threshold)
+    : myAPI(api), myThreshold(threshold), myNumPending(0),
+      myNumRequested(0), myNumSent(0), myNumMessages(0), mySendTime(0) {}
+
+
+RoutingCommandBuffer::~RoutingCommandBuffer() {}
+
+
+void
+RoutingCommandBuffer::addRoute(const std::string& routeID, const std::vector<std::string>& edges) {
+    myNumRequested++;
+    Route route;
+    route.id = routeID;
+    route.edges = edges;
+    myRoutes.push_back(route);
+    Command c;
+    c.var = ADD;
+    c.index = (unsigned int)myRoutes.size() - 1;
+    c.value = 0;
+    c.active = true;
+    myCommands.push_back(c);
+    myNumPending++;
+}
+
+
+void
+RoutingCommandBuffer::addRoutes(const std::vector<std::string>& routeIDs, const std::vector<std::vector<std::string> >& edges) {
+    if (routeIDs.size() != edges.size()) {
+        throw std::invalid_argument("The number of route ids and edge lists differ");
+    }
+    for (unsigned int i = 0; i < (unsigned int)routeIDs.size(); ++i) {
+        addRoute(routeIDs[i], edges[i]);
+    }
+}
+
+
+void
+RoutingCommandBuffer::adaptTraveltime(const std::string& edgeID, SUMOReal time) {
+    addWeight(edgeID, WEIGHT_TRAVELTIME, time);
+}
+
+
+void
+RoutingCommandBuffer::adaptTraveltimes(const std::vector<EdgeValue>& times) {
+    for (std::vector<EdgeValue>::const_iterator i = times.begin(); i != times.end(); ++i) {
+        addWeight(i->first, WEIGHT_TRAVELTIME, i->second);
+    }
+}
+
+
+void
+RoutingCommandBuffer::setEffort(const std::string& edgeID, SUMOReal effort) {
+    addWeight(edgeID, WEIGHT_EFFORT, effort);
+}
+
+
+void
+RoutingCommandBuffer::setEfforts(const std::vector<EdgeValue>& efforts) {
+    for (std::vector<EdgeValue>::const_iterator i = efforts.begin(); i != efforts.end(); ++i) {
+        addWeight(i->first, WEIGHT_EFFORT, i->second);
+    }
+}
+
+
+void
+RoutingCommandBuffer::forget() {
+    for (std::vector<Edge>::iterator i = myEdges.begin(); i != myEdges.end(); ++i) {
+        i->known[WEIGHT_TRAVELTIME] = false;
+        i->known[WEIGHT_EFFORT] = false;
+    }
+}
+
+
+void
+RoutingCommandBuffer::flush() {
+    if (myNumPending == 0) {
+        discard();
+        return;
+    }
+    if (myAPI.mySocket == 0) {
+        throw tcpip::SocketException("Socket is not initialised");
+    }
+    const SUMOLong begin = SysUtils::getCurrentMicros();
+    tcpip::Storage outMsg;
+    for (std::vector<Command>::const_iterator i = myCommands.begin(); i != myCommands.end(); ++i) {
+        if (!i->active) {
+            continue;
+        }
+        tcpip::Storage content;
+        if (i->var == ADD) {
+            const Route& route = myRoutes[i->index];
+            content.writeUnsignedByte(TYPE_STRINGLIST);
+            content.writeStringList(route.edges);
+            TraCIAPI::write_commandSetValue(outMsg, CMD_SET_ROUTE_VARIABLE, ADD, route.id, content);
+        } else {
+            // the weight is valid for all times, given as a compound of the value only
+            content.writeUnsignedByte(TYPE_COMPOUND);
+            content.writeInt(1);
+            content.writeUnsignedByte(TYPE_DOUBLE);
+            content.writeDouble(i->value);
+            TraCIAPI::write_commandSetValue(outMsg, CMD_SET_EDGE_VARIABLE, i->var, myEdges[i->index].id, content);
+        }
+    }
+    myAPI.mySocket->sendExact(outMsg);
+    myNumSent += myNumPending;
+    myNumMessages++;
+    // all commands of the message are answered within one message, in order
+    tcpip::Storage inMsg;
+    myAPI.mySocket->receiveExact(inMsg);
+    std::string errors;
+    try {
+        for (std::vector<Command>::const_iterator i = myCommands.begin(); i != myCommands.end(); ++i) {
+            if (!i->active) {
+                continue;
+            }
+            const unsigned int cmdBegin = inMsg.position();
+            unsigned int length = inMsg.readUnsignedByte();
+            if (length == 0) {
+                length = inMsg.readInt();
+            }
+            const int command = inMsg.readUnsignedByte();
+            const int resultType = inMsg.readUnsignedByte();
+            const std::string description = inMsg.readString();
+            const int expected = i->var == ADD ? CMD_SET_ROUTE_VARIABLE : CMD_SET_EDGE_VARIABLE;
+            if (command != expected || inMsg.position() != cmdBegin + length) {
+                throw std::invalid_argument("unexpected status");
+            }
+            if (i->var == ADD) {
+                if (resultType != RTYPE_OK) {
+                    errors += (errors.empty() ? "" : "; ") + myRoutes[i->index].id + ": " + description;
+                }
+                continue;
+            }
+            Edge& edge = myEdges[i->index];
+            const Weight weight = i->var == VAR_EDGE_TRAVELTIME ? WEIGHT_TRAVELTIME : WEIGHT_EFFORT;
+            if (resultType == RTYPE_OK) {
+                edge.sent[weight] = i->value;
+                edge.known[weight] = true;
+            } else {
+                edge.known[weight] = false;
+                errors += (errors.empty() ? "" : "; ") + edge.id + ": " + description;
+            }
+        }
+    } catch (std::invalid_argument&) {
+        discard();
+        forget();
+        throw tcpip::SocketException("#Error: the answer to the routing commands is malformed");
+    }
+    mySendTime += SysUtils::getCurrentMicros() - begin;
+    discard();
+    if (!errors.empty()) {
+        throw tcpip::SocketException(".. Answered with error to routing commands, [description: " + errors + "]");
+    }
+}
+
+
+void
+RoutingCommandBuffer::discard() {
+    for (std::vector<Command>::const_iterator i = myCommands.begin(); i != myCommands.end(); ++i) {
+        if (i->var != ADD) {
+            myEdges[i->index].pending[WEIGHT_TRAVELTIME] = NO_COMMAND;
+            myEdges[i->index].pending[WEIGHT_EFFORT] = NO_COMMAND;
+        }
+    }
+    myCommands.clear();
+    myRoutes.clear();
+    myNumPending = 0;
+}
+
+
+double
+RoutingCommandBuffer::getUpdatesPerSecond() const {
+    if (mySendTime <= 0) {
+        return 0;
+    }
+    return 1000000. * (double)myNumSent / (double)mySendTime;
+}
+
+
+void
+RoutingCommandBuffer::addWeight(const std::string& edgeID, Weight weight, SUMOReal value) {
+    myNumRequested++;
+    const unsigned int index = getEdge(edgeID);
+    Edge& edge = myEdges[index];
+    const bool unchanged = edge.known[weight] && fabs(value - edge.sent[weight]) <= myThreshold;
+    if (edge.pending[weight] != NO_COMMAND) {
+        // the update replaces the recorded one
+        Command& c = myCommands[edge.pending[weight]];
+        if (unchanged) {
+            c.active = false;
+            edge.pending[weight] = NO_COMMAND;
+            myNumPending--;
+        } else {
+            c.value = value;
+        }
+        return;
+    }
+    if (unchanged) {
+        return;
+    }
+    Command c;
+    c.var = weight == WEIGHT_TRAVELTIME ? VAR_EDGE_TRAVELTIME : VAR_EDGE_EFFORT;
+    c.index = index;
+    c.value = value;
+    c.active = true;
+    edge.pending[weight] = (unsigned int)myCommands.size();
+    myCommands.push_back(c);
+    myNumPending++;
+}
+
+
+unsigned int
+RoutingCommandBuffer::getEdge(const std::string& edgeID) {
+    const unsigned int* const known = myEdgeIndex.find(edgeID);
+    if (known != 0) {
+        return *known;
+    }
+    Edge edge;
+    edge.id = edgeID;
+    edge.sent[WEIGHT_TRAVELTIME] = edge.sent[WEIGHT_EFFORT] = 0;
+    edge.known[WEIGHT_TRAVELTIME] = edge.known[WEIGHT_EFFORT] = false;
+    edge.pending[WEIGHT_TRAVELTIME] = edge.pending[WEIGHT_EFFORT] = NO_COMMAND;
+    myEdges.push_back(edge);
+    myEdgeIndex.insert(edgeID, (unsigned int)myEdges.size() - 1);
+    return (unsigned int)myEdges.size() - 1;
+}
+
+
+/****************************************************************************/
+
@@ -0,0 +1,257 @@
+/****************************************************************************/
+/// @file    RoutingCommandBuffer.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Collects route definitions and edge weight updates and sends them at once
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef RoutingCommandBuffer_h
+#define RoutingCommandBuffer_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+#include <utils/common/FlatStringMap.h>
+#include "TraCIAPI.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class RoutingCommandBuffer
+ * @brief Collects route definitions and edge weight updates and sends them at once
+ *
+ * TraCIAPI::RouteScope::add and the weight setters of TraCIAPI::EdgeScope
+ *  pay one round trip per route or edge. The buffer records routes and
+ *  travel time / effort updates, single or as arrays of (edge, value)
+ *  pairs, and flush() sends all of them within one message, checking all
+ *  acknowledgements from the one answer. This suits dynamic assignment,
+ *  which pushes thousands of weights per interval.
+ *
+ * Weight updates are diffed against the values sent before: an update
+ *  which differs from the last value sent for the edge by no more than
+ *  the threshold is dropped, as is all but the last update of an edge
+ *  within one flush. The weights are set for all times (the simulation's
+ *  global edge weights). Routes are sent as given.
+ *
+ * The number of updates sent and the time spent sending them are
+ *  recorded, giving the achieved updates per second.
+ */
+class RoutingCommandBuffer {
+public:
+    /// @brief An (edge, value) pair
+    typedef std::pair<std::string, SUMOReal> EdgeValue;
+
+
+    /** @brief Constructor
+     * @param[in] api The connection to send the commands over
+     * @param[in] threshold The change of a weight below which it is not sent again
+     */
+    RoutingCommandBuffer(TraCIAPI& api, SUMOReal threshold = 0);
+
+
+    /// @brief Destructor
+    ~RoutingCommandBuffer();
+
+
+    /// @name recording commands
+    /// @{
+
+    /// @brief Records the definition of a route
+    void addRoute(const std::string& routeID, const std::vector<std::string>& edges);
+
+    /// @brief Records the definitions of routes (ids and edges in parallel)
+    void addRoutes(const std::vector<std::string>& routeIDs, const std::vector<std::vector<std::string> >& edges);
+
+    /// @brief Records the travel time of an edge
+    void adaptTraveltime(const std::string& edgeID, SUMOReal time);
+
+    /// @brief Records the travel times of edges
+    void adaptTraveltimes(const std::vector<EdgeValue>& times);
+
+    /// @brief Records the effort of an edge
+    void setEffort(const std::string& edgeID, SUMOReal effort);
+
+    /// @brief Records the efforts of edges
+    void setEfforts(const std::vector<EdgeValue>& efforts);
+    /// @}
+
+
+    /// @brief Sets the change of a weight below which it is not sent again
+    void setThreshold(SUMOReal threshold) {
+        myThreshold = threshold;
+    }
+
+
+    /// @brief Returns the change of a weight below which it is not sent again
+    SUMOReal getThreshold() const {
+        return myThreshold;
+    }
+
+
+    /// @brief Forgets the weights sent so far (e.g. if another client set them), so all are sent again
+    void forget();
+
+
+    /** @brief Sends the recorded commands within one message and checks the answers
+     *
+     * All answers are read even if some commands failed; the failures are
+     *  reported together afterwards.
+     *
+     * @exception tcpip::SocketException if the connection fails or any command was answered with an error
+     */
+    void flush();
+
+
+    /// @brief Discards the recorded commands without sending them
+    void discard();
+
+
+    /// @brief Returns the number of recorded commands which will be sent
+    unsigned int size() const {
+        return myNumPending;
+    }
+
+
+    /// @name statistics
+    /// @{
+
+    /// @brief Returns the number of routes and weight updates requested so far
+    unsigned int getNumRequested() const {
+        return myNumRequested;
+    }
+
+    /// @brief Returns the number of routes and weight updates sent so far
+    unsigned int getNumSent() const {
+        return myNumSent;
+    }
+
+    /// @brief Returns the number of messages sent so far
+    unsigned int getNumMessages() const {
+        return myNumMessages;
+    }
+
+    /// @brief Returns the time spent sending and awaiting the answers so far (in microseconds)
+    SUMOLong getSendTime() const {
+        return mySendTime;
+    }
+
+    /// @brief Returns the achieved number of routes and weight updates sent per second (0 if none was sent)
+    double getUpdatesPerSecond() const;
+    /// @}
+
+
+private:
+    /// @brief The weights of an edge
+    enum Weight {
+        WEIGHT_TRAVELTIME = 0,
+        WEIGHT_EFFORT = 1
+    };
+
+
+    /// @brief A recorded command
+    struct Command {
+        /// @brief The variable (ADD for routes)
+        int var;
+        /// @brief The index of the edge within myEdges or of the route within myRoutes
+        unsigned int index;
+        /// @brief The weight
+        SUMOReal value;
+        /// @brief Whether the command is still to be sent
+        bool active;
+    };
+
+
+    /// @brief What was sent to an edge
+    struct Edge {
+        /// @brief The id of the edge
+        std::string id;
+        /// @brief The weights sent last
+        SUMOReal sent[2];
+        /// @brief Whether the weights were sent
+        bool known[2];
+        /// @brief The index of the recorded update of each weight within myCommands (NO_COMMAND if none)
+        unsigned int pending[2];
+    };
+
+
+    /// @brief A recorded route
+    struct Route {
+        /// @brief The id of the route
+        std::string id;
+        /// @brief The edges of the route
+        std::vector<std::string> edges;
+    };
+
+
+    /// @brief Records a weight update
+    void addWeight(const std::string& edgeID, Weight weight, SUMOReal value);
+
+    /// @brief Returns the index of the edge within myEdges, adding it if needed
+    unsigned int getEdge(const std::string& edgeID);
+
+
+private:
+    /// @brief Marks a missing command
+    static const unsigned int NO_COMMAND;
+
+    /// @brief The connection
+    TraCIAPI& myAPI;
+
+    /// @brief The change of a weight below which it is not sent again
+    SUMOReal myThreshold;
+
+    /// @brief The edges seen so far
+    std::vector<Edge> myEdges;
+
+    /// @brief The indices of the edges by id
+    FlatStringMap<unsigned int> myEdgeIndex;
+
+    /// @brief The recorded routes
+    std::vector<Route> myRoutes;
+
+    /// @brief The recorded commands
+    std::vector<Command> myCommands;
+
+    /// @brief The number of recorded commands to be sent
+    unsigned int myNumPending;
+
+    /// @brief The statistics
+    unsigned int myNumRequested, myNumSent, myNumMessages;
+
+    /// @brief The time spent sending and awaiting the answers
+    SUMOLong mySendTime;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    RoutingCommandBuffer(const RoutingCommandBuffer&);
+
+    /// @brief Invalidated assignment operator.
+    RoutingCommandBuffer& operator=(const RoutingCommandBuffer&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
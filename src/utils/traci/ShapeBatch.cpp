@@ -0,0 +1,337 @@
+/****************************************************************************/
+/// @file    ShapeBatch.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Creates and updates many POIs and polygons using pipelined messages
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <stdexcept>
+#include <foreign/tcpip/socket.h>
+#include <traci-server/TraCIConstants.h>
+#include <utils/common/SysUtils.h>
+#include "ShapeBatch.h"
+
+
+// ===========================================================================
+// member definitions
+// ===========================================================================
+ShapeBatch::ShapeBatch(TraCIAPI& api, unsigned int batchSize, unsigned int maxInFlight)
+    : myAPI(api), myBatchSize(batchSize == 0 ? 1 : batchSize), myMaxInFlight(maxInFlight == 0 ? 1 : maxInFlight),
+      myMessageSize(0), myNumSent(0), myNumMessages(0), mySendTime(0) {}
+
+
+ShapeBatch::~ShapeBatch() {}
+
+
+void
+ShapeBatch::addPOIs(const std::vector<std::string>& ids, const TraCIAPI::TraCIPositionVector& positions,
+                    const std::vector<TraCIAPI::TraCIColor>& colors, const std::string& type, int layer) {
+    if (positions.size() != ids.size()) {
+        throw std::invalid_argument("The number of POI ids and positions differ");
+    }
+    checkColors(ids, colors);
+    for (unsigned int i = 0; i < (unsigned int)ids.size(); ++i) {
+        tcpip::Storage content;
+        content.writeUnsignedByte(TYPE_COMPOUND);
+        content.writeInt(4);
+        content.writeUnsignedByte(TYPE_STRING);
+        content.writeString(type);
+        writeColor(content, getColor(colors, i));
+        content.writeUnsignedByte(TYPE_INTEGER);
+        content.writeInt(layer);
+        content.writeUnsignedByte(POSITION_2D);
+        content.writeDouble(positions[i].x);
+        content.writeDouble(positions[i].y);
+        add(CMD_SET_POI_VARIABLE, ADD, ids[i], content);
+    }
+}
+
+
+void
+ShapeBatch::setPOIPositions(const std::vector<std::string>& ids, const TraCIAPI::TraCIPositionVector& positions) {
+    if (positions.size() != ids.size()) {
+        throw std::invalid_argument("The number of POI ids and positions differ");
+    }
+    for (unsigned int i = 0; i < (unsigned int)ids.size(); ++i) {
+        tcpip::Storage content;
+        content.writeUnsignedByte(POSITION_2D);
+        content.writeDouble(positions[i].x);
+        content.writeDouble(positions[i].y);
+        add(CMD_SET_POI_VARIABLE, VAR_POSITION, ids[i], content);
+    }
+}
+
+
+void
+ShapeBatch::setPOIColors(const std::vector<std::string>& ids, const std::vector<TraCIAPI::TraCIColor>& colors) {
+    checkColors(ids, colors);
+    for (unsigned int i = 0; i < (unsigned int)ids.size(); ++i) {
+        tcpip::Storage content;
+        writeColor(content, getColor(colors, i));
+        add(CMD_SET_POI_VARIABLE, VAR_COLOR, ids[i], content);
+    }
+}
+
+
+void
+ShapeBatch::removePOIs(const std::vector<std::string>& ids, int layer) {
+    for (std::vector<std::string>::const_iterator i = ids.begin(); i != ids.end(); ++i) {
+        tcpip::Storage content;
+        content.writeUnsignedByte(TYPE_INTEGER);
+        content.writeInt(layer);
+        add(CMD_SET_POI_VARIABLE, REMOVE, *i, content);
+    }
+}
+
+
+void
+ShapeBatch::addPolygons(const std::vector<std::string>& ids, const TraCIAPI::TraCIPositionVector& points,
+                        const std::vector<unsigned int>& begins, const std::vector<TraCIAPI::TraCIColor>& colors,
+                        bool fill, const std::string& type, int layer) {
+    checkShapes(ids, points, begins);
+    checkColors(ids, colors);
+    for (unsigned int i = 0; i < (unsigned int)ids.size(); ++i) {
+        tcpip::Storage content;
+        content.writeUnsignedByte(TYPE_COMPOUND);
+        content.writeInt(5);
+        content.writeUnsignedByte(TYPE_STRING);
+        content.writeString(type);
+        writeColor(content, getColor(colors, i));
+        content.writeUnsignedByte(TYPE_UBYTE);
+        content.writeUnsignedByte(fill ? 1 : 0);
+        content.writeUnsignedByte(TYPE_INTEGER);
+        content.writeInt(layer);
+        if (writePolygon(content, points, begins[i], begins[i + 1])) {
+            add(CMD_SET_POLYGON_VARIABLE, ADD, ids[i], content);
+        } else {
+            fail(CMD_SET_POLYGON_VARIABLE, ADD, ids[i], "The shape has more than 255 points");
+        }
+    }
+}
+
+
+void
+ShapeBatch::setPolygonShapes(const std::vector<std::string>& ids, const TraCIAPI::TraCIPositionVector& points,
+                             const std::vector<unsigned int>& begins) {
+    checkShapes(ids, points, begins);
+    for (unsigned int i = 0; i < (unsigned int)ids.size(); ++i) {
+        tcpip::Storage content;
+        if (writePolygon(content, points, begins[i], begins[i + 1])) {
+            add(CMD_SET_POLYGON_VARIABLE, VAR_SHAPE, ids[i], content);
+        } else {
+            fail(CMD_SET_POLYGON_VARIABLE, VAR_SHAPE, ids[i], "The shape has more than 255 points");
+        }
+    }
+}
+
+
+void
+ShapeBatch::setPolygonColors(const std::vector<std::string>& ids, const std::vector<TraCIAPI::TraCIColor>& colors) {
+    checkColors(ids, colors);
+    for (unsigned int i = 0; i < (unsigned int)ids.size(); ++i) {
+        tcpip::Storage content;
+        writeColor(content, getColor(colors, i));
+        add(CMD_SET_POLYGON_VARIABLE, VAR_COLOR, ids[i], content);
+    }
+}
+
+
+void
+ShapeBatch::removePolygons(const std::vector<std::string>& ids, int layer) {
+    for (std::vector<std::string>::const_iterator i = ids.begin(); i != ids.end(); ++i) {
+        tcpip::Storage content;
+        content.writeUnsignedByte(TYPE_INTEGER);
+        content.writeInt(layer);
+        add(CMD_SET_POLYGON_VARIABLE, REMOVE, *i, content);
+    }
+}
+
+
+unsigned int
+ShapeBatch::flush() {
+    myFailures.swap(myLocalFailures);
+    myLocalFailures.clear();
+    if (myMessageSize > 0) {
+        finishMessage();
+    }
+    if (myMessages.empty()) {
+        return (unsigned int)myFailures.size();
+    }
+    if (myAPI.mySocket == 0) {
+        discard();
+        throw tcpip::SocketException("Socket is not initialised");
+    }
+    const SUMOLong begin = SysUtils::getCurrentMicros();
+    std::vector<Command>::const_iterator command = myCommands.begin();
+    size_t sent = 0;
+    try {
+        for (size_t answered = 0; answered < myMessages.size(); ++answered) {
+            while (sent < myMessages.size() && sent - answered < myMaxInFlight) {
+                myAPI.mySocket->send(myMessages[sent]);
+                myNumSent += myMessageSizes[sent];
+                myNumMessages++;
+                sent++;
+            }
+            // all commands of a message are answered within one message, in order
+            tcpip::Storage inMsg;
+            myAPI.mySocket->receiveExact(inMsg);
+            for (unsigned int i = 0; i < myMessageSizes[answered]; ++i, ++command) {
+                const unsigned int cmdBegin = inMsg.position();
+                unsigned int length = inMsg.readUnsignedByte();
+                if (length == 0) {
+                    length = inMsg.readInt();
+                }
+                const int commandID = inMsg.readUnsignedByte();
+                const int resultType = inMsg.readUnsignedByte();
+                const std::string description = inMsg.readString();
+                if (commandID != command->command || inMsg.position() != cmdBegin + length) {
+                    throw std::invalid_argument("unexpected status");
+                }
+                if (resultType != RTYPE_OK) {
+                    Failure f;
+                    f.command = command->command;
+                    f.var = command->var;
+                    f.id = command->id;
+                    f.description = description;
+                    myFailures.push_back(f);
+                }
+            }
+        }
+    } catch (std::invalid_argument&) {
+        discard();
+        throw tcpip::SocketException("#Error: the answer to the shape commands is malformed");
+    } catch (tcpip::SocketException&) {
+        discard();
+        throw;
+    }
+    mySendTime += SysUtils::getCurrentMicros() - begin;
+    discard();
+    return (unsigned int)myFailures.size();
+}
+
+
+void
+ShapeBatch::discard() {
+    myCommands.clear();
+    myMessages.clear();
+    myMessageSizes.clear();
+    myMessage.reset();
+    myMessageSize = 0;
+}
+
+
+void
+ShapeBatch::add(int command, int var, const std::string& id, tcpip::Storage& content) {
+    TraCIAPI::write_commandSetValue(myMessage, command, var, id, content);
+    Command c;
+    c.command = command;
+    c.var = var;
+    c.id = id;
+    myCommands.push_back(c);
+    if (++myMessageSize == myBatchSize) {
+        finishMessage();
+    }
+}
+
+
+void
+ShapeBatch::fail(int command, int var, const std::string& id, const std::string& description) {
+    Failure f;
+    f.command = command;
+    f.var = var;
+    f.id = id;
+    f.description = description;
+    myLocalFailures.push_back(f);
+}
+
+
+void
+ShapeBatch::finishMessage() {
+    // the length header as written by tcpip::Socket::sendExact
+    tcpip::Storage header;
+    header.writeInt(4 + (int)myMessage.size());
+    myMessages.push_back(std::vector<unsigned char>());
+    std::vector<unsigned char>& added = myMessages.back();
+    added.reserve(header.size() + myMessage.size());
+    added.insert(added.end(), header.begin(), header.end());
+    added.insert(added.end(), myMessage.begin(), myMessage.end());
+    myMessageSizes.push_back(myMessageSize);
+    myMessage.reset();
+    myMessageSize = 0;
+}
+
+
+const TraCIAPI::TraCIColor&
+ShapeBatch::getColor(const std::vector<TraCIAPI::TraCIColor>& colors, unsigned int i) {
+    return colors.size() == 1 ? colors[0] : colors[i];
+}
+
+
+void
+ShapeBatch::checkColors(const std::vector<std::string>& ids, const std::vector<TraCIAPI::TraCIColor>& colors) {
+    if (colors.size() != ids.size() && colors.size() != 1) {
+        throw std::invalid_argument("The number of colors must be one or the number of ids");
+    }
+}
+
+
+void
+ShapeBatch::checkShapes(const std::vector<std::string>& ids, const TraCIAPI::TraCIPositionVector& points,
+                        const std::vector<unsigned int>& begins) {
+    if (begins.size() != ids.size() + 1) {
+        throw std::invalid_argument("The number of shape begins must be one more than the number of ids");
+    }
+    for (unsigned int i = 0; i < (unsigned int)ids.size(); ++i) {
+        if (begins[i] > begins[i + 1] || begins[i + 1] > points.size()) {
+            throw std::invalid_argument("The shape begins are not ascending within the points");
+        }
+    }
+}
+
+
+void
+ShapeBatch::writeColor(tcpip::Storage& content, const TraCIAPI::TraCIColor& c) {
+    content.writeUnsignedByte(TYPE_COLOR);
+    content.writeUnsignedByte(c.r);
+    content.writeUnsignedByte(c.g);
+    content.writeUnsignedByte(c.b);
+    content.writeUnsignedByte(c.a);
+}
+
+
+bool
+ShapeBatch::writePolygon(tcpip::Storage& content, const TraCIAPI::TraCIPositionVector& points,
+                         unsigned int begin, unsigned int end) {
+    if (end - begin > 255) {
+        return false;
+    }
+    content.writeUnsignedByte(TYPE_POLYGON);
+    content.writeUnsignedByte(end - begin);
+    for (unsigned int i = begin; i < end; ++i) {
+        content.writeDouble(points[i].x);
+        content.writeDouble(points[i].y);
+    }
+    return true;
+}
+
+
+/****************************************************************************/
+
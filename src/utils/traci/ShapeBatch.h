@@ -0,0 +1,275 @@
+/****************************************************************************/
+/// @file    ShapeBatch.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Creates and updates many POIs and polygons using pipelined messages
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef ShapeBatch_h
+#define ShapeBatch_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <string>
+#include <vector>
+#include <foreign/tcpip/storage.h>
+#include "TraCIAPI.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class ShapeBatch
+ * @brief Creates and updates many POIs and polygons using pipelined messages
+ *
+ * The setters of TraCIAPI::POIScope and TraCIAPI::PolygonScope send one
+ *  command per shape and wait for its answer, so loading a large overlay
+ *  pays one round trip per shape. The bulk methods of the batch take
+ *  arrays of ids and the matching positions, colors and shapes and encode
+ *  one command per shape into messages of up to batchSize commands.
+ *  flush() streams the messages keeping up to maxInFlight of them sent
+ *  but not yet answered (as TraCIProgramExecutor does), which bounds the
+ *  memory the simulation buffers while hiding the round trips.
+ *
+ * A failing command does not abort the batch: all answers are read and
+ *  the failed commands are reported by getFailures(). Polygons with more
+ *  points than TraCI can encode (255) fail without being sent.
+ *
+ * Polygon shapes are given as one flat point buffer with the begin of
+ *  each shape (one more than shapes), the layout NetworkCache stores
+ *  shapes in. Color arrays hold either one color per shape or a single
+ *  color for all of them.
+ */
+class ShapeBatch {
+public:
+    /// @brief A command which failed
+    struct Failure {
+        /// @brief The command (CMD_SET_POI_VARIABLE or CMD_SET_POLYGON_VARIABLE)
+        int command;
+        /// @brief The variable (ADD, REMOVE, VAR_POSITION, VAR_SHAPE, VAR_COLOR)
+        int var;
+        /// @brief The id of the shape
+        std::string id;
+        /// @brief The description of the error
+        std::string description;
+    };
+
+
+    /** @brief Constructor
+     * @param[in] api The connection to send the commands over
+     * @param[in] batchSize The maximum number of commands per message
+     * @param[in] maxInFlight The maximum number of messages sent but not answered
+     */
+    ShapeBatch(TraCIAPI& api, unsigned int batchSize = 256, unsigned int maxInFlight = 4);
+
+
+    /// @brief Destructor
+    ~ShapeBatch();
+
+
+    /// @name POIs
+    /// @{
+
+    /** @brief Records the creation of POIs
+     * @param[in] ids The ids of the POIs
+     * @param[in] positions The position of each POI
+     * @param[in] colors The color of each POI or one color for all
+     * @param[in] type The type of all POIs
+     * @param[in] layer The layer of all POIs
+     * @exception std::invalid_argument if the array sizes do not match
+     */
+    void addPOIs(const std::vector<std::string>& ids, const TraCIAPI::TraCIPositionVector& positions,
+                 const std::vector<TraCIAPI::TraCIColor>& colors, const std::string& type, int layer);
+
+    /// @brief Records moving POIs
+    void setPOIPositions(const std::vector<std::string>& ids, const TraCIAPI::TraCIPositionVector& positions);
+
+    /// @brief Records recoloring POIs
+    void setPOIColors(const std::vector<std::string>& ids, const std::vector<TraCIAPI::TraCIColor>& colors);
+
+    /// @brief Records the removal of POIs
+    void removePOIs(const std::vector<std::string>& ids, int layer = 0);
+    /// @}
+
+
+    /// @name polygons
+    /// @{
+
+    /** @brief Records the creation of polygons
+     * @param[in] ids The ids of the polygons
+     * @param[in] points The points of all shapes
+     * @param[in] begins The index of each shape's first point (one more than ids)
+     * @param[in] colors The color of each polygon or one color for all
+     * @param[in] fill Whether the polygons are filled
+     * @param[in] type The type of all polygons
+     * @param[in] layer The layer of all polygons
+     * @exception std::invalid_argument if the array sizes do not match
+     */
+    void addPolygons(const std::vector<std::string>& ids, const TraCIAPI::TraCIPositionVector& points,
+                     const std::vector<unsigned int>& begins, const std::vector<TraCIAPI::TraCIColor>& colors,
+                     bool fill, const std::string& type, int layer);
+
+    /// @brief Records reshaping polygons
+    void setPolygonShapes(const std::vector<std::string>& ids, const TraCIAPI::TraCIPositionVector& points,
+                          const std::vector<unsigned int>& begins);
+
+    /// @brief Records recoloring polygons
+    void setPolygonColors(const std::vector<std::string>& ids, const std::vector<TraCIAPI::TraCIColor>& colors);
+
+    /// @brief Records the removal of polygons
+    void removePolygons(const std::vector<std::string>& ids, int layer = 0);
+    /// @}
+
+
+    /** @brief Sends the recorded commands and reads all answers
+     * @return The number of commands which failed (see getFailures)
+     * @exception tcpip::SocketException if the connection fails or an answer is malformed
+     */
+    unsigned int flush();
+
+
+    /// @brief Discards the recorded commands without sending them
+    void discard();
+
+
+    /// @brief Returns the number of recorded commands which will be sent
+    unsigned int size() const {
+        return (unsigned int)myCommands.size();
+    }
+
+
+    /// @brief Returns the commands which failed in the last flush
+    const std::vector<Failure>& getFailures() const {
+        return myFailures;
+    }
+
+
+    /// @name statistics
+    /// @{
+
+    /// @brief Returns the number of commands sent so far
+    unsigned int getNumSent() const {
+        return myNumSent;
+    }
+
+    /// @brief Returns the number of messages sent so far
+    unsigned int getNumMessages() const {
+        return myNumMessages;
+    }
+
+    /// @brief Returns the time spent sending and awaiting the answers so far (in microseconds)
+    SUMOLong getSendTime() const {
+        return mySendTime;
+    }
+    /// @}
+
+
+private:
+    /// @brief A recorded command
+    struct Command {
+        /// @brief The command
+        int command;
+        /// @brief The variable
+        int var;
+        /// @brief The id of the shape
+        std::string id;
+    };
+
+
+    /// @brief Encodes a command into the message being built
+    void add(int command, int var, const std::string& id, tcpip::Storage& content);
+
+    /// @brief Records a local failure
+    void fail(int command, int var, const std::string& id, const std::string& description);
+
+    /// @brief Appends the message being built to the prepared ones
+    void finishMessage();
+
+    /// @brief Returns the color of the given shape
+    static const TraCIAPI::TraCIColor& getColor(const std::vector<TraCIAPI::TraCIColor>& colors, unsigned int i);
+
+    /// @brief Checks that the colors match the ids
+    static void checkColors(const std::vector<std::string>& ids, const std::vector<TraCIAPI::TraCIColor>& colors);
+
+    /// @brief Checks that the shapes match the ids
+    static void checkShapes(const std::vector<std::string>& ids, const TraCIAPI::TraCIPositionVector& points,
+                            const std::vector<unsigned int>& begins);
+
+    /// @brief Writes a color value
+    static void writeColor(tcpip::Storage& content, const TraCIAPI::TraCIColor& c);
+
+    /** @brief Writes a polygon value
+     * @return Whether the polygon could be encoded
+     */
+    static bool writePolygon(tcpip::Storage& content, const TraCIAPI::TraCIPositionVector& points,
+                             unsigned int begin, unsigned int end);
+
+
+private:
+    /// @brief The connection
+    TraCIAPI& myAPI;
+
+    /// @brief The maximum number of commands per message
+    const unsigned int myBatchSize;
+
+    /// @brief The maximum number of messages sent but not answered
+    const unsigned int myMaxInFlight;
+
+    /// @brief The recorded commands
+    std::vector<Command> myCommands;
+
+    /// @brief The prepared messages, including the length header
+    std::vector<std::vector<unsigned char> > myMessages;
+
+    /// @brief The number of commands of each prepared message
+    std::vector<unsigned int> myMessageSizes;
+
+    /// @brief The commands of the message being built
+    tcpip::Storage myMessage;
+
+    /// @brief The number of commands of the message being built
+    unsigned int myMessageSize;
+
+    /// @brief The commands which failed in the last flush
+    std::vector<Failure> myFailures;
+
+    /// @brief The commands which failed while being recorded
+    std::vector<Failure> myLocalFailures;
+
+    /// @brief The statistics
+    unsigned int myNumSent, myNumMessages;
+
+    /// @brief The time spent sending and awaiting the answers
+    SUMOLong mySendTime;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    ShapeBatch(const ShapeBatch&);
+
+    /// @brief Invalidated assignment operator.
+    ShapeBatch& operator=(const ShapeBatch&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -0,0 +1,441 @@
+/****************************************************************************/
+/// @file    ShapeSmoother.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Smooths many polylines at once by fitting biarcs or Euler spirals in parallel
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <cmath>
+#include <utils/common/SysUtils.h>
+#include "ShapeSmoother.h"
+
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif // CHECK_MEMORY_LEAKS
+
+
+// ===========================================================================
+// static members
+// ===========================================================================
+const unsigned int ShapeSmoother::GRAIN;
+
+
+// ===========================================================================
+// helper definitions
+// ===========================================================================
+namespace {
+/// @brief Returns whether the fitted curves are usable for a segment of the given length
+bool
+isPlausible(double length, double chord) {
+    // rejects NaNs as well as curves looping around
+    return length >= chord * (1. - 1e-6) && length <= chord * 4.;
+}
+
+
+/// @brief Returns a straight line from the given point with the given direction and length
+EulerSpiralParams
+straight(const TraCIAPI::TraCIPosition& from, double angle, double length) {
+    EulerSpiralParams result;
+    result.start_pt = Point2D<double>(from.x, from.y);
+    result.start_angle = angle;
+    result.L = length;
+    return result;
+}
+
+
+/// @brief Returns the angle within [-pi, pi)
+double
+normalized(double angle) {
+    angle = fmod(angle + M_PI, 2 * M_PI);
+    return (angle < 0 ? angle + 2 * M_PI : angle) - M_PI;
+}
+
+
+/// @brief Sets the arc starting at the point with the given direction and ending at (x, y)
+void
+setArc(const Point2D<double>& from, double angle, double x, double y, EulerSpiralParams& arc) {
+    const double dx = x - from.getX();
+    const double dy = y - from.getY();
+    const double chord = sqrt(dx * dx + dy * dy);
+    arc = EulerSpiralParams();
+    arc.start_pt = from;
+    arc.start_angle = angle;
+    if (chord == 0) {
+        return;
+    }
+    // the arc turns by twice the angle between its start direction and its chord
+    const double alpha = normalized(atan2(dy, dx) - angle);
+    arc.K0 = 2 * sin(alpha) / chord;
+    arc.L = fabs(alpha) < 1e-9 ? chord : chord * alpha / sin(alpha);
+    arc.end_pt = Point2D<double>(x, y);
+    arc.end_angle = angle + 2 * alpha;
+}
+
+
+/** @brief Fits a biarc to the segment, stored as two spirals of constant curvature
+ *
+ * The tangent segments from both ends to the arcs' control points have the
+ *  same length d, so the control points are 2d apart and the arcs join
+ *  halfway between them.
+ *
+ * @return Whether a biarc exists
+ */
+bool
+fitBiarc(const Point2D<double>& start, double startAngle, const Point2D<double>& end, double endAngle,
+         EulerSpiralParams& first, EulerSpiralParams& second) {
+    const double vx = end.getX() - start.getX();
+    const double vy = end.getY() - start.getY();
+    const double t1x = cos(startAngle);
+    const double t1y = sin(startAngle);
+    const double t2x = cos(endAngle);
+    const double t2y = sin(endAngle);
+    const double vv = vx * vx + vy * vy;
+    const double vt = vx * (t1x + t2x) + vy * (t1y + t2y);
+    // the positive root of 2 (1 - t1.t2) d^2 + 2 (v.t) d - v.v = 0, in a form stable for parallel tangents
+    const double denominator = vt + sqrt(vt * vt + 2 * (1 - (t1x * t2x + t1y * t2y)) * vv);
+    if (!(denominator > 0)) {
+        return false;
+    }
+    const double d = vv / denominator;
+    const double midX = start.getX() + (vx + d * (t1x - t2x)) / 2;
+    const double midY = start.getY() + (vy + d * (t1y - t2y)) / 2;
+    setArc(start, startAngle, midX, midY, first);
+    setArc(Point2D<double>(midX, midY), first.L > 0 ? first.end_angle : startAngle, end.getX(), end.getY(), second);
+    return true;
+}
+
+
+/// @brief Integrates the unit direction of the angle theta0 + a u + b u^2 over u within [0, 1]
+void
+integrateDirection(double theta0, double a, double b, double& x, double& y) {
+    static const double nodes[4] = {-0.861136311594052575, -0.339981043584856265, 0.339981043584856265, 0.861136311594052575};
+    static const double weights[4] = {0.347854845137453857, 0.652145154862546143, 0.652145154862546143, 0.347854845137453857};
+    // four point Gauss-Legendre quadrature over intervals turning by at most a quarter radian
+    const unsigned int steps = 1 + (unsigned int)((fabs(a) + 2 * fabs(b)) / 0.25);
+    const double h = 1. / steps;
+    x = 0;
+    y = 0;
+    for (unsigned int i = 0; i < steps; ++i) {
+        for (int q = 0; q < 4; ++q) {
+            const double u = (i + 0.5 * (1 + nodes[q])) * h;
+            const double angle = theta0 + u * (a + b * u);
+            x += 0.5 * h * weights[q] * cos(angle);
+            y += 0.5 * h * weights[q] * sin(angle);
+        }
+    }
+}
+
+
+/// @brief Returns the direction of the end point of the spiral of unit length
+double
+endDirection(double theta0, double a, double b) {
+    double x, y;
+    integrateDirection(theta0, a, b, x, y);
+    return atan2(y, x);
+}
+
+
+/** @brief Fits an Euler spiral to the segment
+ *
+ * Measured in units of its length L and relative to the chord, the spiral's
+ *  angle is theta0 + a u + b u^2 where a + b is the turning angle. The
+ *  direction of its end point therefore only depends on a, whose root is
+ *  found by the secant method starting from the small angle approximation
+ *  (the end point lies in the direction theta0 + a / 2 + b / 3); the length
+ *  then scales the spiral onto the chord.
+ *
+ * @return Whether the fit converged
+ */
+bool
+fitEulerSpiral(const Point2D<double>& start, double startAngle, const Point2D<double>& end, double endAngle,
+               EulerSpiralParams& spiral) {
+    const double vx = end.getX() - start.getX();
+    const double vy = end.getY() - start.getY();
+    const double theta0 = normalized(startAngle - atan2(vy, vx));
+    const double turn = normalized(endAngle - startAngle);
+    double a0 = -6 * theta0 - 2 * turn;
+    double f0 = endDirection(theta0, a0, turn - a0);
+    double a1 = a0 + 0.1;
+    double f1 = endDirection(theta0, a1, turn - a1);
+    for (int i = 0; i < 50 && fabs(f1) > 1e-12; ++i) {
+        if (f1 == f0) {
+            break;
+        }
+        const double a2 = a1 - f1 * (a1 - a0) / (f1 - f0);
+        a0 = a1;
+        f0 = f1;
+        a1 = a2;
+        f1 = endDirection(theta0, a1, turn - a1);
+    }
+    if (!(fabs(f1) < 1e-9)) {
+        return false;
+    }
+    double x, y;
+    integrateDirection(theta0, a1, turn - a1, x, y);
+    const double length = sqrt(vx * vx + vy * vy) / sqrt(x * x + y * y);
+    spiral = EulerSpiralParams();
+    spiral.start_pt = start;
+    spiral.start_angle = startAngle;
+    spiral.end_pt = end;
+    spiral.end_angle = startAngle + turn;
+    spiral.K0 = a1 / length;
+    spiral.gamma = 2 * (turn - a1) / (length * length);
+    spiral.K2 = spiral.K0 + spiral.gamma * length;
+    spiral.turningAngle = turn;
+    spiral.L = length;
+    return true;
+}
+}
+
+
+// ===========================================================================
+// task definitions
+// ===========================================================================
+class ShapeSmoother::TangentTask : public ThreadPool::Task {
+public:
+    TangentTask(const TraCIAPI::TraCIPositionVector& points, const std::vector<unsigned int>& begins, std::vector<double>& tangents)
+        : myPoints(points), myBegins(begins), myTangents(tangents) {}
+
+    void run(unsigned int begin, unsigned int end) {
+        for (unsigned int shape = begin; shape < end; ++shape) {
+            const unsigned int first = myBegins[shape];
+            const unsigned int last = myBegins[shape + 1];
+            for (unsigned int i = first; i < last; ++i) {
+                // the sum of the unit directions of the adjacent segments is their bisector
+                double dx = 0;
+                double dy = 0;
+                if (i > first) {
+                    add(myPoints[i - 1], myPoints[i], dx, dy);
+                }
+                if (i + 1 < last) {
+                    add(myPoints[i], myPoints[i + 1], dx, dy);
+                }
+                myTangents[i] = dx == 0 && dy == 0 ? 0 : atan2(dy, dx);
+            }
+        }
+    }
+
+private:
+    static void add(const TraCIAPI::TraCIPosition& from, const TraCIAPI::TraCIPosition& to, double& dx, double& dy) {
+        const double x = to.x - from.x;
+        const double y = to.y - from.y;
+        const double length = sqrt(x * x + y * y);
+        if (length > 0) {
+            dx += x / length;
+            dy += y / length;
+        }
+    }
+
+    const TraCIAPI::TraCIPositionVector& myPoints;
+    const std::vector<unsigned int>& myBegins;
+    std::vector<double>& myTangents;
+
+private:
+    TangentTask& operator=(const TangentTask&);
+};
+
+
+class ShapeSmoother::FitTask : public ThreadPool::Task {
+public:
+    FitTask(Method method, const TraCIAPI::TraCIPositionVector& points, const std::vector<unsigned int>& begins,
+            const std::vector<unsigned int>& segmentShapes, const std::vector<double>& tangents, std::vector<EulerSpiralParams>& curves)
+        : myMethod(method), myPoints(points), myBegins(begins), mySegmentShapes(segmentShapes),
+          myTangents(tangents), myCurves(curves) {}
+
+    void run(unsigned int begin, unsigned int end) {
+        for (unsigned int i = begin; i < end; ++i) {
+            if (i + 1 >= myBegins[mySegmentShapes[i] + 1]) {
+                // the last point of its shape
+                continue;
+            }
+            const TraCIAPI::TraCIPosition& from = myPoints[i];
+            const TraCIAPI::TraCIPosition& to = myPoints[i + 1];
+            const double chord = sqrt((to.x - from.x) * (to.x - from.x) + (to.y - from.y) * (to.y - from.y));
+            EulerSpiralParams& first = myCurves[2 * i];
+            EulerSpiralParams& second = myCurves[2 * i + 1];
+            first = straight(from, atan2(to.y - from.y, to.x - from.x), chord);
+            second = EulerSpiralParams();
+            if (chord == 0) {
+                continue;
+            }
+            const Point2D<double> start(from.x, from.y);
+            const Point2D<double> stop(to.x, to.y);
+            if (myMethod == BIARC) {
+                EulerSpiralParams arc1, arc2;
+                if (fitBiarc(start, myTangents[i], stop, myTangents[i + 1], arc1, arc2)
+                        && isPlausible(arc1.L + arc2.L, chord)) {
+                    first = arc1;
+                    second = arc2;
+                }
+            } else {
+                EulerSpiralParams spiral;
+                if (fitEulerSpiral(start, myTangents[i], stop, myTangents[i + 1], spiral)
+                        && isPlausible(spiral.L, chord)) {
+                    first = spiral;
+                }
+            }
+        }
+    }
+
+private:
+    const Method myMethod;
+    const TraCIAPI::TraCIPositionVector& myPoints;
+    const std::vector<unsigned int>& myBegins;
+    const std::vector<unsigned int>& mySegmentShapes;
+    const std::vector<double>& myTangents;
+    std::vector<EulerSpiralParams>& myCurves;
+
+private:
+    FitTask& operator=(const FitTask&);
+};
+
+
+class ShapeSmoother::SampleTask : public ThreadPool::Task {
+public:
+    SampleTask(const EulerSpiralBatch& batch, const std::vector<unsigned int>& targets, const std::vector<double>& heights,
+               std::vector<double>& x, std::vector<double>& y, TraCIAPI::TraCIPositionVector& smoothed)
+        : myBatch(batch), myTargets(targets), myHeights(heights), myX(x), myY(y), mySmoothed(smoothed) {}
+
+    void run(unsigned int begin, unsigned int end) {
+        myBatch.evaluate(begin, end, &myX[0], &myY[0]);
+        for (unsigned int curve = begin; curve < end; ++curve) {
+            // the first point equals the last one of the preceding curve
+            const int offset = myBatch.first_point(curve);
+            const int num = myBatch.num_points(curve);
+            TraCIAPI::TraCIPosition* const target = &mySmoothed[0] + myTargets[curve];
+            for (int j = 1; j < num; ++j) {
+                target[j].x = myX[offset + j];
+                target[j].y = myY[offset + j];
+                target[j].z = myHeights[curve];
+            }
+        }
+    }
+
+private:
+    const EulerSpiralBatch& myBatch;
+    const std::vector<unsigned int>& myTargets;
+    const std::vector<double>& myHeights;
+    std::vector<double>& myX;
+    std::vector<double>& myY;
+    TraCIAPI::TraCIPositionVector& mySmoothed;
+
+private:
+    SampleTask& operator=(const SampleTask&);
+};
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+ShapeSmoother::ShapeSmoother(Method method, double spacing, unsigned int numThreads)
+    : myMethod(method), mySpacing(spacing > 0 ? spacing : 1.), myPool(numThreads) {
+    myTimings.tangents = 0;
+    myTimings.fitting = 0;
+    myTimings.sampling = 0;
+    myTimings.total = 0;
+}
+
+
+ShapeSmoother::~ShapeSmoother() {}
+
+
+void
+ShapeSmoother::smooth(const TraCIAPI::TraCIPositionVector& points, const std::vector<unsigned int>& begins,
+                      TraCIAPI::TraCIPositionVector& smoothed, std::vector<unsigned int>& smoothedBegins) {
+    const long start = SysUtils::getCurrentMillis();
+    const unsigned int numShapes = begins.size() > 0 ? (unsigned int)begins.size() - 1 : 0;
+    const unsigned int numPoints = (unsigned int)points.size();
+    myTangents.resize(numPoints);
+    mySegmentShapes.resize(numPoints);
+    for (unsigned int shape = 0; shape < numShapes; ++shape) {
+        for (unsigned int i = begins[shape]; i < begins[shape + 1]; ++i) {
+            mySegmentShapes[i] = shape;
+        }
+    }
+    TangentTask tangents(points, begins, myTangents);
+    myPool.parallelFor(numShapes, GRAIN, tangents);
+    const long tangentsDone = SysUtils::getCurrentMillis();
+
+    myCurves.resize(2 * numPoints);
+    FitTask fit(myMethod, points, begins, mySegmentShapes, myTangents, myCurves);
+    myPool.parallelFor(numPoints, GRAIN, fit);
+    const long fittingDone = SysUtils::getCurrentMillis();
+
+    // collect the curves, remembering where their points go
+    myBatch.clear();
+    myCurveTargets.clear();
+    myCurveHeights.clear();
+    smoothedBegins.clear();
+    smoothedBegins.reserve(numShapes + 1);
+    std::vector<unsigned int> pointTargets(numPoints);
+    unsigned int numSmoothed = 0;
+    for (unsigned int shape = 0; shape < numShapes; ++shape) {
+        smoothedBegins.push_back(numSmoothed);
+        const unsigned int first = begins[shape];
+        const unsigned int last = begins[shape + 1];
+        if (first == last) {
+            continue;
+        }
+        pointTargets[first] = numSmoothed++;
+        for (unsigned int i = first + 1; i < last; ++i) {
+            if (last - first >= 3) {
+                // all points but the first one of each curve
+                for (unsigned int j = 2 * (i - 1); j < 2 * i; ++j) {
+                    const EulerSpiralParams& curve = myCurves[j];
+                    if (curve.L > 0) {
+                        myBatch.add(curve, (int)ceil(curve.L / mySpacing) + 1);
+                        myCurveTargets.push_back(numSmoothed - 1);
+                        myCurveHeights.push_back(points[i - 1].z);
+                        numSmoothed += myBatch.num_points(myBatch.size() - 1) - 1;
+                    }
+                }
+            }
+            if (pointTargets[i - 1] == numSmoothed - 1) {
+                // no curve (a repeated point or a short shape)
+                numSmoothed++;
+            }
+            pointTargets[i] = numSmoothed - 1;
+        }
+    }
+    smoothedBegins.push_back(numSmoothed);
+    smoothed.resize(numSmoothed);
+    myX.resize(myBatch.num_points());
+    myY.resize(myBatch.num_points());
+    SampleTask sample(myBatch, myCurveTargets, myCurveHeights, myX, myY, smoothed);
+    myPool.parallelFor(myBatch.size(), GRAIN, sample);
+    // the curves end close to the original points, the smoothed shapes pass them exactly
+    for (unsigned int i = 0; i < numPoints; ++i) {
+        smoothed[pointTargets[i]] = points[i];
+    }
+    const long done = SysUtils::getCurrentMillis();
+    myTimings.tangents = tangentsDone - start;
+    myTimings.fitting = fittingDone - tangentsDone;
+    myTimings.sampling = done - fittingDone;
+    myTimings.total = done - start;
+}
+
+
+/****************************************************************************/
+
@@ -0,0 +1,172 @@
+/****************************************************************************/
+/// @file    ShapeSmoother.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Smooths many polylines at once by fitting biarcs or Euler spirals in parallel
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef ShapeSmoother_h
+#define ShapeSmoother_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <vector>
+#include <foreign/eulerspiral/euler_batch.h>
+#include <utils/common/ThreadPool.h>
+#include "TraCIAPI.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class ShapeSmoother
+ * @brief Smooths many polylines at once by fitting biarcs or Euler spirals in parallel
+ *
+ * The shapes are given as one flat point buffer with the begin of each
+ *  shape (one more than shapes), the layout NetworkCache stores the lane
+ *  shapes in, and the smoothed shapes are written into a buffer of the same
+ *  layout. Each segment between two consecutive points is replaced by a
+ *  curve joining both points with the tangent directions of the polyline
+ *  there (the bisectors of the adjacent segments), so the smoothed shape
+ *  passes through all original points with a continuous direction.
+ *
+ * Smoothing runs in three stages, each distributed over a thread pool:
+ *  computing the tangents (per shape), fitting the curves (per segment)
+ *  and sampling the curves (per range of segments, see EulerSpiralBatch).
+ *  The time spent in each stage is reported.
+ */
+class ShapeSmoother {
+public:
+    /// @brief The curves to fit to the segments
+    enum Method {
+        /// @brief a biarc (two circular arcs) per segment
+        BIARC,
+        /// @brief an Euler spiral (linearly changing curvature) per segment
+        EULER_SPIRAL
+    };
+
+
+    /// @brief The wall clock time spent in the stages of the last smooth call (in ms)
+    struct Timings {
+        long tangents;
+        long fitting;
+        long sampling;
+        long total;
+    };
+
+
+    /** @brief Constructor
+     * @param[in] method The curves to fit
+     * @param[in] spacing The maximum distance between sampled points
+     * @param[in] numThreads The number of threads besides the calling one
+     */
+    ShapeSmoother(Method method, double spacing, unsigned int numThreads = ThreadPool::getHardwareConcurrency() - 1);
+
+
+    /// @brief Destructor
+    ~ShapeSmoother();
+
+
+    /** @brief Smooths all given shapes
+     *
+     * Shapes with less than three points are copied unchanged.
+     *
+     * @param[in] points The points of all shapes
+     * @param[in] begins The index of each shape's first point (one more than shapes)
+     * @param[out] smoothed The points of all smoothed shapes
+     * @param[out] smoothedBegins The index of each smoothed shape's first point
+     */
+    void smooth(const TraCIAPI::TraCIPositionVector& points, const std::vector<unsigned int>& begins,
+                TraCIAPI::TraCIPositionVector& smoothed, std::vector<unsigned int>& smoothedBegins);
+
+
+    /// @brief Returns the timings of the last smooth call
+    const Timings& getTimings() const {
+        return myTimings;
+    }
+
+
+private:
+    /// @brief Computes the tangent direction at each point of a range of shapes
+    class TangentTask;
+
+    /// @brief Fits the curves to a range of segments
+    class FitTask;
+
+    /// @brief Samples the curves of a range of segments
+    class SampleTask;
+
+
+    /// @brief The number of shapes / segments per claimed range
+    static const unsigned int GRAIN = 64;
+
+
+private:
+    /// @brief The curves to fit
+    const Method myMethod;
+
+    /// @brief The maximum distance between sampled points
+    const double mySpacing;
+
+    /// @brief The threads
+    ThreadPool myPool;
+
+    /// @brief The tangent direction at each input point
+    std::vector<double> myTangents;
+
+    /// @brief The input shape of each segment (the segments are indexed by their first point)
+    std::vector<unsigned int> mySegmentShapes;
+
+    /// @brief The curves fitted to each segment (one per Euler spiral, two per biarc)
+    std::vector<EulerSpiralParams> myCurves;
+
+    /// @brief The sampled curves
+    EulerSpiralBatch myBatch;
+
+    /// @brief The index of the smoothed point each curve starts at
+    std::vector<unsigned int> myCurveTargets;
+
+    /// @brief The height (z) of each curve
+    std::vector<double> myCurveHeights;
+
+    /// @brief The sampled points of all curves
+    std::vector<double> myX, myY;
+
+    /// @brief The timings of the last call
+    Timings myTimings;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    ShapeSmoother(const ShapeSmoother&);
+
+    /// @brief Invalidated assignment operator.
+    ShapeSmoother& operator=(const ShapeSmoother&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -0,0 +1,134 @@
+/****************************************************************************/
+/// @file    StepSummary.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// The vehicles loaded, departed, teleported and arrived in a step
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <stdexcept>
+#include <foreign/tcpip/storage.h>
+#include <traci-server/TraCIConstants.h>
+#include "TraCIAPI.h"
+#include "TraCIReader.h"
+#include "StepSummary.h"
+
+
+// ===========================================================================
+// member definitions
+// ===========================================================================
+StepSummary::StepSummary()
+    : myTime(0), myMinExpectedNumber(0), myAmValid(false) {}
+
+
+StepSummary::~StepSummary() {}
+
+
+void
+StepSummary::subscribe(TraCIAPI& api, SUMOTime beginTime, SUMOTime endTime) {
+    std::vector<int> vars;
+    vars.push_back(VAR_TIME_STEP);
+    vars.push_back(VAR_MIN_EXPECTED_VEHICLES);
+    vars.push_back(VAR_LOADED_VEHICLES_IDS);
+    vars.push_back(VAR_DEPARTED_VEHICLES_IDS);
+    vars.push_back(VAR_ARRIVED_VEHICLES_IDS);
+    vars.push_back(VAR_TELEPORT_STARTING_VEHICLES_IDS);
+    vars.push_back(VAR_TELEPORT_ENDING_VEHICLES_IDS);
+    api.subscribe(CMD_SUBSCRIBE_SIM_VARIABLE, "", beginTime, endTime, vars);
+}
+
+
+void
+StepSummary::readStep(tcpip::Storage& inMsg) {
+    myArena.reset();
+    myLoaded.clear();
+    myDeparted.clear();
+    myArrived.clear();
+    myStartingTeleport.clear();
+    myEndingTeleport.clear();
+    myAmValid = false;
+    const unsigned int end = (unsigned int)inMsg.size();
+    try {
+        TraCIReader reader(end == 0 ? 0 : &*inMsg.begin(), inMsg.position(), end);
+        const unsigned int numResults = reader.readLength();
+        for (unsigned int i = 0; i < numResults; ++i) {
+            const unsigned int begin = reader.position();
+            const unsigned int length = reader.readCommandLength();
+            if (reader.readUnsignedByte() != RESPONSE_SUBSCRIBE_SIM_VARIABLE) {
+                reader.skip(begin + length - reader.position());
+                continue;
+            }
+            reader.skipString();
+            const unsigned int numVars = reader.readUnsignedByte();
+            for (unsigned int j = 0; j < numVars; ++j) {
+                const int var = reader.readUnsignedByte();
+                const int status = reader.readUnsignedByte();
+                const int type = reader.readUnsignedByte();
+                IDList* const list = getList(var);
+                if (status != RTYPE_OK) {
+                    reader.skipValue(type);
+                } else if (list != 0 && type == TYPE_STRINGLIST) {
+                    const unsigned int num = reader.readLength();
+                    for (unsigned int k = 0; k < num; ++k) {
+                        const unsigned int idLength = reader.readLength();
+                        const unsigned int idBegin = reader.position();
+                        reader.skip(idLength);
+                        list->push_back(myArena.copy((const char*)reader.getData() + idBegin, idLength));
+                    }
+                } else if (var == VAR_TIME_STEP && type == TYPE_INTEGER) {
+                    myTime = reader.readInt();
+                } else if (var == VAR_MIN_EXPECTED_VEHICLES && type == TYPE_INTEGER) {
+                    myMinExpectedNumber = reader.readInt();
+                } else {
+                    reader.skipValue(type);
+                }
+            }
+            if (reader.position() != begin + length) {
+                throw std::invalid_argument("StepSummary::readStep(): wrong length");
+            }
+            myAmValid = true;
+        }
+    } catch (std::invalid_argument&) {
+        throw tcpip::SocketException("#Error: the simulation's subscription results are malformed");
+    }
+}
+
+
+StepSummary::IDList*
+StepSummary::getList(int var) {
+    switch (var) {
+        case VAR_LOADED_VEHICLES_IDS:
+            return &myLoaded;
+        case VAR_DEPARTED_VEHICLES_IDS:
+            return &myDeparted;
+        case VAR_ARRIVED_VEHICLES_IDS:
+            return &myArrived;
+        case VAR_TELEPORT_STARTING_VEHICLES_IDS:
+            return &myStartingTeleport;
+        case VAR_TELEPORT_ENDING_VEHICLES_IDS:
+            return &myEndingTeleport;
+        default:
+            return 0;
+    }
+}
+
+
+/****************************************************************************/
+
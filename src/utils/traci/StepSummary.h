@@ -0,0 +1,188 @@
+/****************************************************************************/
+/// @file    StepSummary.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// The vehicles loaded, departed, teleported and arrived in a step
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef StepSummary_h
+#define StepSummary_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <vector>
+#include <utils/common/Arena.h>
+#include <utils/common/SUMOTime.h>
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class TraCIAPI;
+namespace tcpip {
+class Storage;
+}
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class StepSummary
+ * @brief The vehicles loaded, departed, teleported and arrived in a step
+ *
+ * subscribe() subscribes to the simulation's vehicle id lists, the time
+ *  and the minimum number of expected vehicles; a summary registered using
+ *  TraCIAPI::setStepSummary is then filled from each simulation step's
+ *  answer, so the bookkeeping of a step costs no further round trip.
+ *  Other subscription results within the answer are skipped (and may be
+ *  read by SubscriptionResults from the same answer).
+ *
+ * The ids are copied into an arena which is reset with each step, so
+ *  after the first steps no memory is allocated; they stay valid until the
+ *  next step is read. The numbers of vehicles are the sizes of the lists.
+ */
+class StepSummary {
+public:
+    /// @brief The ids of a step, 0-terminated, valid until the next step is read
+    typedef std::vector<const char*> IDList;
+
+
+    /// @brief Constructor
+    StepSummary();
+
+
+    /// @brief Destructor
+    ~StepSummary();
+
+
+    /** @brief Subscribes to the simulation variables of the summary
+     * @param[in] api The connection to subscribe on
+     * @param[in] beginTime The begin of the subscription
+     * @param[in] endTime The end of the subscription
+     * @exception tcpip::SocketException if the subscription fails
+     */
+    static void subscribe(TraCIAPI& api, SUMOTime beginTime = 0, SUMOTime endTime = SUMOTime_MAX);
+
+
+    /** @brief Reads the simulation's values from the answer to a simulation step
+     * @param[in] inMsg The answer, positioned at the number of subscription results (the position is kept)
+     * @exception tcpip::SocketException if the answer is malformed
+     */
+    void readStep(tcpip::Storage& inMsg);
+
+
+    /// @brief Returns whether the last step reported the simulation's values
+    bool isValid() const {
+        return myAmValid;
+    }
+
+
+    /// @brief Returns the time of the last step
+    SUMOTime getTime() const {
+        return myTime;
+    }
+
+
+    /// @brief Returns the number of vehicles which are in the net or still to depart
+    int getMinExpectedNumber() const {
+        return myMinExpectedNumber;
+    }
+
+
+    /// @name the vehicles of the last step
+    /// @{
+
+    const IDList& getLoadedIDList() const {
+        return myLoaded;
+    }
+
+    const IDList& getDepartedIDList() const {
+        return myDeparted;
+    }
+
+    const IDList& getArrivedIDList() const {
+        return myArrived;
+    }
+
+    const IDList& getStartingTeleportIDList() const {
+        return myStartingTeleport;
+    }
+
+    const IDList& getEndingTeleportIDList() const {
+        return myEndingTeleport;
+    }
+
+    unsigned int getLoadedNumber() const {
+        return (unsigned int)myLoaded.size();
+    }
+
+    unsigned int getDepartedNumber() const {
+        return (unsigned int)myDeparted.size();
+    }
+
+    unsigned int getArrivedNumber() const {
+        return (unsigned int)myArrived.size();
+    }
+
+    unsigned int getStartingTeleportNumber() const {
+        return (unsigned int)myStartingTeleport.size();
+    }
+
+    unsigned int getEndingTeleportNumber() const {
+        return (unsigned int)myEndingTeleport.size();
+    }
+    /// @}
+
+
+private:
+    /// @brief Returns the list the variable is read into (0 if none)
+    IDList* getList(int var);
+
+
+private:
+    /// @brief The storage of the ids
+    Arena myArena;
+
+    /// @brief The id lists
+    IDList myLoaded, myDeparted, myArrived, myStartingTeleport, myEndingTeleport;
+
+    /// @brief The time of the last step
+    SUMOTime myTime;
+
+    /// @brief The minimum number of expected vehicles
+    int myMinExpectedNumber;
+
+    /// @brief Whether the last step reported the simulation's values
+    bool myAmValid;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    StepSummary(const StepSummary&);
+
+    /// @brief Invalidated assignment operator.
+    StepSummary& operator=(const StepSummary&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -0,0 +1,486 @@
+/****************************************************************************/
+/// @file    SubscriptionResults.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Stores subscription results and tracks which values changed in a step
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <cstring>
+#include <stdexcept>
+#include <foreign/tcpip/storage.h>
+#include <traci-server/TraCIConstants.h>
+#include <utils/common/ToString.h>
+#include <utils/common/UtilExceptions.h>
+#include "TraCIReader.h"
+#include "SubscriptionResults.h"
+
+
+// ===========================================================================
+// static members
+// ===========================================================================
+const unsigned int SubscriptionResults::NO_OBJECT = (unsigned int) - 1;
+
+
+// ===========================================================================
+// member definitions
+// ===========================================================================
+SubscriptionResults::SubscriptionResults()
+    : myStep(0), myUnusedEntries(0), myUnusedBytes(0) {}
+
+
+SubscriptionResults::~SubscriptionResults() {}
+
+
+void
+SubscriptionResults::readStep(tcpip::Storage& inMsg) {
+    const unsigned int end = (unsigned int)inMsg.size();
+    readStep(end == 0 ? 0 : &*inMsg.begin(), inMsg.position(), end);
+}
+
+
+void
+SubscriptionResults::readStep(const unsigned char* data, unsigned int pos, unsigned int end) {
+    releaseVanished();
+    if (myUnusedEntries > myEntries.size() / 2 || myUnusedBytes > myValues.size() / 2) {
+        compact();
+    }
+    ++myStep;
+    myChanges.clear();
+    myAppeared.clear();
+    myNotifications.clear();
+    try {
+        TraCIReader reader(data, pos, end);
+        const unsigned int numResults = reader.readLength();
+        for (unsigned int i = 0; i < numResults; ++i) {
+            readResult(reader);
+        }
+    } catch (std::invalid_argument&) {
+        throw tcpip::SocketException("#Error: the subscription results are malformed");
+    }
+    // objects which were not reported vanished
+    for (unsigned int i = 0; i < (unsigned int)myObjects.size(); ++i) {
+        const Object& o = myObjects[i];
+        if (o.seen != 0 && o.seen != myStep) {
+            myVanished.push_back(i);
+            buildKey(myKey, o.response, o.context, o.id);
+            myIndex.erase(myKey);
+        }
+    }
+    // listeners may register further ones, so the lists are addressed by index
+    for (unsigned int i = 0; i < (unsigned int)myNotifications.size(); ++i) {
+        const Notification n = myNotifications[i];
+        for (unsigned int j = 0; j < (unsigned int)myListeners[n.listeners].size(); ++j) {
+            myListeners[n.listeners][j]->valueChanged(*this, n.object, n.var);
+        }
+    }
+}
+
+
+void
+SubscriptionResults::clear() {
+    myStep = 0;
+    myObjects.clear();
+    myIndex.clear();
+    myFreeSlots.clear();
+    myEntries.clear();
+    myUnusedEntries = 0;
+    myValues.clear();
+    myUnusedBytes = 0;
+    myChanges.clear();
+    myAppeared.clear();
+    myVanished.clear();
+    myNotifications.clear();
+    myListenerIndex.clear();
+    myListeners.clear();
+}
+
+
+bool
+SubscriptionResults::hasChanged(unsigned int object, int var) const {
+    const Object& o = myObjects[object];
+    for (unsigned int i = o.firstEntry; i < o.firstEntry + o.numEntries; ++i) {
+        if (myEntries[i].var == var) {
+            return myEntries[i].changed == myStep;
+        }
+    }
+    return false;
+}
+
+
+unsigned int
+SubscriptionResults::find(int command, const std::string& objID, const std::string& context) const {
+    // a local key keeps the const queries free of side effects
+    std::string key;
+    buildKey(key, command + 0x10, context, objID);
+    const unsigned int* const slot = myIndex.find(key);
+    return slot == 0 ? NO_OBJECT : *slot;
+}
+
+
+bool
+SubscriptionResults::hasValue(unsigned int object, int var) const {
+    const Object& o = myObjects[object];
+    for (unsigned int i = o.firstEntry; i < o.firstEntry + o.numEntries; ++i) {
+        if (myEntries[i].var == var) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+bool
+SubscriptionResults::isOK(unsigned int object, int var) const {
+    return myValues[getEntry(object, var).offset] == RTYPE_OK;
+}
+
+
+int
+SubscriptionResults::getType(unsigned int object, int var) const {
+    return myValues[getEntry(object, var).offset + 1];
+}
+
+
+SUMOReal
+SubscriptionResults::getDouble(unsigned int object, int var) const {
+    TraCIReader reader = getValue(object, var);
+    switch (reader.readUnsignedByte()) {
+        case TYPE_DOUBLE:
+            return (SUMOReal)reader.readDouble();
+        case TYPE_INTEGER:
+            return (SUMOReal)reader.readInt();
+        case TYPE_UBYTE:
+            return (SUMOReal)reader.readUnsignedByte();
+        default:
+            throw InvalidArgument("The value of variable " + toString(var) + " of '" + getID(object) + "' is not numeric.");
+    }
+}
+
+
+int
+SubscriptionResults::getInt(unsigned int object, int var) const {
+    TraCIReader reader = getValue(object, var);
+    switch (reader.readUnsignedByte()) {
+        case TYPE_INTEGER:
+            return reader.readInt();
+        case TYPE_UBYTE:
+            return reader.readUnsignedByte();
+        default:
+            throw InvalidArgument("The value of variable " + toString(var) + " of '" + getID(object) + "' is not an integer.");
+    }
+}
+
+
+std::string
+SubscriptionResults::getString(unsigned int object, int var) const {
+    TraCIReader reader = getValue(object, var);
+    if (reader.readUnsignedByte() != TYPE_STRING) {
+        throw InvalidArgument("The value of variable " + toString(var) + " of '" + getID(object) + "' is not a string.");
+    }
+    return reader.readString();
+}
+
+
+std::vector<std::string>
+SubscriptionResults::getStringList(unsigned int object, int var) const {
+    TraCIReader reader = getValue(object, var);
+    if (reader.readUnsignedByte() != TYPE_STRINGLIST) {
+        throw InvalidArgument("The value of variable " + toString(var) + " of '" + getID(object) + "' is not a string list.");
+    }
+    std::vector<std::string> result;
+    const unsigned int num = reader.readLength();
+    for (unsigned int i = 0; i < num; ++i) {
+        result.push_back(reader.readString());
+    }
+    return result;
+}
+
+
+TraCIAPI::TraCIPosition
+SubscriptionResults::getPosition(unsigned int object, int var) const {
+    TraCIReader reader = getValue(object, var);
+    const int type = reader.readUnsignedByte();
+    if (type != POSITION_2D && type != POSITION_3D) {
+        throw InvalidArgument("The value of variable " + toString(var) + " of '" + getID(object) + "' is not a position.");
+    }
+    TraCIAPI::TraCIPosition p;
+    p.x = reader.readDouble();
+    p.y = reader.readDouble();
+    p.z = type == POSITION_3D ? reader.readDouble() : 0.;
+    return p;
+}
+
+
+void
+SubscriptionResults::addListener(int command, const std::string& objID, int var, Listener* listener, const std::string& context) {
+    buildKey(myKey, command + 0x10, context, objID);
+    myKey += (char)var;
+    unsigned int index = (unsigned int)myListeners.size();
+    const unsigned int* const known = myListenerIndex.find(myKey);
+    if (known == 0) {
+        myListenerIndex.insert(myKey, index);
+        myListeners.push_back(std::vector<Listener*>());
+    } else {
+        index = *known;
+    }
+    myListeners[index].push_back(listener);
+    // attach the listeners to the value if the object is already reported
+    myKey.erase(myKey.size() - 1);
+    const unsigned int* const slot = myIndex.find(myKey);
+    if (slot != 0) {
+        const Object& o = myObjects[*slot];
+        for (unsigned int i = o.firstEntry; i < o.firstEntry + o.numEntries; ++i) {
+            if (myEntries[i].var == var) {
+                myEntries[i].listeners = index;
+            }
+        }
+    }
+}
+
+
+void
+SubscriptionResults::clearListeners() {
+    myListenerIndex.clear();
+    myListeners.clear();
+    myNotifications.clear();
+    for (std::vector<Entry>::iterator i = myEntries.begin(); i != myEntries.end(); ++i) {
+        i->listeners = NO_OBJECT;
+    }
+}
+
+
+void
+SubscriptionResults::readResult(TraCIReader& reader) {
+    const unsigned int begin = reader.position();
+    const unsigned int length = reader.readCommandLength();
+    const int response = reader.readUnsignedByte();
+    const int command = response - 0x10;
+    if (command >= CMD_SUBSCRIBE_INDUCTIONLOOP_VARIABLE && command <= CMD_SUBSCRIBE_PERSON_VARIABLE) {
+        const std::string objID = reader.readString();
+        const unsigned int numVars = reader.readUnsignedByte();
+        readObject(reader, response, "", objID, numVars);
+    } else if (command >= CMD_SUBSCRIBE_INDUCTIONLOOP_CONTEXT && command <= CMD_SUBSCRIBE_PERSON_CONTEXT) {
+        const std::string context = reader.readString();
+        reader.readUnsignedByte();
+        const unsigned int numVars = reader.readUnsignedByte();
+        const unsigned int numObjects = reader.readLength();
+        for (unsigned int i = 0; i < numObjects; ++i) {
+            const std::string objID = reader.readString();
+            readObject(reader, response, context, objID, numVars);
+        }
+    } else {
+        throw std::invalid_argument("SubscriptionResults::readResult(): unknown response " + toString(response));
+    }
+    if (reader.position() != begin + length) {
+        throw std::invalid_argument("SubscriptionResults::readResult(): wrong length");
+    }
+}
+
+
+void
+SubscriptionResults::readObject(TraCIReader& reader, int response, const std::string& context, const std::string& objID,
+                                unsigned int numVars) {
+    myVars.clear();
+    myBounds.clear();
+    for (unsigned int i = 0; i < numVars; ++i) {
+        myVars.push_back(reader.readUnsignedByte());
+        myBounds.push_back(reader.position());
+        reader.skip(1);
+        reader.skipValue(reader.readUnsignedByte());
+        myBounds.push_back(reader.position());
+    }
+    const unsigned int slot = getSlot(response, context, objID);
+    Object& o = myObjects[slot];
+    if (o.seen == 0) {
+        myAppeared.push_back(slot);
+    }
+    o.seen = myStep;
+    // (re)allocate the entries if the subscribed variables changed
+    bool same = o.numEntries == numVars;
+    for (unsigned int i = 0; same && i < numVars; ++i) {
+        same = myEntries[o.firstEntry + i].var == myVars[i];
+    }
+    if (!same) {
+        for (unsigned int i = o.firstEntry; i < o.firstEntry + o.numEntries; ++i) {
+            myUnusedBytes += myEntries[i].size;
+        }
+        myUnusedEntries += o.numEntries;
+        o.firstEntry = (unsigned int)myEntries.size();
+        o.numEntries = numVars;
+        for (unsigned int i = 0; i < numVars; ++i) {
+            Entry e;
+            e.var = myVars[i];
+            e.offset = 0;
+            e.size = 0;
+            e.changed = 0;
+            e.listeners = findListeners(myVars[i]);
+            myEntries.push_back(e);
+        }
+    }
+    // compare the received bytes with the stored ones
+    const unsigned char* const data = reader.getData();
+    for (unsigned int i = 0; i < numVars; ++i) {
+        Entry& e = myEntries[o.firstEntry + i];
+        const unsigned char* const value = data + myBounds[2 * i];
+        const unsigned int size = myBounds[2 * i + 1] - myBounds[2 * i];
+        if (e.size == size && memcmp(&myValues[e.offset], value, size) == 0) {
+            continue;
+        }
+        if (e.size == size) {
+            memcpy(&myValues[e.offset], value, size);
+        } else {
+            myUnusedBytes += e.size;
+            e.offset = (unsigned int)myValues.size();
+            e.size = size;
+            myValues.insert(myValues.end(), value, value + size);
+        }
+        e.changed = myStep;
+        Change c;
+        c.object = slot;
+        c.var = e.var;
+        myChanges.push_back(c);
+        if (e.listeners != NO_OBJECT) {
+            Notification n;
+            n.listeners = e.listeners;
+            n.object = slot;
+            n.var = e.var;
+            myNotifications.push_back(n);
+        }
+    }
+}
+
+
+unsigned int
+SubscriptionResults::getSlot(int response, const std::string& context, const std::string& objID) {
+    buildKey(myKey, response, context, objID);
+    const unsigned int* const known = myIndex.find(myKey);
+    if (known != 0) {
+        return *known;
+    }
+    unsigned int slot;
+    if (myFreeSlots.empty()) {
+        slot = (unsigned int)myObjects.size();
+        myObjects.push_back(Object());
+    } else {
+        slot = myFreeSlots.back();
+        myFreeSlots.pop_back();
+    }
+    Object& o = myObjects[slot];
+    o.response = response;
+    o.id = objID;
+    o.context = context;
+    o.firstEntry = (unsigned int)myEntries.size();
+    o.numEntries = 0;
+    o.seen = 0;
+    myIndex.insert(myKey, slot);
+    return slot;
+}
+
+
+unsigned int
+SubscriptionResults::findListeners(int var) {
+    if (myListeners.empty()) {
+        return NO_OBJECT;
+    }
+    myKey += (char)var;
+    const unsigned int* const index = myListenerIndex.find(myKey);
+    myKey.erase(myKey.size() - 1);
+    return index == 0 ? NO_OBJECT : *index;
+}
+
+
+void
+SubscriptionResults::releaseVanished() {
+    for (std::vector<unsigned int>::const_iterator i = myVanished.begin(); i != myVanished.end(); ++i) {
+        Object& o = myObjects[*i];
+        for (unsigned int j = o.firstEntry; j < o.firstEntry + o.numEntries; ++j) {
+            myUnusedBytes += myEntries[j].size;
+        }
+        myUnusedEntries += o.numEntries;
+        o.numEntries = 0;
+        o.seen = 0;
+        myFreeSlots.push_back(*i);
+    }
+    myVanished.clear();
+}
+
+
+void
+SubscriptionResults::compact() {
+    std::vector<Entry> entries;
+    std::vector<unsigned char> values;
+    entries.reserve(myEntries.size() - myUnusedEntries);
+    values.reserve(myValues.size() - myUnusedBytes);
+    for (std::vector<Object>::iterator i = myObjects.begin(); i != myObjects.end(); ++i) {
+        const unsigned int first = (unsigned int)entries.size();
+        for (unsigned int j = i->firstEntry; j < i->firstEntry + i->numEntries; ++j) {
+            Entry e = myEntries[j];
+            if (e.size != 0) {
+                values.insert(values.end(), myValues.begin() + e.offset, myValues.begin() + e.offset + e.size);
+            }
+            e.offset = (unsigned int)values.size() - e.size;
+            entries.push_back(e);
+        }
+        i->firstEntry = first;
+    }
+    myEntries.swap(entries);
+    myValues.swap(values);
+    myUnusedEntries = 0;
+    myUnusedBytes = 0;
+}
+
+
+const SubscriptionResults::Entry&
+SubscriptionResults::getEntry(unsigned int object, int var) const {
+    const Object& o = myObjects[object];
+    for (unsigned int i = o.firstEntry; i < o.firstEntry + o.numEntries; ++i) {
+        if (myEntries[i].var == var) {
+            return myEntries[i];
+        }
+    }
+    throw InvalidArgument("No value of variable " + toString(var) + " for '" + o.id + "'.");
+}
+
+
+TraCIReader
+SubscriptionResults::getValue(unsigned int object, int var) const {
+    const Entry& e = getEntry(object, var);
+    TraCIReader reader(myValues, e.offset, e.offset + e.size);
+    reader.skip(1);
+    return reader;
+}
+
+
+void
+SubscriptionResults::buildKey(std::string& key, int response, const std::string& context, const std::string& objID) {
+    key.assign(1, (char)response);
+    key += context;
+    key += '\0';
+    key += objID;
+}
+
+
+/****************************************************************************/
+
@@ -0,0 +1,402 @@
+/****************************************************************************/
+/// @file    SubscriptionResults.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Stores subscription results and tracks which values changed in a step
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef SubscriptionResults_h
+#define SubscriptionResults_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <utils/common/FlatStringMap.h>
+#include "TraCIAPI.h"
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class TraCIReader;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class SubscriptionResults
+ * @brief Stores subscription results and tracks which values changed in a step
+ *
+ * The simulation answers each step with the values of all subscribed
+ *  variables, whether they changed or not. readStep decodes the answer
+ *  once and compares each value's bytes with the ones stored for the
+ *  previous step, so that a step reports only the values which changed,
+ *  the objects which appeared (all their values count as changed) and
+ *  the ones which vanished. Listeners registered for an (object, variable)
+ *  pair are called for its changes only, so controllers and loggers do
+ *  work proportional to what changed instead of to what is subscribed.
+ *
+ * Objects are identified by the subscription command, the object id and,
+ *  for the objects of a context subscription, the id of the object whose
+ *  context they were reported in. They are addressed by slot numbers
+ *  which stay valid while the object is reported; the slot of a vanished
+ *  object is reused after the next step.
+ *
+ * The values are kept as they were received ([status][type][value]) in
+ *  one buffer; a change of a value's size moves it to the end and the
+ *  buffer is compacted once more than half of it is unused.
+ *
+ * The const queries have no side effects, so several threads may read
+ *  the results at once between two calls of readStep.
+ */
+class SubscriptionResults {
+public:
+    /// @brief Marks a missing slot
+    static const unsigned int NO_OBJECT;
+
+
+    /// @brief A changed value
+    struct Change {
+        /// @brief The slot of the object
+        unsigned int object;
+        /// @brief The variable
+        int var;
+    };
+
+
+    /// @brief Iterates over the changes of the last step
+    typedef std::vector<Change>::const_iterator ChangeIterator;
+
+
+    /**
+     * @class Listener
+     * @brief Is notified about the changes of single values
+     */
+    class Listener {
+    public:
+        /// @brief Destructor
+        virtual ~Listener() {}
+
+        /** @brief Called for each change of a value the listener is registered for
+         * @param[in] results The results holding the new value
+         * @param[in] object The slot of the object
+         * @param[in] var The variable
+         */
+        virtual void valueChanged(const SubscriptionResults& results, unsigned int object, int var) = 0;
+    };
+
+
+    /// @brief Constructor
+    SubscriptionResults();
+
+
+    /// @brief Destructor
+    ~SubscriptionResults();
+
+
+    /// @name reading steps
+    /// @{
+
+    /** @brief Reads the subscription results of a simulation step
+     *
+     * Reads the remainder of the step's answer (starting with the number of
+     *  results) and notifies the listeners of the changed values.
+     *
+     * @param[in] inMsg The answer, positioned behind the step's status
+     * @exception tcpip::SocketException if the answer is malformed
+     */
+    void readStep(tcpip::Storage& inMsg);
+
+
+    /** @brief Reads subscription results from raw bytes
+     * @see readStep(tcpip::Storage&)
+     */
+    void readStep(const unsigned char* data, unsigned int pos, unsigned int end);
+
+
+    /// @brief Returns the number of steps read
+    unsigned int getStep() const {
+        return myStep;
+    }
+
+
+    /// @brief Removes all objects and listeners
+    void clear();
+    /// @}
+
+
+    /// @name changes of the last step
+    /// @{
+
+    /// @brief Returns the values which changed or were reported for the first time
+    const std::vector<Change>& getChanges() const {
+        return myChanges;
+    }
+
+    ChangeIterator changesBegin() const {
+        return myChanges.begin();
+    }
+
+    ChangeIterator changesEnd() const {
+        return myChanges.end();
+    }
+
+    /// @brief Returns the slots of the objects reported for the first time
+    const std::vector<unsigned int>& getAppeared() const {
+        return myAppeared;
+    }
+
+    /// @brief Returns the slots of the objects no longer reported (valid until the next step)
+    const std::vector<unsigned int>& getVanished() const {
+        return myVanished;
+    }
+
+    /// @brief Returns whether the value changed in the last step
+    bool hasChanged(unsigned int object, int var) const;
+    /// @}
+
+
+    /// @name objects
+    /// @{
+
+    /** @brief Returns the slot of an object
+     * @param[in] command The subscription command (CMD_SUBSCRIBE_..._VARIABLE or _CONTEXT)
+     * @param[in] objID The id of the object
+     * @param[in] context The object whose context the object was reported in (context subscriptions only)
+     * @return The slot or NO_OBJECT if the object was not reported
+     */
+    unsigned int find(int command, const std::string& objID, const std::string& context = "") const;
+
+    /// @brief Returns the number of reported objects
+    unsigned int size() const {
+        return myIndex.size();
+    }
+
+    /// @brief Returns the id of the object
+    const std::string& getID(unsigned int object) const {
+        return myObjects[object].id;
+    }
+
+    /// @brief Returns the object whose context the object was reported in (empty for variable subscriptions)
+    const std::string& getContext(unsigned int object) const {
+        return myObjects[object].context;
+    }
+
+    /// @brief Returns the subscription command the object was reported for
+    int getCommand(unsigned int object) const {
+        return myObjects[object].response - 0x10;
+    }
+    /// @}
+
+
+    /// @name values
+    /// @{
+
+    /// @brief Returns whether the object has a value for the variable
+    bool hasValue(unsigned int object, int var) const;
+
+    /// @brief Returns whether the variable was retrieved without error
+    bool isOK(unsigned int object, int var) const;
+
+    /// @brief Returns the type of the value
+    int getType(unsigned int object, int var) const;
+
+    /// @brief Returns a numeric value (TYPE_DOUBLE, TYPE_INTEGER or TYPE_UBYTE)
+    SUMOReal getDouble(unsigned int object, int var) const;
+
+    /// @brief Returns an integer value (TYPE_INTEGER or TYPE_UBYTE)
+    int getInt(unsigned int object, int var) const;
+
+    /// @brief Returns a string value (TYPE_STRING, also the error description of a failed variable)
+    std::string getString(unsigned int object, int var) const;
+
+    /// @brief Returns a string list value
+    std::vector<std::string> getStringList(unsigned int object, int var) const;
+
+    /// @brief Returns a position value (POSITION_2D or POSITION_3D)
+    TraCIAPI::TraCIPosition getPosition(unsigned int object, int var) const;
+    /// @}
+
+
+    /// @name listeners
+    /// @{
+
+    /** @brief Registers a listener for the changes of an object's variable
+     *
+     * The listener is called during readStep, after all values of the step
+     *  were stored. It is not deleted by the results.
+     *
+     * @param[in] command The subscription command
+     * @param[in] objID The id of the object (it does not need to be reported yet)
+     * @param[in] var The variable
+     * @param[in] listener The listener to call
+     * @param[in] context The object whose context the object is reported in (context subscriptions only)
+     */
+    void addListener(int command, const std::string& objID, int var, Listener* listener, const std::string& context = "");
+
+    /// @brief Removes all listeners
+    void clearListeners();
+    /// @}
+
+
+private:
+    /// @brief A stored value
+    struct Entry {
+        /// @brief The variable
+        int var;
+        /// @brief The position of the value within myValues
+        unsigned int offset;
+        /// @brief The size of the value including status and type
+        unsigned int size;
+        /// @brief The step the value changed last
+        unsigned int changed;
+        /// @brief The listeners' index within myListeners (NO_OBJECT if none)
+        unsigned int listeners;
+    };
+
+
+    /// @brief A change to report to listeners
+    struct Notification {
+        /// @brief The listeners' index within myListeners
+        unsigned int listeners;
+        /// @brief The slot of the object
+        unsigned int object;
+        /// @brief The variable
+        int var;
+    };
+
+
+    /// @brief A reported object
+    struct Object {
+        /// @brief The response id of the subscription
+        int response;
+        /// @brief The id of the object
+        std::string id;
+        /// @brief The object whose context the object was reported in
+        std::string context;
+        /// @brief The position of the first value within myEntries
+        unsigned int firstEntry;
+        /// @brief The number of values
+        unsigned int numEntries;
+        /// @brief The step the object was reported last (0 for a free slot)
+        unsigned int seen;
+    };
+
+
+    /// @brief Reads one subscription result
+    void readResult(TraCIReader& reader);
+
+    /// @brief Stores the values of one object
+    void readObject(TraCIReader& reader, int response, const std::string& context, const std::string& objID,
+                    unsigned int numVars);
+
+    /// @brief Returns the slot of the object, creating it if needed (leaves the object's key in myKey)
+    unsigned int getSlot(int response, const std::string& context, const std::string& objID);
+
+    /// @brief Returns the listeners' index for a value of the object currently in myKey (NO_OBJECT if none)
+    unsigned int findListeners(int var);
+
+    /// @brief Frees the slots of the objects which vanished in the last step
+    void releaseVanished();
+
+    /// @brief Moves all live values and entries to the front
+    void compact();
+
+    /// @brief Returns the value of the object's variable, throwing InvalidArgument if there is none
+    const Entry& getEntry(unsigned int object, int var) const;
+
+    /// @brief Returns a reader positioned at the value's type
+    TraCIReader getValue(unsigned int object, int var) const;
+
+    /// @brief Builds the key of an object
+    static void buildKey(std::string& key, int response, const std::string& context, const std::string& objID);
+
+
+private:
+    /// @brief The number of steps read
+    unsigned int myStep;
+
+    /// @brief The objects
+    std::vector<Object> myObjects;
+
+    /// @brief The slots of the objects by key
+    FlatStringMap<unsigned int> myIndex;
+
+    /// @brief The slots which may be reused
+    std::vector<unsigned int> myFreeSlots;
+
+    /// @brief The values of all objects, each object's ones contiguous
+    std::vector<Entry> myEntries;
+
+    /// @brief The number of unused entries
+    unsigned int myUnusedEntries;
+
+    /// @brief The received bytes of all values
+    std::vector<unsigned char> myValues;
+
+    /// @brief The number of unused bytes within myValues
+    unsigned int myUnusedBytes;
+
+    /// @brief The changes of the last step
+    std::vector<Change> myChanges;
+
+    /// @brief The objects which appeared in the last step
+    std::vector<unsigned int> myAppeared;
+
+    /// @brief The objects which vanished in the last step
+    std::vector<unsigned int> myVanished;
+
+    /// @brief The listeners by object key and variable
+    FlatStringMap<unsigned int> myListenerIndex;
+
+    /// @brief The listeners of each registered (object, variable) pair
+    std::vector<std::vector<Listener*> > myListeners;
+
+    /// @brief The changes to report to listeners
+    std::vector<Notification> myNotifications;
+
+    /// @brief The variables of the object being read
+    std::vector<int> myVars;
+
+    /// @brief The begin and end of the values of the object being read
+    std::vector<unsigned int> myBounds;
+
+    /// @brief The key being looked up
+    std::string myKey;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    SubscriptionResults(const SubscriptionResults&);
+
+    /// @brief Invalidated assignment operator.
+    SubscriptionResults& operator=(const SubscriptionResults&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
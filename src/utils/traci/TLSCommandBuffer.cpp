@@ -0,0 +1,265 @@
+/****************************************************************************/
+/// @file    TLSCommandBuffer.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Collects the traffic light actuation of a step and sends it at once
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <stdexcept>
+#include <foreign/tcpip/storage.h>
+#include <traci-server/TraCIConstants.h>
+#include "TLSCommandBuffer.h"
+
+
+// ===========================================================================
+// static members
+// ===========================================================================
+const unsigned int TLSCommandBuffer::NO_COMMAND = (unsigned int) - 1;
+
+
+// ===========================================================================
+// member definitions
+// ===========================================================================
+TLSCommandBuffer::TLSCommandBuffer(TraCIAPI& api)
+    : myAPI(api), myNumPending(0), myNumRequested(0), myNumSent(0), myNumMessages(0) {}
+
+
+TLSCommandBuffer::~TLSCommandBuffer() {}
+
+
+void
+TLSCommandBuffer::setRedYellowGreenState(const std::string& tlsID, const std::string& state) {
+    add(tlsID, TL_RED_YELLOW_GREEN_STATE, state, 0);
+}
+
+
+void
+TLSCommandBuffer::setPhase(const std::string& tlsID, unsigned int index) {
+    add(tlsID, TL_PHASE_INDEX, "", (int)index);
+}
+
+
+void
+TLSCommandBuffer::setProgram(const std::string& tlsID, const std::string& programID) {
+    add(tlsID, TL_PROGRAM, programID, 0);
+}
+
+
+void
+TLSCommandBuffer::setPhaseDuration(const std::string& tlsID, unsigned int phaseDuration) {
+    add(tlsID, TL_PHASE_DURATION, "", int(1000 * phaseDuration));
+}
+
+
+void
+TLSCommandBuffer::setCurrentState(const std::string& tlsID, const std::string& state) {
+    TLS& tls = myTLS[getTLS(tlsID)];
+    tls.state = state;
+    tls.stateKnown = true;
+}
+
+
+void
+TLSCommandBuffer::setCurrentProgram(const std::string& tlsID, const std::string& programID) {
+    TLS& tls = myTLS[getTLS(tlsID)];
+    tls.program = programID;
+    tls.programKnown = true;
+}
+
+
+void
+TLSCommandBuffer::forget() {
+    for (std::vector<TLS>::iterator i = myTLS.begin(); i != myTLS.end(); ++i) {
+        i->stateKnown = false;
+        i->programKnown = false;
+    }
+}
+
+
+void
+TLSCommandBuffer::flush() {
+    if (myNumPending == 0) {
+        discard();
+        return;
+    }
+    if (myAPI.mySocket == 0) {
+        throw tcpip::SocketException("Socket is not initialised");
+    }
+    tcpip::Storage outMsg;
+    for (std::vector<Command>::const_iterator i = myCommands.begin(); i != myCommands.end(); ++i) {
+        if (!i->active) {
+            continue;
+        }
+        tcpip::Storage content;
+        if (i->var == TL_RED_YELLOW_GREEN_STATE || i->var == TL_PROGRAM) {
+            content.writeUnsignedByte(TYPE_STRING);
+            content.writeString(i->stringValue);
+        } else {
+            content.writeUnsignedByte(TYPE_INTEGER);
+            content.writeInt(i->intValue);
+        }
+        TraCIAPI::write_commandSetValue(outMsg, CMD_SET_TL_VARIABLE, i->var, myTLS[i->tls].id, content);
+    }
+    myAPI.mySocket->sendExact(outMsg);
+    myNumSent += myNumPending;
+    myNumMessages++;
+    // all commands of the message are answered within one message, in order
+    tcpip::Storage inMsg;
+    myAPI.mySocket->receiveExact(inMsg);
+    std::string errors;
+    try {
+        for (std::vector<Command>::const_iterator i = myCommands.begin(); i != myCommands.end(); ++i) {
+            if (!i->active) {
+                continue;
+            }
+            const unsigned int begin = inMsg.position();
+            unsigned int length = inMsg.readUnsignedByte();
+            if (length == 0) {
+                length = inMsg.readInt();
+            }
+            const int command = inMsg.readUnsignedByte();
+            const int resultType = inMsg.readUnsignedByte();
+            const std::string description = inMsg.readString();
+            if (command != CMD_SET_TL_VARIABLE || inMsg.position() != begin + length) {
+                throw std::invalid_argument("unexpected status");
+            }
+            TLS& tls = myTLS[i->tls];
+            if (resultType == RTYPE_OK) {
+                executed(tls, *i);
+            } else {
+                tls.stateKnown = false;
+                tls.programKnown = false;
+                errors += (errors.empty() ? "" : "; ") + tls.id + ": " + description;
+            }
+        }
+    } catch (std::invalid_argument&) {
+        discard();
+        forget();
+        throw tcpip::SocketException("#Error: the answer to the traffic light commands is malformed");
+    }
+    discard();
+    if (!errors.empty()) {
+        throw tcpip::SocketException(".. Answered with error to traffic light commands, [description: " + errors + "]");
+    }
+}
+
+
+void
+TLSCommandBuffer::discard() {
+    for (std::vector<Command>::const_iterator i = myCommands.begin(); i != myCommands.end(); ++i) {
+        myTLS[i->tls].last = NO_COMMAND;
+        myTLS[i->tls].pending = 0;
+    }
+    myCommands.clear();
+    myNumPending = 0;
+}
+
+
+void
+TLSCommandBuffer::add(const std::string& tlsID, int var, const std::string& stringValue, int intValue) {
+    myNumRequested++;
+    const unsigned int index = getTLS(tlsID);
+    TLS& tls = myTLS[index];
+    if (tls.last != NO_COMMAND && myCommands[tls.last].var == var) {
+        // the write replaces the preceding one
+        Command& c = myCommands[tls.last];
+        if (tls.pending == 1 && isKnown(tls, var, stringValue)) {
+            c.active = false;
+            tls.last = NO_COMMAND;
+            tls.pending = 0;
+            myNumPending--;
+        } else {
+            c.stringValue = stringValue;
+            c.intValue = intValue;
+        }
+        return;
+    }
+    // the known values hold until the first command to the traffic light is executed
+    if (tls.pending == 0 && isKnown(tls, var, stringValue)) {
+        return;
+    }
+    Command c;
+    c.tls = index;
+    c.var = var;
+    c.stringValue = stringValue;
+    c.intValue = intValue;
+    c.active = true;
+    tls.last = (unsigned int)myCommands.size();
+    tls.pending++;
+    myCommands.push_back(c);
+    myNumPending++;
+}
+
+
+bool
+TLSCommandBuffer::isKnown(const TLS& tls, int var, const std::string& stringValue) {
+    switch (var) {
+        case TL_RED_YELLOW_GREEN_STATE:
+            return tls.stateKnown && tls.state == stringValue;
+        case TL_PROGRAM:
+            return tls.programKnown && tls.program == stringValue;
+        default:
+            return false;
+    }
+}
+
+
+unsigned int
+TLSCommandBuffer::getTLS(const std::string& tlsID) {
+    const unsigned int* const known = myTLSIndex.find(tlsID);
+    if (known != 0) {
+        return *known;
+    }
+    TLS tls;
+    tls.id = tlsID;
+    tls.stateKnown = false;
+    tls.programKnown = false;
+    tls.last = NO_COMMAND;
+    tls.pending = 0;
+    myTLS.push_back(tls);
+    myTLSIndex.insert(tlsID, (unsigned int)myTLS.size() - 1);
+    return (unsigned int)myTLS.size() - 1;
+}
+
+
+void
+TLSCommandBuffer::executed(TLS& tls, const Command& c) {
+    switch (c.var) {
+        case TL_RED_YELLOW_GREEN_STATE:
+            tls.state = c.stringValue;
+            tls.stateKnown = true;
+            break;
+        case TL_PROGRAM:
+            tls.program = c.stringValue;
+            tls.programKnown = true;
+            tls.stateKnown = false;
+            break;
+        case TL_PHASE_INDEX:
+            tls.stateKnown = false;
+            break;
+        default:
+            break;
+    }
+}
+
+
+/****************************************************************************/
+
@@ -0,0 +1,215 @@
+/****************************************************************************/
+/// @file    TLSCommandBuffer.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Collects the traffic light actuation of a step and sends it at once
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef TLSCommandBuffer_h
+#define TLSCommandBuffer_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <string>
+#include <vector>
+#include <utils/common/FlatStringMap.h>
+#include "TraCIAPI.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class TLSCommandBuffer
+ * @brief Collects the traffic light actuation of a step and sends it at once
+ *
+ * The setters of TraCIAPI::TrafficLightScope send one command each and
+ *  wait for its acknowledgement. The buffer offers the same setters but
+ *  only records the commands; flush() sends all of them within one
+ *  message and checks all acknowledgements from the one answer, so a
+ *  controller actuating hundreds of intersections per step pays one round
+ *  trip instead of hundreds.
+ *
+ * Redundant writes are dropped before sending:
+ * - consecutive writes of the same variable of a traffic light (with no
+ *  other write to that traffic light in between) collapse to the last one
+ * - a state or program which equals the known one of the traffic light is
+ *  not sent at all. The state and program are known after they were sent
+ *  successfully or reported using setCurrentState/setCurrentProgram;
+ *  setting the program or phase makes the state unknown again. Phase
+ *  indices and durations advance with the simulation and are always sent.
+ */
+class TLSCommandBuffer {
+public:
+    /** @brief Constructor
+     * @param[in] api The connection to send the commands over
+     */
+    TLSCommandBuffer(TraCIAPI& api);
+
+
+    /// @brief Destructor
+    ~TLSCommandBuffer();
+
+
+    /// @name recording commands
+    /// @{
+
+    void setRedYellowGreenState(const std::string& tlsID, const std::string& state);
+    void setPhase(const std::string& tlsID, unsigned int index);
+    void setProgram(const std::string& tlsID, const std::string& programID);
+    void setPhaseDuration(const std::string& tlsID, unsigned int phaseDuration);
+    /// @}
+
+
+    /// @name knowledge about the traffic lights
+    /// @{
+
+    /// @brief Reports the current state of the traffic light (e.g. as retrieved by getRedYellowGreenState)
+    void setCurrentState(const std::string& tlsID, const std::string& state);
+
+    /// @brief Reports the current program of the traffic light
+    void setCurrentProgram(const std::string& tlsID, const std::string& programID);
+
+    /// @brief Forgets the known states and programs (e.g. if another client actuated the traffic lights)
+    void forget();
+    /// @}
+
+
+    /** @brief Sends the recorded commands within one message and checks the answers
+     *
+     * All answers are read even if some commands failed; the failures are
+     *  reported together afterwards.
+     *
+     * @exception tcpip::SocketException if the connection fails or any command was answered with an error
+     */
+    void flush();
+
+
+    /// @brief Discards the recorded commands without sending them
+    void discard();
+
+
+    /// @brief Returns the number of recorded commands which will be sent
+    unsigned int size() const {
+        return myNumPending;
+    }
+
+
+    /// @name statistics
+    /// @{
+
+    /// @brief Returns the number of commands requested so far
+    unsigned int getNumRequested() const {
+        return myNumRequested;
+    }
+
+    /// @brief Returns the number of commands sent so far
+    unsigned int getNumSent() const {
+        return myNumSent;
+    }
+
+    /// @brief Returns the number of messages sent so far
+    unsigned int getNumMessages() const {
+        return myNumMessages;
+    }
+    /// @}
+
+
+private:
+    /// @brief A recorded command
+    struct Command {
+        /// @brief The traffic light's index within myTLS
+        unsigned int tls;
+        /// @brief The variable
+        int var;
+        /// @brief The value of string variables
+        std::string stringValue;
+        /// @brief The value of integer variables
+        int intValue;
+        /// @brief Whether the command is still to be sent
+        bool active;
+    };
+
+
+    /// @brief What is known about a traffic light
+    struct TLS {
+        /// @brief The id of the traffic light
+        std::string id;
+        /// @brief The known state
+        std::string state;
+        /// @brief The known program
+        std::string program;
+        /// @brief Whether state and program are known
+        bool stateKnown, programKnown;
+        /// @brief The index of the last recorded command within myCommands (NO_COMMAND if none)
+        unsigned int last;
+        /// @brief The number of recorded commands to be sent
+        unsigned int pending;
+    };
+
+
+    /// @brief Records a command
+    void add(const std::string& tlsID, int var, const std::string& stringValue, int intValue);
+
+    /// @brief Returns whether the value equals the known one of the traffic light
+    static bool isKnown(const TLS& tls, int var, const std::string& stringValue);
+
+    /// @brief Returns the index of the traffic light within myTLS, adding it if needed
+    unsigned int getTLS(const std::string& tlsID);
+
+    /// @brief Updates the knowledge about the traffic light after the command was executed
+    static void executed(TLS& tls, const Command& c);
+
+
+private:
+    /// @brief Marks a missing command
+    static const unsigned int NO_COMMAND;
+
+    /// @brief The connection
+    TraCIAPI& myAPI;
+
+    /// @brief The traffic lights seen so far
+    std::vector<TLS> myTLS;
+
+    /// @brief The indices of the traffic lights by id
+    FlatStringMap<unsigned int> myTLSIndex;
+
+    /// @brief The recorded commands
+    std::vector<Command> myCommands;
+
+    /// @brief The number of recorded commands to be sent
+    unsigned int myNumPending;
+
+    /// @brief The statistics
+    unsigned int myNumRequested, myNumSent, myNumMessages;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    TLSCommandBuffer(const TLSCommandBuffer&);
+
+    /// @brief Invalidated assignment operator.
+    TLSCommandBuffer& operator=(const TLSCommandBuffer&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -0,0 +1,422 @@
+/****************************************************************************/
+/// @file    TLSProgramModel.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// A client side model of the traffic light programs predicting their switches
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <foreign/tcpip/storage.h>
+#include <traci-server/TraCIConstants.h>
+#include <utils/common/ToString.h>
+#include "TLSProgramModel.h"
+
+
+// ===========================================================================
+// static members
+// ===========================================================================
+const unsigned int TLSProgramModel::NO_TLS = (unsigned int) - 1;
+
+
+// ===========================================================================
+// helper definitions
+// ===========================================================================
+namespace {
+
+/// @brief Throws if the value has not the expected type
+void
+checkType(int var, int valueType, int expected) {
+    if (valueType != expected) {
+        throw tcpip::SocketException("Unexpected type " + toString(valueType) + " for variable " + toString(var) + ".");
+    }
+}
+
+
+/// @brief Collects the programs and current phases of traffic lights
+class ProgramReader : public TraCIAPI::BatchReader {
+public:
+    ProgramReader(unsigned int n) : logics(n), programs(n), phases(n, 0), nextSwitches(n, 0) {}
+
+    void read(unsigned int object, int var, int valueType, tcpip::Storage& inMsg) {
+        switch (var) {
+            case TL_COMPLETE_DEFINITION_RYG:
+                checkType(var, valueType, TYPE_COMPOUND);
+                logics[object] = TraCIAPI::readLogics(inMsg);
+                break;
+            case TL_CURRENT_PROGRAM:
+                checkType(var, valueType, TYPE_STRING);
+                programs[object] = inMsg.readString();
+                break;
+            case TL_CURRENT_PHASE:
+                checkType(var, valueType, TYPE_INTEGER);
+                phases[object] = inMsg.readInt();
+                break;
+            case TL_NEXT_SWITCH:
+                checkType(var, valueType, TYPE_INTEGER);
+                nextSwitches[object] = inMsg.readInt();
+                break;
+            default:
+                break;
+        }
+    }
+
+    std::vector<std::vector<TraCIAPI::TraCILogic> > logics;
+    std::vector<std::string> programs;
+    std::vector<int> phases;
+    std::vector<SUMOTime> nextSwitches;
+};
+
+}
+
+
+// ===========================================================================
+// member definitions
+// ===========================================================================
+TLSProgramModel::TLSProgramModel()
+    : myNumDrifts(0) {}
+
+
+TLSProgramModel::~TLSProgramModel() {}
+
+
+void
+TLSProgramModel::load(TraCIAPI& api, const std::vector<std::string>& tlsIDs, unsigned int batchSize) {
+    clear();
+    std::vector<int> vars;
+    vars.push_back(TL_COMPLETE_DEFINITION_RYG);
+    vars.push_back(TL_CURRENT_PROGRAM);
+    vars.push_back(TL_CURRENT_PHASE);
+    vars.push_back(TL_NEXT_SWITCH);
+    ProgramReader reader((unsigned int)tlsIDs.size());
+    api.getVariables(CMD_GET_TL_VARIABLE, vars, tlsIDs, reader, batchSize);
+    for (unsigned int i = 0; i < (unsigned int)tlsIDs.size(); ++i) {
+        TLS tls;
+        tls.id = tlsIDs[i];
+        tls.drifted = false;
+        myTLS.push_back(tls);
+        myIndex.insert(tlsIDs[i], i);
+        setPrograms(i, reader.logics[i]);
+        setCurrent(i, reader.programs[i], reader.phases[i], reader.nextSwitches[i]);
+    }
+}
+
+
+unsigned int
+TLSProgramModel::resync(TraCIAPI& api, unsigned int batchSize) {
+    std::vector<unsigned int> drifted;
+    std::vector<std::string> ids;
+    for (unsigned int i = 0; i < (unsigned int)myTLS.size(); ++i) {
+        if (myTLS[i].drifted) {
+            drifted.push_back(i);
+            ids.push_back(myTLS[i].id);
+        }
+    }
+    if (drifted.empty()) {
+        return 0;
+    }
+    std::vector<int> vars;
+    vars.push_back(TL_CURRENT_PROGRAM);
+    vars.push_back(TL_CURRENT_PHASE);
+    vars.push_back(TL_NEXT_SWITCH);
+    ProgramReader reader((unsigned int)ids.size());
+    api.getVariables(CMD_GET_TL_VARIABLE, vars, ids, reader, batchSize);
+    // programs set by clients (e.g. the "online" one of setRedYellowGreenState) are not known yet
+    std::vector<unsigned int> unknown;
+    std::vector<std::string> unknownIDs;
+    for (unsigned int i = 0; i < (unsigned int)drifted.size(); ++i) {
+        if (findProgram(myTLS[drifted[i]], reader.programs[i]) == NO_TLS) {
+            unknown.push_back(i);
+            unknownIDs.push_back(ids[i]);
+        }
+    }
+    if (!unknown.empty()) {
+        ProgramReader definitions((unsigned int)unknownIDs.size());
+        api.getVariables(CMD_GET_TL_VARIABLE, std::vector<int>(1, TL_COMPLETE_DEFINITION_RYG), unknownIDs, definitions, batchSize);
+        for (unsigned int i = 0; i < (unsigned int)unknown.size(); ++i) {
+            setPrograms(drifted[unknown[i]], definitions.logics[i]);
+        }
+    }
+    for (unsigned int i = 0; i < (unsigned int)drifted.size(); ++i) {
+        setCurrent(drifted[i], reader.programs[i], reader.phases[i], reader.nextSwitches[i]);
+    }
+    return (unsigned int)drifted.size();
+}
+
+
+void
+TLSProgramModel::advance(SUMOTime time) {
+    for (std::vector<TLS>::iterator i = myTLS.begin(); i != myTLS.end(); ++i) {
+        const unsigned int numPhases = myNumPhases[i->program];
+        const SUMOTime cycle = myCycleTimes[i->program];
+        if (numPhases == 0 || cycle <= 0 || i->nextSwitch > time) {
+            continue;
+        }
+        // whole cycles end in the same phase
+        i->nextSwitch += (time - i->nextSwitch) / cycle * cycle;
+        const SUMOTime* const durations = &myDurations[myFirstPhase[i->program]];
+        while (i->nextSwitch <= time) {
+            i->phase = (i->phase + 1) % numPhases;
+            i->nextSwitch += durations[i->phase];
+        }
+    }
+}
+
+
+bool
+TLSProgramModel::observeState(unsigned int tls, const std::string& state) {
+    TLS& t = myTLS[tls];
+    bool same = state.size() == getNumLinks(tls) && t.phase < myNumPhases[t.program];
+    const unsigned int begin = same ? myStateBegins[myFirstPhase[t.program] + t.phase] : 0;
+    for (unsigned int i = 0; same && i < (unsigned int)state.size(); ++i) {
+        same = getPacked(begin, i) == parseSignal(state[i]);
+    }
+    if (!same && !t.drifted) {
+        t.drifted = true;
+        myNumDrifts++;
+    }
+    return same;
+}
+
+
+bool
+TLSProgramModel::observe(unsigned int tls, unsigned int phase, SUMOTime nextSwitch) {
+    TLS& t = myTLS[tls];
+    const bool same = t.phase == phase && t.nextSwitch == nextSwitch;
+    if (!same) {
+        myNumDrifts++;
+        t.phase = phase < myNumPhases[t.program] ? phase : 0;
+        t.nextSwitch = nextSwitch;
+    }
+    t.drifted = false;
+    return same;
+}
+
+
+void
+TLSProgramModel::invalidate(unsigned int tls) {
+    myTLS[tls].drifted = true;
+}
+
+
+void
+TLSProgramModel::clear() {
+    myTLS.clear();
+    myIndex.clear();
+    myProgramIDs.clear();
+    myFirstPhase.clear();
+    myNumPhases.clear();
+    myNumLinks.clear();
+    myCycleTimes.clear();
+    myDurations.clear();
+    myMinDurations.clear();
+    myMaxDurations.clear();
+    myStateBegins.clear();
+    myStates.clear();
+    myNumDrifts = 0;
+}
+
+
+unsigned int
+TLSProgramModel::index(const std::string& tlsID) const {
+    const unsigned int* const i = myIndex.find(tlsID);
+    return i == 0 ? NO_TLS : *i;
+}
+
+
+TLSProgramModel::Signal
+TLSProgramModel::getSignal(unsigned int tls, unsigned int phase, unsigned int link) const {
+    const unsigned int program = myTLS[tls].program;
+    if (phase >= myNumPhases[program] || link >= myNumLinks[program]) {
+        return SIGNAL_UNKNOWN;
+    }
+    return getPacked(myStateBegins[myFirstPhase[program] + phase], link);
+}
+
+
+std::string
+TLSProgramModel::getState(unsigned int tls, unsigned int phase) const {
+    const unsigned int program = myTLS[tls].program;
+    if (phase >= myNumPhases[program]) {
+        return "";
+    }
+    const unsigned int numLinks = myNumLinks[program];
+    const unsigned int begin = myStateBegins[myFirstPhase[program] + phase];
+    std::string state(numLinks, ' ');
+    for (unsigned int i = 0; i < numLinks; ++i) {
+        state[i] = toChar(getPacked(begin, i));
+    }
+    return state;
+}
+
+
+unsigned int
+TLSProgramModel::predictPhase(unsigned int tls, SUMOTime time) const {
+    const TLS& t = myTLS[tls];
+    const unsigned int numPhases = myNumPhases[t.program];
+    const SUMOTime cycle = myCycleTimes[t.program];
+    if (numPhases == 0 || cycle <= 0 || t.nextSwitch > time) {
+        return t.phase;
+    }
+    SUMOTime nextSwitch = t.nextSwitch + (time - t.nextSwitch) / cycle * cycle;
+    unsigned int phase = t.phase;
+    while (nextSwitch <= time) {
+        phase = (phase + 1) % numPhases;
+        nextSwitch += myDurations[myFirstPhase[t.program] + phase];
+    }
+    return phase;
+}
+
+
+SUMOTime
+TLSProgramModel::predictChange(unsigned int tls, unsigned int link) const {
+    const TLS& t = myTLS[tls];
+    const unsigned int numPhases = myNumPhases[t.program];
+    const Signal current = getSignal(tls, link);
+    SUMOTime time = t.nextSwitch;
+    unsigned int phase = t.phase;
+    for (unsigned int i = 0; i < numPhases; ++i) {
+        phase = (phase + 1) % numPhases;
+        if (getSignal(tls, phase, link) != current) {
+            return time;
+        }
+        time += myDurations[myFirstPhase[t.program] + phase];
+    }
+    return -1;
+}
+
+
+SUMOTime
+TLSProgramModel::predictSignal(unsigned int tls, unsigned int link, Signal signal) const {
+    const TLS& t = myTLS[tls];
+    const unsigned int numPhases = myNumPhases[t.program];
+    SUMOTime time = t.nextSwitch;
+    unsigned int phase = t.phase;
+    for (unsigned int i = 0; i < numPhases; ++i) {
+        phase = (phase + 1) % numPhases;
+        if (getSignal(tls, phase, link) == signal) {
+            return time;
+        }
+        time += myDurations[myFirstPhase[t.program] + phase];
+    }
+    return -1;
+}
+
+
+TLSProgramModel::Signal
+TLSProgramModel::parseSignal(char c) {
+    switch (c) {
+        case 'r':
+            return SIGNAL_RED;
+        case 'u':
+            return SIGNAL_RED_YELLOW;
+        case 'y':
+            return SIGNAL_YELLOW;
+        case 'g':
+            return SIGNAL_GREEN_MINOR;
+        case 'G':
+            return SIGNAL_GREEN_MAJOR;
+        case 's':
+            return SIGNAL_STOP;
+        case 'o':
+            return SIGNAL_OFF_BLINKING;
+        case 'O':
+            return SIGNAL_OFF;
+        default:
+            return SIGNAL_UNKNOWN;
+    }
+}
+
+
+char
+TLSProgramModel::toChar(Signal signal) {
+    static const char chars[] = "ruygGsoO?";
+    return chars[signal <= SIGNAL_UNKNOWN ? signal : SIGNAL_UNKNOWN];
+}
+
+
+void
+TLSProgramModel::setPrograms(unsigned int tls, const std::vector<TraCIAPI::TraCILogic>& logics) {
+    // the replaced programs stay in the tables until the next load
+    TLS& t = myTLS[tls];
+    t.firstProgram = (unsigned int)myProgramIDs.size();
+    t.numPrograms = (unsigned int)logics.size();
+    for (std::vector<TraCIAPI::TraCILogic>::const_iterator i = logics.begin(); i != logics.end(); ++i) {
+        const unsigned int numLinks = i->phases.empty() ? 0 : (unsigned int)i->phases.front().phase.size();
+        SUMOTime cycle = 0;
+        myProgramIDs.push_back(i->subID);
+        myFirstPhase.push_back((unsigned int)myDurations.size());
+        myNumPhases.push_back((unsigned int)i->phases.size());
+        myNumLinks.push_back(numLinks);
+        for (std::vector<TraCIAPI::TraCIPhase>::const_iterator j = i->phases.begin(); j != i->phases.end(); ++j) {
+            myDurations.push_back(j->duration);
+            myMinDurations.push_back(j->duration1);
+            myMaxDurations.push_back(j->duration2);
+            cycle += j->duration;
+            const unsigned int begin = (unsigned int)myStates.size();
+            myStateBegins.push_back(begin);
+            myStates.resize(begin + (numLinks + 1) / 2, 0);
+            for (unsigned int k = 0; k < numLinks && k < (unsigned int)j->phase.size(); ++k) {
+                const unsigned char code = (unsigned char)parseSignal(j->phase[k]);
+                myStates[begin + k / 2] |= (k % 2) == 0 ? code : (unsigned char)(code << 4);
+            }
+        }
+        myCycleTimes.push_back(cycle);
+    }
+    if (t.numPrograms == 0) {
+        // keep an empty program so that the traffic light may be queried
+        t.numPrograms = 1;
+        myProgramIDs.push_back("");
+        myFirstPhase.push_back((unsigned int)myDurations.size());
+        myNumPhases.push_back(0);
+        myNumLinks.push_back(0);
+        myCycleTimes.push_back(0);
+    }
+    t.program = t.firstProgram;
+}
+
+
+void
+TLSProgramModel::setCurrent(unsigned int tls, const std::string& programID, unsigned int phase, SUMOTime nextSwitch) {
+    TLS& t = myTLS[tls];
+    const unsigned int program = findProgram(t, programID);
+    if (program == NO_TLS) {
+        t.drifted = true;
+        return;
+    }
+    t.program = program;
+    t.phase = phase < myNumPhases[program] ? phase : 0;
+    t.nextSwitch = nextSwitch;
+    t.drifted = false;
+}
+
+
+unsigned int
+TLSProgramModel::findProgram(const TLS& tls, const std::string& programID) const {
+    for (unsigned int i = tls.firstProgram; i < tls.firstProgram + tls.numPrograms; ++i) {
+        if (myProgramIDs[i] == programID) {
+            return i;
+        }
+    }
+    return NO_TLS;
+}
+
+
+/****************************************************************************/
+
@@ -0,0 +1,364 @@
+/****************************************************************************/
+/// @file    TLSProgramModel.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// A client side model of the traffic light programs predicting their switches
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef TLSProgramModel_h
+#define TLSProgramModel_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <string>
+#include <vector>
+#include <utils/common/FlatStringMap.h>
+#include <utils/common/SUMOTime.h>
+#include "TraCIAPI.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class TLSProgramModel
+ * @brief A client side model of the traffic light programs predicting their switches
+ *
+ * The programs of the traffic lights are retrieved once and stored in flat
+ *  tables: the phase durations in arrays indexed by a global phase number,
+ *  the signals of each phase as four bit codes per link, two links per
+ *  byte. The current program, phase and next switch time of each traffic
+ *  light are advanced locally (advance()) using the phase durations, so
+ *  phases, states and switch times may be queried and predicted without
+ *  any round trip.
+ *
+ * The model drifts if a traffic light does not follow its durations (e.g.
+ *  actuated programs) or is changed by a client. Observations (the state
+ *  from a subscription, or phase and next switch) are compared with the
+ *  model using observeState/observe; traffic lights which disagree are
+ *  marked and resync() queries only these, reloading the programs of those
+ *  running a program the model does not know.
+ */
+class TLSProgramModel {
+public:
+    /// @brief The signal of a link, see LinkState
+    enum Signal {
+        /// @brief 'r'
+        SIGNAL_RED = 0,
+        /// @brief 'u'
+        SIGNAL_RED_YELLOW = 1,
+        /// @brief 'y'
+        SIGNAL_YELLOW = 2,
+        /// @brief 'g'
+        SIGNAL_GREEN_MINOR = 3,
+        /// @brief 'G'
+        SIGNAL_GREEN_MAJOR = 4,
+        /// @brief 's'
+        SIGNAL_STOP = 5,
+        /// @brief 'o'
+        SIGNAL_OFF_BLINKING = 6,
+        /// @brief 'O'
+        SIGNAL_OFF = 7,
+        /// @brief any other character
+        SIGNAL_UNKNOWN = 8
+    };
+
+
+    /// @brief Marks a missing traffic light
+    static const unsigned int NO_TLS;
+
+
+    /// @brief Constructor
+    TLSProgramModel();
+
+
+    /// @brief Destructor
+    ~TLSProgramModel();
+
+
+    /// @name synchronisation
+    /// @{
+
+    /** @brief Retrieves the programs and the current phases of the given traffic lights
+     * @param[in] api The connection to use
+     * @param[in] tlsIDs The traffic lights to model
+     * @param[in] batchSize The number of requests to send per message
+     * @exception tcpip::SocketException if the retrieval fails
+     */
+    void load(TraCIAPI& api, const std::vector<std::string>& tlsIDs, unsigned int batchSize = 1024);
+
+
+    /** @brief Retrieves the current phases of all traffic lights whose model drifted
+     * @param[in] api The connection to use
+     * @param[in] batchSize The number of requests to send per message
+     * @return The number of traffic lights updated
+     * @exception tcpip::SocketException if the retrieval fails
+     */
+    unsigned int resync(TraCIAPI& api, unsigned int batchSize = 1024);
+
+
+    /** @brief Advances all traffic lights to the given time
+     *
+     * Each traffic light switches to its next phase whenever the time
+     *  reaches its next switch, as a static program does.
+     *
+     * @param[in] time The current simulation time
+     */
+    void advance(SUMOTime time);
+
+
+    /** @brief Compares the observed state with the modelled one
+     * @param[in] tls The traffic light
+     * @param[in] state The observed state (e.g. from a subscription to TL_RED_YELLOW_GREEN_STATE)
+     * @return Whether the model agrees, the traffic light is marked as drifted otherwise
+     */
+    bool observeState(unsigned int tls, const std::string& state);
+
+
+    /** @brief Compares the observed phase with the modelled one and adopts it
+     *
+     * The program is assumed to be unchanged, the drift mark is removed.
+     *
+     * @param[in] tls The traffic light
+     * @param[in] phase The observed phase index
+     * @param[in] nextSwitch The observed time of the next switch
+     * @return Whether the model agreed
+     */
+    bool observe(unsigned int tls, unsigned int phase, SUMOTime nextSwitch);
+
+
+    /// @brief Marks the traffic light as drifted (e.g. after actuating it)
+    void invalidate(unsigned int tls);
+
+
+    /// @brief Returns whether the traffic light is marked as drifted
+    bool hasDrifted(unsigned int tls) const {
+        return myTLS[tls].drifted;
+    }
+
+
+    /// @brief Returns the number of detected drifts so far
+    unsigned int getNumDrifts() const {
+        return myNumDrifts;
+    }
+
+
+    /// @brief Removes all traffic lights
+    void clear();
+    /// @}
+
+
+    /// @name traffic lights
+    /// @{
+
+    /// @brief Returns the number of modelled traffic lights
+    unsigned int size() const {
+        return (unsigned int)myTLS.size();
+    }
+
+    /// @brief Returns the index of the traffic light (NO_TLS if not modelled)
+    unsigned int index(const std::string& tlsID) const;
+
+    /// @brief Returns the id of the traffic light
+    const std::string& getID(unsigned int tls) const {
+        return myTLS[tls].id;
+    }
+
+    /// @brief Returns the id of the current program
+    const std::string& getProgram(unsigned int tls) const {
+        return myProgramIDs[myTLS[tls].program];
+    }
+
+    /// @brief Returns the number of phases of the current program
+    unsigned int getNumPhases(unsigned int tls) const {
+        return myNumPhases[myTLS[tls].program];
+    }
+
+    /// @brief Returns the number of controlled links
+    unsigned int getNumLinks(unsigned int tls) const {
+        return myNumLinks[myTLS[tls].program];
+    }
+    /// @}
+
+
+    /// @name the current phase
+    /// @{
+
+    /// @brief Returns the index of the current phase
+    unsigned int getPhase(unsigned int tls) const {
+        return myTLS[tls].phase;
+    }
+
+    /// @brief Returns the time of the next switch
+    SUMOTime getNextSwitch(unsigned int tls) const {
+        return myTLS[tls].nextSwitch;
+    }
+
+    /// @brief Returns the signal of the link in the current phase
+    Signal getSignal(unsigned int tls, unsigned int link) const {
+        return getSignal(tls, myTLS[tls].phase, link);
+    }
+
+    /// @brief Returns the state of the current phase
+    std::string getState(unsigned int tls) const {
+        return getState(tls, myTLS[tls].phase);
+    }
+    /// @}
+
+
+    /// @name the phases of the current program
+    /// @{
+
+    /// @brief Returns the signal of the link in the given phase (SIGNAL_UNKNOWN if either is not known)
+    Signal getSignal(unsigned int tls, unsigned int phase, unsigned int link) const;
+
+    /// @brief Returns the state of the given phase (empty if the phase is not known)
+    std::string getState(unsigned int tls, unsigned int phase) const;
+
+    /// @brief Returns the duration of the given phase
+    SUMOTime getDuration(unsigned int tls, unsigned int phase) const {
+        return myDurations[myFirstPhase[myTLS[tls].program] + phase];
+    }
+
+    /// @brief Returns the minimum duration of the given phase (actuated programs)
+    SUMOTime getMinDuration(unsigned int tls, unsigned int phase) const {
+        return myMinDurations[myFirstPhase[myTLS[tls].program] + phase];
+    }
+
+    /// @brief Returns the maximum duration of the given phase (actuated programs)
+    SUMOTime getMaxDuration(unsigned int tls, unsigned int phase) const {
+        return myMaxDurations[myFirstPhase[myTLS[tls].program] + phase];
+    }
+
+    /// @brief Returns the cycle time of the current program
+    SUMOTime getCycleTime(unsigned int tls) const {
+        return myCycleTimes[myTLS[tls].program];
+    }
+    /// @}
+
+
+    /// @name predictions
+    /// @{
+
+    /// @brief Returns the phase the traffic light will be in at the given (future) time
+    unsigned int predictPhase(unsigned int tls, SUMOTime time) const;
+
+    /** @brief Returns the time the link's signal changes next
+     * @return The time or -1 if the signal is the same in all phases
+     */
+    SUMOTime predictChange(unsigned int tls, unsigned int link) const;
+
+    /** @brief Returns the time of the next switch to a phase in which the link shows the given signal
+     * @return The time or -1 if no phase shows the signal
+     */
+    SUMOTime predictSignal(unsigned int tls, unsigned int link, Signal signal) const;
+    /// @}
+
+
+    /// @brief Returns the signal code of a state character
+    static Signal parseSignal(char c);
+
+    /// @brief Returns the state character of a signal code
+    static char toChar(Signal signal);
+
+
+private:
+    /// @brief The modelled state of a traffic light
+    struct TLS {
+        /// @brief The id
+        std::string id;
+        /// @brief The index of the first program
+        unsigned int firstProgram;
+        /// @brief The number of programs
+        unsigned int numPrograms;
+        /// @brief The index of the current program
+        unsigned int program;
+        /// @brief The current phase within the program
+        unsigned int phase;
+        /// @brief The time of the next switch
+        SUMOTime nextSwitch;
+        /// @brief Whether observations disagreed with the model
+        bool drifted;
+    };
+
+
+    /// @brief Stores the programs of a traffic light, replacing the known ones
+    void setPrograms(unsigned int tls, const std::vector<TraCIAPI::TraCILogic>& logics);
+
+    /// @brief Adopts the current program, phase and next switch of a traffic light
+    void setCurrent(unsigned int tls, const std::string& programID, unsigned int phase, SUMOTime nextSwitch);
+
+    /// @brief Returns the index of the traffic light's program (NO_TLS if unknown)
+    unsigned int findProgram(const TLS& tls, const std::string& programID) const;
+
+    /// @brief Returns the code of the signal at the given position of the packed states
+    Signal getPacked(unsigned int begin, unsigned int link) const {
+        const unsigned char b = myStates[begin + link / 2];
+        return (Signal)((link % 2) == 0 ? (b & 0x0f) : (b >> 4));
+    }
+
+
+private:
+    /// @brief The traffic lights
+    std::vector<TLS> myTLS;
+
+    /// @brief The indices of the traffic lights by id
+    FlatStringMap<unsigned int> myIndex;
+
+    /// @brief The ids of all programs
+    std::vector<std::string> myProgramIDs;
+
+    /// @brief The first phase and number of phases of all programs
+    std::vector<unsigned int> myFirstPhase, myNumPhases;
+
+    /// @brief The number of links of all programs
+    std::vector<unsigned int> myNumLinks;
+
+    /// @brief The cycle times of all programs
+    std::vector<SUMOTime> myCycleTimes;
+
+    /// @brief The durations of all phases
+    std::vector<SUMOTime> myDurations;
+
+    /// @brief The minimum and maximum durations of all phases
+    std::vector<SUMOTime> myMinDurations, myMaxDurations;
+
+    /// @brief The begin of each phase's signals within myStates
+    std::vector<unsigned int> myStateBegins;
+
+    /// @brief The signals of all phases, four bits per link
+    std::vector<unsigned char> myStates;
+
+    /// @brief The number of detected drifts
+    unsigned int myNumDrifts;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    TLSProgramModel(const TLSProgramModel&);
+
+    /// @brief Invalidated assignment operator.
+    TLSProgramModel& operator=(const TLSProgramModel&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
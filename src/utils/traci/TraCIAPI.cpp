@@ -28,7 +28,10 @@
 #include <config.h>
 
 #include "TraCIAPI.h"
+#include "SubscriptionResults.h"
+#include "StepSummary.h"
 #include <traci-server/TraCIConstants.h>
+#include <utils/common/StdDefs.h>
 #include <utils/common/ToString.h>
 
 // ===========================================================================
@@ -45,7 +48,7 @@ TraCIAPI::TraCIAPI()
       junction(*this), lane(*this), multientryexit(*this), poi(*this),
       polygon(*this), route(*this), simulation(*this), trafficlights(*this),
       vehicletype(*this),
-      mySocket(0) {}
+      mySocket(0), myStepSummary(0) {}
 #ifdef _MSC_VER
 #pragma warning(default: 4355)
 #endif
@@ -80,27 +83,83 @@ TraCIAPI::close() {
 }
 
 
+void
+TraCIAPI::simulationStep(SUMOTime time) {
+    send_commandSimulationStep(time);
+    tcpip::Storage inMsg;
+    check_resultState(inMsg, CMD_SIMSTEP2);
+    readStepSummary(inMsg);
+}
+
+
+void
+TraCIAPI::simulationStep(SUMOTime time, SubscriptionResults& results) {
+    send_commandSimulationStep(time);
+    tcpip::Storage inMsg;
+    check_resultState(inMsg, CMD_SIMSTEP2);
+    readStepSummary(inMsg);
+    results.readStep(inMsg);
+}
+
+
+void
+TraCIAPI::readStepSummary(tcpip::Storage& inMsg) {
+    if (myStepSummary != 0) {
+        myStepSummary->readStep(inMsg);
+    }
+}
+
+
+void
+TraCIAPI::subscribe(int domID, const std::string& objID, SUMOTime beginTime, SUMOTime endTime, const std::vector<int>& vars) {
+    send_commandSubscribeObjectVariable(domID, objID, (int)beginTime, (int)endTime, vars);
+    tcpip::Storage inMsg;
+    check_resultState(inMsg, domID);
+}
+
+
+void
+TraCIAPI::subscribeContext(int domID, const std::string& objID, SUMOTime beginTime, SUMOTime endTime,
+                           int domain, SUMOReal range, const std::vector<int>& vars) {
+    send_commandSubscribeObjectContext(domID, objID, (int)beginTime, (int)endTime, domain, range, vars);
+    tcpip::Storage inMsg;
+    check_resultState(inMsg, domID);
+}
+
+
 void
 TraCIAPI::send_commandSimulationStep(SUMOTime time) const {
     tcpip::Storage outMsg;
+    write_commandSimulationStep(outMsg, time);
+    // send request message
+    mySocket->sendExact(outMsg);
+}
+
+
+void
+TraCIAPI::write_commandSimulationStep(tcpip::Storage& outMsg, SUMOTime time) {
     // command length
     outMsg.writeUnsignedByte(1 + 1 + 4);
     // command id
     outMsg.writeUnsignedByte(CMD_SIMSTEP2);
     outMsg.writeInt(time);
-    // send request message
-    mySocket->sendExact(outMsg);
 }
 
 
 void
 TraCIAPI::send_commandClose() const {
     tcpip::Storage outMsg;
+    write_commandClose(outMsg);
+    mySocket->sendExact(outMsg);
+}
+
+
+void
+TraCIAPI::write_commandClose(tcpip::Storage& outMsg) {
     // command length
     outMsg.writeUnsignedByte(1 + 1);
     // command id
     outMsg.writeUnsignedByte(CMD_CLOSE);
-    mySocket->sendExact(outMsg);
 }
 
 
@@ -110,6 +169,14 @@ TraCIAPI::send_commandGetVariable(int domID, int varID, const std::string& objID
         throw tcpip::SocketException("Socket is not initialised");
     }
     tcpip::Storage outMsg;
+    write_commandGetVariable(outMsg, domID, varID, objID, add);
+    // send request message
+    mySocket->sendExact(outMsg);
+}
+
+
+void
+TraCIAPI::write_commandGetVariable(tcpip::Storage& outMsg, int domID, int varID, const std::string& objID, tcpip::Storage* add) {
     // command length
     unsigned int length = 1 + 1 + 1 + 4 + (int) objID.length();
     if (add != 0) {
@@ -126,8 +193,6 @@ TraCIAPI::send_commandGetVariable(int domID, int varID, const std::string& objID
     if (add != 0) {
         outMsg.writeStorage(*add);
     }
-    // send request message
-    mySocket->sendExact(outMsg);
 }
 
 
@@ -137,8 +202,22 @@ TraCIAPI::send_commandSetValue(int domID, int varID, const std::string& objID, t
         throw tcpip::SocketException("Socket is not initialised");
     }
     tcpip::Storage outMsg;
+    write_commandSetValue(outMsg, domID, varID, objID, content);
+    // send message
+    mySocket->sendExact(outMsg);
+}
+
+
+void
+TraCIAPI::write_commandSetValue(tcpip::Storage& outMsg, int domID, int varID, const std::string& objID, tcpip::Storage& content) {
     // command length (domID, varID, objID, dataType, data)
-    outMsg.writeUnsignedByte(1 + 1 + 1 + 4 + (int) objID.length() + (int)content.size());
+    const int length = 1 + 1 + 4 + (int) objID.length() + (int)content.size();
+    if (length + 1 <= 255) {
+        outMsg.writeUnsignedByte(length + 1);
+    } else {
+        outMsg.writeUnsignedByte(0);
+        outMsg.writeInt(length + 5);
+    }
     // command id
     outMsg.writeUnsignedByte(domID);
     // variable id
@@ -147,8 +226,6 @@ TraCIAPI::send_commandSetValue(int domID, int varID, const std::string& objID, t
     outMsg.writeString(objID);
     // data type
     outMsg.writeStorage(content);
-    // send message
-    mySocket->sendExact(outMsg);
 }
 
 
@@ -159,6 +236,15 @@ TraCIAPI::send_commandSubscribeObjectVariable(int domID, const std::string& objI
         throw tcpip::SocketException("Socket is not initialised");
     }
     tcpip::Storage outMsg;
+    write_commandSubscribeObjectVariable(outMsg, domID, objID, beginTime, endTime, vars);
+    // send message
+    mySocket->sendExact(outMsg);
+}
+
+
+void
+TraCIAPI::write_commandSubscribeObjectVariable(tcpip::Storage& outMsg, int domID, const std::string& objID, int beginTime, int endTime,
+        const std::vector<int>& vars) {
     // command length (domID, objID, beginTime, endTime, length, vars)
     int varNo = (int) vars.size();
     outMsg.writeUnsignedByte(0);
@@ -175,8 +261,6 @@ TraCIAPI::send_commandSubscribeObjectVariable(int domID, const std::string& objI
     for (int i = 0; i < varNo; ++i) {
         outMsg.writeUnsignedByte(vars[i]);
     }
-    // send message
-    mySocket->sendExact(outMsg);
 }
 
 
@@ -187,6 +271,15 @@ TraCIAPI::send_commandSubscribeObjectContext(int domID, const std::string& objID
         throw tcpip::SocketException("Socket is not initialised");
     }
     tcpip::Storage outMsg;
+    write_commandSubscribeObjectContext(outMsg, domID, objID, beginTime, endTime, domain, range, vars);
+    // send message
+    mySocket->sendExact(outMsg);
+}
+
+
+void
+TraCIAPI::write_commandSubscribeObjectContext(tcpip::Storage& outMsg, int domID, const std::string& objID, int beginTime, int endTime,
+        int domain, SUMOReal range, const std::vector<int>& vars) {
     // command length (domID, objID, beginTime, endTime, length, vars)
     int varNo = (int) vars.size();
     outMsg.writeUnsignedByte(0);
@@ -206,8 +299,6 @@ TraCIAPI::send_commandSubscribeObjectContext(int domID, const std::string& objID
     for (int i = 0; i < varNo; ++i) {
         outMsg.writeUnsignedByte(vars[i]);
     }
-    // send message
-    mySocket->sendExact(outMsg);
 }
 
 
@@ -216,6 +307,12 @@ TraCIAPI::send_commandSubscribeObjectContext(int domID, const std::string& objID
 void
 TraCIAPI::check_resultState(tcpip::Storage& inMsg, int command, bool ignoreCommandId, std::string* acknowledgement) const {
     mySocket->receiveExact(inMsg);
+    read_resultState(inMsg, command, ignoreCommandId, acknowledgement);
+}
+
+
+void
+TraCIAPI::read_resultState(tcpip::Storage& inMsg, int command, bool ignoreCommandId, std::string* acknowledgement) const {
     int cmdLength;
     int cmdId;
     int resultType;
@@ -359,16 +456,7 @@ TraCIAPI::getPolygon(int cmd, int var, const std::string& id, tcpip::Storage* ad
     tcpip::Storage inMsg;
     send_commandGetVariable(cmd, var, id, add);
     processGET(inMsg, cmd, TYPE_POLYGON);
-    unsigned int size = inMsg.readInt();
-    TraCIPositionVector ret;
-    for (unsigned int i = 0; i < size; ++i) {
-        TraCIPosition p;
-        p.x = inMsg.readDouble();
-        p.y = inMsg.readDouble();
-        p.z = 0;
-        ret.push_back(p);
-    }
-    return ret;
+    return readPolygon(inMsg);
 }
 
 
@@ -418,6 +506,122 @@ TraCIAPI::getColor(int cmd, int var, const std::string& id, tcpip::Storage* add)
 }
 
 
+void
+TraCIAPI::getVariables(int cmd, const std::vector<int>& vars, const std::vector<std::string>& ids,
+                       BatchReader& reader, unsigned int batchSize) {
+    if (mySocket == 0) {
+        throw tcpip::SocketException("Socket is not initialised");
+    }
+    if (vars.empty() || batchSize == 0) {
+        return;
+    }
+    const unsigned int numVars = (unsigned int)vars.size();
+    const unsigned int total = (unsigned int)ids.size() * numVars;
+    for (unsigned int first = 0; first < total; first += batchSize) {
+        const unsigned int end = MIN2(total, first + batchSize);
+        tcpip::Storage outMsg;
+        for (unsigned int i = first; i < end; ++i) {
+            write_commandGetVariable(outMsg, cmd, vars[i % numVars], ids[i / numVars]);
+        }
+        mySocket->sendExact(outMsg);
+        // all commands of the message are answered within one message, in order
+        tcpip::Storage inMsg;
+        mySocket->receiveExact(inMsg);
+        for (unsigned int i = first; i < end; ++i) {
+            read_resultState(inMsg, cmd);
+            check_commandGetResult(inMsg, cmd);
+            const int valueType = inMsg.readUnsignedByte();
+            reader.read(i / numVars, vars[i % numVars], valueType, inMsg);
+        }
+    }
+}
+
+
+TraCIAPI::TraCIPositionVector
+TraCIAPI::readPolygon(tcpip::Storage& inMsg) {
+    unsigned int size = inMsg.readUnsignedByte();
+    TraCIPositionVector ret;
+    for (unsigned int i = 0; i < size; ++i) {
+        TraCIPosition p;
+        p.x = inMsg.readDouble();
+        p.y = inMsg.readDouble();
+        p.z = 0;
+        ret.push_back(p);
+    }
+    return ret;
+}
+
+
+void
+TraCIAPI::writePolygon(tcpip::Storage& content, const TraCIPositionVector& shape) {
+    if (shape.size() > 255) {
+        throw tcpip::SocketException("The shape has more than 255 points");
+    }
+    content.writeUnsignedByte((int)shape.size());
+    for (unsigned int i = 0; i < shape.size(); ++i) {
+        content.writeDouble(shape[i].x);
+        content.writeDouble(shape[i].y);
+    }
+}
+
+
+std::vector<TraCIAPI::TraCILink>
+TraCIAPI::readLinks(tcpip::Storage& inMsg) {
+    std::vector<TraCIAPI::TraCILink> ret;
+    // the number of components, the number of signals and per signal the number of links
+    //  followed by one (from, to, via) string list per link
+    inMsg.readInt();
+    inMsg.readUnsignedByte();
+    const int signalNo = inMsg.readInt();
+    for (int i = 0; i < signalNo; ++i) {
+        inMsg.readUnsignedByte();
+        const int linkNo = inMsg.readInt();
+        for (int j = 0; j < linkNo; ++j) {
+            inMsg.readUnsignedByte();
+            const std::vector<std::string> link = inMsg.readStringList();
+            if (link.size() != 3) {
+                throw tcpip::SocketException("Controlled link of " + toString(link.size()) + " lanes instead of 3.");
+            }
+            ret.push_back(TraCIAPI::TraCILink(link[0], link[2], link[1]));
+        }
+    }
+    return ret;
+}
+
+
+std::vector<TraCIAPI::TraCILogic>
+TraCIAPI::readLogics(tcpip::Storage& inMsg) {
+    std::vector<TraCIAPI::TraCILogic> ret;
+    int logicNo = inMsg.readInt();
+    for (int i = 0; i < logicNo; ++i) {
+        inMsg.readUnsignedByte();
+        std::string subID = inMsg.readString();
+        inMsg.readUnsignedByte();
+        int type = inMsg.readInt();
+        inMsg.readUnsignedByte();
+        inMsg.readInt(); // add
+        inMsg.readUnsignedByte();
+        int phaseIndex = inMsg.readInt();
+        inMsg.readUnsignedByte();
+        int phaseNumber = inMsg.readInt();
+        std::vector<TraCIAPI::TraCIPhase> phases;
+        for (int j = 0; j < phaseNumber; ++j) {
+            inMsg.readUnsignedByte();
+            int duration = inMsg.readInt();
+            inMsg.readUnsignedByte();
+            int duration1 = inMsg.readInt();
+            inMsg.readUnsignedByte();
+            int duration2 = inMsg.readInt();
+            inMsg.readUnsignedByte();
+            std::string phase = inMsg.readString();
+            phases.push_back(TraCIAPI::TraCIPhase(duration, duration1, duration2, phase));
+        }
+        ret.push_back(TraCIAPI::TraCILogic(subID, type, std::map<std::string, SUMOReal>(), phaseIndex, phases));
+    }
+    return ret;
+}
+
+
 
 // ---------------------------------------------------------------------------
 // TraCIAPI::EdgeScope-methods
@@ -520,23 +724,34 @@ TraCIAPI::EdgeScope::getLastStepVehicleIDs(const std::string& edgeID) const {
 
 void
 TraCIAPI::EdgeScope::adaptTraveltime(const std::string& edgeID, SUMOReal time) const {
+    // the weight is valid for all times, given as a compound of the value only
     tcpip::Storage content;
+    content.writeUnsignedByte(TYPE_COMPOUND);
+    content.writeInt(1);
+    content.writeUnsignedByte(TYPE_DOUBLE);
     content.writeDouble(time);
     myParent.send_commandSetValue(CMD_SET_EDGE_VARIABLE, VAR_EDGE_TRAVELTIME, edgeID, content);
+    myParent.check_resultState(content, CMD_SET_EDGE_VARIABLE);
 }
 
 void
 TraCIAPI::EdgeScope::setEffort(const std::string& edgeID, SUMOReal effort) const {
     tcpip::Storage content;
+    content.writeUnsignedByte(TYPE_COMPOUND);
+    content.writeInt(1);
+    content.writeUnsignedByte(TYPE_DOUBLE);
     content.writeDouble(effort);
     myParent.send_commandSetValue(CMD_SET_EDGE_VARIABLE, VAR_EDGE_EFFORT, edgeID, content);
+    myParent.check_resultState(content, CMD_SET_EDGE_VARIABLE);
 }
 
 void
 TraCIAPI::EdgeScope::setMaxSpeed(const std::string& edgeID, SUMOReal speed) const {
     tcpip::Storage content;
+    content.writeUnsignedByte(TYPE_DOUBLE);
     content.writeDouble(speed);
     myParent.send_commandSetValue(CMD_SET_EDGE_VARIABLE, VAR_MAXSPEED, edgeID, content);
+    myParent.check_resultState(content, CMD_SET_EDGE_VARIABLE);
 }
 
 
@@ -734,82 +949,82 @@ TraCIAPI::LaneScope::getLinkNumber(const std::string& /* laneID */) const {
 
 TraCIAPI::TraCIPositionVector
 TraCIAPI::LaneScope::getShape(const std::string& laneID) const {
-    throw myParent.getPolygon(CMD_GET_LANE_VARIABLE, VAR_SHAPE, laneID);
+    return myParent.getPolygon(CMD_GET_LANE_VARIABLE, VAR_SHAPE, laneID);
 }
 
 std::string
 TraCIAPI::LaneScope::getEdgeID(const std::string& laneID) const {
-    throw myParent.getString(CMD_GET_LANE_VARIABLE, LANE_EDGE_ID, laneID);
+    return myParent.getString(CMD_GET_LANE_VARIABLE, LANE_EDGE_ID, laneID);
 }
 
 SUMOReal
 TraCIAPI::LaneScope::getCO2Emission(const std::string& laneID) const {
-    throw myParent.getDouble(CMD_GET_LANE_VARIABLE, VAR_CO2EMISSION, laneID);
+    return myParent.getDouble(CMD_GET_LANE_VARIABLE, VAR_CO2EMISSION, laneID);
 }
 
 SUMOReal
 TraCIAPI::LaneScope::getCOEmission(const std::string& laneID) const {
-    throw myParent.getDouble(CMD_GET_LANE_VARIABLE, VAR_COEMISSION, laneID);
+    return myParent.getDouble(CMD_GET_LANE_VARIABLE, VAR_COEMISSION, laneID);
 }
 
 SUMOReal
 TraCIAPI::LaneScope::getHCEmission(const std::string& laneID) const {
-    throw myParent.getDouble(CMD_GET_LANE_VARIABLE, VAR_HCEMISSION, laneID);
+    return myParent.getDouble(CMD_GET_LANE_VARIABLE, VAR_HCEMISSION, laneID);
 }
 
 SUMOReal
 TraCIAPI::LaneScope::getPMxEmission(const std::string& laneID) const {
-    throw myParent.getDouble(CMD_GET_LANE_VARIABLE, VAR_PMXEMISSION, laneID);
+    return myParent.getDouble(CMD_GET_LANE_VARIABLE, VAR_PMXEMISSION, laneID);
 }
 
 SUMOReal
 TraCIAPI::LaneScope::getNOxEmission(const std::string& laneID) const {
-    throw myParent.getDouble(CMD_GET_LANE_VARIABLE, VAR_NOXEMISSION, laneID);
+    return myParent.getDouble(CMD_GET_LANE_VARIABLE, VAR_NOXEMISSION, laneID);
 }
 
 SUMOReal
 TraCIAPI::LaneScope::getFuelConsumption(const std::string& laneID) const {
-    throw myParent.getDouble(CMD_GET_LANE_VARIABLE, VAR_FUELCONSUMPTION, laneID);
+    return myParent.getDouble(CMD_GET_LANE_VARIABLE, VAR_FUELCONSUMPTION, laneID);
 }
 
 SUMOReal
 TraCIAPI::LaneScope::getNoiseEmission(const std::string& laneID) const {
-    throw myParent.getDouble(CMD_GET_LANE_VARIABLE, VAR_NOISEEMISSION, laneID);
+    return myParent.getDouble(CMD_GET_LANE_VARIABLE, VAR_NOISEEMISSION, laneID);
 }
 
 SUMOReal
 TraCIAPI::LaneScope::getLastStepMeanSpeed(const std::string& laneID) const {
-    throw myParent.getDouble(CMD_GET_LANE_VARIABLE, LAST_STEP_MEAN_SPEED, laneID);
+    return myParent.getDouble(CMD_GET_LANE_VARIABLE, LAST_STEP_MEAN_SPEED, laneID);
 }
 
 SUMOReal
 TraCIAPI::LaneScope::getLastStepOccupancy(const std::string& laneID) const {
-    throw myParent.getDouble(CMD_GET_LANE_VARIABLE, LAST_STEP_OCCUPANCY, laneID);
+    return myParent.getDouble(CMD_GET_LANE_VARIABLE, LAST_STEP_OCCUPANCY, laneID);
 }
 
 SUMOReal
 TraCIAPI::LaneScope::getLastStepLength(const std::string& laneID) const {
-    throw myParent.getDouble(CMD_GET_LANE_VARIABLE, LAST_STEP_LENGTH, laneID);
+    return myParent.getDouble(CMD_GET_LANE_VARIABLE, LAST_STEP_LENGTH, laneID);
 }
 
 SUMOReal
 TraCIAPI::LaneScope::getTraveltime(const std::string& laneID) const {
-    throw myParent.getDouble(CMD_GET_LANE_VARIABLE, VAR_CURRENT_TRAVELTIME, laneID);
+    return myParent.getDouble(CMD_GET_LANE_VARIABLE, VAR_CURRENT_TRAVELTIME, laneID);
 }
 
 unsigned int
 TraCIAPI::LaneScope::getLastStepVehicleNumber(const std::string& laneID) const {
-    throw myParent.getInt(CMD_GET_LANE_VARIABLE, LAST_STEP_VEHICLE_NUMBER, laneID);
+    return myParent.getInt(CMD_GET_LANE_VARIABLE, LAST_STEP_VEHICLE_NUMBER, laneID);
 }
 
 unsigned int
 TraCIAPI::LaneScope::getLastStepHaltingNumber(const std::string& laneID) const {
-    throw myParent.getInt(CMD_GET_LANE_VARIABLE, LAST_STEP_VEHICLE_HALTING_NUMBER, laneID);
+    return myParent.getInt(CMD_GET_LANE_VARIABLE, LAST_STEP_VEHICLE_HALTING_NUMBER, laneID);
 }
 
 std::vector<std::string>
 TraCIAPI::LaneScope::getLastStepVehicleIDs(const std::string& laneID) const {
-    throw myParent.getStringVector(CMD_GET_LANE_VARIABLE, LAST_STEP_VEHICLE_ID_LIST, laneID);
+    return myParent.getStringVector(CMD_GET_LANE_VARIABLE, LAST_STEP_VEHICLE_ID_LIST, laneID);
 }
 
 
@@ -923,6 +1138,7 @@ TraCIAPI::POIScope::setType(const std::string& poiID, const std::string& setType
     content.writeUnsignedByte(TYPE_STRING);
     content.writeString(setType);
     myParent.send_commandSetValue(CMD_SET_POI_VARIABLE, VAR_TYPE, poiID, content);
+    myParent.check_resultState(content, CMD_SET_POI_VARIABLE);
 }
 
 void
@@ -932,6 +1148,7 @@ TraCIAPI::POIScope::setPosition(const std::string& poiID, SUMOReal x, SUMOReal y
     content.writeDouble(x);
     content.writeDouble(y);
     myParent.send_commandSetValue(CMD_SET_POI_VARIABLE, VAR_POSITION, poiID, content);
+    myParent.check_resultState(content, CMD_SET_POI_VARIABLE);
 }
 
 void
@@ -943,6 +1160,7 @@ TraCIAPI::POIScope::setColor(const std::string& poiID, const TraCIColor& c) cons
     content.writeUnsignedByte(c.b);
     content.writeUnsignedByte(c.a);
     myParent.send_commandSetValue(CMD_SET_POI_VARIABLE, VAR_COLOR, poiID, content);
+    myParent.check_resultState(content, CMD_SET_POI_VARIABLE);
 }
 
 void
@@ -963,6 +1181,7 @@ TraCIAPI::POIScope::add(const std::string& poiID, SUMOReal x, SUMOReal y, const
     content.writeDouble(x);
     content.writeDouble(y);
     myParent.send_commandSetValue(CMD_SET_POI_VARIABLE, ADD, poiID, content);
+    myParent.check_resultState(content, CMD_SET_POI_VARIABLE);
 }
 
 void
@@ -971,6 +1190,7 @@ TraCIAPI::POIScope::remove(const std::string& poiID, int layer) const {
     content.writeUnsignedByte(TYPE_INTEGER);
     content.writeInt(layer);
     myParent.send_commandSetValue(CMD_SET_POI_VARIABLE, REMOVE, poiID, content);
+    myParent.check_resultState(content, CMD_SET_POI_VARIABLE);
 }
 
 
@@ -1005,18 +1225,16 @@ TraCIAPI::PolygonScope::setType(const std::string& polygonID, const std::string&
     content.writeUnsignedByte(TYPE_STRING);
     content.writeString(setType);
     myParent.send_commandSetValue(CMD_SET_POLYGON_VARIABLE, VAR_TYPE, polygonID, content);
+    myParent.check_resultState(content, CMD_SET_POLYGON_VARIABLE);
 }
 
 void
 TraCIAPI::PolygonScope::setShape(const std::string& polygonID, const TraCIAPI::TraCIPositionVector& shape) const {
     tcpip::Storage content;
     content.writeUnsignedByte(TYPE_POLYGON);
-    content.writeInt((int)shape.size());
-    for (unsigned int i = 0; i < shape.size(); ++i) {
-        content.writeDouble(shape[i].x);
-        content.writeDouble(shape[i].y);
-    }
-    myParent.send_commandSetValue(CMD_SET_POLYGON_VARIABLE, VAR_POSITION, polygonID, content);
+    writePolygon(content, shape);
+    myParent.send_commandSetValue(CMD_SET_POLYGON_VARIABLE, VAR_SHAPE, polygonID, content);
+    myParent.check_resultState(content, CMD_SET_POLYGON_VARIABLE);
 }
 
 void
@@ -1028,13 +1246,14 @@ TraCIAPI::PolygonScope::setColor(const std::string& polygonID, const TraCIColor&
     content.writeUnsignedByte(c.b);
     content.writeUnsignedByte(c.a);
     myParent.send_commandSetValue(CMD_SET_POLYGON_VARIABLE, VAR_COLOR, polygonID, content);
+    myParent.check_resultState(content, CMD_SET_POLYGON_VARIABLE);
 }
 
 void
 TraCIAPI::PolygonScope::add(const std::string& polygonID, const TraCIAPI::TraCIPositionVector& shape, const TraCIColor& c, bool fill, const std::string& type, int layer) const {
     tcpip::Storage content;
     content.writeUnsignedByte(TYPE_COMPOUND);
-    content.writeInt(4);
+    content.writeInt(5);
     content.writeUnsignedByte(TYPE_STRING);
     content.writeString(type);
     content.writeUnsignedByte(TYPE_COLOR);
@@ -1048,12 +1267,9 @@ TraCIAPI::PolygonScope::add(const std::string& polygonID, const TraCIAPI::TraCIP
     content.writeUnsignedByte(TYPE_INTEGER);
     content.writeInt(layer);
     content.writeUnsignedByte(TYPE_POLYGON);
-    content.writeInt((int)shape.size());
-    for (unsigned int i = 0; i < shape.size(); ++i) {
-        content.writeDouble(shape[i].x);
-        content.writeDouble(shape[i].y);
-    }
+    writePolygon(content, shape);
     myParent.send_commandSetValue(CMD_SET_POLYGON_VARIABLE, ADD, polygonID, content);
+    myParent.check_resultState(content, CMD_SET_POLYGON_VARIABLE);
 }
 
 void
@@ -1062,6 +1278,7 @@ TraCIAPI::PolygonScope::remove(const std::string& polygonID, int layer) const {
     content.writeUnsignedByte(TYPE_INTEGER);
     content.writeInt(layer);
     myParent.send_commandSetValue(CMD_SET_POLYGON_VARIABLE, REMOVE, polygonID, content);
+    myParent.check_resultState(content, CMD_SET_POLYGON_VARIABLE);
 }
 
 
@@ -1085,7 +1302,8 @@ TraCIAPI::RouteScope::add(const std::string& routeID, const std::vector<std::str
     tcpip::Storage content;
     content.writeUnsignedByte(TYPE_STRINGLIST);
     content.writeStringList(edges);
-    myParent.send_commandSetValue(CMD_SET_ROUTE_VARIABLE, VAR_POSITION, routeID, content);
+    myParent.send_commandSetValue(CMD_SET_ROUTE_VARIABLE, ADD, routeID, content);
+    myParent.check_resultState(content, CMD_SET_ROUTE_VARIABLE);
 }
 
 
@@ -1185,34 +1403,7 @@ TraCIAPI::TrafficLightScope::getCompleteRedYellowGreenDefinition(const std::stri
     tcpip::Storage inMsg;
     myParent.send_commandGetVariable(CMD_GET_TL_VARIABLE, TL_COMPLETE_DEFINITION_RYG, tlsID);
     myParent.processGET(inMsg, CMD_GET_TL_VARIABLE, TYPE_COMPOUND);
-    std::vector<TraCIAPI::TraCILogic> ret;
-    int logicNo = inMsg.readInt();
-    for (int i = 0; i < logicNo; ++i) {
-        inMsg.readUnsignedByte();
-        std::string subID = inMsg.readString();
-        inMsg.readUnsignedByte();
-        int type = inMsg.readInt();
-        inMsg.readUnsignedByte();
-        inMsg.readInt(); // add
-        inMsg.readUnsignedByte();
-        int phaseIndex = inMsg.readInt();
-        inMsg.readUnsignedByte();
-        int phaseNumber = inMsg.readInt();
-        std::vector<TraCIAPI::TraCIPhase> phases;
-        for (int j = 0; j < phaseNumber; ++j) {
-            inMsg.readUnsignedByte();
-            int duration = inMsg.readInt();
-            inMsg.readUnsignedByte();
-            int duration1 = inMsg.readInt();
-            inMsg.readUnsignedByte();
-            int duration2 = inMsg.readInt();
-            inMsg.readUnsignedByte();
-            std::string phase = inMsg.readString();
-            phases.push_back(TraCIAPI::TraCIPhase(duration, duration1, duration2, phase));
-        }
-        ret.push_back(TraCIAPI::TraCILogic(subID, type, std::map<std::string, SUMOReal>(), phaseIndex, phases));
-    }
-    return ret;
+    return readLogics(inMsg);
 }
 
 std::vector<std::string>
@@ -1225,18 +1416,7 @@ TraCIAPI::TrafficLightScope::getControlledLinks(const std::string& tlsID) const
     tcpip::Storage inMsg;
     myParent.send_commandGetVariable(CMD_GET_TL_VARIABLE, TL_CONTROLLED_LINKS, tlsID);
     myParent.processGET(inMsg, CMD_GET_TL_VARIABLE, TYPE_COMPOUND);
-    std::vector<TraCIAPI::TraCILink> ret;
-    int linkNo = inMsg.readInt();
-    for (int i = 0; i < linkNo; ++i) {
-        inMsg.readUnsignedByte();
-        std::string from = inMsg.readString();
-        inMsg.readUnsignedByte();
-        std::string via = inMsg.readString();
-        inMsg.readUnsignedByte();
-        std::string to = inMsg.readString();
-        ret.push_back(TraCIAPI::TraCILink(from, via, to));
-    }
-    return ret;
+    return readLinks(inMsg);
 }
 
 std::string
@@ -44,6 +44,13 @@
 #define DEFAULT_VIEW "View #0"
 
 
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class SubscriptionResults;
+class StepSummary;
+
+
 // ===========================================================================
 // class definitions
 // ===========================================================================
@@ -150,6 +157,65 @@ public:
 
 
 
+    /// @name Simulation control and subscriptions
+    /// @{
+
+    /** @brief Advances the simulation, ignoring the subscription results
+     * @param[in] time The time to advance to (0 for one step)
+     * @exception tcpip::SocketException if the step fails
+     */
+    void simulationStep(SUMOTime time = 0);
+
+
+    /** @brief Advances the simulation and stores the subscription results
+     * @param[in] time The time to advance to (0 for one step)
+     * @param[in] results The results to update with the step's values
+     * @exception tcpip::SocketException if the step fails
+     */
+    void simulationStep(SUMOTime time, SubscriptionResults& results);
+
+
+    /** @brief Registers a summary to fill from the answer to each simulation step
+     *
+     * The summary's variables have to be subscribed (see StepSummary::subscribe).
+     *
+     * @param[in] summary The summary to fill (0 to stop)
+     */
+    void setStepSummary(StepSummary* summary) {
+        myStepSummary = summary;
+    }
+
+
+    /** @brief Subscribes variables of an object
+     *
+     * The values are delivered with the following steps.
+     *
+     * @param[in] domID The subscription command of the object's domain
+     * @param[in] objID The object to subscribe the variables from
+     * @param[in] beginTime The begin time of the subscription
+     * @param[in] endTime The end time of the subscription
+     * @param[in] vars The variables to subscribe
+     * @exception tcpip::SocketException if the subscription fails
+     */
+    void subscribe(int domID, const std::string& objID, SUMOTime beginTime, SUMOTime endTime, const std::vector<int>& vars);
+
+
+    /** @brief Subscribes variables of the objects around an object
+     * @param[in] domID The context subscription command of the object's domain
+     * @param[in] objID The object whose context is subscribed
+     * @param[in] beginTime The begin time of the subscription
+     * @param[in] endTime The end time of the subscription
+     * @param[in] domain The domain of the objects whose values are subscribed
+     * @param[in] range The range around the object
+     * @param[in] vars The variables to subscribe
+     * @exception tcpip::SocketException if the subscription fails
+     */
+    void subscribeContext(int domID, const std::string& objID, SUMOTime beginTime, SUMOTime endTime,
+                          int domain, SUMOReal range, const std::vector<int>& vars);
+    /// @}
+
+
+
     /// @name Atomar getter
     /// @{
 
@@ -169,6 +235,62 @@ public:
 
 
 
+    /// @name Batched getter
+    /// @{
+
+    /** @class BatchReader
+     * @brief Receives the values retrieved by getVariables
+     */
+    class BatchReader {
+    public:
+        /// @brief Destructor
+        virtual ~BatchReader() {}
+
+        /** @brief Reads one value from the answer
+         *
+         * The value has to be consumed completely, the next answer follows it.
+         *
+         * @param[in] object The index of the object within the requested ids
+         * @param[in] var The variable
+         * @param[in] valueType The type of the value
+         * @param[in] inMsg The answer, positioned at the value
+         */
+        virtual void read(unsigned int object, int var, int valueType, tcpip::Storage& inMsg) = 0;
+    };
+
+
+    /** @brief Retrieves the given variables of all given objects with few round trips
+     *
+     * The GetVariable requests are sent in messages of at most batchSize
+     *  commands each; the simulation answers all commands of a message
+     *  within one answer, so the number of round trips is divided by batchSize.
+     *
+     * @param[in] cmd The get command of the domain
+     * @param[in] vars The variables to retrieve per object
+     * @param[in] ids The objects
+     * @param[in] reader The reader to hand the values to (in the order of ids, then vars)
+     * @param[in] batchSize The maximum number of commands per message
+     * @exception tcpip::SocketException if the connection fails or a command is answered with an error
+     */
+    void getVariables(int cmd, const std::vector<int>& vars, const std::vector<std::string>& ids,
+                      BatchReader& reader, unsigned int batchSize = 1024);
+
+
+    /// @brief Reads a polygon value (without the type)
+    static TraCIPositionVector readPolygon(tcpip::Storage& inMsg);
+
+    /// @brief Writes a polygon value as readPolygon reads it (without the type)
+    static void writePolygon(tcpip::Storage& content, const TraCIPositionVector& shape);
+
+    /// @brief Reads the compound value of controlled links (without the type), ordered by signal
+    static std::vector<TraCILink> readLinks(tcpip::Storage& inMsg);
+
+    /// @brief Reads the compound value of a complete traffic light definition (without the type)
+    static std::vector<TraCILogic> readLogics(tcpip::Storage& inMsg);
+    /// @}
+
+
+
     /** @class TraCIScopeWrapper
      * @brief An abstract interface for accessing type-dependent values
      *
@@ -669,6 +791,15 @@ public:
 
 
 protected:
+    /// @brief Compiled programs encode their commands using the write_command methods
+    friend class TraCIProgram;
+
+    /// @brief Command buffers send the collected commands over the connection
+    friend class TLSCommandBuffer;
+    friend class RoutingCommandBuffer;
+    friend class ShapeBatch;
+
+
     /// @name Command sending methods
     /// @{
 
@@ -677,11 +808,24 @@ protected:
     void send_commandSimulationStep(SUMOTime time) const;
 
 
+    /** @brief Appends a SimulationStep command to a message without sending it
+     * @param[in] outMsg The message to extend
+     * @param[in] time The time step to simulate until
+     */
+    static void write_commandSimulationStep(tcpip::Storage& outMsg, SUMOTime time);
+
+
     /** @brief Sends a Close command
      */
     void send_commandClose() const;
 
 
+    /** @brief Appends a Close command to a message without sending it
+     * @param[in] outMsg The message to extend
+     */
+    static void write_commandClose(tcpip::Storage& outMsg);
+
+
     /** @brief Sends a GetVariable request
      * @param[in] domID The domain of the variable
      * @param[in] varID The variable to retrieve
@@ -691,6 +835,16 @@ protected:
     void send_commandGetVariable(int domID, int varID, const std::string& objID, tcpip::Storage* add = 0) const;
 
 
+    /** @brief Appends a GetVariable request to a message without sending it
+     * @param[in] outMsg The message to extend
+     * @param[in] domID The domain of the variable
+     * @param[in] varID The variable to retrieve
+     * @param[in] objID The object to retrieve the variable from
+     * @param[in] add Optional additional parameter
+     */
+    static void write_commandGetVariable(tcpip::Storage& outMsg, int domID, int varID, const std::string& objID, tcpip::Storage* add = 0);
+
+
     /** @brief Sends a SetVariable request
      * @param[in] domID The domain of the variable
      * @param[in] varID The variable to set
@@ -700,6 +854,16 @@ protected:
     void send_commandSetValue(int domID, int varID, const std::string& objID, tcpip::Storage& content) const;
 
 
+    /** @brief Appends a SetVariable request to a message without sending it
+     * @param[in] outMsg The message to extend
+     * @param[in] domID The domain of the variable
+     * @param[in] varID The variable to set
+     * @param[in] objID The object to change
+     * @param[in] content The value of the variable
+     */
+    static void write_commandSetValue(tcpip::Storage& outMsg, int domID, int varID, const std::string& objID, tcpip::Storage& content);
+
+
     /** @brief Sends a SubscribeVariable request
      * @param[in] domID The domain of the variable
      * @param[in] objID The object to subscribe the variables from
@@ -710,6 +874,12 @@ protected:
     void send_commandSubscribeObjectVariable(int domID, const std::string& objID, int beginTime, int endTime, const std::vector<int>& vars) const;
 
 
+    /** @brief Appends a SubscribeVariable request to a message without sending it
+     * @see send_commandSubscribeObjectVariable
+     */
+    static void write_commandSubscribeObjectVariable(tcpip::Storage& outMsg, int domID, const std::string& objID, int beginTime, int endTime, const std::vector<int>& vars);
+
+
     /** @brief Sends a SubscribeContext request
      * @param[in] domID The domain of the variable
      * @param[in] objID The object to subscribe the variables from
@@ -721,6 +891,13 @@ protected:
      */
     void send_commandSubscribeObjectContext(int domID, const std::string& objID, int beginTime, int endTime,
                                             int domain, SUMOReal range, const std::vector<int>& vars) const;
+
+
+    /** @brief Appends a SubscribeContext request to a message without sending it
+     * @see send_commandSubscribeObjectContext
+     */
+    static void write_commandSubscribeObjectContext(tcpip::Storage& outMsg, int domID, const std::string& objID, int beginTime, int endTime,
+            int domain, SUMOReal range, const std::vector<int>& vars);
     /// @}
 
 
@@ -736,9 +913,19 @@ protected:
      */
     void check_resultState(tcpip::Storage& inMsg, int command, bool ignoreCommandId = false, std::string* acknowledgement = 0) const;
 
+    /** @brief Validates the result state of a command within an already received message
+     * @see check_resultState
+     */
+    void read_resultState(tcpip::Storage& inMsg, int command, bool ignoreCommandId = false, std::string* acknowledgement = 0) const;
+
     void check_commandGetResult(tcpip::Storage& inMsg, int command, int expectedType = -1, bool ignoreCommandId = false) const;
 
     void processGET(tcpip::Storage& inMsg, int command, int expectedType, bool ignoreCommandId = false) const;
+
+    /** @brief Fills the registered step summary (if any) from the answer to a simulation step
+     * @param[in] inMsg The answer, positioned at the subscription results (the position is kept)
+     */
+    void readStepSummary(tcpip::Storage& inMsg);
     /// @}
 
 
@@ -746,6 +933,9 @@ protected:
     /// @brief The socket
     tcpip::Socket* mySocket;
 
+    /// @brief The summary filled with each simulation step (0 if none)
+    StepSummary* myStepSummary;
+
 
 };
 
@@ -0,0 +1,434 @@
+/****************************************************************************/
+/// @file    TraCIProgram.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// A TraCITestClient script compiled into pre-encoded TraCI commands
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <foreign/tcpip/storage.h>
+#include <traci-server/TraCIConstants.h>
+#include <utils/common/SUMOTime.h>
+#include <utils/common/ToString.h>
+#include <utils/common/UtilExceptions.h>
+#include "TraCIAPI.h"
+#include "TraCIProgram.h"
+
+
+// ===========================================================================
+// static members
+// ===========================================================================
+/// @brief The first string of a program file
+static const std::string PROGRAM_MAGIC = "SUMO TraCI program";
+
+/// @brief The format version, to be increased whenever the layout changes
+static const int PROGRAM_FORMAT = 1;
+
+
+// ===========================================================================
+// helper definitions
+// ===========================================================================
+namespace {
+
+/**
+ * @class ScriptReader
+ * @brief Splits a script into whitespace separated tokens and converts them
+ */
+class ScriptReader {
+public:
+    ScriptReader(const std::string& script, const std::string& source)
+        : myScript(script), mySource(source), myPos(0), myLine(1) {}
+
+    /// @brief Reads the next token, returns false at the end of the script
+    bool next(std::string& token) {
+        while (myPos < myScript.size() && isspace((unsigned char)myScript[myPos])) {
+            if (myScript[myPos] == '\n') {
+                myLine++;
+            }
+            myPos++;
+        }
+        if (myPos == myScript.size()) {
+            return false;
+        }
+        const size_t begin = myPos;
+        while (myPos < myScript.size() && !isspace((unsigned char)myScript[myPos])) {
+            myPos++;
+        }
+        token.assign(myScript, begin, myPos - begin);
+        return true;
+    }
+
+    /// @brief Reads the next token, which must exist
+    std::string string() {
+        std::string token;
+        if (!next(token)) {
+            error("Unexpected end of the script");
+        }
+        return token;
+    }
+
+    /// @brief Reads an integer (decimal, octal or hexadecimal like the interpreter)
+    int integer() {
+        const std::string token = string();
+        char* end = 0;
+        const long value = strtol(token.c_str(), &end, 0);
+        if (*end != 0) {
+            error("'" + token + "' is not an integer");
+        }
+        return (int)value;
+    }
+
+    /// @brief Reads a floating point number
+    double real() {
+        const std::string token = string();
+        char* end = 0;
+        const double value = strtod(token.c_str(), &end);
+        if (*end != 0) {
+            error("'" + token + "' is not a number");
+        }
+        return value;
+    }
+
+    /// @brief Reads a time given in seconds
+    SUMOTime time() {
+        const std::string token = string();
+        try {
+            return string2time(token);
+        } catch (ProcessError&) {
+            error("'" + token + "' is not a valid time");
+        }
+        return 0;
+    }
+
+    /// @brief Reads a type / value pair (see TraCITestClient::setValueTypeDependant) and encodes it
+    void value(tcpip::Storage& into) {
+        const std::string dataType = string();
+        if (dataType == "<airDist>") {
+            into.writeUnsignedByte(REQUEST_AIRDIST);
+        } else if (dataType == "<drivingDist>") {
+            into.writeUnsignedByte(REQUEST_DRIVINGDIST);
+        } else if (dataType == "<objSubscription>") {
+            into.writeInt(integer());
+            into.writeInt(integer());
+            const int numVars = integer();
+            into.writeInt(numVars);
+            for (int i = 0; i < numVars; ++i) {
+                into.writeUnsignedByte(integer());
+            }
+        } else if (dataType == "<int>") {
+            into.writeUnsignedByte(TYPE_INTEGER);
+            into.writeInt(integer());
+        } else if (dataType == "<byte>") {
+            into.writeUnsignedByte(TYPE_BYTE);
+            into.writeByte(integer());
+        } else if (dataType == "<ubyte>") {
+            into.writeUnsignedByte(TYPE_UBYTE);
+            into.writeUnsignedByte(integer());
+        } else if (dataType == "<float>") {
+            into.writeUnsignedByte(TYPE_FLOAT);
+            into.writeFloat(float(real()));
+        } else if (dataType == "<double>") {
+            into.writeUnsignedByte(TYPE_DOUBLE);
+            into.writeDouble(real());
+        } else if (dataType == "<string>") {
+            std::string value = string();
+            if (value == "\"\"") {
+                value = "";
+            }
+            into.writeUnsignedByte(TYPE_STRING);
+            into.writeString(value);
+        } else if (dataType == "<string*>") {
+            std::vector<std::string> values;
+            const int num = integer();
+            for (int i = 0; i < num; ++i) {
+                values.push_back(string());
+            }
+            into.writeUnsignedByte(TYPE_STRINGLIST);
+            into.writeStringList(values);
+        } else if (dataType == "<compound>") {
+            const int num = integer();
+            into.writeUnsignedByte(TYPE_COMPOUND);
+            into.writeInt(num);
+            for (int i = 0; i < num; ++i) {
+                value(into);
+            }
+        } else if (dataType == "<color>") {
+            into.writeUnsignedByte(TYPE_COLOR);
+            for (int i = 0; i < 4; ++i) {
+                into.writeUnsignedByte(integer());
+            }
+        } else if (dataType == "<position2D>") {
+            into.writeUnsignedByte(POSITION_2D);
+            into.writeDouble(real());
+            into.writeDouble(real());
+        } else if (dataType == "<position3D>") {
+            into.writeUnsignedByte(POSITION_3D);
+            into.writeDouble(real());
+            into.writeDouble(real());
+            into.writeDouble(real());
+        } else if (dataType == "<positionRoadmap>") {
+            into.writeUnsignedByte(POSITION_ROADMAP);
+            into.writeString(string());
+            into.writeDouble(real());
+            into.writeUnsignedByte(integer());
+        } else if (dataType == "<shape>") {
+            const int num = integer();
+            into.writeUnsignedByte(TYPE_POLYGON);
+            into.writeUnsignedByte(num);
+            for (int i = 0; i < num; ++i) {
+                into.writeDouble(real());
+                into.writeDouble(real());
+            }
+        } else {
+            error("Unknown data type '" + dataType + "'");
+        }
+    }
+
+    /// @brief Throws a ProcessError naming the script and the current line
+    void error(const std::string& msg) const {
+        throw ProcessError("Error in definition file '" + mySource + "', line " + toString(myLine) + ": " + msg + ".");
+    }
+
+private:
+    const std::string& myScript;
+    const std::string& mySource;
+    size_t myPos;
+    int myLine;
+
+private:
+    ScriptReader& operator=(const ScriptReader&);
+};
+
+}
+
+
+// ===========================================================================
+// member definitions
+// ===========================================================================
+TraCIProgram::TraCIProgram() {}
+
+
+TraCIProgram::~TraCIProgram() {}
+
+
+void
+TraCIProgram::compile(const std::string& file) {
+    std::ifstream strm(file.c_str(), std::ios::in | std::ios::binary);
+    if (!strm.good()) {
+        throw ProcessError("Can not open definition file '" + file + "'.");
+    }
+    const std::string script((std::istreambuf_iterator<char>(strm)), std::istreambuf_iterator<char>());
+    compileScript(script, file);
+}
+
+
+void
+TraCIProgram::compileScript(const std::string& script, const std::string& source) {
+    clear();
+    ScriptReader reader(script, source);
+    std::string command;
+    bool inComment = false;
+    while (reader.next(command)) {
+        if (command == "%") {
+            inComment = !inComment;
+            continue;
+        }
+        if (inComment) {
+            continue;
+        }
+        int repeat = 1;
+        if (command == "repeat") {
+            repeat = reader.integer();
+            if (repeat < 0) {
+                reader.error("Negative repeat count");
+            }
+            command = reader.string();
+        }
+        tcpip::Storage encoded;
+        if (command == "simstep2") {
+            TraCIAPI::write_commandSimulationStep(encoded, reader.time());
+            append(SIMSTEP, CMD_SIMSTEP2, repeat, encoded);
+        } else if (command == "getvariable" || command == "getvariable_plus") {
+            const int domID = reader.integer();
+            const int varID = reader.integer();
+            const std::string objID = reader.string();
+            if (command == "getvariable") {
+                TraCIAPI::write_commandGetVariable(encoded, domID, varID, objID);
+            } else {
+                tcpip::Storage add;
+                reader.value(add);
+                TraCIAPI::write_commandGetVariable(encoded, domID, varID, objID, &add);
+            }
+            append(GET_VARIABLE, domID, repeat, encoded);
+        } else if (command == "subscribevariable") {
+            const int domID = reader.integer();
+            const std::string objID = reader.string();
+            const SUMOTime beginTime = reader.time();
+            const SUMOTime endTime = reader.time();
+            const int varNo = reader.integer();
+            std::vector<int> vars;
+            for (int i = 0; i < varNo; ++i) {
+                vars.push_back(reader.integer());
+            }
+            TraCIAPI::write_commandSubscribeObjectVariable(encoded, domID, objID, (int)beginTime, (int)endTime, vars);
+            append(SUBSCRIBE, domID, repeat, encoded);
+        } else if (command == "subscribecontext") {
+            const int domID = reader.integer();
+            const std::string objID = reader.string();
+            const SUMOTime beginTime = reader.time();
+            const SUMOTime endTime = reader.time();
+            const int domain = reader.integer();
+            const SUMOReal range = (SUMOReal)reader.real();
+            const int varNo = reader.integer();
+            std::vector<int> vars;
+            for (int i = 0; i < varNo; ++i) {
+                vars.push_back(reader.integer());
+            }
+            TraCIAPI::write_commandSubscribeObjectContext(encoded, domID, objID, (int)beginTime, (int)endTime, domain, range, vars);
+            append(SUBSCRIBE, domID, repeat, encoded);
+        } else if (command == "setvalue") {
+            const int domID = reader.integer();
+            const int varID = reader.integer();
+            const std::string objID = reader.string();
+            tcpip::Storage content;
+            reader.value(content);
+            TraCIAPI::write_commandSetValue(encoded, domID, varID, objID, content);
+            append(SET_VARIABLE, domID, repeat, encoded);
+        } else {
+            reader.error("'" + command + "' is not a valid command");
+        }
+    }
+}
+
+
+bool
+TraCIProgram::load(const std::string& file) {
+    std::ifstream strm(file.c_str(), std::ios::in | std::ios::binary);
+    if (!strm.good()) {
+        return false;
+    }
+    const std::vector<unsigned char> data((std::istreambuf_iterator<char>(strm)), std::istreambuf_iterator<char>());
+    if (data.empty()) {
+        return false;
+    }
+    tcpip::Storage in(&data[0], (int)data.size());
+    clear();
+    try {
+        if (in.readString() != PROGRAM_MAGIC || in.readInt() != PROGRAM_FORMAT) {
+            return false;
+        }
+        const int codeSize = in.readInt();
+        if (codeSize < 0 || (unsigned int)codeSize > data.size()) {
+            throw std::invalid_argument("invalid code size");
+        }
+        myCode.reserve(codeSize);
+        for (int i = 0; i < codeSize; ++i) {
+            myCode.push_back(in.readChar());
+        }
+        const int numCommands = in.readInt();
+        for (int i = 0; i < numCommands; ++i) {
+            Command c;
+            const int kind = in.readUnsignedByte();
+            if (kind > SUBSCRIBE) {
+                throw std::invalid_argument("unknown command kind");
+            }
+            c.kind = (CommandKind)kind;
+            c.id = in.readUnsignedByte();
+            c.begin = (unsigned int)in.readInt();
+            c.end = (unsigned int)in.readInt();
+            c.repeat = (unsigned int)in.readInt();
+            if (c.begin > c.end || c.end > myCode.size()) {
+                throw std::invalid_argument("invalid command bounds");
+            }
+            myCommands.push_back(c);
+        }
+    } catch (std::invalid_argument&) {
+        clear();
+        return false;
+    }
+    return true;
+}
+
+
+void
+TraCIProgram::save(const std::string& file) const {
+    tcpip::Storage out;
+    out.writeString(PROGRAM_MAGIC);
+    out.writeInt(PROGRAM_FORMAT);
+    out.writeInt((int)myCode.size());
+    out.writePacket(myCode);
+    out.writeInt((int)myCommands.size());
+    for (std::vector<Command>::const_iterator i = myCommands.begin(); i != myCommands.end(); ++i) {
+        out.writeUnsignedByte(i->kind);
+        out.writeUnsignedByte(i->id);
+        out.writeInt((int)i->begin);
+        out.writeInt((int)i->end);
+        out.writeInt((int)i->repeat);
+    }
+    std::ofstream strm(file.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    const std::vector<unsigned char> data(out.begin(), out.end());
+    strm.write((const char*)&data[0], data.size());
+    strm.close();
+    if (strm.fail()) {
+        throw IOError("Could not write the program '" + file + "'.");
+    }
+}
+
+
+void
+TraCIProgram::clear() {
+    myCommands.clear();
+    myCode.clear();
+}
+
+
+unsigned int
+TraCIProgram::getNumExecutedCommands() const {
+    unsigned int result = 0;
+    for (std::vector<Command>::const_iterator i = myCommands.begin(); i != myCommands.end(); ++i) {
+        result += i->repeat;
+    }
+    return result;
+}
+
+
+void
+TraCIProgram::append(CommandKind kind, int id, unsigned int repeat, const tcpip::Storage& encoded) {
+    if (repeat == 0) {
+        return;
+    }
+    Command c;
+    c.kind = kind;
+    c.id = id;
+    c.begin = (unsigned int)myCode.size();
+    myCode.insert(myCode.end(), encoded.begin(), encoded.end());
+    c.end = (unsigned int)myCode.size();
+    c.repeat = repeat;
+    myCommands.push_back(c);
+}
+
+
+/****************************************************************************/
+
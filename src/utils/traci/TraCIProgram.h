@@ -0,0 +1,169 @@
+/****************************************************************************/
+/// @file    TraCIProgram.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// A TraCITestClient script compiled into pre-encoded TraCI commands
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef TraCIProgram_h
+#define TraCIProgram_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <string>
+#include <vector>
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+namespace tcpip {
+class Storage;
+}
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class TraCIProgram
+ * @brief A TraCITestClient script compiled into pre-encoded TraCI commands
+ *
+ * The script is parsed once (the same language TraCITestClient::run reads:
+ *  simstep2, getvariable, getvariable_plus, setvalue, subscribevariable,
+ *  subscribecontext, "repeat n" prefixes and "%" comments) and every
+ *  command is stored in its wire format together with its repeat count,
+ *  so executing the program (see TraCIProgramExecutor) only copies bytes.
+ *  Unlike the interpreter, "repeat" is honoured for all commands.
+ *
+ * Compiled programs may be saved to a binary file and loaded again.
+ */
+class TraCIProgram {
+public:
+    /// @brief The kinds of commands, telling how they are answered
+    enum CommandKind {
+        /// @brief a simulation step, answered by a status and the subscription results
+        SIMSTEP = 0,
+        /// @brief a GetVariable request, answered by a status and the value
+        GET_VARIABLE = 1,
+        /// @brief a SetVariable request, answered by a status
+        SET_VARIABLE = 2,
+        /// @brief a subscription, answered by a status and the first result
+        SUBSCRIBE = 3
+    };
+
+
+    /// @brief A compiled command
+    struct Command {
+        /// @brief The kind of the command
+        CommandKind kind;
+        /// @brief The command id (the status answering the command carries it)
+        int id;
+        /// @brief The begin of the encoded command within the code
+        unsigned int begin;
+        /// @brief The end of the encoded command within the code
+        unsigned int end;
+        /// @brief The number of times the command is executed in a row
+        unsigned int repeat;
+    };
+
+
+    /// @brief Constructor
+    TraCIProgram();
+
+
+    /// @brief Destructor
+    ~TraCIProgram();
+
+
+    /** @brief Compiles the given script, replacing the current program
+     * @param[in] file The script file
+     * @exception ProcessError If the script can not be read or is invalid
+     */
+    void compile(const std::string& file);
+
+
+    /** @brief Compiles the given script text, replacing the current program
+     * @param[in] script The script
+     * @param[in] source The name of the script for error messages
+     * @exception ProcessError If the script is invalid
+     */
+    void compileScript(const std::string& script, const std::string& source);
+
+
+    /** @brief Loads a compiled program from the given file
+     * @param[in] file The file to read
+     * @return Whether the file existed and contains a program of this format version
+     */
+    bool load(const std::string& file);
+
+
+    /** @brief Saves the compiled program to the given file
+     * @param[in] file The file to write
+     * @exception IOError if the file could not be written
+     */
+    void save(const std::string& file) const;
+
+
+    /// @brief Removes all commands
+    void clear();
+
+
+    /// @brief Returns the compiled commands in the order of execution
+    const std::vector<Command>& getCommands() const {
+        return myCommands;
+    }
+
+
+    /// @brief Returns the encoded commands (addressed by Command::begin and Command::end)
+    const std::vector<unsigned char>& getCode() const {
+        return myCode;
+    }
+
+
+    /// @brief Returns the number of commands executed by the program (including repetitions)
+    unsigned int getNumExecutedCommands() const;
+
+
+private:
+    /// @brief Appends an encoded command
+    void append(CommandKind kind, int id, unsigned int repeat, const tcpip::Storage& encoded);
+
+
+private:
+    /// @brief The commands
+    std::vector<Command> myCommands;
+
+    /// @brief The encoded commands
+    std::vector<unsigned char> myCode;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    TraCIProgram(const TraCIProgram&);
+
+    /// @brief Invalidated assignment operator.
+    TraCIProgram& operator=(const TraCIProgram&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -0,0 +1,236 @@
+/****************************************************************************/
+/// @file    TraCIProgramExecutor.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Replays compiled TraCI programs with pipelining and measures the latencies
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+#include <foreign/tcpip/storage.h>
+#include <foreign/tcpip/socket.h>
+#include <traci-server/TraCIConstants.h>
+#include <utils/common/StdDefs.h>
+#include <utils/common/SysUtils.h>
+#include <utils/common/ToString.h>
+#include "TraCIProgramExecutor.h"
+
+
+// ===========================================================================
+// member definitions
+// ===========================================================================
+TraCIProgramExecutor::TraCIProgramExecutor() {
+    myStatistics.messages = 0;
+    myStatistics.commands = 0;
+    myStatistics.errors = 0;
+    myStatistics.duration = 0;
+}
+
+
+TraCIProgramExecutor::~TraCIProgramExecutor() {}
+
+
+void
+TraCIProgramExecutor::prepare(const TraCIProgram& program, unsigned int batchSize) {
+    if (batchSize == 0) {
+        batchSize = 1;
+    }
+    myMessages.clear();
+    const std::vector<unsigned char>& code = program.getCode();
+    Message message;
+    std::vector<unsigned char> commands;
+    unsigned int inMessage = 0;
+    const std::vector<TraCIProgram::Command>& programCommands = program.getCommands();
+    for (std::vector<TraCIProgram::Command>::const_iterator i = programCommands.begin(); i != programCommands.end(); ++i) {
+        unsigned int left = i->repeat;
+        while (left > 0) {
+            const unsigned int count = MIN2(left, batchSize - inMessage);
+            for (unsigned int j = 0; j < count; ++j) {
+                commands.insert(commands.end(), code.begin() + i->begin, code.begin() + i->end);
+            }
+            Run run;
+            run.kind = i->kind;
+            run.id = i->id;
+            run.count = count;
+            message.runs.push_back(run);
+            left -= count;
+            inMessage += count;
+            if (inMessage == batchSize) {
+                finishMessage(message, commands);
+                inMessage = 0;
+            }
+        }
+    }
+    if (inMessage > 0) {
+        finishMessage(message, commands);
+    }
+}
+
+
+void
+TraCIProgramExecutor::finishMessage(Message& message, std::vector<unsigned char>& commands) {
+    // the length header as written by tcpip::Socket::sendExact
+    tcpip::Storage header;
+    header.writeInt(4 + (int)commands.size());
+    myMessages.push_back(Message());
+    Message& added = myMessages.back();
+    added.data.reserve(header.size() + commands.size());
+    added.data.insert(added.data.end(), header.begin(), header.end());
+    added.data.insert(added.data.end(), commands.begin(), commands.end());
+    added.runs.swap(message.runs);
+    commands.clear();
+}
+
+
+void
+TraCIProgramExecutor::run(unsigned int maxInFlight) {
+    if (mySocket == 0) {
+        throw tcpip::SocketException("Socket is not initialised");
+    }
+    if (maxInFlight == 0) {
+        maxInFlight = 1;
+    }
+    myStatistics.messages = 0;
+    myStatistics.commands = 0;
+    myStatistics.errors = 0;
+    myStatistics.firstError = "";
+    myStatistics.latencies.clear();
+    myStatistics.latencies.reserve(myMessages.size());
+    std::deque<SUMOLong> sendTimes;
+    const SUMOLong begin = SysUtils::getCurrentMicros();
+    size_t sent = 0;
+    for (size_t answered = 0; answered < myMessages.size(); ++answered) {
+        while (sent < myMessages.size() && sent - answered < maxInFlight) {
+            sendTimes.push_back(SysUtils::getCurrentMicros());
+            mySocket->send(myMessages[sent].data);
+            myStatistics.messages++;
+            sent++;
+        }
+        tcpip::Storage inMsg;
+        mySocket->receiveExact(inMsg);
+        myStatistics.latencies.push_back(SysUtils::getCurrentMicros() - sendTimes.front());
+        sendTimes.pop_front();
+        readAnswer(inMsg, myMessages[answered]);
+    }
+    myStatistics.duration = SysUtils::getCurrentMicros() - begin;
+}
+
+
+void
+TraCIProgramExecutor::closeSimulation() {
+    if (mySocket == 0) {
+        return;
+    }
+    send_commandClose();
+    tcpip::Storage inMsg;
+    try {
+        check_resultState(inMsg, CMD_CLOSE);
+    } catch (tcpip::SocketException&) {
+        // the simulation may already have closed the connection
+    }
+    close();
+}
+
+
+SUMOLong
+TraCIProgramExecutor::getLatencyQuantile(double q) const {
+    if (myStatistics.latencies.empty()) {
+        return 0;
+    }
+    std::vector<SUMOLong> latencies = myStatistics.latencies;
+    const size_t index = MIN2(latencies.size() - 1, (size_t)(MAX2(q, 0.) * (double)(latencies.size() - 1) + .5));
+    std::nth_element(latencies.begin(), latencies.begin() + index, latencies.end());
+    return latencies[index];
+}
+
+
+void
+TraCIProgramExecutor::readAnswer(tcpip::Storage& inMsg, const Message& message) {
+    try {
+        for (std::vector<Run>::const_iterator i = message.runs.begin(); i != message.runs.end(); ++i) {
+            for (unsigned int j = 0; j < i->count; ++j) {
+                myStatistics.commands++;
+                if (!readStatus(inMsg, i->id)) {
+                    continue;
+                }
+                switch (i->kind) {
+                    case TraCIProgram::SIMSTEP: {
+                        const int numSubscriptions = inMsg.readInt();
+                        for (int k = 0; k < numSubscriptions; ++k) {
+                            skipCommand(inMsg);
+                        }
+                        break;
+                    }
+                    case TraCIProgram::GET_VARIABLE:
+                    case TraCIProgram::SUBSCRIBE:
+                        skipCommand(inMsg);
+                        break;
+                    case TraCIProgram::SET_VARIABLE:
+                        break;
+                }
+            }
+        }
+    } catch (std::invalid_argument&) {
+        throw tcpip::SocketException("#Error: the answer is shorter than expected");
+    }
+}
+
+
+bool
+TraCIProgramExecutor::readStatus(tcpip::Storage& inMsg, int command) {
+    const unsigned int cmdStart = inMsg.position();
+    const int cmdLength = inMsg.readUnsignedByte();
+    const int cmdId = inMsg.readUnsignedByte();
+    if (cmdId != command) {
+        throw tcpip::SocketException("#Error: received status response to command: " + toString(cmdId) + " but expected: " + toString(command));
+    }
+    const int resultType = inMsg.readUnsignedByte();
+    const std::string msg = inMsg.readString();
+    if (cmdStart + cmdLength != inMsg.position()) {
+        throw tcpip::SocketException("#Error: command at position " + toString(cmdStart) + " has wrong length");
+    }
+    if (resultType != RTYPE_OK) {
+        if (myStatistics.errors == 0) {
+            myStatistics.firstError = "Command " + toString(command) + " failed: " + msg;
+        }
+        myStatistics.errors++;
+        return false;
+    }
+    return true;
+}
+
+
+void
+TraCIProgramExecutor::skipCommand(tcpip::Storage& inMsg) {
+    const unsigned int cmdStart = inMsg.position();
+    unsigned int length = inMsg.readUnsignedByte();
+    if (length == 0) {
+        length = inMsg.readInt();
+    }
+    while (inMsg.position() < cmdStart + length) {
+        inMsg.readChar();
+    }
+}
+
+
+/****************************************************************************/
+
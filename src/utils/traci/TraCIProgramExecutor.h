@@ -0,0 +1,171 @@
+/****************************************************************************/
+/// @file    TraCIProgramExecutor.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Replays compiled TraCI programs with pipelining and measures the latencies
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef TraCIProgramExecutor_h
+#define TraCIProgramExecutor_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <string>
+#include <vector>
+#include "TraCIAPI.h"
+#include "TraCIProgram.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class TraCIProgramExecutor
+ * @brief Replays compiled TraCI programs with pipelining and measures the latencies
+ *
+ * prepare() packs the program's commands (repetitions unrolled) into
+ *  complete messages of at most batchSize commands, including the length
+ *  header, so run() only writes these bytes to the socket. The simulation
+ *  answers all commands of a message within one answer message, in order.
+ *
+ * run() keeps up to maxInFlight messages sent but not yet answered, which
+ *  hides the network round trip; with maxInFlight 1 and batchSize 1 it
+ *  behaves like TraCITestClient. The answers are only checked for their
+ *  status, the values are skipped. The time from sending a message until
+ *  its answer arrived is recorded for each message.
+ *
+ * SUMO serves one client per connection, so concurrency is obtained by
+ *  batching and pipelining within the connection.
+ */
+class TraCIProgramExecutor : public TraCIAPI {
+public:
+    /// @brief The results of a run
+    struct Statistics {
+        /// @brief The number of messages sent
+        unsigned int messages;
+        /// @brief The number of commands sent
+        unsigned int commands;
+        /// @brief The number of commands answered with an error
+        unsigned int errors;
+        /// @brief The description of the first error
+        std::string firstError;
+        /// @brief The duration of the run in microseconds
+        SUMOLong duration;
+        /// @brief The round trip time of each message in microseconds
+        std::vector<SUMOLong> latencies;
+    };
+
+
+    /// @brief Constructor
+    TraCIProgramExecutor();
+
+
+    /// @brief Destructor
+    ~TraCIProgramExecutor();
+
+
+    /** @brief Packs the program's commands into messages
+     * @param[in] program The program to execute
+     * @param[in] batchSize The maximum number of commands per message
+     */
+    void prepare(const TraCIProgram& program, unsigned int batchSize = 1);
+
+
+    /** @brief Sends the prepared messages and reads the answers
+     * @param[in] maxInFlight The maximum number of messages sent but not answered
+     * @exception tcpip::SocketException if the connection fails or an answer is malformed
+     */
+    void run(unsigned int maxInFlight = 1);
+
+
+    /// @brief Sends a Close command and closes the connection
+    void closeSimulation();
+
+
+    /// @brief Returns the results of the last run
+    const Statistics& getStatistics() const {
+        return myStatistics;
+    }
+
+
+    /** @brief Returns a latency quantile of the last run
+     * @param[in] q The quantile (0 returns the minimum, 1 the maximum)
+     * @return The latency in microseconds, 0 if no message was sent
+     */
+    SUMOLong getLatencyQuantile(double q) const;
+
+
+private:
+    /// @brief A sequence of equal commands within a message
+    struct Run {
+        /// @brief The kind of the commands
+        TraCIProgram::CommandKind kind;
+        /// @brief The id of the commands
+        int id;
+        /// @brief The number of commands
+        unsigned int count;
+    };
+
+
+    /// @brief A prepared message
+    struct Message {
+        /// @brief The message as sent, including the length header
+        std::vector<unsigned char> data;
+        /// @brief The commands of the message
+        std::vector<Run> runs;
+    };
+
+
+    /// @brief Reads and checks the answer to the given message
+    void readAnswer(tcpip::Storage& inMsg, const Message& message);
+
+
+    /// @brief Reads a status response, returns whether it reports success
+    bool readStatus(tcpip::Storage& inMsg, int command);
+
+
+    /// @brief Skips a response command
+    static void skipCommand(tcpip::Storage& inMsg);
+
+
+    /// @brief Adds the header to the message being built and appends it to the prepared ones
+    void finishMessage(Message& message, std::vector<unsigned char>& commands);
+
+
+private:
+    /// @brief The prepared messages
+    std::vector<Message> myMessages;
+
+    /// @brief The results of the last run
+    Statistics myStatistics;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    TraCIProgramExecutor(const TraCIProgramExecutor&);
+
+    /// @brief Invalidated assignment operator.
+    TraCIProgramExecutor& operator=(const TraCIProgramExecutor&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
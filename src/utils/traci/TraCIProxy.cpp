@@ -0,0 +1,780 @@
+/****************************************************************************/
+/// @file    TraCIProxy.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Serves many TraCI clients over one connection to the simulation
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#ifdef WIN32
+#include <winsock2.h>
+#else
+#include <sys/select.h>
+#endif
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <foreign/tcpip/storage.h>
+#include <foreign/tcpip/socket.h>
+#include <traci-server/TraCIConstants.h>
+#include <utils/common/StdDefs.h>
+#include "TraCIReader.h"
+#include "TraCIProxy.h"
+
+
+// ===========================================================================
+// static members
+// ===========================================================================
+namespace {
+/// @brief The time between two checks for new clients (in microseconds)
+const long ACCEPT_INTERVAL = 50000;
+
+
+/// @brief Returns whether the command subscribes object variables
+bool
+isVariableSubscription(int command) {
+    return command >= CMD_SUBSCRIBE_INDUCTIONLOOP_VARIABLE && command <= CMD_SUBSCRIBE_PERSON_VARIABLE;
+}
+
+
+/// @brief Returns whether the command subscribes the variables of the objects around an object
+bool
+isContextSubscription(int command) {
+    return command >= CMD_SUBSCRIBE_INDUCTIONLOOP_CONTEXT && command <= CMD_SUBSCRIBE_PERSON_CONTEXT;
+}
+
+
+/// @brief Appends an int in network byte order
+void
+appendInt(std::vector<unsigned char>& out, int value) {
+    out.push_back((unsigned char)((value >> 24) & 0xff));
+    out.push_back((unsigned char)((value >> 16) & 0xff));
+    out.push_back((unsigned char)((value >> 8) & 0xff));
+    out.push_back((unsigned char)(value & 0xff));
+}
+
+
+/// @brief Overwrites an int in network byte order
+void
+patchInt(std::vector<unsigned char>& out, unsigned int pos, int value) {
+    out[pos] = (unsigned char)((value >> 24) & 0xff);
+    out[pos + 1] = (unsigned char)((value >> 16) & 0xff);
+    out[pos + 2] = (unsigned char)((value >> 8) & 0xff);
+    out[pos + 3] = (unsigned char)(value & 0xff);
+}
+
+
+/// @brief Appends the length of a command with the given content size
+void
+appendLength(std::vector<unsigned char>& out, unsigned int contentSize) {
+    if (contentSize + 1 <= 255) {
+        out.push_back((unsigned char)(contentSize + 1));
+    } else {
+        out.push_back(0);
+        appendInt(out, (int)contentSize + 5);
+    }
+}
+}
+
+
+// ===========================================================================
+// member definitions
+// ===========================================================================
+TraCIProxy::TraCIProxy(int port, unsigned int leader, bool synchronous)
+    : myPort(port), myLeader(leader), myAmSynchronous(synchronous), myServer(0), myNumAccepted(0),
+      myNumActivated(0), myTime(-1), myStepStatusEnd(0), myStepSucceeded(false), myAmStepping(false), myAmFinished(false) {
+    myStatistics.clients = 0;
+    myStatistics.steps = 0;
+    myStatistics.subscriptions = 0;
+    myStatistics.upstreamSubscriptions = 0;
+    myStatistics.upstreamBytes = 0;
+    myStatistics.downstreamBytes = 0;
+}
+
+
+TraCIProxy::~TraCIProxy() {
+    for (std::vector<Client*>::iterator i = myClients.begin(); i != myClients.end(); ++i) {
+        delete(*i)->socket;
+        delete *i;
+    }
+    delete myServer;
+}
+
+
+void
+TraCIProxy::run() {
+    if (mySocket == 0) {
+        throw tcpip::SocketException("Socket is not initialised");
+    }
+    if (myServer == 0) {
+        myServer = new tcpip::Socket(myPort);
+        myServer->set_blocking(false);
+    }
+    while (!myAmFinished) {
+        acceptClients();
+        // clients waiting for a step are not read until the step was made
+        fd_set readable;
+        FD_ZERO(&readable);
+        int maxSocket = -1;
+        for (std::vector<Client*>::const_iterator i = myClients.begin(); i != myClients.end(); ++i) {
+            if (!(*i)->waiting) {
+                FD_SET((*i)->socket->socket_descriptor(), &readable);
+                maxSocket = MAX2(maxSocket, (*i)->socket->socket_descriptor());
+            }
+        }
+        struct timeval timeout;
+        timeout.tv_sec = 0;
+        timeout.tv_usec = ACCEPT_INTERVAL;
+        if (select(maxSocket + 1, &readable, 0, 0, &timeout) > 0) {
+            for (size_t i = 0; i < myClients.size() && !myAmFinished; ++i) {
+                Client& client = *myClients[i];
+                if (!client.closed && !client.waiting && FD_ISSET(client.socket->socket_descriptor(), &readable)) {
+                    receive(client);
+                }
+            }
+        }
+        for (std::vector<Client*>::iterator i = myClients.begin(); i != myClients.end();) {
+            if ((*i)->closed) {
+                delete(*i)->socket;
+                delete *i;
+                i = myClients.erase(i);
+            } else {
+                ++i;
+            }
+        }
+    }
+    close();
+}
+
+
+void
+TraCIProxy::acceptClients() {
+    for (tcpip::Socket* socket = myServer->accept(true); socket != 0; socket = myServer->accept(true)) {
+        Client* client = new Client();
+        client->socket = socket;
+        client->index = ++myNumAccepted;
+        client->stepping = false;
+        client->waiting = false;
+        client->target = 0;
+        client->closed = false;
+        client->cursor = 0;
+        myClients.push_back(client);
+        myStatistics.clients++;
+    }
+}
+
+
+void
+TraCIProxy::receive(Client& client) {
+    tcpip::Storage inMsg;
+    try {
+        client.socket->receiveExact(inMsg);
+    } catch (tcpip::SocketException&) {
+        // the client left
+        remove(client);
+        return;
+    }
+    client.request.assign(inMsg.begin(), inMsg.end());
+    client.cursor = 0;
+    client.answer.assign(4, 0);
+    try {
+        process(client);
+    } catch (std::invalid_argument&) {
+        // the client sent a malformed message; failures of the simulation are thrown as tcpip::SocketException
+        remove(client);
+    }
+}
+
+
+void
+TraCIProxy::process(Client& client) {
+    // the message is flushed by a nested call if a step answered the client
+    while (client.cursor < client.request.size() && !client.waiting && !client.closed && !myAmFinished) {
+        const unsigned int size = (unsigned int)client.request.size();
+        const unsigned int begin = client.cursor;
+        TraCIReader reader(client.request, begin, size);
+        client.cursor = begin + reader.readCommandLength();
+        const int command = reader.readUnsignedByte();
+        if (command == CMD_SIMSTEP2) {
+            simulationStep(client, reader.readInt());
+        } else if (command == CMD_CLOSE) {
+            if (isLeader(client)) {
+                forward(client, begin, client.cursor);
+                myAmFinished = true;
+                flush(client);
+            } else {
+                appendStatus(client.answer, CMD_CLOSE);
+                flush(client);
+                remove(client);
+            }
+            return;
+        } else if (isVariableSubscription(command) || isContextSubscription(command)) {
+            subscribe(client, begin, client.cursor);
+        } else {
+            // forward all following commands which need no special treatment at once
+            while (client.cursor < size) {
+                TraCIReader next(client.request, client.cursor, size);
+                const unsigned int length = next.readCommandLength();
+                const int nextCommand = next.readUnsignedByte();
+                if (nextCommand == CMD_SIMSTEP2 || nextCommand == CMD_CLOSE
+                        || isVariableSubscription(nextCommand) || isContextSubscription(nextCommand)) {
+                    break;
+                }
+                client.cursor += length;
+            }
+            forward(client, begin, client.cursor);
+        }
+    }
+    if (!client.answer.empty() && client.cursor >= client.request.size() && !client.waiting && !client.closed) {
+        flush(client);
+    }
+}
+
+
+void
+TraCIProxy::flush(Client& client) {
+    patchInt(client.answer, 0, (int)client.answer.size());
+    try {
+        client.socket->send(client.answer);
+    } catch (tcpip::SocketException&) {
+        remove(client);
+    }
+    client.answer.clear();
+    client.request.clear();
+    client.cursor = 0;
+}
+
+
+void
+TraCIProxy::forward(Client& client, unsigned int begin, unsigned int end) {
+    std::vector<unsigned char> answer;
+    exchange(std::vector<unsigned char>(client.request.begin() + begin, client.request.begin() + end), answer);
+    client.answer.insert(client.answer.end(), answer.begin(), answer.end());
+}
+
+
+void
+TraCIProxy::subscribe(Client& client, unsigned int begin, unsigned int end) {
+    TraCIReader reader(client.request, begin, end);
+    reader.readCommandLength();
+    ClientSubscription part;
+    part.client = client.index;
+    const int command = reader.readUnsignedByte();
+    part.begin = reader.readInt();
+    part.end = reader.readInt();
+    const std::string objID = reader.readString();
+    int domain = -1;
+    double range = 0;
+    if (isContextSubscription(command)) {
+        domain = reader.readUnsignedByte();
+        range = reader.readDouble();
+    }
+    const int varNo = reader.readUnsignedByte();
+    for (int i = 0; i < varNo; ++i) {
+        part.vars.push_back(reader.readUnsignedByte());
+    }
+    if (reader.position() != end) {
+        throw std::invalid_argument("TraCIProxy::subscribe(): wrong command length");
+    }
+    myStatistics.subscriptions++;
+    const ObjectKey object = getObjectKey(command, domain, objID);
+    if (varNo == 0) {
+        // the simulation removes the subscriptions of all ranges
+        std::map<SubscriptionKey, Subscription>::iterator i = mySubscriptions.lower_bound(std::make_pair(object, -std::numeric_limits<double>::max()));
+        while (i != mySubscriptions.end() && i->first.first == object) {
+            if (!removeClientSubscription(i->second, client.index)) {
+                eraseSubscription(i++, true);
+            } else {
+                ++i;
+            }
+        }
+        appendStatus(client.answer, command);
+        return;
+    }
+    const SubscriptionKey key = std::make_pair(object, range);
+    std::map<SubscriptionKey, Subscription>::iterator i = mySubscriptions.find(key);
+    if (i == mySubscriptions.end()) {
+        Subscription s;
+        s.command = command;
+        s.objID = objID;
+        s.domain = domain;
+        s.range = range;
+        s.active = false;
+        s.order = 0;
+        i = mySubscriptions.insert(std::make_pair(key, s)).first;
+    }
+    Subscription& s = i->second;
+    const std::vector<ClientSubscription> previous = s.clients;
+    removeClientSubscription(s, client.index);
+    s.clients.push_back(part);
+    // the subscription is renewed even if nothing changed to obtain the current values
+    std::vector<unsigned char> answer;
+    unsigned int status = 0;
+    const bool success = subscribeMerged(s, answer, status);
+    try {
+        TraCIReader result(answer, status, (unsigned int)answer.size());
+        readStatus(result);
+        client.answer.insert(client.answer.end(), answer.begin() + status, answer.begin() + result.position());
+        if (success) {
+            std::vector<unsigned int> bounds;
+            Result decoded;
+            std::map<ObjectKey, unsigned int> seen;
+            decodeResult(result, bounds, decoded, seen);
+            decoded.subscription = &s;
+            appendResult(client.answer, answer, bounds, decoded, s.clients.back());
+        }
+    } catch (std::invalid_argument&) {
+        throw tcpip::SocketException("#Error: the answer to a subscription is malformed");
+    }
+    if (!success) {
+        s.clients = previous;
+        if (s.clients.empty()) {
+            eraseSubscription(i, false);
+        }
+    }
+}
+
+
+void
+TraCIProxy::simulationStep(Client& client, SUMOTime target) {
+    client.stepping = true;
+    if (!isLeader(client) && target != 0 && myTime >= target) {
+        appendStepResult(client);
+        return;
+    }
+    client.waiting = true;
+    client.target = target;
+    step();
+}
+
+
+void
+TraCIProxy::step() {
+    if (myAmStepping) {
+        // the clients answered by the current step may ask for the next one
+        return;
+    }
+    myAmStepping = true;
+    try {
+        while (!myAmFinished && canStep()) {
+            stepOnce();
+        }
+    } catch (...) {
+        myAmStepping = false;
+        throw;
+    }
+    myAmStepping = false;
+}
+
+
+bool
+TraCIProxy::canStep() const {
+    const Client* leader = 0;
+    for (std::vector<Client*>::const_iterator i = myClients.begin(); i != myClients.end(); ++i) {
+        if (isLeader(**i)) {
+            leader = *i;
+        } else if (myAmSynchronous && (*i)->stepping && !(*i)->waiting && !(*i)->closed) {
+            return false;
+        }
+    }
+    return leader != 0 && leader->waiting && !leader->closed;
+}
+
+
+void
+TraCIProxy::stepOnce() {
+    Client* leader = 0;
+    for (std::vector<Client*>::const_iterator i = myClients.begin(); i != myClients.end(); ++i) {
+        if (isLeader(**i)) {
+            leader = *i;
+        }
+    }
+    // the time is requested along with the step to tell when the other clients are due
+    tcpip::Storage outMsg;
+    write_commandSimulationStep(outMsg, leader->target);
+    write_commandGetVariable(outMsg, CMD_GET_SIM_VARIABLE, VAR_TIME_STEP, "");
+    exchange(std::vector<unsigned char>(outMsg.begin(), outMsg.end()), myStepAnswer);
+    myStatistics.steps++;
+    myStatistics.upstreamBytes += myStepAnswer.size() + 4;
+    myResults.clear();
+    myBounds.clear();
+    try {
+        TraCIReader reader(myStepAnswer, 0, (unsigned int)myStepAnswer.size());
+        myStepSucceeded = readStatus(reader) == RTYPE_OK;
+        myStepStatusEnd = reader.position();
+        if (myStepSucceeded) {
+            const int numResults = reader.readInt();
+            std::map<ObjectKey, unsigned int> seen;
+            for (int i = 0; i < numResults; ++i) {
+                myResults.push_back(Result());
+                decodeResult(reader, myBounds, myResults.back(), seen);
+            }
+        }
+        if (readStatus(reader) == RTYPE_OK) {
+            reader.readCommandLength();
+            reader.skip(2);
+            reader.skipString();
+            const int type = reader.readUnsignedByte();
+            myTime = type == TYPE_DOUBLE ? (SUMOTime)(reader.readDouble() * 1000. + .5) : reader.readInt();
+        }
+    } catch (std::invalid_argument&) {
+        throw tcpip::SocketException("#Error: the answer to the simulation step is malformed");
+    }
+    // end the parts whose time window is over
+    for (std::map<SubscriptionKey, Subscription>::iterator i = mySubscriptions.begin(); i != mySubscriptions.end();) {
+        std::vector<ClientSubscription>& parts = i->second.clients;
+        for (std::vector<ClientSubscription>::iterator j = parts.begin(); j != parts.end();) {
+            j = j->end < myTime ? parts.erase(j) : j + 1;
+        }
+        if (parts.empty()) {
+            eraseSubscription(i++, true);
+        } else {
+            ++i;
+        }
+    }
+    // collect the clients first, the ones answered may wait for the next step again
+    std::vector<Client*> due;
+    for (std::vector<Client*>::const_iterator i = myClients.begin(); i != myClients.end(); ++i) {
+        Client& client = **i;
+        if (client.waiting && !client.closed && (isLeader(client) || client.target == 0 || client.target <= myTime)) {
+            due.push_back(&client);
+        }
+    }
+    for (std::vector<Client*>::const_iterator i = due.begin(); i != due.end(); ++i) {
+        appendStepResult(**i);
+        (*i)->waiting = false;
+        process(**i);
+    }
+}
+
+
+void
+TraCIProxy::appendStepResult(Client& client) {
+    std::vector<unsigned char>& out = client.answer;
+    const size_t before = out.size();
+    out.insert(out.end(), myStepAnswer.begin(), myStepAnswer.begin() + myStepStatusEnd);
+    if (myStepSucceeded) {
+        const unsigned int countPos = (unsigned int)out.size();
+        appendInt(out, 0);
+        int count = 0;
+        for (std::vector<Result>::const_iterator i = myResults.begin(); i != myResults.end(); ++i) {
+            if (i->subscription == 0) {
+                continue;
+            }
+            const std::vector<ClientSubscription>& parts = i->subscription->clients;
+            for (std::vector<ClientSubscription>::const_iterator j = parts.begin(); j != parts.end(); ++j) {
+                if (j->client == client.index && j->begin <= myTime && myTime <= j->end) {
+                    appendResult(out, myStepAnswer, myBounds, *i, *j);
+                    count++;
+                }
+            }
+        }
+        patchInt(out, countPos, count);
+    }
+    myStatistics.downstreamBytes += out.size() - before;
+}
+
+
+void
+TraCIProxy::remove(Client& client) {
+    client.closed = true;
+    client.waiting = false;
+    for (std::map<SubscriptionKey, Subscription>::iterator i = mySubscriptions.begin(); i != mySubscriptions.end();) {
+        if (!removeClientSubscription(i->second, client.index)) {
+            eraseSubscription(i++, !myAmFinished);
+        } else {
+            ++i;
+        }
+    }
+    client.socket->close();
+    if (isLeader(client) && !myAmFinished) {
+        // the leader left without closing the simulation
+        myAmFinished = true;
+        tcpip::Storage outMsg;
+        write_commandClose(outMsg);
+        std::vector<unsigned char> answer;
+        exchange(std::vector<unsigned char>(outMsg.begin(), outMsg.end()), answer);
+    } else if (myAmSynchronous) {
+        // the leader may have waited for this client
+        step();
+    }
+}
+
+
+bool
+TraCIProxy::subscribeMerged(Subscription& s, std::vector<unsigned char>& answer, unsigned int& status) {
+    // the variables of all parts in the order of their first request
+    std::vector<int> vars = s.active ? s.vars : std::vector<int>();
+    for (std::vector<ClientSubscription>::const_iterator i = s.clients.begin(); i != s.clients.end(); ++i) {
+        for (std::vector<int>::const_iterator j = i->vars.begin(); j != i->vars.end(); ++j) {
+            if (std::find(vars.begin(), vars.end(), *j) == vars.end()) {
+                vars.push_back(*j);
+            }
+        }
+    }
+    tcpip::Storage outMsg;
+    writeSubscription(outMsg, s, s.range, vars);
+    exchange(std::vector<unsigned char>(outMsg.begin(), outMsg.end()), answer);
+    myStatistics.upstreamSubscriptions++;
+    try {
+        TraCIReader reader(answer, 0, (unsigned int)answer.size());
+        status = reader.position();
+        if (readStatus(reader) == RTYPE_OK) {
+            if (!s.active) {
+                // a new range is appended behind the ones the simulation holds
+                s.order = myNumActivated++;
+            }
+            s.vars = vars;
+            s.active = true;
+            updateSelections(s);
+            return true;
+        }
+    } catch (std::invalid_argument&) {
+        throw tcpip::SocketException("#Error: the answer to a subscription is malformed");
+    }
+    return false;
+}
+
+
+bool
+TraCIProxy::removeClientSubscription(Subscription& s, unsigned int client) {
+    for (std::vector<ClientSubscription>::iterator i = s.clients.begin(); i != s.clients.end(); ++i) {
+        if (i->client == client) {
+            s.clients.erase(i);
+            break;
+        }
+    }
+    return !s.clients.empty();
+}
+
+
+void
+TraCIProxy::eraseSubscription(std::map<SubscriptionKey, Subscription>::iterator i, bool unsubscribe) {
+    const ObjectKey object = i->first.first;
+    const bool active = i->second.active;
+    if (unsubscribe && active) {
+        tcpip::Storage outMsg;
+        writeSubscription(outMsg, i->second, i->second.range, std::vector<int>());
+        std::vector<unsigned char> answer;
+        exchange(std::vector<unsigned char>(outMsg.begin(), outMsg.end()), answer);
+        myStatistics.upstreamSubscriptions++;
+    }
+    for (std::vector<Result>::iterator j = myResults.begin(); j != myResults.end(); ++j) {
+        if (j->subscription == &i->second) {
+            j->subscription = 0;
+        }
+    }
+    mySubscriptions.erase(i);
+    if (unsubscribe && active && isContextSubscription(object.first / 256)) {
+        // the other ranges are subscribed anew, keeping their order
+        const std::vector<Subscription*> others = getActiveSubscriptions(object);
+        if (!others.empty()) {
+            tcpip::Storage outMsg;
+            for (std::vector<Subscription*>::const_iterator j = others.begin(); j != others.end(); ++j) {
+                writeSubscription(outMsg, **j, (*j)->range, (*j)->vars);
+                (*j)->order = myNumActivated++;
+            }
+            std::vector<unsigned char> answer;
+            exchange(std::vector<unsigned char>(outMsg.begin(), outMsg.end()), answer);
+            myStatistics.upstreamSubscriptions += (unsigned int)others.size();
+        }
+    }
+}
+
+
+std::vector<TraCIProxy::Subscription*>
+TraCIProxy::getActiveSubscriptions(const ObjectKey& object) {
+    std::vector<std::pair<unsigned int, Subscription*> > ordered;
+    std::map<SubscriptionKey, Subscription>::iterator i = mySubscriptions.lower_bound(std::make_pair(object, -std::numeric_limits<double>::max()));
+    for (; i != mySubscriptions.end() && i->first.first == object; ++i) {
+        if (i->second.active) {
+            ordered.push_back(std::make_pair(i->second.order, &i->second));
+        }
+    }
+    std::sort(ordered.begin(), ordered.end());
+    std::vector<Subscription*> result;
+    for (std::vector<std::pair<unsigned int, Subscription*> >::const_iterator j = ordered.begin(); j != ordered.end(); ++j) {
+        result.push_back(j->second);
+    }
+    return result;
+}
+
+
+TraCIProxy::Subscription*
+TraCIProxy::findActiveSubscription(const ObjectKey& object, unsigned int index) {
+    // an object is rarely subscribed with more than one range, so the ranges are just counted
+    const std::map<SubscriptionKey, Subscription>::iterator begin = mySubscriptions.lower_bound(std::make_pair(object, -std::numeric_limits<double>::max()));
+    for (std::map<SubscriptionKey, Subscription>::iterator i = begin; i != mySubscriptions.end() && i->first.first == object; ++i) {
+        if (!i->second.active) {
+            continue;
+        }
+        unsigned int before = 0;
+        for (std::map<SubscriptionKey, Subscription>::iterator j = begin; j != mySubscriptions.end() && j->first.first == object; ++j) {
+            if (j->second.active && j->second.order < i->second.order) {
+                before++;
+            }
+        }
+        if (before == index) {
+            return &i->second;
+        }
+    }
+    return 0;
+}
+
+
+void
+TraCIProxy::decodeResult(TraCIReader& reader, std::vector<unsigned int>& bounds, Result& result,
+                         std::map<ObjectKey, unsigned int>& seen) {
+    result.begin = reader.position();
+    result.end = result.begin + reader.readCommandLength();
+    result.head = reader.position();
+    // the response id is the subscription command's one plus 0x10
+    const int command = reader.readUnsignedByte() - 0x10;
+    const std::string objID = reader.readString();
+    const bool context = isContextSubscription(command);
+    const int domain = context ? reader.readUnsignedByte() : -1;
+    result.varCount = reader.position();
+    result.numVars = reader.readUnsignedByte();
+    result.numObjects = context ? (unsigned int)reader.readInt() : 1;
+    result.bounds = (unsigned int)bounds.size();
+    // per object the begin of its id followed by the begins of its values and their end
+    for (unsigned int i = 0; i < result.numObjects; ++i) {
+        bounds.push_back(reader.position());
+        if (context) {
+            reader.skipString();
+        }
+        for (unsigned int j = 0; j < result.numVars; ++j) {
+            bounds.push_back(reader.position());
+            reader.skip(2);
+            reader.skipValue(reader.readUnsignedByte());
+        }
+        bounds.push_back(reader.position());
+    }
+    if (reader.position() != result.end) {
+        throw std::invalid_argument("TraCIProxy::decodeResult(): wrong result length");
+    }
+    // the results of the object's ranges come in the order the simulation holds them
+    const ObjectKey object = getObjectKey(command, domain, objID);
+    result.subscription = findActiveSubscription(object, seen[object]++);
+}
+
+
+void
+TraCIProxy::exchange(const std::vector<unsigned char>& commands, std::vector<unsigned char>& answer) {
+    std::vector<unsigned char> outMsg;
+    outMsg.reserve(commands.size() + 4);
+    appendInt(outMsg, (int)commands.size() + 4);
+    outMsg.insert(outMsg.end(), commands.begin(), commands.end());
+    mySocket->send(outMsg);
+    tcpip::Storage inMsg;
+    mySocket->receiveExact(inMsg);
+    answer.assign(inMsg.begin(), inMsg.end());
+}
+
+
+void
+TraCIProxy::updateSelections(Subscription& s) {
+    for (std::vector<ClientSubscription>::iterator i = s.clients.begin(); i != s.clients.end(); ++i) {
+        i->identical = i->vars == s.vars;
+        i->selection.clear();
+        for (std::vector<int>::const_iterator j = i->vars.begin(); j != i->vars.end(); ++j) {
+            i->selection.push_back((unsigned int)(std::find(s.vars.begin(), s.vars.end(), *j) - s.vars.begin()));
+        }
+    }
+}
+
+
+void
+TraCIProxy::appendResult(std::vector<unsigned char>& out, const std::vector<unsigned char>& data,
+                         const std::vector<unsigned int>& bounds, const Result& result, const ClientSubscription& part) {
+    if (part.identical || result.numVars != result.subscription->vars.size()) {
+        out.insert(out.end(), data.begin() + result.begin, data.begin() + result.end);
+        return;
+    }
+    const bool context = result.subscription->domain >= 0;
+    const unsigned int stride = result.numVars + 2;
+    // response id, object id (and domain), variable count (and object count)
+    unsigned int size = result.varCount - result.head + 1 + (context ? 4 : 0);
+    for (unsigned int i = 0; i < result.numObjects; ++i) {
+        const unsigned int* const object = &bounds[result.bounds + i * stride];
+        size += object[1] - object[0];
+        for (std::vector<unsigned int>::const_iterator j = part.selection.begin(); j != part.selection.end(); ++j) {
+            size += object[*j + 2] - object[*j + 1];
+        }
+    }
+    appendLength(out, size);
+    out.insert(out.end(), data.begin() + result.head, data.begin() + result.varCount);
+    out.push_back((unsigned char)part.selection.size());
+    if (context) {
+        appendInt(out, (int)result.numObjects);
+    }
+    for (unsigned int i = 0; i < result.numObjects; ++i) {
+        const unsigned int* const object = &bounds[result.bounds + i * stride];
+        out.insert(out.end(), data.begin() + object[0], data.begin() + object[1]);
+        for (std::vector<unsigned int>::const_iterator j = part.selection.begin(); j != part.selection.end(); ++j) {
+            out.insert(out.end(), data.begin() + object[*j + 1], data.begin() + object[*j + 2]);
+        }
+    }
+}
+
+
+void
+TraCIProxy::writeSubscription(tcpip::Storage& outMsg, const Subscription& s, double range, const std::vector<int>& vars) {
+    const int endTime = std::numeric_limits<int>::max();
+    if (s.domain < 0) {
+        write_commandSubscribeObjectVariable(outMsg, s.command, s.objID, 0, endTime, vars);
+    } else {
+        write_commandSubscribeObjectContext(outMsg, s.command, s.objID, 0, endTime, s.domain, range, vars);
+    }
+}
+
+
+int
+TraCIProxy::readStatus(TraCIReader& reader) {
+    const unsigned int begin = reader.position();
+    const unsigned int length = reader.readCommandLength();
+    reader.readUnsignedByte();
+    const int resultType = reader.readUnsignedByte();
+    reader.skipString();
+    if (reader.position() != begin + length) {
+        throw std::invalid_argument("TraCIProxy::readStatus(): wrong status length");
+    }
+    return resultType;
+}
+
+
+void
+TraCIProxy::appendStatus(std::vector<unsigned char>& out, int command) {
+    out.push_back(7);
+    out.push_back((unsigned char)command);
+    out.push_back(RTYPE_OK);
+    appendInt(out, 0);
+}
+
+
+TraCIProxy::ObjectKey
+TraCIProxy::getObjectKey(int command, int domain, const std::string& objID) {
+    return std::make_pair(command * 256 + MAX2(domain, 0), objID);
+}
+
+
+/****************************************************************************/
+
@@ -0,0 +1,367 @@
+/****************************************************************************/
+/// @file    TraCIProxy.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Serves many TraCI clients over one connection to the simulation
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef TraCIProxy_h
+#define TraCIProxy_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "TraCIAPI.h"
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class TraCIReader;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class TraCIProxy
+ * @brief Serves many TraCI clients over one connection to the simulation
+ *
+ * The proxy holds the only connection to the simulation and accepts any
+ *  number of clients on its own port. Requests are answered as if the
+ *  clients talked to the simulation directly, with these differences:
+ *
+ * - Subscriptions of different clients to the same object (and the same
+ *  context domain and range) are merged into one subscription of the
+ *  simulation which covers the union of the variables for all times; the
+ *  clients' time windows are applied by the proxy. The simulation's
+ *  subscription only grows until the last client subscribed to the object
+ *  unsubscribes, leaves or its window ends.
+ * - Context subscriptions to the same object and domain with different
+ *  ranges stay apart, so no client receives objects beyond its range. The
+ *  simulation does not tell their results apart, so they are matched by
+ *  the order the simulation holds them in; unsubscribing removes all ranges
+ *  of a client at once, as the simulation does.
+ * - Only the leader (the client connecting as the leader-th one) advances
+ *  the simulation. The answer to its SimulationStep is decoded once and
+ *  each waiting client receives its own subscription results, copied
+ *  verbatim if the client subscribed the same variables as the merged
+ *  subscription and re-assembled from the decoded values otherwise.
+ * - A SimulationStep of another client waits until the simulation reached
+ *  the requested time (or made the next step when asked for time 0). In
+ *  synchronous mode the leader's steps additionally wait until every
+ *  other client which ever stepped waits for a step, so no client misses
+ *  a step.
+ * - The Close command of the leader closes the simulation and stops the
+ *  proxy, the one of another client only closes its connection.
+ *
+ * All other commands are forwarded unchanged, consecutive ones within one
+ *  message together.
+ */
+class TraCIProxy : public TraCIAPI {
+public:
+    /// @brief The traffic of a run
+    struct Statistics {
+        /// @brief The number of clients served
+        unsigned int clients;
+        /// @brief The number of simulation steps
+        unsigned int steps;
+        /// @brief The number of subscriptions requested by the clients
+        unsigned int subscriptions;
+        /// @brief The number of subscription requests forwarded to the simulation
+        unsigned int upstreamSubscriptions;
+        /// @brief The number of bytes of step answers received from the simulation
+        SUMOLong upstreamBytes;
+        /// @brief The number of bytes of step answers sent to the clients
+        SUMOLong downstreamBytes;
+    };
+
+
+    /** @brief Constructor
+     * @param[in] port The port to accept the clients on
+     * @param[in] leader The number of the client which controls the steps (1 for the first connecting one)
+     * @param[in] synchronous Whether the leader's steps wait for all stepping clients
+     */
+    TraCIProxy(int port, unsigned int leader = 1, bool synchronous = false);
+
+
+    /// @brief Destructor
+    ~TraCIProxy();
+
+
+    /** @brief Serves the clients until the leader closed the simulation or left
+     *
+     * The connection to the simulation has to be established using connect() before.
+     *
+     * @exception tcpip::SocketException if the connection to the simulation fails
+     */
+    void run();
+
+
+    /// @brief Returns the traffic of the last run
+    const Statistics& getStatistics() const {
+        return myStatistics;
+    }
+
+
+private:
+    /// @brief A client's part of a merged subscription
+    struct ClientSubscription {
+        /// @brief The number of the client
+        unsigned int client;
+        /// @brief The time window requested by the client
+        int begin, end;
+        /// @brief The variables requested by the client
+        std::vector<int> vars;
+        /// @brief The index of each requested variable within the merged ones
+        std::vector<unsigned int> selection;
+        /// @brief Whether the client requested exactly the merged variables
+        bool identical;
+    };
+
+
+    /// @brief A subscription of the simulation, merged from the clients' ones
+    struct Subscription {
+        /// @brief The subscription command
+        int command;
+        /// @brief The subscribed object
+        std::string objID;
+        /// @brief The context domain (-1 for a variable subscription)
+        int domain;
+        /// @brief The context range (0 for a variable subscription)
+        double range;
+        /// @brief The variables subscribed at the simulation
+        std::vector<int> vars;
+        /// @brief Whether the simulation holds the subscription
+        bool active;
+        /// @brief When the simulation took the subscription, orders the ones to the same object
+        unsigned int order;
+        /// @brief The clients' parts
+        std::vector<ClientSubscription> clients;
+    };
+
+
+    /// @brief Identifies the subscribed object by command and context domain, and its id
+    typedef std::pair<int, std::string> ObjectKey;
+
+    /// @brief Subscriptions are identified by the object and the context range
+    typedef std::pair<ObjectKey, double> SubscriptionKey;
+
+
+    /// @brief A decoded subscription result, in positions within the answer it was read from
+    struct Result {
+        /// @brief The subscription the result belongs to (0 if none)
+        Subscription* subscription;
+        /// @brief The begin and end of the result
+        unsigned int begin, end;
+        /// @brief The position of the response id
+        unsigned int head;
+        /// @brief The position of the variable count
+        unsigned int varCount;
+        /// @brief The number of variables per object
+        unsigned int numVars;
+        /// @brief The number of objects (1 for a variable subscription)
+        unsigned int numObjects;
+        /// @brief The index of the result's first object bound
+        unsigned int bounds;
+    };
+
+
+    /// @brief A connected client
+    struct Client {
+        /// @brief The connection
+        tcpip::Socket* socket;
+        /// @brief The number of the client (in the order of connection)
+        unsigned int index;
+        /// @brief Whether the client ever asked for a step
+        bool stepping;
+        /// @brief Whether the client waits for a step
+        bool waiting;
+        /// @brief The time the client waits for (0 for the next step)
+        SUMOTime target;
+        /// @brief Whether the client closed its connection
+        bool closed;
+        /// @brief The message being processed
+        std::vector<unsigned char> request;
+        /// @brief The position of the next command to process
+        unsigned int cursor;
+        /// @brief The answer being assembled, starting with room for the length
+        std::vector<unsigned char> answer;
+    };
+
+
+    /// @brief Accepts pending connections
+    void acceptClients();
+
+    /// @brief Reads the next message of the client
+    void receive(Client& client);
+
+    /// @brief Processes the client's commands until the message is done or a step is awaited
+    void process(Client& client);
+
+    /// @brief Sends the assembled answer to the client
+    void flush(Client& client);
+
+    /// @brief Forwards the given commands of the client's message to the simulation and appends the answer
+    void forward(Client& client, unsigned int begin, unsigned int end);
+
+    /// @brief Handles a subscription command of the client
+    void subscribe(Client& client, unsigned int begin, unsigned int end);
+
+    /// @brief Handles a simulation step command of the client
+    void simulationStep(Client& client, SUMOTime target);
+
+    /// @brief Makes simulation steps as long as the leader and, if synchronous, all others wait
+    void step();
+
+    /// @brief Returns whether the leader waits for a step which may be made now
+    bool canStep() const;
+
+    /// @brief Makes one simulation step and answers the clients waiting for it
+    void stepOnce();
+
+    /// @brief Appends the answer to the last simulation step to the client's answer
+    void appendStepResult(Client& client);
+
+    /// @brief Removes the client's subscriptions and closes its connection
+    void remove(Client& client);
+
+    /// @brief Subscribes the union of the parts' variables at the simulation
+    bool subscribeMerged(Subscription& s, std::vector<unsigned char>& answer, unsigned int& status);
+
+    /// @brief Removes a client's part of the subscription, returns whether parts remain
+    static bool removeClientSubscription(Subscription& s, unsigned int client);
+
+    /** @brief Removes a subscription, unsubscribing it at the simulation if wished
+     *
+     * As unsubscribing removes the other ranges of the object at the simulation,
+     *  these are subscribed anew.
+     */
+    void eraseSubscription(std::map<SubscriptionKey, Subscription>::iterator i, bool unsubscribe);
+
+    /// @brief Returns the active subscriptions to the object in the order the simulation holds them
+    std::vector<Subscription*> getActiveSubscriptions(const ObjectKey& object);
+
+    /// @brief Returns the index-th active subscription to the object in that order (0 if there is none)
+    Subscription* findActiveSubscription(const ObjectKey& object, unsigned int index);
+
+    /** @brief Decodes a subscription result, appending the positions of its parts to bounds
+     * @param[in, out] seen The number of results decoded so far per object (to tell the ranges apart)
+     */
+    void decodeResult(TraCIReader& reader, std::vector<unsigned int>& bounds, Result& result,
+                      std::map<ObjectKey, unsigned int>& seen);
+
+    /// @brief Sends the given commands to the simulation and reads the answer
+    void exchange(const std::vector<unsigned char>& commands, std::vector<unsigned char>& answer);
+
+    /// @brief Returns whether the client is the leader
+    bool isLeader(const Client& client) const {
+        return client.index == myLeader;
+    }
+
+
+    /// @brief Computes which of the subscribed variables each part gets
+    static void updateSelections(Subscription& s);
+
+    /// @brief Appends a client's part of the result
+    static void appendResult(std::vector<unsigned char>& out, const std::vector<unsigned char>& data,
+                             const std::vector<unsigned int>& bounds, const Result& result, const ClientSubscription& part);
+
+    /// @brief Appends a subscription command for the given variables (none to unsubscribe)
+    static void writeSubscription(tcpip::Storage& outMsg, const Subscription& s, double range, const std::vector<int>& vars);
+
+    /// @brief Reads a status response and returns its result type
+    static int readStatus(TraCIReader& reader);
+
+    /// @brief Appends a successful status response
+    static void appendStatus(std::vector<unsigned char>& out, int command);
+
+    /// @brief Returns the key of the subscribed object
+    static ObjectKey getObjectKey(int command, int domain, const std::string& objID);
+
+
+private:
+    /// @brief The port to accept clients on
+    const int myPort;
+
+    /// @brief The number of the leading client
+    const unsigned int myLeader;
+
+    /// @brief Whether the leader's steps wait for all stepping clients
+    const bool myAmSynchronous;
+
+    /// @brief The socket accepting the clients
+    tcpip::Socket* myServer;
+
+    /// @brief The connected clients
+    std::vector<Client*> myClients;
+
+    /// @brief The number of clients accepted so far
+    unsigned int myNumAccepted;
+
+    /// @brief The merged subscriptions
+    std::map<SubscriptionKey, Subscription> mySubscriptions;
+
+    /// @brief The number of subscriptions taken by the simulation so far
+    unsigned int myNumActivated;
+
+    /// @brief The simulation time after the last step (-1 before the first one)
+    SUMOTime myTime;
+
+    /// @brief The answer to the last step
+    std::vector<unsigned char> myStepAnswer;
+
+    /// @brief The end of the step's status within the last step answer
+    unsigned int myStepStatusEnd;
+
+    /// @brief Whether the last step succeeded
+    bool myStepSucceeded;
+
+    /// @brief The decoded subscription results of the last step
+    std::vector<Result> myResults;
+
+    /// @brief The positions of object ids and variable values of the decoded results
+    std::vector<unsigned int> myBounds;
+
+    /// @brief Whether a step is being made
+    bool myAmStepping;
+
+    /// @brief Whether the simulation was closed
+    bool myAmFinished;
+
+    /// @brief The traffic of the run
+    Statistics myStatistics;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    TraCIProxy(const TraCIProxy&);
+
+    /// @brief Invalidated assignment operator.
+    TraCIProxy& operator=(const TraCIProxy&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -0,0 +1,221 @@
+/****************************************************************************/
+/// @file    TraCIReader.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Reads TraCI messages in place, without copying them into a tcpip::Storage
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef TraCIReader_h
+#define TraCIReader_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <foreign/tcpip/storage.h>
+#include <traci-server/TraCIConstants.h>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class TraCIReader
+ * @brief Reads TraCI messages in place, without copying them into a tcpip::Storage
+ *
+ * Works on the raw bytes of a message so that its parts can be compared
+ *  or copied by their positions, and values can be skipped without
+ *  decoding them. Reading beyond the end throws std::invalid_argument as
+ *  tcpip::Storage does.
+ */
+class TraCIReader {
+public:
+    /** @brief Constructor
+     * @param[in] data The message
+     * @param[in] pos The position to start reading at
+     * @param[in] end The end of the readable part
+     */
+    TraCIReader(const unsigned char* data, unsigned int pos, unsigned int end)
+        : myData(data), myPos(pos), myEnd(end) {}
+
+
+    /// @brief Constructor reading from a vector
+    TraCIReader(const std::vector<unsigned char>& data, unsigned int pos, unsigned int end)
+        : myData(data.empty() ? 0 : &data[0]), myPos(pos), myEnd(end) {}
+
+
+    /// @brief Returns the message
+    const unsigned char* getData() const {
+        return myData;
+    }
+
+
+    /// @brief Returns the read position
+    unsigned int position() const {
+        return myPos;
+    }
+
+
+    /// @brief Skips the given number of bytes
+    void skip(unsigned int num) {
+        if (num > myEnd - myPos) {
+            throw std::invalid_argument("TraCIReader::skip(): invalid position");
+        }
+        myPos += num;
+    }
+
+
+    int readUnsignedByte() {
+        skip(1);
+        return myData[myPos - 1];
+    }
+
+
+    int readInt() {
+        skip(4);
+        const unsigned char* const p = myData + myPos - 4;
+        return (int)(((unsigned int)p[0] << 24) | ((unsigned int)p[1] << 16) | ((unsigned int)p[2] << 8) | (unsigned int)p[3]);
+    }
+
+
+    double readDouble() {
+        skip(8);
+        tcpip::Storage value(myData + myPos - 8, 8);
+        return value.readDouble();
+    }
+
+
+    std::string readString() {
+        const unsigned int length = readLength();
+        skip(length);
+        return std::string((const char*)myData + myPos - length, length);
+    }
+
+
+    void skipString() {
+        skip(readLength());
+    }
+
+
+    /// @brief Reads a non-negative int as used for string and list lengths
+    unsigned int readLength() {
+        const int length = readInt();
+        if (length < 0) {
+            throw std::invalid_argument("TraCIReader::readLength(): negative length");
+        }
+        return (unsigned int)length;
+    }
+
+
+    /// @brief Reads a command length (one byte or zero followed by an int) and returns it
+    unsigned int readCommandLength() {
+        const unsigned int begin = myPos;
+        unsigned int length = readUnsignedByte();
+        if (length == 0) {
+            length = readLength();
+        }
+        if (length <= myPos - begin || length > myEnd - begin) {
+            throw std::invalid_argument("TraCIReader::readCommandLength(): invalid length");
+        }
+        return length;
+    }
+
+
+    /// @brief Skips a value of the given type
+    void skipValue(int type) {
+        switch (type) {
+            case TYPE_UBYTE:
+            case TYPE_BYTE:
+                skip(1);
+                break;
+            case TYPE_INTEGER:
+            case TYPE_FLOAT:
+            case TYPE_COLOR:
+                skip(4);
+                break;
+            case TYPE_DOUBLE:
+                skip(8);
+                break;
+            case TYPE_STRING:
+                skipString();
+                break;
+            case POSITION_LON_LAT:
+            case POSITION_2D:
+                skip(16);
+                break;
+            case POSITION_LON_LAT_ALT:
+            case POSITION_3D:
+                skip(24);
+                break;
+            case POSITION_ROADMAP:
+                skipString();
+                skip(9);
+                break;
+            case TYPE_BOUNDINGBOX:
+                skip(32);
+                break;
+            case TYPE_POLYGON:
+                skip(16 * readUnsignedByte());
+                break;
+            case TYPE_TLPHASELIST: {
+                const int num = readUnsignedByte();
+                for (int i = 0; i < num; ++i) {
+                    skipString();
+                    skipString();
+                    skip(1);
+                }
+                break;
+            }
+            case TYPE_STRINGLIST: {
+                const unsigned int num = readLength();
+                for (unsigned int i = 0; i < num; ++i) {
+                    skipString();
+                }
+                break;
+            }
+            case TYPE_COMPOUND: {
+                const unsigned int num = readLength();
+                for (unsigned int i = 0; i < num; ++i) {
+                    skipValue(readUnsignedByte());
+                }
+                break;
+            }
+            default:
+                throw std::invalid_argument("TraCIReader::skipValue(): unknown type");
+        }
+    }
+
+
+private:
+    /// @brief The message
+    const unsigned char* myData;
+
+    /// @brief The read position
+    unsigned int myPos;
+
+    /// @brief The end of the readable part
+    const unsigned int myEnd;
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
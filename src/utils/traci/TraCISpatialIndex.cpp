@@ -0,0 +1,291 @@
+/****************************************************************************/
+/// @file    TraCISpatialIndex.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// A client side spatial index over objects retrieved via TraCI
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <cmath>
+#include <algorithm>
+#include <traci-server/TraCIConstants.h>
+#include <utils/common/StdDefs.h>
+#include "TraCISpatialIndex.h"
+
+
+// ===========================================================================
+// member definitions
+// ===========================================================================
+TraCISpatialIndex::TraCISpatialIndex(TraCIAPI& api)
+    : myAPI(api) {}
+
+
+TraCISpatialIndex::~TraCISpatialIndex() {}
+
+
+void
+TraCISpatialIndex::loadJunctions() {
+    loadPoints(OBJECT_JUNCTION, CMD_GET_JUNCTION_VARIABLE, myAPI.junction.getIDList());
+}
+
+
+void
+TraCISpatialIndex::loadPOIs() {
+    loadPoints(OBJECT_POI, CMD_GET_POI_VARIABLE, myAPI.poi.getIDList());
+}
+
+
+void
+TraCISpatialIndex::loadLanes() {
+    Layer& layer = myLayers[OBJECT_LANE];
+    clear(layer);
+    const std::vector<std::string> ids = myAPI.lane.getIDList();
+    for (std::vector<std::string>::const_iterator i = ids.begin(); i != ids.end(); ++i) {
+        const TraCIAPI::TraCIPositionVector shape = myAPI.lane.getShape(*i);
+        if (shape.empty()) {
+            continue;
+        }
+        PackedRTree<unsigned int>::Box box = pointBox(shape[0].x, shape[0].y);
+        for (TraCIAPI::TraCIPositionVector::const_iterator p = shape.begin() + 1; p != shape.end(); ++p) {
+            box.add(pointBox(p->x, p->y));
+        }
+        add(layer, *i, box);
+        layer.shapes.push_back(shape);
+    }
+    layer.tree.pack();
+}
+
+
+void
+TraCISpatialIndex::loadInductionLoops() {
+    Layer& layer = myLayers[OBJECT_INDUCTIONLOOP];
+    clear(layer);
+    const Layer& lanes = myLayers[OBJECT_LANE];
+    const std::vector<std::string> ids = myAPI.inductionloop.getIDList();
+    for (std::vector<std::string>::const_iterator i = ids.begin(); i != ids.end(); ++i) {
+        const std::string laneID = myAPI.inductionloop.getLaneID(*i);
+        const SUMOReal pos = myAPI.inductionloop.getPosition(*i);
+        const unsigned int* const lane = lanes.index.find(laneID);
+        const TraCIAPI::TraCIPosition p = positionAtOffset(
+                                              lane != 0 ? lanes.shapes[*lane] : myAPI.lane.getShape(laneID), pos);
+        add(layer, *i, pointBox(p.x, p.y));
+    }
+    layer.tree.pack();
+}
+
+
+void
+TraCISpatialIndex::updateVehicles() {
+    Layer& layer = myLayers[OBJECT_VEHICLE];
+    const std::vector<std::string> ids = myAPI.getStringVector(CMD_GET_VEHICLE_VARIABLE, ID_LIST, "");
+    std::vector<bool> seen(layer.ids.size(), false);
+    for (std::vector<std::string>::const_iterator i = ids.begin(); i != ids.end(); ++i) {
+        const TraCIAPI::TraCIPosition p = myAPI.getPosition(CMD_GET_VEHICLE_VARIABLE, VAR_POSITION, *i);
+        const PackedRTree<unsigned int>::Box box = pointBox(p.x, p.y);
+        const unsigned int* const known = layer.index.find(*i);
+        if (known == 0) {
+            add(layer, *i, box);
+            seen.resize(layer.ids.size(), false);
+            seen[*layer.index.find(*i)] = true;
+            continue;
+        }
+        const unsigned int k = *known;
+        seen[k] = true;
+        PackedRTree<unsigned int>::Box& old = layer.boxes[k];
+        if (old.min[0] != box.min[0] || old.min[1] != box.min[1]) {
+            layer.tree.remove(old.min, old.max, k);
+            layer.tree.insert(box.min, box.max, k);
+            old = box;
+        }
+    }
+    // remove the vehicles which left the network
+    for (unsigned int k = 0; k < (unsigned int)seen.size(); ++k) {
+        if (!seen[k] && !layer.ids[k].empty()) {
+            layer.tree.remove(layer.boxes[k].min, layer.boxes[k].max, k);
+            layer.index.erase(layer.ids[k]);
+            layer.ids[k].clear();
+            layer.free.push_back(k);
+        }
+    }
+}
+
+
+std::vector<std::string>
+TraCISpatialIndex::getWithin(ObjectType type, SUMOReal x, SUMOReal y, SUMOReal radius) const {
+    const Layer& layer = myLayers[type];
+    std::vector<unsigned int> found;
+    Collector collector(found);
+    layer.tree.searchWithin((float)x, (float)y, (float)radius, collector);
+    return filter(layer, found, x, y, radius);
+}
+
+
+std::vector<std::string>
+TraCISpatialIndex::getNearJunction(ObjectType type, const std::string& junctionID, SUMOReal radius) const {
+    const Layer& junctions = myLayers[OBJECT_JUNCTION];
+    const unsigned int* const junction = junctions.index.find(junctionID);
+    if (junction != 0) {
+        const PackedRTree<unsigned int>::Box& box = junctions.boxes[*junction];
+        return getWithin(type, box.min[0], box.min[1], radius);
+    }
+    const TraCIAPI::TraCIPosition p = myAPI.junction.getPosition(junctionID);
+    return getWithin(type, p.x, p.y, radius);
+}
+
+
+std::vector<std::string>
+TraCISpatialIndex::getWithinLinear(ObjectType type, SUMOReal x, SUMOReal y, SUMOReal radius) const {
+    const Layer& layer = myLayers[type];
+    std::vector<unsigned int> found;
+    for (unsigned int i = 0; i < (unsigned int)layer.ids.size(); ++i) {
+        if (!layer.ids[i].empty()) {
+            found.push_back(i);
+        }
+    }
+    return filter(layer, found, x, y, radius);
+}
+
+
+size_t
+TraCISpatialIndex::size(ObjectType type) const {
+    return myLayers[type].tree.size();
+}
+
+
+void
+TraCISpatialIndex::clear(Layer& layer) {
+    layer.tree.clear();
+    layer.ids.clear();
+    layer.boxes.clear();
+    layer.shapes.clear();
+    layer.index.clear();
+    layer.free.clear();
+}
+
+
+void
+TraCISpatialIndex::add(Layer& layer, const std::string& id, const PackedRTree<unsigned int>::Box& box) {
+    unsigned int k;
+    if (!layer.free.empty()) {
+        k = layer.free.back();
+        layer.free.pop_back();
+        layer.ids[k] = id;
+        layer.boxes[k] = box;
+    } else {
+        k = (unsigned int)layer.ids.size();
+        layer.ids.push_back(id);
+        layer.boxes.push_back(box);
+    }
+    layer.index.insert(id, k);
+    layer.tree.insert(box.min, box.max, k);
+}
+
+
+void
+TraCISpatialIndex::loadPoints(ObjectType type, int cmd, const std::vector<std::string>& ids) {
+    Layer& layer = myLayers[type];
+    clear(layer);
+    for (std::vector<std::string>::const_iterator i = ids.begin(); i != ids.end(); ++i) {
+        const TraCIAPI::TraCIPosition p = myAPI.getPosition(cmd, VAR_POSITION, *i);
+        add(layer, *i, pointBox(p.x, p.y));
+    }
+    layer.tree.pack();
+}
+
+
+bool
+TraCISpatialIndex::isWithin(const Layer& layer, unsigned int i, SUMOReal x, SUMOReal y, SUMOReal radius) const {
+    if (layer.ids[i].empty()) {
+        return false;
+    }
+    if (!layer.shapes.empty()) {
+        return distanceToShape(layer.shapes[i], x, y) <= radius;
+    }
+    // compare in float precision like the tree does
+    return layer.boxes[i].distance2((float)x, (float)y) <= (float)radius * (float)radius;
+}
+
+
+std::vector<std::string>
+TraCISpatialIndex::filter(const Layer& layer, const std::vector<unsigned int>& found,
+                          SUMOReal x, SUMOReal y, SUMOReal radius) const {
+    std::vector<std::string> result;
+    for (std::vector<unsigned int>::const_iterator i = found.begin(); i != found.end(); ++i) {
+        if (isWithin(layer, *i, x, y, radius)) {
+            result.push_back(layer.ids[*i]);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+
+PackedRTree<unsigned int>::Box
+TraCISpatialIndex::pointBox(SUMOReal x, SUMOReal y) {
+    PackedRTree<unsigned int>::Box box;
+    box.min[0] = box.max[0] = (float)x;
+    box.min[1] = box.max[1] = (float)y;
+    return box;
+}
+
+
+SUMOReal
+TraCISpatialIndex::distanceToShape(const TraCIAPI::TraCIPositionVector& shape, SUMOReal x, SUMOReal y) {
+    SUMOReal best = sqrt((shape[0].x - x) * (shape[0].x - x) + (shape[0].y - y) * (shape[0].y - y));
+    for (size_t i = 1; i < shape.size(); ++i) {
+        const SUMOReal dx = shape[i].x - shape[i - 1].x;
+        const SUMOReal dy = shape[i].y - shape[i - 1].y;
+        const SUMOReal length2 = dx * dx + dy * dy;
+        SUMOReal t = length2 > 0 ? ((x - shape[i - 1].x) * dx + (y - shape[i - 1].y) * dy) / length2 : 0;
+        t = MAX2((SUMOReal)0, MIN2((SUMOReal)1, t));
+        const SUMOReal px = shape[i - 1].x + t * dx - x;
+        const SUMOReal py = shape[i - 1].y + t * dy - y;
+        best = MIN2(best, (SUMOReal)sqrt(px * px + py * py));
+    }
+    return best;
+}
+
+
+TraCIAPI::TraCIPosition
+TraCISpatialIndex::positionAtOffset(const TraCIAPI::TraCIPositionVector& shape, SUMOReal pos) {
+    TraCIAPI::TraCIPosition result;
+    result.x = result.y = result.z = 0;
+    if (shape.empty()) {
+        return result;
+    }
+    result = shape[0];
+    for (size_t i = 1; i < shape.size(); ++i) {
+        const SUMOReal dx = shape[i].x - shape[i - 1].x;
+        const SUMOReal dy = shape[i].y - shape[i - 1].y;
+        const SUMOReal length = sqrt(dx * dx + dy * dy);
+        if (pos <= length && length > 0) {
+            result.x = shape[i - 1].x + dx * pos / length;
+            result.y = shape[i - 1].y + dy * pos / length;
+            return result;
+        }
+        pos -= length;
+        result = shape[i];
+    }
+    return result;
+}
+
+
+/****************************************************************************/
+
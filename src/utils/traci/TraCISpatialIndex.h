@@ -0,0 +1,216 @@
+/****************************************************************************/
+/// @file    TraCISpatialIndex.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// A client side spatial index over objects retrieved via TraCI
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef TraCISpatialIndex_h
+#define TraCISpatialIndex_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <vector>
+#include <string>
+#include <utils/common/FlatStringMap.h>
+#include <utils/common/PackedRTree.h>
+#include "TraCIAPI.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class TraCISpatialIndex
+ * @brief A client side spatial index over objects retrieved via TraCI
+ *
+ * Answers "which objects are within a distance of this point / junction"
+ *  without asking the simulation. The static objects (junctions, POIs,
+ *  lanes and induction loops) are retrieved once and packed into one
+ *  PackedRTree per object type; vehicles are updated incrementally by
+ *  updateVehicles, which is meant to be called once per simulation step.
+ *
+ * Points (junctions, POIs, loops, vehicles) are stored as degenerated
+ *  rectangles; lanes are stored by the bounding box of their shape and
+ *  are reported if any segment of the shape is within the distance.
+ */
+class TraCISpatialIndex {
+public:
+    /// @brief The indexed object types
+    enum ObjectType {
+        OBJECT_JUNCTION = 0,
+        OBJECT_POI,
+        OBJECT_LANE,
+        OBJECT_INDUCTIONLOOP,
+        OBJECT_VEHICLE,
+        OBJECT_TYPE_NUMBER
+    };
+
+
+public:
+    /** @brief Constructor
+     * @param[in] api The connection to retrieve the objects with
+     */
+    TraCISpatialIndex(TraCIAPI& api);
+
+
+    /// @brief Destructor
+    ~TraCISpatialIndex();
+
+
+    /// @name retrieving the objects
+    /// @{
+
+    /// @brief Retrieves the positions of all junctions
+    void loadJunctions();
+
+    /// @brief Retrieves the positions of all POIs
+    void loadPOIs();
+
+    /// @brief Retrieves the shapes of all lanes
+    void loadLanes();
+
+    /// @brief Retrieves the positions of all induction loops (uses the lane shapes if loaded)
+    void loadInductionLoops();
+
+    /** @brief Retrieves the positions of all vehicles
+     *
+     * Known vehicles are moved, departed ones added and arrived ones removed.
+     *  The moved vehicles stay in the tree's unpacked buffer until it
+     *  repacks itself, so a step costs no full rebuild.
+     */
+    void updateVehicles();
+    /// @}
+
+
+    /// @name queries
+    /// @{
+
+    /** @brief Returns the ids of all objects of the given type within the distance of the point
+     * @param[in] type The type of objects to report
+     * @param[in] x The x-coordinate of the point
+     * @param[in] y The y-coordinate of the point
+     * @param[in] radius The distance
+     * @return The sorted ids of the objects found
+     */
+    std::vector<std::string> getWithin(ObjectType type, SUMOReal x, SUMOReal y, SUMOReal radius) const;
+
+
+    /** @brief Returns the ids of all objects of the given type within the distance of the junction
+     *
+     * The junction's position is taken from the index if junctions were loaded.
+     *
+     * @param[in] type The type of objects to report
+     * @param[in] junctionID The id of the junction
+     * @param[in] radius The distance
+     * @return The sorted ids of the objects found
+     */
+    std::vector<std::string> getNearJunction(ObjectType type, const std::string& junctionID, SUMOReal radius) const;
+
+
+    /** @brief Returns the ids of all objects of the given type within the distance, found by a linear scan
+     *
+     * Yields the same result as getWithin; meant for validating and benchmarking.
+     */
+    std::vector<std::string> getWithinLinear(ObjectType type, SUMOReal x, SUMOReal y, SUMOReal radius) const;
+
+
+    /// @brief Returns the number of indexed objects of the given type
+    size_t size(ObjectType type) const;
+    /// @}
+
+
+private:
+    /// @brief The objects of one type
+    struct Layer {
+        /// @brief The tree storing indices into the following vectors
+        PackedRTree<unsigned int> tree;
+        /// @brief The object ids (empty for free slots)
+        std::vector<std::string> ids;
+        /// @brief The bounding boxes the objects were inserted with
+        std::vector<PackedRTree<unsigned int>::Box> boxes;
+        /// @brief The shapes (lanes only)
+        std::vector<TraCIAPI::TraCIPositionVector> shapes;
+        /// @brief The index by id
+        FlatStringMap<unsigned int> index;
+        /// @brief Free slots (vehicles only)
+        std::vector<unsigned int> free;
+    };
+
+    /// @brief Collects the indices found within the tree
+    struct Collector {
+        Collector(std::vector<unsigned int>& into) : myInto(into) {}
+        void operator()(unsigned int i) {
+            myInto.push_back(i);
+        }
+        std::vector<unsigned int>& myInto;
+    };
+
+
+    /// @brief Removes all objects from the layer
+    static void clear(Layer& layer);
+
+    /// @brief Adds an object to the layer (without packing)
+    void add(Layer& layer, const std::string& id, const PackedRTree<unsigned int>::Box& box);
+
+    /// @brief Clears the layer and adds the points of the given ids
+    void loadPoints(ObjectType type, int cmd, const std::vector<std::string>& ids);
+
+    /// @brief Returns whether the object at the index is within the distance
+    bool isWithin(const Layer& layer, unsigned int i, SUMOReal x, SUMOReal y, SUMOReal radius) const;
+
+    /// @brief Returns the ids of the found objects within the distance, sorted
+    std::vector<std::string> filter(const Layer& layer, const std::vector<unsigned int>& found,
+                                    SUMOReal x, SUMOReal y, SUMOReal radius) const;
+
+    /// @brief Returns the bounding box of the point
+    static PackedRTree<unsigned int>::Box pointBox(SUMOReal x, SUMOReal y);
+
+    /// @brief Returns the distance between the point and the polyline
+    static SUMOReal distanceToShape(const TraCIAPI::TraCIPositionVector& shape, SUMOReal x, SUMOReal y);
+
+    /// @brief Returns the position at the given offset along the polyline
+    static TraCIAPI::TraCIPosition positionAtOffset(const TraCIAPI::TraCIPositionVector& shape, SUMOReal pos);
+
+
+private:
+    /// @brief The connection
+    TraCIAPI& myAPI;
+
+    /// @brief The objects by type
+    Layer myLayers[OBJECT_TYPE_NUMBER];
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    TraCISpatialIndex(const TraCISpatialIndex&);
+
+    /// @brief Invalidated assignment operator.
+    TraCISpatialIndex& operator=(const TraCISpatialIndex&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
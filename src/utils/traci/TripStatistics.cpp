@@ -0,0 +1,202 @@
+/****************************************************************************/
+/// @file    TripStatistics.cpp
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Online travel time statistics of the vehicles per class
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <algorithm>
+#include <functional>
+#include "TripStatistics.h"
+
+
+// ===========================================================================
+// static members
+// ===========================================================================
+const unsigned int TripStatistics::NO_CLASS = (unsigned int) - 1;
+
+
+// ===========================================================================
+// member definitions
+// ===========================================================================
+TripStatistics::TripStatistics(SUMOTime begin, double compression)
+    : myBegin(begin), myCompression(compression), myDefaultClass(NO_CLASS),
+      myNumUnclassified(0), myNumUnseenDepartures(0) {}
+
+
+TripStatistics::~TripStatistics() {
+    for (std::vector<Class*>::iterator i = myClasses.begin(); i != myClasses.end(); ++i) {
+        delete *i;
+    }
+}
+
+
+unsigned int
+TripStatistics::addClass(const std::string& name) {
+    const unsigned int known = getClass(name);
+    if (known != NO_CLASS) {
+        return known;
+    }
+    myClasses.push_back(new Class(name, myCompression));
+    myClassIndex.insert(name, (unsigned int)myClasses.size() - 1);
+    return (unsigned int)myClasses.size() - 1;
+}
+
+
+unsigned int
+TripStatistics::getClass(const StringRef& name) const {
+    const unsigned int* const known = myClassIndex.find(name);
+    return known != 0 ? *known : NO_CLASS;
+}
+
+
+void
+TripStatistics::addPrefix(const std::string& prefix, unsigned int cls) {
+    unsigned int* const known = myPrefixes.find(prefix);
+    if (known != 0) {
+        *known = cls;
+        return;
+    }
+    myPrefixes.insert(prefix, cls);
+    const unsigned int length = (unsigned int)prefix.size();
+    if (std::find(myPrefixLengths.begin(), myPrefixLengths.end(), length) == myPrefixLengths.end()) {
+        myPrefixLengths.push_back(length);
+        std::sort(myPrefixLengths.begin(), myPrefixLengths.end(), std::greater<unsigned int>());
+    }
+}
+
+
+void
+TripStatistics::addType(const std::string& typeID, unsigned int cls) {
+    unsigned int* const known = myTypes.find(typeID);
+    if (known != 0) {
+        *known = cls;
+    } else {
+        myTypes.insert(typeID, cls);
+    }
+}
+
+
+unsigned int
+TripStatistics::classify(const StringRef& vehID) const {
+    for (std::vector<unsigned int>::const_iterator i = myPrefixLengths.begin(); i != myPrefixLengths.end(); ++i) {
+        if (*i <= vehID.size()) {
+            const unsigned int* const cls = myPrefixes.find(StringRef(vehID.data(), *i));
+            if (cls != 0) {
+                return *cls;
+            }
+        }
+    }
+    return myDefaultClass;
+}
+
+
+void
+TripStatistics::depart(const StringRef& vehID, SUMOTime time, const StringRef& typeID) {
+    const unsigned int* const byType = typeID.empty() ? 0 : myTypes.find(typeID);
+    const unsigned int cls = byType != 0 ? *byType : classify(vehID);
+    if (!myDepartures.insert(vehID.str(), Departure(time, cls))) {
+        return;
+    }
+    if (cls != NO_CLASS) {
+        myClasses[cls]->departed++;
+        myClasses[cls]->running++;
+    }
+}
+
+
+void
+TripStatistics::arrive(const StringRef& vehID, SUMOTime time) {
+    const Departure* const departure = myDepartures.find(vehID);
+    unsigned int cls;
+    SUMOTime begin;
+    if (departure != 0) {
+        cls = departure->cls;
+        begin = departure->time;
+        myDepartures.erase(vehID);
+        if (cls != NO_CLASS) {
+            myClasses[cls]->running--;
+        }
+    } else {
+        cls = classify(vehID);
+        begin = myBegin;
+        myNumUnseenDepartures++;
+    }
+    if (cls == NO_CLASS) {
+        myNumUnclassified++;
+        return;
+    }
+    Class& c = *myClasses[cls];
+    const double travelTime = (double)(time - begin);
+    c.arrived++;
+    c.sum += travelTime;
+    c.travelTimes.add(travelTime);
+}
+
+
+void
+TripStatistics::depart(const StepSummary::IDList& vehIDs, SUMOTime time) {
+    for (StepSummary::IDList::const_iterator i = vehIDs.begin(); i != vehIDs.end(); ++i) {
+        depart(*i, time);
+    }
+}
+
+
+void
+TripStatistics::arrive(const StepSummary::IDList& vehIDs, SUMOTime time) {
+    for (StepSummary::IDList::const_iterator i = vehIDs.begin(); i != vehIDs.end(); ++i) {
+        arrive(*i, time);
+    }
+}
+
+
+void
+TripStatistics::update(const StepSummary& summary, SUMOTime time) {
+    if (!summary.isValid()) {
+        return;
+    }
+    // a vehicle may depart and arrive within the same step
+    depart(summary.getDepartedIDList(), time);
+    arrive(summary.getArrivedIDList(), time);
+}
+
+
+void
+TripStatistics::writeHeader(std::ostream& into) {
+    into << "time\tclass\tdeparted\tarrived\trunning\tmean\tmin\tmedian\tp90\tp99\tmax" << std::endl;
+}
+
+
+void
+TripStatistics::write(std::ostream& into, SUMOTime time) const {
+    for (unsigned int i = 0; i < (unsigned int)myClasses.size(); ++i) {
+        const Class& c = *myClasses[i];
+        into << time << "\t" << c.name << "\t" << c.departed << "\t" << c.arrived << "\t" << c.running
+             << "\t" << getMeanTravelTime(i) << "\t" << c.travelTimes.getMin()
+             << "\t" << c.travelTimes.getQuantile(.5) << "\t" << c.travelTimes.getQuantile(.9)
+             << "\t" << c.travelTimes.getQuantile(.99) << "\t" << c.travelTimes.getMax() << "\n";
+    }
+    into.flush();
+}
+
+
+/****************************************************************************/
+
@@ -0,0 +1,281 @@
+/****************************************************************************/
+/// @file    TripStatistics.h
+/// @date    Oct 2026
+/// @version $Id$
+///
+// Online travel time statistics of the vehicles per class
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2012-2015 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef TripStatistics_h
+#define TripStatistics_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#include <config.h>
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <utils/common/FlatStringMap.h>
+#include <utils/common/StringRef.h>
+#include <utils/common/SUMOTime.h>
+#include <utils/common/TDigest.h>
+#include "StepSummary.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class TripStatistics
+ * @brief Online travel time statistics of the vehicles per class
+ *
+ * The departing and arriving vehicles are fed per step (e.g. from a
+ *  StepSummary); each vehicle is classified when it departs and its travel
+ *  time is recorded within its class when it arrives. The numbers, the sum
+ *  and the extremes of each class are kept up to date, the quantiles are
+ *  estimated by a TDigest, so all values may be read during the run at a
+ *  cost which does not grow with the number of trips.
+ *
+ * The classes are interned names. A vehicle is classified by its type if a
+ *  class was given for it, else by the longest prefix of its id a class was
+ *  given for (a flow's vehicles are named "<flow>.<index>"), else it falls
+ *  into the default class. The matcher looks up each distinct prefix length
+ *  once, so classifying does not copy the id.
+ *
+ * Vehicles arriving without a recorded departure (e.g. as only arrivals
+ *  are fed) are measured from the begin of the statistics, making their
+ *  travel time the arrival time.
+ */
+class TripStatistics {
+public:
+    /// @brief The class of vehicles not matched by any rule (without a default class)
+    static const unsigned int NO_CLASS;
+
+
+    /** @brief Constructor
+     * @param[in] begin The time vehicles without a recorded departure are measured from
+     * @param[in] compression The accuracy of the quantiles (see TDigest)
+     */
+    TripStatistics(SUMOTime begin = 0, double compression = 100);
+
+
+    /// @brief Destructor
+    ~TripStatistics();
+
+
+    /// @name classification
+    /// @{
+
+    /** @brief Returns the index of the class, adding it if it is not known
+     * @param[in] name The name of the class
+     * @return The index of the class
+     */
+    unsigned int addClass(const std::string& name);
+
+    /// @brief Returns the index of the named class (NO_CLASS if not known)
+    unsigned int getClass(const StringRef& name) const;
+
+    /// @brief Returns the number of classes
+    unsigned int getNumClasses() const {
+        return (unsigned int)myClasses.size();
+    }
+
+    /// @brief Returns the name of the class
+    const std::string& getClassName(unsigned int cls) const {
+        return myClasses[cls]->name;
+    }
+
+    /// @brief Assigns the vehicles whose id starts with the prefix to the class
+    void addPrefix(const std::string& prefix, unsigned int cls);
+
+    /// @brief Assigns the vehicles of the type to the class
+    void addType(const std::string& typeID, unsigned int cls);
+
+    /// @brief Sets the class of the vehicles not matched otherwise
+    void setDefaultClass(unsigned int cls) {
+        myDefaultClass = cls;
+    }
+
+    /// @brief Returns the class of the vehicle by its id (NO_CLASS if not matched)
+    unsigned int classify(const StringRef& vehID) const;
+    /// @}
+
+
+    /// @name feeding
+    /// @{
+
+    /** @brief Records the departure of a vehicle
+     * @param[in] vehID The id of the vehicle
+     * @param[in] time The time of the departure
+     * @param[in] typeID The type of the vehicle (empty if not known)
+     */
+    void depart(const StringRef& vehID, SUMOTime time, const StringRef& typeID = StringRef());
+
+    /** @brief Records the arrival of a vehicle
+     * @param[in] vehID The id of the vehicle
+     * @param[in] time The time of the arrival
+     */
+    void arrive(const StringRef& vehID, SUMOTime time);
+
+    /// @brief Records the departure of the vehicles
+    void depart(const StepSummary::IDList& vehIDs, SUMOTime time);
+
+    /// @brief Records the arrival of the vehicles
+    void arrive(const StepSummary::IDList& vehIDs, SUMOTime time);
+
+    /// @brief Records the departures and then the arrivals of the summarised step
+    void update(const StepSummary& summary, SUMOTime time);
+    /// @}
+
+
+    /// @name the statistics of a class, the travel times are in the unit of the given times
+    /// @{
+
+    unsigned int getDepartedNumber(unsigned int cls) const {
+        return myClasses[cls]->departed;
+    }
+
+    unsigned int getArrivedNumber(unsigned int cls) const {
+        return myClasses[cls]->arrived;
+    }
+
+    /// @brief Returns the number of vehicles departed but not arrived
+    unsigned int getRunningNumber(unsigned int cls) const {
+        return myClasses[cls]->running;
+    }
+
+    double getTravelTimeSum(unsigned int cls) const {
+        return myClasses[cls]->sum;
+    }
+
+    /// @brief Returns the mean travel time (0 if no vehicle arrived)
+    double getMeanTravelTime(unsigned int cls) const {
+        return myClasses[cls]->arrived > 0 ? myClasses[cls]->sum / myClasses[cls]->arrived : 0;
+    }
+
+    double getMinTravelTime(unsigned int cls) const {
+        return myClasses[cls]->travelTimes.getMin();
+    }
+
+    double getMaxTravelTime(unsigned int cls) const {
+        return myClasses[cls]->travelTimes.getMax();
+    }
+
+    /// @brief Returns the estimated travel time at the quantile q within [0, 1]
+    double getTravelTimeQuantile(unsigned int cls, double q) const {
+        return myClasses[cls]->travelTimes.getQuantile(q);
+    }
+    /// @}
+
+
+    /// @brief Returns the number of arrived vehicles which were not classified
+    unsigned int getNumUnclassified() const {
+        return myNumUnclassified;
+    }
+
+
+    /// @brief Returns the number of arrived vehicles whose departure was not recorded
+    unsigned int getNumUnseenDepartures() const {
+        return myNumUnseenDepartures;
+    }
+
+
+    /// @brief Writes the tab separated column names matching write()
+    static void writeHeader(std::ostream& into);
+
+
+    /** @brief Writes one tab separated line per class
+     * @param[in] into The stream to write to
+     * @param[in] time The time to write in the first column
+     */
+    void write(std::ostream& into, SUMOTime time) const;
+
+
+private:
+    /// @brief A class of vehicles
+    struct Class {
+        Class(const std::string& n, double compression)
+            : name(n), departed(0), arrived(0), running(0), sum(0), travelTimes(compression) {}
+        /// @brief The name
+        const std::string name;
+        /// @brief The numbers of vehicles
+        unsigned int departed, arrived, running;
+        /// @brief The sum of the travel times
+        double sum;
+        /// @brief The distribution of the travel times
+        TDigest travelTimes;
+    };
+
+    /// @brief A vehicle which departed
+    struct Departure {
+        Departure() : time(0), cls(NO_CLASS) {}
+        Departure(SUMOTime t, unsigned int c) : time(t), cls(c) {}
+        /// @brief The time of the departure
+        SUMOTime time;
+        /// @brief The class
+        unsigned int cls;
+    };
+
+
+private:
+    /// @brief The time vehicles without a recorded departure are measured from
+    const SUMOTime myBegin;
+
+    /// @brief The accuracy of the quantiles
+    const double myCompression;
+
+    /// @brief The classes
+    std::vector<Class*> myClasses;
+
+    /// @brief The classes by name
+    FlatStringMap<unsigned int> myClassIndex;
+
+    /// @brief The classes by id prefix
+    FlatStringMap<unsigned int> myPrefixes;
+
+    /// @brief The distinct lengths of the prefixes, longest first
+    std::vector<unsigned int> myPrefixLengths;
+
+    /// @brief The classes by type
+    FlatStringMap<unsigned int> myTypes;
+
+    /// @brief The class of the vehicles not matched otherwise
+    unsigned int myDefaultClass;
+
+    /// @brief The vehicles departed but not arrived
+    FlatStringMap<Departure> myDepartures;
+
+    /// @brief The number of arrived vehicles which were not classified
+    unsigned int myNumUnclassified;
+
+    /// @brief The number of arrived vehicles whose departure was not recorded
+    unsigned int myNumUnseenDepartures;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    TripStatistics(const TripStatistics&);
+
+    /// @brief Invalidated assignment operator.
+    TripStatistics& operator=(const TripStatistics&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+